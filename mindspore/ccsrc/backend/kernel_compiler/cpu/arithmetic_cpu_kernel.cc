@@ -17,6 +17,7 @@
 #include <map>
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "nnacl/fp32/add_fp32.h"
 #include "nnacl/fp32/power_fp32.h"
 #include "nnacl/fp32/sub_fp32.h"
 #include "nnacl/fp32/mul_fp32.h"
@@ -35,347 +36,152 @@ void ArithmeticCPUKernel<T>::AssignAdd(T *input1, const T *input2, T *out) {
 }
 
 template <typename T>
-void ArithmeticCPUKernel<T>::Add(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] + input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
+template <typename Op>
+void ArithmeticCPUKernel<T>::BinaryOp(const T *input1, const T *input2, T *out, const Op &op) {
+  auto row_type = broadcast_.row_type();
+  auto row_func = [input1, input2, out, row_type, &op](size_t pos1, size_t pos2, size_t pos, size_t size) {
+    BroadcastRowCompute(input1 + pos1, input2 + pos2, out + pos, size, row_type, op);
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto task = [this, &row_func](size_t start, size_t end) { broadcast_.ForEachRow(start, end, row_func); };
+  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
-void ArithmeticCPUKernel<T>::Sub(const T *input1, const T *input2, T *out) {
+void ArithmeticCPUKernel<T>::NnaclBinaryOp(const float *input1, const float *input2, float *out,
+                                           NnaclElementFunc element_func, NnaclElementOptFunc element_opt_func) {
+  ArithmeticParameter row_para = op_para;
+  row_para.in_elements_num0_ = broadcast_.row_type() == BroadcastRowIterator::kRowScalarA ? 1 : 0;
+  row_para.in_elements_num1_ = broadcast_.row_type() == BroadcastRowIterator::kRowScalarB ? 1 : 0;
+  auto task = [&](size_t start, size_t end) {
+    broadcast_.ForEachRow(start, end, [&](size_t pos1, size_t pos2, size_t pos, size_t size) {
+      if (broadcast_.row_type() == BroadcastRowIterator::kRowElementwise) {
+        (void)element_func(input1 + pos1, input2 + pos2, out + pos, SizeToInt(size));
+      } else {
+        (void)element_opt_func(input1 + pos1, input2 + pos2, out + pos, SizeToInt(size), &row_para);
+      }
+    });
+  };
+  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+}
+
+template <typename T>
+void ArithmeticCPUKernel<T>::Add(const T *input1, const T *input2, T *out) {
   if constexpr (std::is_same_v<T, float>) {
-    if (input_shape1_ == input_shape2_) {
-      auto task = [&](size_t start, size_t end) {
-        ElementSub(input1 + start, input2 + start, out + start, end - start);
-      };
-      ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-      return;
-    }
-    if (op_para.in_elements_num0_ == 1 || op_para.in_elements_num1_ == 1) {
-      auto task = [&](size_t start, size_t end) {
-        if (op_para.in_elements_num0_ == 1) {
-          ElementOptSub(input1, input2 + start, out + start, end - start, &op_para);
-        } else {
-          ElementOptSub(input1 + start, input2, out + start, end - start, &op_para);
-        }
-      };
-      ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-      return;
-    }
+    NnaclBinaryOp(input1, input2, out, ElementAdd, ElementOptAdd);
+    return;
   }
+  BinaryOp(input1, input2, out, [](T x, T y) { return x + y; });
+}
 
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_, MAX_SUB_SERIAL_SIZE);
+template <typename T>
+void ArithmeticCPUKernel<T>::Sub(const T *input1, const T *input2, T *out) {
+  if constexpr (std::is_same_v<T, float>) {
+    NnaclBinaryOp(input1, input2, out, ElementSub, ElementOptSub);
+    return;
+  }
+  BinaryOp(input1, input2, out, [](T x, T y) { return x - y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Mul(const T *input1, const T *input2, T *out) {
   if constexpr (std::is_same_v<T, float>) {
-    if (input_shape1_ == input_shape2_) {
-      auto task = [&](size_t start, size_t end) {
-        ElementMul(input1 + start, input2 + start, out + start, end - start);
-      };
-      ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-      return;
-    }
-    if (op_para.in_elements_num0_ == 1 || op_para.in_elements_num1_ == 1) {
-      auto task = [&](size_t start, size_t end) {
-        if (op_para.in_elements_num0_ == 1) {
-          ElementOptMul(input1, input2 + start, out + start, end - start, &op_para);
-        } else {
-          ElementOptMul(input1 + start, input2, out + start, end - start, &op_para);
-        }
-      };
-      ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-      return;
-    }
+    NnaclBinaryOp(input1, input2, out, ElementMul, ElementOptMul);
+    return;
   }
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] * input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, [](T x, T y) { return x * y; });
 }
 
 template <typename T>
-void ElementRealDiv(const T *input1, const T *input2, T *out, size_t size, size_t delta_1, size_t delta_2) {
-  size_t idx_1 = 0;
-  size_t idx_2 = 0;
+T DivideWithZero(T dividend, T divisor) {
   auto zero = (T)0;
-  for (size_t i = 0; i < size; ++i) {
-    auto dividend = input1[idx_1];
-    auto divisor = input2[idx_2];
-    idx_1 += delta_1;
-    idx_2 += delta_2;
-    if (divisor == zero) {
-      if (dividend == zero) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      if (std::numeric_limits<T>::has_infinity) {
-        out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-      } else {
-        out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-      }
-      continue;
+  if (divisor == zero) {
+    if (dividend == zero) {
+      return std::numeric_limits<T>::quiet_NaN();
     }
-    out[i] = dividend / divisor;
+    if (std::numeric_limits<T>::has_infinity) {
+      return dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+    }
+    return dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
   }
+  return dividend / divisor;
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::RealDiv(const T *input1, const T *input2, T *out) {
-  if (input_shape1_ == input_shape2_) {
-    auto task = [&](size_t start, size_t end) {
-      ElementRealDiv<T>(input1 + start, input2 + start, out + start, end - start, 1, 1);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-  if (op_para.in_elements_num0_ == 1) {
-    auto task = [&](size_t start, size_t end) {
-      ElementRealDiv<T>(input1, input2 + start, out + start, end - start, 0, 1);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-  if (op_para.in_elements_num1_ == 1) {
-    auto task = [&](size_t start, size_t end) {
-      ElementRealDiv<T>(input1 + start, input2, out + start, end - start, 1, 0);
-    };
-    ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
-    return;
-  }
-
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = dividend / divisor;
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, DivideWithZero<T>);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Div(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = dividend / divisor;
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, DivideWithZero<T>);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::FloorDiv(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = (T)floor(static_cast<double>(dividend) / static_cast<double>(divisor));
+  BinaryOp(input1, input2, out, [](T dividend, T divisor) {
+    auto zero = (T)0;
+    if (divisor == zero) {
+      return DivideWithZero(dividend, divisor);
     }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+    return (T)floor(static_cast<double>(dividend) / static_cast<double>(divisor));
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Mod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto data_div = x / y;
-      auto data_div_min = data_div < 0.0 ? data_div : 0.0;
-      auto data_div_max = data_div > 0.0 ? data_div : 0.0;
-      auto data_div_max_floor = floor(data_div_max);
-      auto data_div_min_ceil = ceil(data_div_min);
-      auto data_div_res = data_div_max_floor + data_div_min_ceil;
-      out[i] = static_cast<T>(x - data_div_res * y);
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, [](T input_x, T input_y) {
+    auto x = static_cast<double>(input_x);
+    auto y = static_cast<double>(input_y);
+    auto data_div = x / y;
+    auto data_div_min = data_div < 0.0 ? data_div : 0.0;
+    auto data_div_max = data_div > 0.0 ? data_div : 0.0;
+    auto data_div_max_floor = floor(data_div_max);
+    auto data_div_min_ceil = ceil(data_div_min);
+    auto data_div_res = data_div_max_floor + data_div_min_ceil;
+    return static_cast<T>(x - data_div_res * y);
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::FloorMod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto res = x - floor(x / y) * y;
-      out[i] = static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, [](T input_x, T input_y) {
+    auto x = static_cast<double>(input_x);
+    auto y = static_cast<double>(input_y);
+    auto res = x - floor(x / y) * y;
+    return static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Pow(const T *input1, const T *input2, T *out) {
+  auto pow = [](T x, T y) { return static_cast<T>(std::pow(static_cast<double>(x), static_cast<double>(y))); };
   if constexpr (std::is_same_v<T, float>) {
-    auto is_power_single = [this]() {
-      bool is_power_single = false;
-      if (input_shape1_.size() == input_shape2_.size()) {
-        is_power_single = true;
-        for (size_t i = 0; i < input_shape1_.size(); ++i) {
-          if (input_shape1_[i] != input_shape2_[i]) {
-            is_power_single = false;
-            break;
-          }
-        }
-      }
-      return is_power_single;
-    };
-
-    if (op_para.in_elements_num1_ == 1) {
-      auto task = [&](size_t start, size_t end) {
-        (void)Power(input1 + start, input2, out + start, end - start, 1, 0, true);
-      };
-      CPUKernelUtils::ParallelFor(task, output_size_);
-      return;
-    }
-    if (is_power_single()) {
+    // The nnacl power takes a contiguous or a single exponent.
+    if (broadcast_.row_type() != BroadcastRowIterator::kRowScalarA) {
+      bool scalar_exponent = broadcast_.row_type() == BroadcastRowIterator::kRowScalarB;
       auto task = [&](size_t start, size_t end) {
-        (void)Power(input1 + start, input2 + start, out + start, end - start, 1, 0, false);
+        broadcast_.ForEachRow(start, end, [&](size_t pos1, size_t pos2, size_t pos, size_t size) {
+          (void)Power(input1 + pos1, input2 + pos2, out + pos, SizeToInt(size), 1, 0, scalar_exponent);
+        });
       };
-      CPUKernelUtils::ParallelFor(task, output_size_);
+      ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
       return;
     }
   }
-
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  if (output_size_ > MAX_POW_SERIAL_SIZE) {
-    auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-        auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-        out[i] = static_cast<T>(std::pow(x, y));
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size_);
-  } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      auto sx = static_cast<double>(input1[base_iter.GetInputPosA()]);
-      auto sy = static_cast<double>(input2[base_iter.GetInputPosB()]);
-      out[i] = static_cast<T>(std::pow(sx, sy));
-      base_iter.GenNextPos();
-    }
-  }
+  BinaryOp(input1, input2, out, pow);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::SquaredDifference(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      T diff = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-      out[i] = diff * diff;
-      iter.GenNextPos();
-    }
-  };
-  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+  BinaryOp(input1, input2, out, [](T x, T y) {
+    T diff = x - y;
+    return diff * diff;
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Atan2(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] =
-        (T)atan2(static_cast<double>(input1[iter.GetInputPosA()]), static_cast<double>(input2[iter.GetInputPosB()]));
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, [](T x, T y) { return (T)atan2(static_cast<double>(x), static_cast<double>(y)); });
 }
 
 static const std::map<std::string, OperateType> kArithmeticBinOpTypeMap = {
@@ -435,6 +241,7 @@ void ArithmeticCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
   CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
   CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_ = BroadcastRowIterator(input_shape1_, input_shape2_, output_shape_);
   dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetInputDeviceDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
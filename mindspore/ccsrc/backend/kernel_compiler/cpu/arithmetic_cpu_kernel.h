@@ -22,10 +22,6 @@
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "nnacl/arithmetic.h"
 
-const float MAX_SUB_SERIAL_SIZE = 10000;
-const float MAX_DIV_SERIAL_SIZE = 10000;
-const float MAX_POW_SERIAL_SIZE = 700;
-
 namespace mindspore {
 namespace kernel {
 template <typename T>
@@ -40,6 +36,12 @@ class ArithmeticCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
+  using NnaclElementFunc = int (*)(const float *, const float *, float *, int);
+  using NnaclElementOptFunc = int (*)(const float *, const float *, float *, int, const ArithmeticParameter *);
+  template <typename Op>
+  void BinaryOp(const T *input1, const T *input2, T *out, const Op &op);
+  void NnaclBinaryOp(const float *input1, const float *input2, float *out, NnaclElementFunc element_func,
+                     NnaclElementOptFunc element_opt_func);
   void Sub(const T *input1, const T *input2, T *out);
   void Add(const T *input1, const T *input2, T *out);
   void Mul(const T *input1, const T *input2, T *out);
@@ -59,6 +61,7 @@ class ArithmeticCPUKernel : public CPUKernel {
   std::vector<size_t> output_shape_;
   std::vector<size_t> output_element_num_;
   size_t output_size_;
+  BroadcastRowIterator broadcast_;
   ArithmeticParameter op_para;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
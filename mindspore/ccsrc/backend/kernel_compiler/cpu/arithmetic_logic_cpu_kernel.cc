@@ -23,138 +23,55 @@
 
 namespace mindspore {
 namespace kernel {
+template <typename T>
+template <typename Op>
+void ArithmeticLogicCPUKernel<T>::BinaryOp(const T *input1, const T *input2, bool *out, const Op &op) {
+  auto row_type = broadcast_.row_type();
+  auto row_func = [input1, input2, out, row_type, &op](size_t pos1, size_t pos2, size_t pos, size_t size) {
+    BroadcastRowCompute(input1 + pos1, input2 + pos2, out + pos, size, row_type, op);
+  };
+  auto task = [this, &row_func](size_t start, size_t end) { broadcast_.ForEachRow(start, end, row_func); };
+  ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+}
+
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::Less(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  if (output_size_ > MAX_LESS_SERIAL_SIZE) {
-    auto task = [&](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = input1[iter.GetInputPosA()];
-        auto y = input2[iter.GetInputPosB()];
-        out[i] = std::less<T>()(x, y);
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size_);
-  } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      auto x = input1[base_iter.GetInputPosA()];
-      auto y = input2[base_iter.GetInputPosB()];
-      out[i] = std::less<T>()(x, y);
-      base_iter.GenNextPos();
-    }
-  }
+  BinaryOp(input1, input2, out, std::less<T>());
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::Equal(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = input1[iter.GetInputPosA()];
-      auto y = input2[iter.GetInputPosB()];
-      out[i] = std::equal_to<T>()(x, y);
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, std::equal_to<T>());
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::NotEqual(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = input1[iter.GetInputPosA()];
-      auto y = input2[iter.GetInputPosB()];
-      out[i] = std::not_equal_to<T>()(x, y);
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, std::not_equal_to<T>());
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::LogicalAnd(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] && input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, [](T x, T y) { return x && y; });
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::LogicalOr(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] || input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, [](T x, T y) { return x || y; });
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::Greater(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = input1[iter.GetInputPosA()];
-      auto y = input2[iter.GetInputPosB()];
-      out[i] = std::greater<T>()(x, y);
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, std::greater<T>());
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::GreaterEqual(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = input1[iter.GetInputPosA()];
-      auto y = input2[iter.GetInputPosB()];
-      out[i] = std::greater_equal<T>()(x, y);
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, std::greater_equal<T>());
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::LessEqual(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = input1[iter.GetInputPosA()];
-      auto y = input2[iter.GetInputPosB()];
-      out[i] = std::less_equal<T>()(x, y);
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BinaryOp(input1, input2, out, std::less_equal<T>());
 }
 
 static const std::map<std::string, OperateType> kArithmeticBinOpTypeMap = {
@@ -196,6 +113,7 @@ void ArithmeticLogicCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
   CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
   CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_ = BroadcastRowIterator(input_shape1_, input_shape2_, output_shape_);
   dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetInputDeviceDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
@@ -21,8 +21,6 @@
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
-#define MAX_LESS_SERIAL_SIZE 15000
-
 namespace mindspore {
 namespace kernel {
 template <typename T>
@@ -37,6 +35,8 @@ class ArithmeticLogicCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
+  template <typename Op>
+  void BinaryOp(const T *input1, const T *input2, bool *out, const Op &op);
   void GenIndex(size_t num, std::vector<size_t> *idx);
   void Less(const T *input1, const T *input2, bool *out);
   void Equal(const T *input1, const T *input2, bool *out);
@@ -53,6 +53,7 @@ class ArithmeticLogicCPUKernel : public CPUKernel {
   std::vector<size_t> output_shape_;
   std::vector<size_t> output_element_num_;
   size_t output_size_;
+  BroadcastRowIterator broadcast_;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
   TypeId target_dtype_{kTypeUnknown};
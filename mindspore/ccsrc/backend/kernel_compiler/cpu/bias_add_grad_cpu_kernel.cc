@@ -15,7 +15,7 @@
  */
 
 #include "backend/kernel_compiler/cpu/bias_add_grad_cpu_kernel.h"
-#include "nnacl/fp32/reduce_fp32.h"
+
 namespace mindspore {
 namespace kernel {
 void BiasAddGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -25,38 +25,33 @@ void BiasAddGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     MS_LOG(EXCEPTION) << "Input tensor's rank must be at least 2 for 'BiasAddGrad' Op, but input tensor's rank is "
                       << input_shape_.size();
   }
+  // The gradient of the bias sums over all axes but the channel axis 1.
+  std::vector<int64_t> axes{0};
+  for (size_t i = 2; i < input_shape_.size(); ++i) {
+    axes.emplace_back(SizeToLong(i));
+  }
+  engine_.Init(input_shape_, axes, ReduceOpType::kSum);
+}
+
+void BiasAddGradCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  if (engine_.GetWorkspaceSize() > 0) {
+    workspace_size_list_.emplace_back(engine_.GetWorkspaceSize());
+  }
 }
 
-bool BiasAddGradCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
+bool BiasAddGradCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
                                   const std::vector<AddressPtr> &outputs) {
   if (inputs.size() != 1 || outputs.size() != 1) {
     MS_LOG(EXCEPTION) << "input output size not support";
   }
+  if (engine_.GetWorkspaceSize() > 0 && (workspace.empty() || workspace[0]->size < engine_.GetWorkspaceSize())) {
+    MS_LOG(EXCEPTION) << "BiasAddGrad needs a workspace of " << engine_.GetWorkspaceSize() << " bytes.";
+  }
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
-
-  if (input_shape_.size() > 2) {
-    size_t hw_size = 1;
-    for (size_t i = 2; i < input_shape_.size(); ++i) {
-      hw_size *= input_shape_[i];
-    }
-
-    size_t c_size = input_shape_[1];
-    for (size_t c = 0; c < c_size; ++c) {
-      output_addr[c] = 0;
-      for (size_t n = 0; n < input_shape_[0]; ++n) {
-        size_t offset = n * c_size * hw_size + c * hw_size;
-        for (size_t hw = 0; hw < hw_size; ++hw) {
-          output_addr[c] += input_addr[offset + hw];
-        }
-      }
-    }
-  } else if (input_shape_.size() == 2) {
-    auto task = [&](size_t start, size_t end) {
-      ReduceSumDim2Axis0(end - start, input_shape_[1], input_shape_[0], input_addr + start, output_addr + start);
-    };
-    ParallelLaunchAutoSearch(task, input_shape_[1], this, &parallel_search_info_);
-  }
+  auto workspace_addr = workspace.empty() ? nullptr : reinterpret_cast<float *>(workspace[0]->addr);
+  engine_.Execute(input_addr, output_addr, workspace_addr);
   return true;
 }
 }  // namespace kernel
@@ -21,6 +21,7 @@
 #include <memory>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/reduce_engine.h"
 
 namespace mindspore {
 namespace kernel {
@@ -33,8 +34,12 @@ class BiasAddGradCPUKernel : public CPUKernel {
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
 
+ protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
+
  private:
   std::vector<size_t> input_shape_;
+  ReduceEngine<float> engine_;
 };
 MS_REG_CPU_KERNEL(BiasAddGrad, KernelAttr(), BiasAddGradCPUKernel);
 }  // namespace kernel
@@ -0,0 +1,418 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/bucket_partition.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Keys a segment counts and scatters at least.
+constexpr size_t kPartitionSegmentSize = 16384;
+// Keys a bucket holds on average at least, below it the buckets are merged.
+constexpr size_t kPartitionBucketSize = 4096;
+// Row elements a task adds at least when the rows are split by columns.
+constexpr size_t kColumnParallelSize = 16384;
+// Digits of the radix sort in a bucket, and the bucket size below which a comparison sort is used instead.
+constexpr size_t kRadixBits = 8;
+constexpr size_t kRadixSize = 1 << kRadixBits;
+constexpr size_t kMaxDigitNum = 64 / kRadixBits;
+constexpr size_t kRadixSortMinSize = 64;
+constexpr uint64_t kSignBit = 1ULL << 63;
+
+// Image of the key in the unsigned integers that keeps the order of the keys.
+template <typename K>
+uint64_t OrderedBits(K key) {
+  if constexpr (std::is_integral<K>::value) {
+    return static_cast<uint64_t>(static_cast<int64_t>(key)) ^ kSignBit;
+  } else {
+    // -0.0 and 0.0 are the same key.
+    double value = key == 0 ? 0.0 : static_cast<double>(key);
+    uint64_t bits = 0;
+    (void)std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & kSignBit) != 0 ? ~bits : (bits | kSignBit);
+  }
+}
+
+size_t SegmentNum(size_t key_num) {
+  return std::min(BucketPartition::kMaxSegmentNum, std::max<size_t>(1, key_num / kPartitionSegmentSize));
+}
+
+// Sort the positions of every bucket and count the distinct keys in it.
+template <typename K, typename I>
+void SortBuckets(const BucketPartition &partition, const K *keys, I *positions, I *buffer, size_t *unique_nums) {
+  auto task = [&partition, keys, positions, buffer, unique_nums](size_t start, size_t end) {
+    for (size_t bucket = start; bucket < end; ++bucket) {
+      partition.SortBucket(bucket, keys, positions, buffer);
+      I *begin = positions + partition.bucket_begin(bucket);
+      I *bucket_end = positions + partition.bucket_end(bucket);
+      size_t unique_num = 0;
+      for (I *pos = begin; pos < bucket_end; ++pos) {
+        if (pos == begin || !(keys[*(pos - 1)] == keys[*pos])) {
+          ++unique_num;
+        }
+      }
+      unique_nums[bucket] = unique_num;
+    }
+  };
+  ParallelLaunch(task, partition.bucket_num(), 1);
+}
+
+// Turn the counts of the buckets into their first output index, return the total.
+size_t ExclusivePrefixSum(size_t *counts, size_t num) {
+  size_t total = 0;
+  for (size_t i = 0; i < num; ++i) {
+    size_t count = counts[i];
+    counts[i] = total;
+    total += count;
+  }
+  return total;
+}
+
+// Replace the flags of the first appearances by their rank among the first appearances, return their number.
+template <typename I>
+size_t RankFirstAppearances(I *flags, size_t key_num) {
+  size_t segment_num = SegmentNum(key_num);
+  size_t segment_size = (key_num + segment_num - 1) / segment_num;
+  size_t segment_counts[BucketPartition::kMaxSegmentNum];
+  auto count_task = [flags, key_num, segment_size, &segment_counts](size_t start, size_t end) {
+    for (size_t segment = start; segment < end; ++segment) {
+      size_t count = 0;
+      size_t key_end = std::min(key_num, (segment + 1) * segment_size);
+      for (size_t i = segment * segment_size; i < key_end; ++i) {
+        count += static_cast<size_t>(flags[i]);
+      }
+      segment_counts[segment] = count;
+    }
+  };
+  ParallelLaunch(count_task, segment_num, 1);
+  size_t total = ExclusivePrefixSum(segment_counts, segment_num);
+  auto rank_task = [flags, key_num, segment_size, &segment_counts](size_t start, size_t end) {
+    for (size_t segment = start; segment < end; ++segment) {
+      size_t rank = segment_counts[segment];
+      size_t key_end = std::min(key_num, (segment + 1) * segment_size);
+      for (size_t i = segment * segment_size; i < key_end; ++i) {
+        if (flags[i] != 0) {
+          flags[i] = static_cast<I>(rank++);
+        }
+      }
+    }
+  };
+  ParallelLaunch(rank_task, segment_num, 1);
+  return total;
+}
+}  // namespace
+
+template <typename K, typename I>
+void BucketPartition::Partition(const K *keys, size_t key_num, I *positions) {
+  size_t segment_num = SegmentNum(key_num);
+  size_t segment_size = (key_num + segment_num - 1) / segment_num;
+  uint64_t segment_min[kMaxSegmentNum];
+  uint64_t segment_max[kMaxSegmentNum];
+  auto task = [keys, key_num, segment_size, &segment_min, &segment_max](size_t start, size_t end) {
+    for (size_t segment = start; segment < end; ++segment) {
+      uint64_t min_bits = UINT64_MAX;
+      uint64_t max_bits = 0;
+      size_t key_end = std::min(key_num, (segment + 1) * segment_size);
+      for (size_t i = segment * segment_size; i < key_end; ++i) {
+        uint64_t bits = OrderedBits(keys[i]);
+        min_bits = std::min(min_bits, bits);
+        max_bits = std::max(max_bits, bits);
+      }
+      segment_min[segment] = min_bits;
+      segment_max[segment] = max_bits;
+    }
+  };
+  if (key_num > 0) {
+    ParallelLaunch(task, segment_num, 1);
+  }
+  uint64_t min_bits = UINT64_MAX;
+  uint64_t max_bits = 0;
+  for (size_t segment = 0; key_num > 0 && segment < segment_num; ++segment) {
+    min_bits = std::min(min_bits, segment_min[segment]);
+    max_bits = std::max(max_bits, segment_max[segment]);
+  }
+  PartitionRange(keys, key_num, min_bits, max_bits, positions);
+}
+
+template <typename K, typename I>
+void BucketPartition::Partition(const K *keys, size_t key_num, size_t bound, I *positions) {
+  if (bound == 0) {
+    PartitionRange(keys, 0, UINT64_MAX, 0, positions);
+    return;
+  }
+  PartitionRange(keys, key_num, OrderedBits(static_cast<K>(0)), OrderedBits(static_cast<K>(bound - 1)), positions);
+}
+
+template <typename K, typename I>
+void BucketPartition::PartitionRange(const K *keys, size_t key_num, uint64_t min_bits, uint64_t max_bits,
+                                     I *positions) {
+  bucket_num_ = 1;
+  offsets_[0] = 0;
+  offsets_[1] = 0;
+  if (key_num == 0 || min_bits > max_bits) {
+    return;
+  }
+  segment_num_ = SegmentNum(key_num);
+  segment_size_ = (key_num + segment_num_ - 1) / segment_num_;
+  size_t max_bucket_num = std::min(kMaxBucketNum, std::max<size_t>(1, key_num / kPartitionBucketSize));
+  uint64_t span = max_bits - min_bits;
+  shift_ = 0;
+  while (shift_ < 63 && (span >> shift_) >= max_bucket_num) {
+    ++shift_;
+  }
+  bucket_num_ = static_cast<size_t>(span >> shift_) + 1;
+  min_bits_ = min_bits;
+
+  auto count_task = [this, keys, key_num, min_bits, max_bits](size_t start, size_t end) {
+    for (size_t segment = start; segment < end; ++segment) {
+      size_t *counts = counts_ + segment * kMaxBucketNum;
+      std::fill(counts, counts + bucket_num_, 0);
+      size_t key_end = std::min(key_num, (segment + 1) * segment_size_);
+      for (size_t i = segment * segment_size_; i < key_end; ++i) {
+        uint64_t bits = OrderedBits(keys[i]);
+        if (bits >= min_bits && bits <= max_bits) {
+          ++counts[(bits - min_bits) >> shift_];
+        }
+      }
+    }
+  };
+  ParallelLaunch(count_task, segment_num_, 1);
+
+  size_t offset = 0;
+  for (size_t bucket = 0; bucket < bucket_num_; ++bucket) {
+    offsets_[bucket] = offset;
+    for (size_t segment = 0; segment < segment_num_; ++segment) {
+      size_t &count = counts_[segment * kMaxBucketNum + bucket];
+      size_t segment_offset = offset;
+      offset += count;
+      count = segment_offset;
+    }
+  }
+  offsets_[bucket_num_] = offset;
+
+  auto scatter_task = [this, keys, key_num, min_bits, max_bits, positions](size_t start, size_t end) {
+    for (size_t segment = start; segment < end; ++segment) {
+      size_t *next = counts_ + segment * kMaxBucketNum;
+      size_t key_end = std::min(key_num, (segment + 1) * segment_size_);
+      for (size_t i = segment * segment_size_; i < key_end; ++i) {
+        uint64_t bits = OrderedBits(keys[i]);
+        if (bits >= min_bits && bits <= max_bits) {
+          positions[next[(bits - min_bits) >> shift_]++] = static_cast<I>(i);
+        }
+      }
+    }
+  };
+  ParallelLaunch(scatter_task, segment_num_, 1);
+}
+
+template <typename K, typename I>
+void BucketPartition::SortBucket(size_t bucket, const K *keys, I *positions, I *buffer) const {
+  size_t begin = offsets_[bucket];
+  size_t size = offsets_[bucket + 1] - begin;
+  I *src = positions + begin;
+  I *dst = buffer + begin;
+  uint64_t low_mask = shift_ == 0 ? 0 : (UINT64_MAX >> (64 - shift_));
+  auto low_bits = [this, keys, low_mask](I pos) { return (OrderedBits(keys[pos]) - min_bits_) & low_mask; };
+  if (size < kRadixSortMinSize) {
+    std::sort(src, src + size, [&low_bits](I left, I right) {
+      uint64_t left_bits = low_bits(left);
+      uint64_t right_bits = low_bits(right);
+      return left_bits == right_bits ? left < right : left_bits < right_bits;
+    });
+    return;
+  }
+  size_t digit_num = (shift_ + kRadixBits - 1) / kRadixBits;
+  size_t counts[kMaxDigitNum][kRadixSize] = {};
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t bits = low_bits(src[i]);
+    for (size_t digit = 0; digit < digit_num; ++digit) {
+      ++counts[digit][(bits >> (digit * kRadixBits)) & (kRadixSize - 1)];
+    }
+  }
+  uint64_t first_bits = low_bits(src[0]);
+  for (size_t digit = 0; digit < digit_num; ++digit) {
+    size_t digit_shift = digit * kRadixBits;
+    size_t *digit_counts = counts[digit];
+    // All the keys share the digit, the pass keeps the order.
+    if (digit_counts[(first_bits >> digit_shift) & (kRadixSize - 1)] == size) {
+      continue;
+    }
+    size_t offset = 0;
+    for (size_t value = 0; value < kRadixSize; ++value) {
+      size_t count = digit_counts[value];
+      digit_counts[value] = offset;
+      offset += count;
+    }
+    for (size_t i = 0; i < size; ++i) {
+      dst[digit_counts[(low_bits(src[i]) >> digit_shift) & (kRadixSize - 1)]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != positions + begin) {
+    (void)std::copy(src, src + size, positions + begin);
+  }
+}
+
+template <typename K, typename I>
+size_t UniqueByBucket(const K *keys, size_t key_num, bool sorted, K *output, I *inverse, I *workspace) {
+  if (key_num == 0) {
+    return 0;
+  }
+  I *positions = workspace;
+  I *ranks = workspace + key_num;
+  BucketPartition partition;
+  partition.Partition(keys, key_num, positions);
+  size_t bucket_num = partition.bucket_num();
+  size_t bucket_offsets[BucketPartition::kMaxBucketNum];
+  SortBuckets(partition, keys, positions, ranks, bucket_offsets);
+  size_t unique_num = ExclusivePrefixSum(bucket_offsets, bucket_num);
+  if (!sorted) {
+    // Flag the first appearance of every key, then rank the flags in the order of the keys.
+    auto flag_task = [&partition, keys, positions, ranks](size_t start, size_t end) {
+      for (size_t bucket = start; bucket < end; ++bucket) {
+        I *begin = positions + partition.bucket_begin(bucket);
+        I *bucket_end = positions + partition.bucket_end(bucket);
+        for (I *pos = begin; pos < bucket_end; ++pos) {
+          ranks[*pos] = (pos == begin || !(keys[*(pos - 1)] == keys[*pos])) ? 1 : 0;
+        }
+      }
+    };
+    ParallelLaunch(flag_task, bucket_num, 1);
+    (void)RankFirstAppearances(ranks, key_num);
+  }
+  auto write_task = [&partition, &bucket_offsets, keys, positions, ranks, sorted, output, inverse](size_t start,
+                                                                                                  size_t end) {
+    for (size_t bucket = start; bucket < end; ++bucket) {
+      I *begin = positions + partition.bucket_begin(bucket);
+      I *bucket_end = positions + partition.bucket_end(bucket);
+      size_t rank = bucket_offsets[bucket];
+      for (I *pos = begin; pos < bucket_end; ++pos) {
+        if (pos == begin || !(keys[*(pos - 1)] == keys[*pos])) {
+          // The first position of a key is its first appearance.
+          rank = sorted ? (pos == begin ? rank : rank + 1) : static_cast<size_t>(ranks[*pos]);
+          output[rank] = keys[*pos];
+        }
+        inverse[*pos] = static_cast<I>(rank);
+      }
+    }
+  };
+  ParallelLaunch(write_task, bucket_num, 1);
+  return unique_num;
+}
+
+template <typename T>
+size_t ReduceSparseByBucket(const T *indices, const float *values, size_t index_num, size_t stride, size_t max_index,
+                            T *output_indices, float *output_values, T *workspace) {
+  BucketPartition partition;
+  partition.Partition(indices, index_num, max_index, workspace);
+  size_t bucket_num = partition.bucket_num();
+  size_t bucket_offsets[BucketPartition::kMaxBucketNum];
+  // The output indices are free until the sorted buckets are written.
+  SortBuckets(partition, indices, workspace, output_indices, bucket_offsets);
+  size_t unique_num = ExclusivePrefixSum(bucket_offsets, bucket_num);
+  auto task = [&partition, &bucket_offsets, indices, values, stride, output_indices, output_values, workspace](
+                size_t start, size_t end) {
+    for (size_t bucket = start; bucket < end; ++bucket) {
+      T *begin = workspace + partition.bucket_begin(bucket);
+      T *bucket_end = workspace + partition.bucket_end(bucket);
+      size_t rank = bucket_offsets[bucket];
+      float *out = output_values + rank * stride;
+      for (T *pos = begin; pos < bucket_end; ++pos) {
+        const float *in = values + static_cast<size_t>(*pos) * stride;
+        if (pos == begin || indices[*(pos - 1)] != indices[*pos]) {
+          rank = pos == begin ? rank : rank + 1;
+          output_indices[rank] = indices[*pos];
+          out = output_values + rank * stride;
+          (void)std::copy(in, in + stride, out);
+          continue;
+        }
+        for (size_t j = 0; j < stride; ++j) {
+          out[j] += in[j];
+        }
+      }
+    }
+  };
+  ParallelLaunch(task, bucket_num, 1);
+  return unique_num;
+}
+
+template <typename V, typename S>
+void SegmentSumByBucket(const V *input, const S *segment_ids, size_t id_num, size_t stride, size_t segment_num,
+                        V *output, S *workspace) {
+  BucketPartition partition;
+  partition.Partition(segment_ids, id_num, segment_num, workspace);
+  if (partition.size() == 0 || stride == 0) {
+    return;
+  }
+  if (partition.bucket_num() > 1) {
+    // Every bucket owns a range of the output rows.
+    auto task = [&partition, input, segment_ids, stride, output, workspace](size_t start, size_t end) {
+      for (size_t bucket = start; bucket < end; ++bucket) {
+        for (size_t i = partition.bucket_begin(bucket); i < partition.bucket_end(bucket); ++i) {
+          auto pos = static_cast<size_t>(workspace[i]);
+          const V *in = input + pos * stride;
+          V *out = output + static_cast<size_t>(segment_ids[pos]) * stride;
+          for (size_t j = 0; j < stride; ++j) {
+            out[j] += in[j];
+          }
+        }
+      }
+    };
+    ParallelLaunch(task, partition.bucket_num(), 1);
+    return;
+  }
+  // Few ids, the rows are split by columns instead.
+  auto task = [&partition, input, segment_ids, stride, output, workspace](size_t start, size_t end) {
+    for (size_t i = 0; i < partition.size(); ++i) {
+      auto pos = static_cast<size_t>(workspace[i]);
+      const V *in = input + pos * stride;
+      V *out = output + static_cast<size_t>(segment_ids[pos]) * stride;
+      for (size_t j = start; j < end; ++j) {
+        out[j] += in[j];
+      }
+    }
+  };
+  float block_size = std::max(1.0f, static_cast<float>(kColumnParallelSize) / std::max<size_t>(1, partition.size()));
+  ParallelLaunch(task, stride, block_size);
+}
+
+template size_t UniqueByBucket<int32_t, int32_t>(const int32_t *keys, size_t key_num, bool sorted, int32_t *output,
+                                                 int32_t *inverse, int32_t *workspace);
+template size_t UniqueByBucket<int64_t, int64_t>(const int64_t *keys, size_t key_num, bool sorted, int64_t *output,
+                                                 int64_t *inverse, int64_t *workspace);
+template size_t UniqueByBucket<float, int32_t>(const float *keys, size_t key_num, bool sorted, float *output,
+                                               int32_t *inverse, int32_t *workspace);
+template size_t ReduceSparseByBucket<int32_t>(const int32_t *indices, const float *values, size_t index_num,
+                                              size_t stride, size_t max_index, int32_t *output_indices,
+                                              float *output_values, int32_t *workspace);
+template size_t ReduceSparseByBucket<int64_t>(const int64_t *indices, const float *values, size_t index_num,
+                                              size_t stride, size_t max_index, int64_t *output_indices,
+                                              float *output_values, int64_t *workspace);
+template void SegmentSumByBucket<int32_t, int32_t>(const int32_t *input, const int32_t *segment_ids, size_t id_num,
+                                                   size_t stride, size_t segment_num, int32_t *output,
+                                                   int32_t *workspace);
+template void SegmentSumByBucket<float, int32_t>(const float *input, const int32_t *segment_ids, size_t id_num,
+                                                 size_t stride, size_t segment_num, float *output, int32_t *workspace);
+template void SegmentSumByBucket<int32_t, int64_t>(const int32_t *input, const int64_t *segment_ids, size_t id_num,
+                                                   size_t stride, size_t segment_num, int32_t *output,
+                                                   int64_t *workspace);
+template void SegmentSumByBucket<float, int64_t>(const float *input, const int64_t *segment_ids, size_t id_num,
+                                                 size_t stride, size_t segment_num, float *output, int64_t *workspace);
+}  // namespace kernel
+}  // namespace mindspore
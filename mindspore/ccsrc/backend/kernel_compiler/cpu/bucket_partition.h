@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BUCKET_PARTITION_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BUCKET_PARTITION_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+namespace kernel {
+// Parallel radix partition of keys: the positions of the keys are grouped into buckets of ascending key ranges,
+// taken from the high bits of an order preserving image of the keys. Each segment of the keys counts its keys per
+// bucket, then scatters their positions to its own slice of every bucket, so the positions in a bucket keep their
+// order and no two threads write the same place. The buckets are then independent units of work whose results,
+// concatenated, are in key order. Nothing is allocated, the counts live in the object and the positions in buffers
+// of the caller.
+class BucketPartition {
+ public:
+  static constexpr size_t kMaxSegmentNum = 32;
+  static constexpr size_t kMaxBucketNum = 128;
+
+  BucketPartition() = default;
+  ~BucketPartition() = default;
+
+  // Partition over the range of the keys themselves.
+  template <typename K, typename I>
+  void Partition(const K *keys, size_t key_num, I *positions);
+  // Partition over [0, bound), the keys out of the range are dropped.
+  template <typename K, typename I>
+  void Partition(const K *keys, size_t key_num, size_t bound, I *positions);
+
+  // Order the positions of a bucket by their keys, a stable radix sort on the key bits below the bucket ones. The
+  // buffer is scratch space as large as the positions.
+  template <typename K, typename I>
+  void SortBucket(size_t bucket, const K *keys, I *positions, I *buffer) const;
+
+  size_t bucket_num() const { return bucket_num_; }
+  size_t bucket_begin(size_t bucket) const { return offsets_[bucket]; }
+  size_t bucket_end(size_t bucket) const { return offsets_[bucket + 1]; }
+  // Number of positions kept.
+  size_t size() const { return offsets_[bucket_num_]; }
+
+ private:
+  template <typename K, typename I>
+  void PartitionRange(const K *keys, size_t key_num, uint64_t min_bits, uint64_t max_bits, I *positions);
+
+  size_t segment_num_{1};
+  size_t segment_size_{0};
+  size_t bucket_num_{1};
+  size_t shift_{0};
+  uint64_t min_bits_{0};
+  // Counts of the keys per (segment, bucket), then the next position each segment writes in each bucket.
+  size_t counts_[kMaxSegmentNum * kMaxBucketNum]{};
+  size_t offsets_[kMaxBucketNum + 1]{};
+};
+
+// Unique values of keys and the index of each key in them. The values are in ascending order when sorted, otherwise
+// in the order of their first appearance. The workspace takes 2 * key_num indices. Return the number of values.
+template <typename K, typename I>
+size_t UniqueByBucket(const K *keys, size_t key_num, bool sorted, K *output, I *inverse, I *workspace);
+
+// Sum of the rows of values sharing an index, for the indices in [0, max_index). The output indices are ascending.
+// The workspace takes index_num indices. Return the number of output indices.
+template <typename T>
+size_t ReduceSparseByBucket(const T *indices, const float *values, size_t index_num, size_t stride, size_t max_index,
+                            T *output_indices, float *output_values, T *workspace);
+
+// Add each row of input to the output row of its segment id, the ids out of [0, segment_num) are skipped. The output
+// is expected to be zeros. The workspace takes id_num ids.
+template <typename V, typename S>
+void SegmentSumByBucket(const V *input, const S *segment_ids, size_t id_num, size_t stride, size_t segment_num,
+                        V *output, S *workspace);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BUCKET_PARTITION_H_
@@ -164,7 +164,15 @@ void ParallelLaunch(const CTask &task, size_t count, float block_size, Content c
     MS_LOG(EXCEPTION) << "Actor inner pool has been init, but kernel thread is 0!";
   }
 
-  size_t thread_num = count < block_size * kernel_thread_num ? std::ceil(count / block_size) : kernel_thread_num;
+  // Kernels running at the same time share the kernel threads instead of each fanning out to all of them.
+  struct IntraOpThreads {
+    explicit IntraOpThreads(ActorThreadPool *pool) : pool_(pool), num_(pool->AcquireIntraOpThreads()) {}
+    ~IntraOpThreads() { pool_->ReleaseIntraOpThreads(); }
+    ActorThreadPool *pool_;
+    size_t num_;
+  } intra_op_threads(thread_pool);
+  size_t max_thread_num = intra_op_threads.num_;
+  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
   size_t once_compute_size = (count + thread_num - 1) / thread_num;
   size_t task_num = count / once_compute_size;
   if (count % once_compute_size != 0) {
@@ -298,6 +306,57 @@ void BroadcastIterator::InitStrides() {
                  [](const auto &a, const auto &b) { return b == 1 ? 0 : a; });
 }
 
+BroadcastRowIterator::BroadcastRowIterator(const std::vector<size_t> &input_shape_a,
+                                           const std::vector<size_t> &input_shape_b,
+                                           const std::vector<size_t> &output_shape) {
+  if (input_shape_a.size() > output_shape.size() || input_shape_b.size() > output_shape.size()) {
+    MS_LOG(EXCEPTION) << "The input ranks " << input_shape_a.size() << " and " << input_shape_b.size()
+                      << " should not be larger than the output rank " << output_shape.size();
+  }
+  // Merged axes from the innermost one: size, how it broadcasts and the strides of the inputs.
+  std::vector<size_t> sizes;
+  std::vector<RowType> types;
+  std::vector<size_t> strides_a;
+  std::vector<size_t> strides_b;
+  size_t stride_a = 1;
+  size_t stride_b = 1;
+  size_t offset_a = output_shape.size() - input_shape_a.size();
+  size_t offset_b = output_shape.size() - input_shape_b.size();
+  for (size_t i = output_shape.size(); i > 0; --i) {
+    size_t dim = output_shape[i - 1];
+    size_t dim_a = i - 1 >= offset_a ? input_shape_a[i - 1 - offset_a] : 1;
+    size_t dim_b = i - 1 >= offset_b ? input_shape_b[i - 1 - offset_b] : 1;
+    if ((dim_a != dim && dim_a != 1) || (dim_b != dim && dim_b != 1)) {
+      MS_LOG(EXCEPTION) << "Input shapes can not broadcast to the output at axis " << (i - 1) << ": " << dim_a
+                        << ", " << dim_b << " to " << dim;
+    }
+    if (dim == 1) {
+      continue;
+    }
+    RowType type = dim_a == 1 ? kRowScalarA : (dim_b == 1 ? kRowScalarB : kRowElementwise);
+    if (!types.empty() && types.back() == type) {
+      sizes.back() *= dim;
+    } else {
+      sizes.emplace_back(dim);
+      types.emplace_back(type);
+      strides_a.emplace_back(type == kRowScalarA ? 0 : stride_a);
+      strides_b.emplace_back(type == kRowScalarB ? 0 : stride_b);
+    }
+    stride_a *= dim_a;
+    stride_b *= dim_b;
+  }
+  if (sizes.empty()) {
+    return;
+  }
+  row_size_ = sizes[0];
+  row_type_ = types[0];
+  for (size_t i = sizes.size(); i > 1; --i) {
+    outer_shape_.emplace_back(sizes[i - 1]);
+    outer_strides_a_.emplace_back(strides_a[i - 1]);
+    outer_strides_b_.emplace_back(strides_b[i - 1]);
+  }
+}
+
 TransposeIterator::TransposeIterator(std::vector<size_t> output_shape, std::vector<size_t> axes,
                                      const std::vector<size_t> &input_shape)
     : shape_(std::move(output_shape)), axes_(std::move(axes)) {
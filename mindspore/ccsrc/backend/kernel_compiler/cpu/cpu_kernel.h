@@ -15,6 +15,7 @@
  */
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -197,6 +198,91 @@ class BroadcastIterator {
   int output_dimension_{0};
 };
 
+// Broadcast of two inputs to the output shape, classified once at init. The output axes of size 1 are dropped and
+// adjacent axes that broadcast the same way are merged. The innermost merged axis forms the rows, each row is
+// contiguous in the output and either contiguous or one repeated element in each input, so an element op runs over a
+// row as one plain loop and the positions are only computed once per row.
+class BroadcastRowIterator {
+ public:
+  enum RowType { kRowElementwise, kRowScalarA, kRowScalarB };
+
+  BroadcastRowIterator() = default;
+  BroadcastRowIterator(const std::vector<size_t> &input_shape_a, const std::vector<size_t> &input_shape_b,
+                       const std::vector<size_t> &output_shape);
+  virtual ~BroadcastRowIterator() = default;
+  RowType row_type() const { return row_type_; }
+
+  // Call row_func(pos_a, pos_b, pos_out, size) for the pieces of rows that cover the output positions [start, end).
+  template <typename RowFunc>
+  void ForEachRow(size_t start, size_t end, const RowFunc &row_func) const {
+    if (start >= end) {
+      return;
+    }
+    size_t dimension = outer_shape_.size();
+    std::vector<size_t> coordinates(dimension);
+    size_t row = start / row_size_;
+    size_t col = start % row_size_;
+    size_t pos_a = 0;
+    size_t pos_b = 0;
+    for (size_t i = dimension; i > 0; --i) {
+      coordinates[i - 1] = row % outer_shape_[i - 1];
+      row /= outer_shape_[i - 1];
+      pos_a += coordinates[i - 1] * outer_strides_a_[i - 1];
+      pos_b += coordinates[i - 1] * outer_strides_b_[i - 1];
+    }
+    size_t col_step_a = row_type_ == kRowScalarA ? 0 : 1;
+    size_t col_step_b = row_type_ == kRowScalarB ? 0 : 1;
+    size_t pos = start;
+    while (true) {
+      size_t size = std::min(row_size_ - col, end - pos);
+      row_func(pos_a + col * col_step_a, pos_b + col * col_step_b, pos, size);
+      pos += size;
+      if (pos >= end) {
+        return;
+      }
+      col = 0;
+      for (size_t i = dimension; i > 0; --i) {
+        pos_a += outer_strides_a_[i - 1];
+        pos_b += outer_strides_b_[i - 1];
+        if (++coordinates[i - 1] < outer_shape_[i - 1]) {
+          break;
+        }
+        coordinates[i - 1] = 0;
+        pos_a -= outer_shape_[i - 1] * outer_strides_a_[i - 1];
+        pos_b -= outer_shape_[i - 1] * outer_strides_b_[i - 1];
+      }
+    }
+  }
+
+ private:
+  RowType row_type_{kRowElementwise};
+  size_t row_size_{1};
+  std::vector<size_t> outer_shape_;
+  std::vector<size_t> outer_strides_a_;
+  std::vector<size_t> outer_strides_b_;
+};
+
+// Element op over a row of BroadcastRowIterator, with one loop per row type that the compiler can vectorize.
+template <typename T, typename S, typename Op>
+void BroadcastRowCompute(const T *input_a, const T *input_b, S *output, size_t size,
+                         BroadcastRowIterator::RowType row_type, const Op &op) {
+  if (row_type == BroadcastRowIterator::kRowScalarA) {
+    const T a = input_a[0];
+    for (size_t i = 0; i < size; ++i) {
+      output[i] = op(a, input_b[i]);
+    }
+  } else if (row_type == BroadcastRowIterator::kRowScalarB) {
+    const T b = input_b[0];
+    for (size_t i = 0; i < size; ++i) {
+      output[i] = op(input_a[i], b);
+    }
+  } else {
+    for (size_t i = 0; i < size; ++i) {
+      output[i] = op(input_a[i], input_b[i]);
+    }
+  }
+}
+
 class TransposeIterator {
  public:
   TransposeIterator(std::vector<size_t> output_shape, std::vector<size_t> axes, const std::vector<size_t> &input_shape);
@@ -22,6 +22,7 @@
 
 #include "runtime/device/kernel_info.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
+#include "backend/kernel_compiler/cpu/graph_kernel_cpu_kernel.h"
 
 namespace mindspore {
 namespace kernel {
@@ -40,6 +41,10 @@ void CPUKernelFactory::Register(const std::string &kernel_name, const KernelAttr
 }
 
 std::shared_ptr<CPUKernel> CPUKernelFactory::Create(const std::string &kernel_name, const CNodePtr &apply_kernel) {
+  // Fused nodes are named after their sub graph, they all run on the graph kernel interpreter.
+  if (AnfAlgo::IsGraphKernel(apply_kernel)) {
+    return std::make_shared<GraphKernelCPUKernel>();
+  }
   auto kernel_info = dynamic_cast<device::KernelInfo *>(apply_kernel->kernel_info());
   MS_EXCEPTION_IF_NULL(kernel_info);
   const KernelBuildInfo *kernel_build_Info = kernel_info->select_kernel_build_info();
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/dynamic_quantize.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr float kInt8Max = 127.f;
+
+int8_t QuantizeValue(float value, float scale) {
+  float quantized = std::round(value * scale);
+  return static_cast<int8_t>(std::max(-kInt8Max, std::min(kInt8Max, quantized)));
+}
+}  // namespace
+
+float QuantizeTensor(const float *src, size_t size, int8_t *dst) {
+  float max_abs = 0.f;
+  for (size_t i = 0; i < size; ++i) {
+    max_abs = std::max(max_abs, std::fabs(src[i]));
+  }
+  float scale = max_abs > 0.f ? kInt8Max / max_abs : 1.f;
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = QuantizeValue(src[i], scale);
+  }
+  return scale;
+}
+
+void QuantizeColumns(const float *src, size_t k, size_t n, bool trans, int8_t *dst, std::vector<float> *scales) {
+  for (size_t col = 0; col < n; ++col) {
+    size_t offset = trans ? col * k : col;
+    size_t stride = trans ? 1 : n;
+    float max_abs = 0.f;
+    for (size_t row = 0; row < k; ++row) {
+      max_abs = std::max(max_abs, std::fabs(src[offset + row * stride]));
+    }
+    float scale = max_abs > 0.f ? kInt8Max / max_abs : 1.f;
+    for (size_t row = 0; row < k; ++row) {
+      dst[offset + row * stride] = QuantizeValue(src[offset + row * stride], scale);
+    }
+    (*scales)[col] = scale;
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_DYNAMIC_QUANTIZE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_DYNAMIC_QUANTIZE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+// Symmetric per tensor quantization, returns the scale from float32 to int8.
+float QuantizeTensor(const float *src, size_t size, int8_t *dst);
+
+// Symmetric quantization of each column of a k x n matrix, stored transposed when trans is set. The scale of a
+// column from float32 to int8 goes to scales, which holds n values.
+void QuantizeColumns(const float *src, size_t k, size_t n, bool trans, int8_t *dst, std::vector<float> *scales);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_DYNAMIC_QUANTIZE_H_
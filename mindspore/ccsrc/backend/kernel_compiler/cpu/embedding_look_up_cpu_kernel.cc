@@ -13,40 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <thread>
 #include <string>
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "ir/primitive.h"
-#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
-namespace {
-template <typename T>
-void LookUpTableTask(const float *input_addr, const T *indices_addr, float *output_addr, size_t indices_lens,
-                     size_t outer_dim_size, T offset, size_t first_dim_size) {
-  auto type_size = sizeof(float);
-  size_t lens = outer_dim_size * type_size;
-  for (size_t i = 0; i < indices_lens; ++i) {
-    T index = indices_addr[i] - offset;
-    if (index >= 0 && index < SizeToInt(first_dim_size)) {
-      size_t pos = static_cast<size_t>(index) * outer_dim_size;
-      auto ret = memcpy_s(output_addr, (indices_lens - i) * lens, input_addr + pos, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memcpy failed.";
-      }
-    } else {
-      auto ret = memset_s(output_addr, (indices_lens - i) * lens, 0, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
-      }
-    }
-    output_addr += outer_dim_size;
-  }
-}
-}  // namespace
-
 void EmbeddingLookUpCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   CheckParam(kernel_node);
   node_wpt_ = kernel_node;
@@ -97,31 +70,10 @@ void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
   auto indices_addr = reinterpret_cast<T *>(inputs[1]->addr);
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  size_t thread_num = indices_lens_ / 10000 + 1;
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  thread_num = thread_num > max_thread_num ? max_thread_num : thread_num;
-  std::vector<common::Task> tasks;
-  size_t task_proc_lens = (indices_lens_ + thread_num - 1) / thread_num;
-  size_t i;
-  size_t task_offset = 0;
-  MS_LOG(DEBUG) << "indices_lens_: " << indices_lens_ << " one task proc lens:" << task_proc_lens;
-  for (i = 0; i < thread_num; i++) {
-    if (task_offset >= indices_lens_) {
-      break;
-    }
-    MS_LOG(DEBUG) << "task_offset: " << task_offset << " task_proc_lenss:" << task_proc_lens;
-    auto task = [input_addr, indices_addr, output_addr, task_offset, task_proc_lens, this]() {
-      LookUpTableTask<T>(input_addr, indices_addr + task_offset, output_addr + task_offset * outer_dim_size_,
-                         task_proc_lens, outer_dim_size_, static_cast<T>(offset_), first_dim_size_);
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(task);
-    task_offset += task_proc_lens;
-    if (task_offset + task_proc_lens > indices_lens_) {
-      task_proc_lens = indices_lens_ - task_offset;
-    }
+  engine_.Init(1, first_dim_size_, outer_dim_size_ * sizeof(float), true);
+  if (!engine_.Lookup(input_addr, indices_addr, indices_lens_, static_cast<T>(offset_), output_addr)) {
+    MS_LOG(EXCEPTION) << "EmbeddingLookup failed to copy the rows.";
   }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
 }
 
 bool EmbeddingLookUpCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -19,6 +19,7 @@
 #include <memory>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/lookup_engine.h"
 
 namespace mindspore {
 namespace kernel {
@@ -42,6 +43,7 @@ class EmbeddingLookUpCPUKernel : public CPUKernel {
   size_t outer_dim_size_{1};
   TypeId indices_data_type_{kNumberTypeInt32};
   CNodeWeakPtr node_wpt_;
+  LookupEngine engine_;
 };
 
 MS_REG_CPU_KERNEL(
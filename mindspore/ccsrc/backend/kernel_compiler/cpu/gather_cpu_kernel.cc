@@ -15,9 +15,6 @@
  */
 #include "backend/kernel_compiler/cpu/gather_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
-#include "nnacl/gather_parameter.h"
-#include "nnacl/base/gather_base.h"
-#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -34,56 +31,32 @@ void GatherV2CPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   axis_ += 4 - input_shape_.size();
   CPUKernelUtils::ExpandDimsTo4(&input_shape_);
   CPUKernelUtils::ExpandDimsTo4(&output_shape_);
-}
-
-template <typename T>
-void GatherV2CPUKernel<T>::ParallelRun(int8_t *input_addr, int8_t *output_addr, int thread_num) {
-  int outer_size = 1, inner_size = 1;
+  size_t outer_size = 1;
   for (int64_t i = 0; i < axis_; ++i) {
-    outer_size *= input_shape_.at(i);
+    outer_size *= input_shape_[i];
   }
-  for (size_t i = axis_ + 1; i < input_shape_.size(); ++i) {
-    inner_size *= input_shape_.at(i);
+  size_t inner_size = 1;
+  for (size_t i = LongToSize(axis_) + 1; i < input_shape_.size(); ++i) {
+    inner_size *= input_shape_[i];
   }
-  int indices_element_size = 1;
-  for (size_t i = 0; i < indices_shape_.size(); i++) {
-    indices_element_size *= indices_shape_.at(i);
-  }
-  const int limit = input_shape_.at(axis_);
-  int stride = UP_DIV(outer_size, thread_num);
-  std::vector<common::Task> tasks;
-  int thread_index = 0;
-  while (thread_index < thread_num) {
-    int count = MSMIN(stride, outer_size - stride * thread_index);
-    if (count <= 0) break;
-    auto thread_stride = stride * thread_index;
-    int8_t *in = input_addr + thread_stride * limit * inner_size * sizeof(T);
-    int8_t *out = output_addr + thread_stride * indices_element_size * inner_size * sizeof(T);
-    auto block = [&, in, count, out]() {
-      int ret = Gather(in, count, inner_size, limit, indices_data_, indices_element_size, out, sizeof(T));
-      if (ret != 0) {
-        MS_LOG(ERROR) << "GatherRun error task_id[" << thread_index << "] error_code[" << ret << "]";
-        return common::FAIL;
-      }
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(block);
-    thread_index++;
-  }
-  if (!common::ThreadPool::GetInstance().SyncRun(tasks)) {
-    MS_LOG(EXCEPTION) << "SyncRun error!";
+  indices_element_size_ = 1;
+  for (size_t i = 0; i < indices_shape_.size(); ++i) {
+    indices_element_size_ *= indices_shape_[i];
   }
+  engine_.Init(outer_size, input_shape_[axis_], inner_size * sizeof(T), false);
 }
 
 template <typename T>
 bool GatherV2CPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                   const std::vector<kernel::AddressPtr> &,
                                   const std::vector<kernel::AddressPtr> &outputs) {
-  int8_t *input_tensor = reinterpret_cast<int8_t *>(inputs[0]->addr);
-  indices_data_ = reinterpret_cast<int32_t *>(inputs[1]->addr);
-  int8_t *output_addr = reinterpret_cast<int8_t *>(outputs[0]->addr);
-  int max_thread_num = static_cast<int>(common::ThreadPool::GetInstance().GetSyncRunThreadNum());
-  ParallelRun(input_tensor, output_addr, max_thread_num);
+  auto input_tensor = reinterpret_cast<int8_t *>(inputs[0]->addr);
+  auto indices_data = reinterpret_cast<int32_t *>(inputs[1]->addr);
+  auto output_addr = reinterpret_cast<int8_t *>(outputs[0]->addr);
+  if (!engine_.Lookup(input_tensor, indices_data, indices_element_size_, 0, output_addr)) {
+    MS_LOG(EXCEPTION) << "Gather got an index out of [" << -SizeToLong(input_shape_[axis_]) << ", "
+                      << input_shape_[axis_] << ").";
+  }
   return true;
 }
 
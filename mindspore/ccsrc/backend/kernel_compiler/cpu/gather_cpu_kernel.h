@@ -19,7 +19,7 @@
 #include <memory>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
-#include "backend/kernel_compiler/cpu/nnacl/base/gather_base.h"
+#include "backend/kernel_compiler/cpu/lookup_engine.h"
 
 namespace mindspore {
 namespace kernel {
@@ -36,12 +36,12 @@ class GatherV2CPUKernel : public CPUKernel {
 
  private:
   void CheckParam(const CNodePtr &kernel_node);
-  void ParallelRun(int8_t *input_addr, int8_t *output_addr, int thread_num);
   std::vector<size_t> input_shape_;
   std::vector<size_t> indices_shape_;
   std::vector<size_t> output_shape_;
-  int *indices_data_ = nullptr;
+  size_t indices_element_size_{1};
   int64_t axis_{0};
+  LookupEngine engine_;
 };
 
 MS_REG_CPU_KERNEL_T(Gather, KernelAttr(), GatherV2CPUKernel, uint8_t);
@@ -0,0 +1,928 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/graph_kernel_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include "base/core_ops.h"
+#include "base/float16.h"
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "utils/overload.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/arithmetic_fp32.h"
+#include "nnacl/fp32/arithmetic_self_fp32.h"
+#include "nnacl/fp32/div_fp32.h"
+#include "nnacl/fp32/exp_fp32.h"
+#include "nnacl/fp32/mul_fp32.h"
+#include "nnacl/fp32/sub_fp32.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Elements computed per instruction before moving to the next one, small enough to keep a tile of every
+// live intermediate in L1/L2.
+constexpr size_t kTileSize = 1024;
+// Smallest part of the iteration space worth handing to another thread.
+constexpr size_t kMinChunkSize = 8192;
+constexpr size_t kCombineBlockSize = 4096;
+// One scratch tile per operand for type conversion, broadcast gathering and constants.
+constexpr size_t kTempSlotNum = 2;
+
+size_t SizeOf(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+bool IsSupportedType(TypeId type) {
+  return type == kNumberTypeFloat32 || type == kNumberTypeFloat16 || type == kNumberTypeBool;
+}
+
+std::vector<size_t> BroadcastStrides(const std::vector<size_t> &in_shape, const std::vector<size_t> &out_shape) {
+  std::vector<size_t> strides(out_shape.size(), 0);
+  if (SizeOf(in_shape) == 1) {
+    return strides;
+  }
+  if (in_shape.size() > out_shape.size()) {
+    MS_LOG(EXCEPTION) << "Can not broadcast shape " << in_shape << " to " << out_shape;
+  }
+  size_t offset = out_shape.size() - in_shape.size();
+  size_t stride = 1;
+  for (size_t i = in_shape.size(); i-- > 0;) {
+    if (in_shape[i] == out_shape[i + offset]) {
+      strides[i + offset] = stride;
+    } else if (in_shape[i] != 1) {
+      MS_LOG(EXCEPTION) << "Can not broadcast shape " << in_shape << " to " << out_shape;
+    }
+    stride *= in_shape[i];
+  }
+  return strides;
+}
+
+// Walks the positions [start, start + len) of a row-major shape and calls func(pos, offset, run, stride) for
+// every piece of the innermost dim, where offset is the strided offset of the first element of the piece.
+template <typename F>
+void ForEachRun(const std::vector<size_t> &shape, const std::vector<size_t> &strides, size_t start, size_t len,
+                const F &func) {
+  if (shape.empty()) {
+    func(0, 0, len, 0);
+    return;
+  }
+  size_t rank = shape.size();
+  std::vector<size_t> coord(rank, 0);
+  size_t offset = 0;
+  size_t pos = start;
+  for (size_t d = rank; d-- > 0;) {
+    coord[d] = pos % shape[d];
+    pos /= shape[d];
+    offset += coord[d] * strides[d];
+  }
+  size_t inner = shape[rank - 1];
+  size_t inner_stride = strides[rank - 1];
+  size_t i = 0;
+  while (i < len) {
+    size_t run = std::min(len - i, inner - coord[rank - 1]);
+    func(i, offset, run, inner_stride);
+    i += run;
+    offset = offset + run * inner_stride - inner * inner_stride;
+    coord[rank - 1] = 0;
+    for (size_t d = rank - 1; d-- > 0;) {
+      ++coord[d];
+      offset += strides[d];
+      if (coord[d] < shape[d]) {
+        break;
+      }
+      offset -= coord[d] * strides[d];
+      coord[d] = 0;
+    }
+  }
+}
+
+template <typename T>
+void GatherToFloat(const T *src, const std::vector<size_t> &shape, const std::vector<size_t> &strides, size_t start,
+                   size_t len, float *dst) {
+  ForEachRun(shape, strides, start, len, [src, dst](size_t pos, size_t offset, size_t run, size_t stride) {
+    if (stride == 0) {
+      std::fill(dst + pos, dst + pos + run, static_cast<float>(src[offset]));
+      return;
+    }
+    for (size_t j = 0; j < run; ++j) {
+      dst[pos + j] = static_cast<float>(src[offset + j * stride]);
+    }
+  });
+}
+
+template <typename T>
+void ConvertToFloat(const T *src, size_t len, float *dst) {
+  for (size_t i = 0; i < len; ++i) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <typename T>
+void ConvertFromFloat(const float *src, size_t len, T *dst) {
+  for (size_t i = 0; i < len; ++i) {
+    dst[i] = static_cast<T>(src[i]);
+  }
+}
+
+float ScalarValue(const ValuePtr &value) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (value->isa<tensor::Tensor>()) {
+    auto tensor = value->cast<tensor::TensorPtr>();
+    if (tensor->DataSize() != 1) {
+      MS_LOG(EXCEPTION) << "Only scalar constants can be folded into a graph kernel, but got " << tensor->ToString();
+    }
+    auto data = tensor->data_c();
+    switch (tensor->data_type()) {
+      case kNumberTypeFloat32:
+        return *static_cast<float *>(data);
+      case kNumberTypeFloat16:
+        return static_cast<float>(*static_cast<float16 *>(data));
+      case kNumberTypeFloat64:
+        return static_cast<float>(*static_cast<double *>(data));
+      case kNumberTypeInt32:
+        return static_cast<float>(*static_cast<int32_t *>(data));
+      case kNumberTypeInt64:
+        return static_cast<float>(*static_cast<int64_t *>(data));
+      case kNumberTypeBool:
+        return *static_cast<bool *>(data) ? 1.0f : 0.0f;
+      default:
+        MS_LOG(EXCEPTION) << "Unsupported constant type " << TypeIdLabel(tensor->data_type());
+    }
+  }
+  if (value->isa<FP32Imm>()) {
+    return GetValue<float>(value);
+  }
+  if (value->isa<Int64Imm>()) {
+    return static_cast<float>(GetValue<int64_t>(value));
+  }
+  if (value->isa<BoolImm>()) {
+    return GetValue<bool>(value) ? 1.0f : 0.0f;
+  }
+  MS_LOG(EXCEPTION) << "Unsupported constant " << value->ToString();
+}
+}  // namespace
+
+float GraphKernelCPUKernel::ReduceInit(OpCode op) {
+  if (op == OpCode::kReduceMax) {
+    return -std::numeric_limits<float>::infinity();
+  }
+  if (op == OpCode::kReduceMin) {
+    return std::numeric_limits<float>::infinity();
+  }
+  return 0.0f;
+}
+
+float GraphKernelCPUKernel::ReduceCombine(OpCode op, float a, float b) {
+  if (op == OpCode::kReduceMax) {
+    return std::max(a, b);
+  }
+  if (op == OpCode::kReduceMin) {
+    return std::min(a, b);
+  }
+  return a + b;
+}
+
+float GraphKernelCPUKernel::ReduceRun(OpCode op, const float *in, size_t len) {
+  if (op == OpCode::kReduceSum) {
+    // Independent partial sums so that the loop is not bound by the latency of a single add chain.
+    float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+      sum[0] += in[i];
+      sum[1] += in[i + 1];
+      sum[2] += in[i + 2];
+      sum[3] += in[i + 3];
+    }
+    for (; i < len; ++i) {
+      sum[0] += in[i];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+  }
+  float result = ReduceInit(op);
+  for (size_t i = 0; i < len; ++i) {
+    result = ReduceCombine(op, result, in[i]);
+  }
+  return result;
+}
+
+size_t GraphKernelCPUKernel::AddValue(const AnfNodePtr &node, const CNodePtr &kernel_node) {
+  auto iter = node_value_map_.find(node);
+  if (iter != node_value_map_.end()) {
+    return iter->second;
+  }
+  if (!node->isa<ValueNode>()) {
+    MS_LOG(EXCEPTION) << "Input " << node->DebugString() << " of graph kernel " << kernel_node->fullname_with_scope()
+                      << " is not computed before it is used.";
+  }
+  Value value;
+  auto value_node = node->cast<ValueNodePtr>();
+  auto tensor = value_node->value()->cast<tensor::TensorPtr>();
+  if (tensor != nullptr) {
+    auto &shape = tensor->shape();
+    (void)std::transform(shape.begin(), shape.end(), std::back_inserter(value.shape),
+                         [](int64_t dim) { return LongToSize(dim); });
+  }
+  value.size = 1;
+  value.root = values_.size();
+  value.storage = StorageType::kConst;
+  value.index = consts_.size();
+  consts_.push_back(ScalarValue(value_node->value()));
+  values_.push_back(value);
+  node_value_map_[node] = value.root;
+  return value.root;
+}
+
+void GraphKernelCPUKernel::InitReduce(const CNodePtr &cnode, Instruction *inst) const {
+  auto &shape = inst->shape;
+  size_t rank = shape.size();
+  std::vector<bool> reduced(rank, false);
+  std::vector<int64_t> axis;
+  auto prim = AnfAlgo::GetCNodePrimitive(cnode);
+  MS_EXCEPTION_IF_NULL(prim);
+  auto axis_attr = prim->GetAttr(AXIS);
+  if (axis_attr != nullptr) {
+    if (axis_attr->isa<ValueTuple>() || axis_attr->isa<ValueList>()) {
+      axis = GetValue<std::vector<int64_t>>(axis_attr);
+    } else {
+      axis.push_back(GetValue<int64_t>(axis_attr));
+    }
+  }
+  // An empty axis list reduces all dims.
+  if (axis.empty()) {
+    std::fill(reduced.begin(), reduced.end(), true);
+  }
+  for (auto a : axis) {
+    auto dim = a < 0 ? a + SizeToLong(rank) : a;
+    if (dim < 0 || dim >= SizeToLong(rank)) {
+      MS_LOG(EXCEPTION) << "Reduce axis " << a << " is out of range for shape " << shape << " in "
+                        << cnode->fullname_with_scope();
+    }
+    reduced[LongToSize(dim)] = true;
+  }
+
+  inst->reduce_strides.assign(rank, 0);
+  size_t stride = 1;
+  size_t row = 1;
+  for (size_t i = rank; i-- > 0;) {
+    if (reduced[i]) {
+      row *= shape[i];
+      continue;
+    }
+    inst->reduce_strides[i] = stride;
+    stride *= shape[i];
+  }
+  // A reduce over trailing axes works on contiguous rows. Dims of size one do not change the memory order,
+  // so they are ignored here.
+  bool trailing = true;
+  bool seen_kept = false;
+  for (size_t i = rank; i-- > 0;) {
+    if (shape[i] == 1) {
+      continue;
+    }
+    if (!reduced[i]) {
+      seen_kept = true;
+    } else if (seen_kept) {
+      trailing = false;
+      break;
+    }
+  }
+  inst->reduce_row = trailing ? row : 0;
+}
+
+void GraphKernelCPUKernel::AddInstruction(const CNodePtr &cnode, const CNodePtr &kernel_node) {
+  static const std::unordered_map<std::string, OpCode> kOpCodeMap = {
+    {prim::kPrimAdd->name(), OpCode::kAdd},
+    {prim::kPrimSub->name(), OpCode::kSub},
+    {prim::kPrimMul->name(), OpCode::kMul},
+    {prim::kPrimRealDiv->name(), OpCode::kRealDiv},
+    {prim::kPrimMaximum->name(), OpCode::kMaximum},
+    {prim::kPrimMinimum->name(), OpCode::kMinimum},
+    {prim::kPrimPow->name(), OpCode::kPow},
+    {prim::kPrimEqual->name(), OpCode::kEqual},
+    {prim::kPrimNotEqual->name(), OpCode::kNotEqual},
+    {prim::kPrimGreater->name(), OpCode::kGreater},
+    {prim::kPrimGreaterEqual->name(), OpCode::kGreaterEqual},
+    {prim::kPrimLess->name(), OpCode::kLess},
+    {prim::kPrimLessEqual->name(), OpCode::kLessEqual},
+    {prim::kPrimAbs->name(), OpCode::kAbs},
+    {prim::kPrimNeg->name(), OpCode::kNeg},
+    {prim::kPrimExp->name(), OpCode::kExp},
+    {prim::kPrimLog->name(), OpCode::kLog},
+    {prim::kPrimSqrt->name(), OpCode::kSqrt},
+    {prim::kPrimRsqrt->name(), OpCode::kRsqrt},
+    {prim::kPrimSquare->name(), OpCode::kSquare},
+    {prim::kPrimReciprocal->name(), OpCode::kReciprocal},
+    {prim::kPrimRound->name(), OpCode::kRound},
+    {prim::kPrimTanh->name(), OpCode::kTanh},
+    {prim::kPrimSigmoid->name(), OpCode::kSigmoid},
+    {prim::kPrimRelu->name(), OpCode::kRelu},
+    {prim::kPrimCast->name(), OpCode::kCast},
+    {prim::kPrimReduceSum->name(), OpCode::kReduceSum},
+    {prim::kPrimReduceMax->name(), OpCode::kReduceMax},
+    {prim::kPrimReduceMin->name(), OpCode::kReduceMin},
+  };
+  auto op_name = AnfAlgo::GetCNodeName(cnode);
+  auto out_type = AnfAlgo::GetOutputInferDataType(cnode, 0);
+  if (!IsSupportedType(out_type)) {
+    MS_LOG(EXCEPTION) << "Unsupported output type " << TypeIdLabel(out_type) << " of " << cnode->fullname_with_scope()
+                      << " in graph kernel " << kernel_node->fullname_with_scope();
+  }
+  Value out;
+  out.shape = AnfAlgo::GetOutputInferShape(cnode, 0);
+  out.size = SizeOf(out.shape);
+
+  // Reshape does not move data, the output is a renamed view of the input.
+  if (op_name == prim::kPrimReshape->name()) {
+    auto input = AddValue(cnode->input(1), kernel_node);
+    if (values_[input].size != out.size) {
+      MS_LOG(EXCEPTION) << "Reshape " << cnode->fullname_with_scope() << " changes the element count.";
+    }
+    out.root = values_[input].root;
+    node_value_map_[cnode] = values_.size();
+    values_.push_back(out);
+    return;
+  }
+
+  auto iter = kOpCodeMap.find(op_name);
+  if (iter == kOpCodeMap.end()) {
+    MS_LOG(EXCEPTION) << "Operator " << op_name << " is not supported by graph kernel on CPU, node "
+                      << cnode->fullname_with_scope();
+  }
+  Instruction inst;
+  inst.op = iter->second;
+  size_t input_num = AnfAlgo::GetInputTensorNum(cnode);
+  size_t expect_num = (inst.op <= OpCode::kLessEqual) ? 2 : 1;
+  if (input_num < expect_num) {
+    MS_LOG(EXCEPTION) << "Operator " << cnode->fullname_with_scope() << " needs " << expect_num << " inputs, but got "
+                      << input_num;
+  }
+  for (size_t i = 1; i <= expect_num; ++i) {
+    inst.inputs.push_back(AddValue(cnode->input(i), kernel_node));
+  }
+  if (IsReduce(inst.op)) {
+    inst.shape = values_[inst.inputs[0]].shape;
+    InitReduce(cnode, &inst);
+    if (inst.reduce_row > 0 && SizeOf(inst.shape) / std::max(inst.reduce_row, size_t(1)) != out.size) {
+      MS_LOG(EXCEPTION) << "Reduce " << cnode->fullname_with_scope() << " output shape " << out.shape
+                        << " does not match its input shape " << inst.shape;
+    }
+    inst.input_strides.emplace_back();
+    out.is_reduce_output = true;
+  } else {
+    inst.shape = out.shape;
+    for (auto input : inst.inputs) {
+      const auto &in = values_[input];
+      // An input with as many elements as the output can only differ in leading ones and is read in order.
+      if (in.size == out.size) {
+        inst.input_strides.emplace_back();
+      } else {
+        inst.input_strides.push_back(BroadcastStrides(in.shape, out.shape));
+      }
+    }
+    if (inst.op == OpCode::kCast) {
+      inst.cast_dtype = out_type;
+    }
+  }
+  // Constant inputs are added to the values above, so the output index is only known here.
+  inst.output = values_.size();
+  out.root = inst.output;
+  node_value_map_[cnode] = inst.output;
+  values_.push_back(out);
+  insts_.push_back(inst);
+}
+
+void GraphKernelCPUKernel::PlanOutputs(const FuncGraphPtr &func_graph, const CNodePtr &kernel_node) {
+  AnfNodePtrList output_nodes;
+  auto output = func_graph->output();
+  if (IsPrimitiveCNode(output, prim::kPrimMakeTuple)) {
+    auto tuple = output->cast<CNodePtr>();
+    output_nodes.assign(tuple->inputs().begin() + 1, tuple->inputs().end());
+  } else {
+    output_nodes.push_back(output);
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+  if (output_nodes.size() != output_num) {
+    MS_LOG(EXCEPTION) << "Graph kernel " << kernel_node->fullname_with_scope() << " has " << output_num
+                      << " outputs, but its sub graph returns " << output_nodes.size();
+  }
+  for (size_t i = 0; i < output_num; ++i) {
+    output_dtypes_.push_back(AnfAlgo::GetOutputDeviceDataType(kernel_node, i));
+    if (!IsSupportedType(output_dtypes_.back())) {
+      MS_LOG(EXCEPTION) << "Unsupported output type " << TypeIdLabel(output_dtypes_.back()) << " of graph kernel "
+                        << kernel_node->fullname_with_scope();
+    }
+    auto value = AddValue(output_nodes[i], kernel_node);
+    auto &root = values_[values_[value].root];
+    // A float32 result is computed right into the output buffer, anything else is converted at the end.
+    if (root.storage == StorageType::kLocal && output_dtypes_[i] == kNumberTypeFloat32) {
+      root.storage = StorageType::kOutput;
+      root.index = i;
+      continue;
+    }
+    root.need_materialize = true;
+    post_copies_.push_back({value, i});
+  }
+}
+
+void GraphKernelCPUKernel::PlanStages() {
+  for (size_t idx = 0; idx < insts_.size(); ++idx) {
+    auto &inst = insts_[idx];
+    size_t space = SizeOf(inst.shape);
+    bool new_stage = stages_.empty() || stages_.back().space != space;
+    // Values read out of order must be complete before the stage starts.
+    for (size_t i = 0; i < inst.inputs.size() && !new_stage; ++i) {
+      const auto &root = values_[values_[inst.inputs[i]].root];
+      if (root.stage == stages_.size() - 1 && (root.is_reduce_output || !inst.input_strides[i].empty())) {
+        new_stage = true;
+      }
+    }
+    if (new_stage) {
+      Stage stage;
+      stage.space = space;
+      stages_.push_back(stage);
+    }
+    auto &stage = stages_.back();
+    size_t stage_idx = stages_.size() - 1;
+    stage.insts.push_back(idx);
+    for (size_t i = 0; i < inst.inputs.size(); ++i) {
+      auto &root = values_[values_[inst.inputs[i]].root];
+      if (root.stage != stage_idx || !inst.input_strides[i].empty()) {
+        root.need_materialize = true;
+      }
+    }
+    auto &out = values_[values_[inst.output].root];
+    out.stage = stage_idx;
+    if (!IsReduce(inst.op)) {
+      continue;
+    }
+    out.need_materialize = true;
+    if (inst.reduce_row > 0 && stage.align == 1) {
+      stage.align = inst.reduce_row;
+    }
+    inst.reduce_direct = inst.reduce_row > 0 && stage.align % inst.reduce_row == 0;
+    if (!inst.reduce_direct) {
+      inst.partial_offset = stage.partial_size;
+      stage.partial_size += out.size;
+    }
+  }
+}
+
+void GraphKernelCPUKernel::PlanStorage() {
+  for (size_t i = 0; i < values_.size(); ++i) {
+    auto &value = values_[i];
+    if (value.root == i && value.storage == StorageType::kLocal && value.need_materialize) {
+      value.storage = StorageType::kWorkspace;
+      value.index = workspace_elements_;
+      workspace_elements_ += value.size;
+    }
+  }
+
+  // Tile slots of values that never leave their stage are reused after the last read.
+  std::vector<size_t> last_use(values_.size(), 0);
+  for (size_t idx = 0; idx < insts_.size(); ++idx) {
+    for (auto input : insts_[idx].inputs) {
+      last_use[values_[input].root] = idx;
+    }
+  }
+  for (const auto &stage : stages_) {
+    std::vector<size_t> free_slots;
+    size_t slot_num = 0;
+    for (auto idx : stage.insts) {
+      const auto &inst = insts_[idx];
+      auto &out = values_[values_[inst.output].root];
+      if (out.storage == StorageType::kLocal) {
+        if (free_slots.empty()) {
+          out.index = slot_num++;
+        } else {
+          out.index = free_slots.back();
+          free_slots.pop_back();
+        }
+      }
+      for (size_t i = 0; i < inst.inputs.size(); ++i) {
+        auto root = values_[inst.inputs[i]].root;
+        bool repeated = std::find(inst.inputs.begin(), inst.inputs.begin() + i, inst.inputs[i]) !=
+                        inst.inputs.begin() + i;
+        if (values_[root].storage == StorageType::kLocal && last_use[root] == idx && !repeated) {
+          free_slots.push_back(values_[root].index);
+        }
+      }
+    }
+    max_slot_num_ = std::max(max_slot_num_, slot_num);
+  }
+}
+
+void GraphKernelCPUKernel::PlanChunks(size_t thread_num) {
+  size_t scratch_size = 0;
+  size_t partials_size = 0;
+  for (auto &stage : stages_) {
+    if (stage.space == 0) {
+      continue;
+    }
+    size_t chunk_num = std::max(size_t(1), std::min(thread_num, (stage.space + kMinChunkSize - 1) / kMinChunkSize));
+    size_t chunk_len = (stage.space + chunk_num - 1) / chunk_num;
+    stage.chunk_len = (chunk_len + stage.align - 1) / stage.align * stage.align;
+    stage.chunk_num = (stage.space + stage.chunk_len - 1) / stage.chunk_len;
+    scratch_size = std::max(scratch_size, stage.chunk_num * (max_slot_num_ + kTempSlotNum) * kTileSize);
+    partials_size = std::max(partials_size, stage.chunk_num * stage.partial_size);
+  }
+  scratch_.resize(scratch_size);
+  partials_.resize(partials_size);
+}
+
+void GraphKernelCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto func_graph = AnfAlgo::GetCNodeFuncGraphPtr(kernel_node);
+  MS_EXCEPTION_IF_NULL(func_graph);
+  const auto &params = func_graph->parameters();
+  if (params.size() != AnfAlgo::GetInputTensorNum(kernel_node)) {
+    MS_LOG(EXCEPTION) << "Graph kernel " << kernel_node->fullname_with_scope() << " has "
+                      << AnfAlgo::GetInputTensorNum(kernel_node) << " inputs, but its sub graph has " << params.size()
+                      << " parameters.";
+  }
+  for (size_t i = 0; i < params.size(); ++i) {
+    Value value;
+    value.shape = AnfAlgo::GetInputDeviceShape(kernel_node, i);
+    value.size = SizeOf(value.shape);
+    value.root = values_.size();
+    value.storage = StorageType::kInput;
+    value.index = i;
+    value.dtype = AnfAlgo::GetInputDeviceDataType(kernel_node, i);
+    if (!IsSupportedType(value.dtype)) {
+      MS_LOG(EXCEPTION) << "Unsupported input type " << TypeIdLabel(value.dtype) << " of graph kernel "
+                        << kernel_node->fullname_with_scope();
+    }
+    node_value_map_[params[i]] = value.root;
+    values_.push_back(value);
+  }
+  auto nodes = TopoSort(func_graph->get_return());
+  for (const auto &node : nodes) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode == nullptr || !AnfAlgo::IsRealKernel(cnode)) {
+      continue;
+    }
+    AddInstruction(cnode, kernel_node);
+  }
+  PlanOutputs(func_graph, kernel_node);
+  PlanStages();
+  PlanStorage();
+  PlanChunks(GetActorMgrInnerThreadPool()->GetKernelThreadNum());
+  MS_LOG(INFO) << "Graph kernel " << kernel_node->fullname_with_scope() << " is compiled into " << insts_.size()
+               << " instructions in " << stages_.size() << " stages, workspace " << workspace_elements_
+               << " elements, tile slots " << max_slot_num_ << ".";
+}
+
+void GraphKernelCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  if (workspace_elements_ > 0) {
+    workspace_size_list_.emplace_back(workspace_elements_ * sizeof(float));
+  }
+}
+
+float *GraphKernelCPUKernel::ValueData(const Value &value) const {
+  if (value.storage == StorageType::kOutput) {
+    return static_cast<float *>(output_addrs_[value.index]);
+  }
+  if (value.storage == StorageType::kWorkspace) {
+    return workspace_addr_ + value.index;
+  }
+  MS_LOG(EXCEPTION) << "The value is not stored in a float32 buffer.";
+}
+
+void GraphKernelCPUKernel::LoadContiguous(const Value &value, size_t start, size_t len, float *dst) const {
+  if (value.storage == StorageType::kConst) {
+    std::fill(dst, dst + len, consts_[value.index]);
+  } else if (value.storage != StorageType::kInput) {
+    auto src = ValueData(value) + start;
+    (void)std::copy(src, src + len, dst);
+  } else if (value.dtype == kNumberTypeFloat32) {
+    auto src = static_cast<const float *>(input_addrs_[value.index]) + start;
+    (void)std::copy(src, src + len, dst);
+  } else if (value.dtype == kNumberTypeFloat16) {
+    ConvertToFloat(static_cast<const float16 *>(input_addrs_[value.index]) + start, len, dst);
+  } else {
+    ConvertToFloat(static_cast<const bool *>(input_addrs_[value.index]) + start, len, dst);
+  }
+}
+
+const float *GraphKernelCPUKernel::LoadOperand(const Instruction &inst, size_t input_idx, float *scratch,
+                                               size_t start, size_t len) const {
+  const auto &root = values_[values_[inst.inputs[input_idx]].root];
+  if (root.storage == StorageType::kLocal) {
+    return scratch + root.index * kTileSize;
+  }
+  float *temp = scratch + (max_slot_num_ + input_idx) * kTileSize;
+  const auto &strides = inst.input_strides[input_idx];
+  if (strides.empty()) {
+    if (root.storage == StorageType::kOutput || root.storage == StorageType::kWorkspace) {
+      return ValueData(root) + start;
+    }
+    if (root.storage == StorageType::kInput && root.dtype == kNumberTypeFloat32) {
+      return static_cast<const float *>(input_addrs_[root.index]) + start;
+    }
+    LoadContiguous(root, start, len, temp);
+    return temp;
+  }
+  if (root.storage == StorageType::kConst) {
+    std::fill(temp, temp + len, consts_[root.index]);
+  } else if (root.storage != StorageType::kInput || root.dtype == kNumberTypeFloat32) {
+    const float *src =
+      root.storage == StorageType::kInput ? static_cast<const float *>(input_addrs_[root.index]) : ValueData(root);
+    GatherToFloat(src, inst.shape, strides, start, len, temp);
+  } else if (root.dtype == kNumberTypeFloat16) {
+    GatherToFloat(static_cast<const float16 *>(input_addrs_[root.index]), inst.shape, strides, start, len, temp);
+  } else {
+    GatherToFloat(static_cast<const bool *>(input_addrs_[root.index]), inst.shape, strides, start, len, temp);
+  }
+  return temp;
+}
+
+void GraphKernelCPUKernel::RunElementwise(const Instruction &inst, const float *in0, const float *in1, float *out,
+                                          size_t len) const {
+  int size = SizeToInt(len);
+  switch (inst.op) {
+    case OpCode::kAdd:
+      (void)ElementAdd(in0, in1, out, size);
+      break;
+    case OpCode::kSub:
+      (void)ElementSub(in0, in1, out, size);
+      break;
+    case OpCode::kMul:
+      (void)ElementMul(in0, in1, out, size);
+      break;
+    case OpCode::kRealDiv:
+      (void)ElementDiv(in0, in1, out, size);
+      break;
+    case OpCode::kMaximum:
+      (void)ElementMaximum(in0, in1, out, size);
+      break;
+    case OpCode::kMinimum:
+      (void)ElementMinimum(in0, in1, out, size);
+      break;
+    case OpCode::kPow:
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = std::pow(in0[i], in1[i]);
+      }
+      break;
+    case OpCode::kEqual:
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = in0[i] == in1[i] ? 1.0f : 0.0f;
+      }
+      break;
+    case OpCode::kNotEqual:
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = in0[i] != in1[i] ? 1.0f : 0.0f;
+      }
+      break;
+    case OpCode::kGreater:
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = in0[i] > in1[i] ? 1.0f : 0.0f;
+      }
+      break;
+    case OpCode::kGreaterEqual:
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = in0[i] >= in1[i] ? 1.0f : 0.0f;
+      }
+      break;
+    case OpCode::kLess:
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = in0[i] < in1[i] ? 1.0f : 0.0f;
+      }
+      break;
+    case OpCode::kLessEqual:
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = in0[i] <= in1[i] ? 1.0f : 0.0f;
+      }
+      break;
+    case OpCode::kAbs:
+      (void)ElementAbs(in0, out, size);
+      break;
+    case OpCode::kNeg:
+      (void)ElementNegative(in0, out, size);
+      break;
+    case OpCode::kExp:
+      ExpFp32(in0, out, size);
+      break;
+    case OpCode::kLog:
+      (void)ElementLog(in0, out, size);
+      break;
+    case OpCode::kSqrt:
+      (void)ElementSqrt(in0, out, size);
+      break;
+    case OpCode::kRsqrt:
+      (void)ElementRsqrt(in0, out, size);
+      break;
+    case OpCode::kSquare:
+      (void)ElementSquare(in0, out, size);
+      break;
+    case OpCode::kReciprocal:
+      (void)ElementReciprocal(in0, out, size);
+      break;
+    case OpCode::kRound:
+      // Keep the round-half-to-even behaviour of the Round cpu kernel.
+      for (size_t i = 0; i < len; ++i) {
+        out[i] = std::nearbyint(in0[i]);
+      }
+      break;
+    case OpCode::kTanh:
+      (void)Tanh(in0, size, out);
+      break;
+    case OpCode::kSigmoid:
+      (void)Sigmoid(in0, size, out);
+      break;
+    case OpCode::kRelu:
+      (void)Fp32Relu(in0, size, out);
+      break;
+    case OpCode::kCast:
+      // Values are kept in float32, the cast only applies the rounding of the target type.
+      if (inst.cast_dtype == kNumberTypeFloat16) {
+        for (size_t i = 0; i < len; ++i) {
+          out[i] = static_cast<float>(float16(in0[i]));
+        }
+      } else if (inst.cast_dtype == kNumberTypeBool) {
+        for (size_t i = 0; i < len; ++i) {
+          out[i] = in0[i] != 0.0f ? 1.0f : 0.0f;
+        }
+      } else if (out != in0) {
+        (void)std::copy(in0, in0 + len, out);
+      }
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Unexpected elementwise op " << static_cast<int>(inst.op);
+  }
+}
+
+void GraphKernelCPUKernel::RunReduce(const Stage &stage, const Instruction &inst, const float *in, size_t chunk,
+                                     size_t start, size_t len) {
+  const auto &out_value = values_[values_[inst.output].root];
+  if (inst.reduce_direct) {
+    float *out = ValueData(out_value);
+    size_t row = inst.reduce_row;
+    size_t i = 0;
+    while (i < len) {
+      size_t pos = start + i;
+      size_t r = pos / row;
+      size_t run = std::min(len - i, (r + 1) * row - pos);
+      out[r] = ReduceCombine(inst.op, out[r], ReduceRun(inst.op, in + i, run));
+      i += run;
+    }
+    return;
+  }
+  float *acc = partials_.data() + chunk * stage.partial_size + inst.partial_offset;
+  auto op = inst.op;
+  ForEachRun(inst.shape, inst.reduce_strides, start, len, [op, in, acc](size_t pos, size_t offset, size_t run,
+                                                                         size_t stride) {
+    if (stride == 0) {
+      acc[offset] = ReduceCombine(op, acc[offset], ReduceRun(op, in + pos, run));
+      return;
+    }
+    for (size_t j = 0; j < run; ++j) {
+      acc[offset + j * stride] = ReduceCombine(op, acc[offset + j * stride], in[pos + j]);
+    }
+  });
+}
+
+void GraphKernelCPUKernel::InitReduceOutputs(const Stage &stage, size_t chunk, size_t start, size_t end) {
+  for (auto idx : stage.insts) {
+    const auto &inst = insts_[idx];
+    if (!IsReduce(inst.op)) {
+      continue;
+    }
+    const auto &out_value = values_[values_[inst.output].root];
+    auto init = ReduceInit(inst.op);
+    if (inst.reduce_direct) {
+      // The chunk owns the rows it covers because chunks are aligned to the row length.
+      float *out = ValueData(out_value);
+      std::fill(out + start / inst.reduce_row, out + end / inst.reduce_row, init);
+    } else {
+      float *acc = partials_.data() + chunk * stage.partial_size + inst.partial_offset;
+      std::fill(acc, acc + out_value.size, init);
+    }
+  }
+}
+
+void GraphKernelCPUKernel::CombinePartials(const Stage &stage, size_t chunk_num) {
+  for (auto idx : stage.insts) {
+    const auto &inst = insts_[idx];
+    if (!IsReduce(inst.op) || inst.reduce_direct) {
+      continue;
+    }
+    const auto &out_value = values_[values_[inst.output].root];
+    float *out = ValueData(out_value);
+    const float *acc = partials_.data() + inst.partial_offset;
+    size_t partial_size = stage.partial_size;
+    auto op = inst.op;
+    auto task = [out, acc, partial_size, chunk_num, op](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        float result = acc[i];
+        for (size_t c = 1; c < chunk_num; ++c) {
+          result = ReduceCombine(op, result, acc[c * partial_size + i]);
+        }
+        out[i] = result;
+      }
+    };
+    ParallelLaunch(task, out_value.size, kCombineBlockSize);
+  }
+}
+
+void GraphKernelCPUKernel::RunTile(const Stage &stage, size_t chunk, size_t start, size_t end) {
+  size_t len = end - start;
+  float *scratch = scratch_.data() + chunk * (max_slot_num_ + kTempSlotNum) * kTileSize;
+  for (auto idx : stage.insts) {
+    const auto &inst = insts_[idx];
+    const float *in0 = LoadOperand(inst, 0, scratch, start, len);
+    if (IsReduce(inst.op)) {
+      RunReduce(stage, inst, in0, chunk, start, len);
+      continue;
+    }
+    const float *in1 = inst.inputs.size() > 1 ? LoadOperand(inst, 1, scratch, start, len) : nullptr;
+    const auto &out_value = values_[values_[inst.output].root];
+    float *out = out_value.storage == StorageType::kLocal ? scratch + out_value.index * kTileSize
+                                                          : ValueData(out_value) + start;
+    RunElementwise(inst, in0, in1, out, len);
+  }
+}
+
+void GraphKernelCPUKernel::RunStage(const Stage &stage) {
+  if (stage.space == 0) {
+    return;
+  }
+  size_t chunk_len = stage.chunk_len;
+  auto task = [this, &stage, chunk_len](size_t start, size_t end) {
+    for (size_t chunk = start; chunk < end; ++chunk) {
+      size_t begin = chunk * chunk_len;
+      size_t finish = std::min(begin + chunk_len, stage.space);
+      InitReduceOutputs(stage, chunk, begin, finish);
+      for (size_t tile = begin; tile < finish; tile += kTileSize) {
+        RunTile(stage, chunk, tile, std::min(tile + kTileSize, finish));
+      }
+    }
+  };
+  ParallelLaunch(task, stage.chunk_num, 1);
+  CombinePartials(stage, stage.chunk_num);
+}
+
+void GraphKernelCPUKernel::RunPostCopy(const PostCopy &copy) const {
+  const auto &root = values_[values_[copy.value].root];
+  void *dst = output_addrs_[copy.output];
+  auto dtype = output_dtypes_[copy.output];
+  auto task = [this, &root, dst, dtype](size_t start, size_t end) {
+    float buf[kTileSize];
+    for (size_t tile = start; tile < end; tile += kTileSize) {
+      size_t len = std::min(kTileSize, end - tile);
+      LoadContiguous(root, tile, len, buf);
+      if (dtype == kNumberTypeFloat32) {
+        (void)std::copy(buf, buf + len, static_cast<float *>(dst) + tile);
+      } else if (dtype == kNumberTypeFloat16) {
+        ConvertFromFloat(buf, len, static_cast<float16 *>(dst) + tile);
+      } else {
+        ConvertFromFloat(buf, len, static_cast<bool *>(dst) + tile);
+      }
+    }
+  };
+  ParallelLaunch(task, values_[copy.value].size, kMinChunkSize);
+}
+
+bool GraphKernelCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                                  const std::vector<AddressPtr> &outputs) {
+  if (inputs.size() != input_size_list_.size() || outputs.size() != output_size_list_.size()) {
+    MS_LOG(EXCEPTION) << "Graph kernel needs " << input_size_list_.size() << " inputs and " << output_size_list_.size()
+                      << " outputs, but got " << inputs.size() << " and " << outputs.size();
+  }
+  input_addrs_.resize(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    input_addrs_[i] = inputs[i]->addr;
+  }
+  output_addrs_.resize(outputs.size());
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    output_addrs_[i] = outputs[i]->addr;
+  }
+  workspace_addr_ = workspace.empty() ? nullptr : static_cast<float *>(workspace[0]->addr);
+  for (const auto &stage : stages_) {
+    RunStage(stage);
+  }
+  for (const auto &copy : post_copies_) {
+    RunPostCopy(copy);
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GRAPH_KERNEL_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GRAPH_KERNEL_CPU_KERNEL_H_
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+// Runs a fused elementwise/broadcast/reduce sub graph produced by the graph kernel cluster pass.
+// The sub graph is compiled into stages at init time. Each stage is executed with one ParallelLaunch,
+// and every chunk walks its part of the iteration space tile by tile, so intermediates that are only
+// consumed inside a stage live in a small per-thread scratch buffer instead of full-size tensors.
+class GraphKernelCPUKernel : public CPUKernel {
+ public:
+  GraphKernelCPUKernel() = default;
+  ~GraphKernelCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
+
+ private:
+  enum class OpCode {
+    kAdd,
+    kSub,
+    kMul,
+    kRealDiv,
+    kMaximum,
+    kMinimum,
+    kPow,
+    kEqual,
+    kNotEqual,
+    kGreater,
+    kGreaterEqual,
+    kLess,
+    kLessEqual,
+    kAbs,
+    kNeg,
+    kExp,
+    kLog,
+    kSqrt,
+    kRsqrt,
+    kSquare,
+    kReciprocal,
+    kRound,
+    kTanh,
+    kSigmoid,
+    kRelu,
+    kCast,
+    kReduceSum,
+    kReduceMax,
+    kReduceMin,
+  };
+  enum class StorageType { kLocal, kConst, kInput, kOutput, kWorkspace };
+
+  struct Value {
+    std::vector<size_t> shape;
+    size_t size{1};
+    // Reshape only renames a value, so it points to the value that owns the data.
+    size_t root{0};
+    StorageType storage{StorageType::kLocal};
+    // Slot, const, input, output index or workspace offset (in elements) depending on the storage.
+    size_t index{0};
+    // Only graph inputs may be stored in a type other than float32.
+    TypeId dtype{kNumberTypeFloat32};
+    bool is_reduce_output{false};
+    bool need_materialize{false};
+    // Stage that produces the value, SIZE_MAX for graph inputs and constants.
+    size_t stage{SIZE_MAX};
+  };
+
+  struct Instruction {
+    OpCode op{OpCode::kAdd};
+    std::vector<size_t> inputs;
+    size_t output{0};
+    // Shape of the iteration space: the output shape for elementwise ops, the input shape for reduces.
+    std::vector<size_t> shape;
+    // Strides used to gather a broadcast input, empty if the input is read element by element.
+    std::vector<std::vector<size_t>> input_strides;
+    TypeId cast_dtype{kNumberTypeFloat32};
+    // Strides into the reduce output for each input dim, zero on reduced axes.
+    std::vector<size_t> reduce_strides;
+    // Length of a reduced row when only trailing axes are reduced, otherwise zero.
+    size_t reduce_row{0};
+    // A direct reduce accumulates into its output, otherwise into per-chunk partial buffers.
+    bool reduce_direct{false};
+    size_t partial_offset{0};
+  };
+
+  struct Stage {
+    size_t space{0};
+    // Chunks of a stage start at multiples of align so that a direct reduce row is owned by one chunk.
+    size_t align{1};
+    size_t partial_size{0};
+    size_t chunk_num{1};
+    size_t chunk_len{0};
+    std::vector<size_t> insts;
+  };
+
+  struct PostCopy {
+    size_t value{0};
+    size_t output{0};
+  };
+
+  static bool IsReduce(OpCode op) {
+    return op == OpCode::kReduceSum || op == OpCode::kReduceMax || op == OpCode::kReduceMin;
+  }
+  static float ReduceInit(OpCode op);
+  static float ReduceCombine(OpCode op, float a, float b);
+  static float ReduceRun(OpCode op, const float *in, size_t len);
+
+  size_t AddValue(const AnfNodePtr &node, const CNodePtr &kernel_node);
+  void AddInstruction(const CNodePtr &cnode, const CNodePtr &kernel_node);
+  void InitReduce(const CNodePtr &cnode, Instruction *inst) const;
+  void PlanOutputs(const FuncGraphPtr &func_graph, const CNodePtr &kernel_node);
+  void PlanStages();
+  void PlanStorage();
+  void PlanChunks(size_t thread_num);
+
+  float *ValueData(const Value &value) const;
+  void LoadContiguous(const Value &value, size_t start, size_t len, float *dst) const;
+  const float *LoadOperand(const Instruction &inst, size_t input_idx, float *scratch, size_t start, size_t len) const;
+  void RunElementwise(const Instruction &inst, const float *in0, const float *in1, float *out, size_t len) const;
+  void RunReduce(const Stage &stage, const Instruction &inst, const float *in, size_t chunk, size_t start,
+                 size_t len);
+  void InitReduceOutputs(const Stage &stage, size_t chunk, size_t start, size_t end);
+  void CombinePartials(const Stage &stage, size_t chunk_num);
+  void RunTile(const Stage &stage, size_t chunk, size_t start, size_t end);
+  void RunStage(const Stage &stage);
+  void RunPostCopy(const PostCopy &copy) const;
+
+  std::vector<Value> values_;
+  std::vector<Instruction> insts_;
+  std::vector<Stage> stages_;
+  std::vector<PostCopy> post_copies_;
+  std::vector<float> consts_;
+  std::vector<TypeId> output_dtypes_;
+  std::unordered_map<AnfNodePtr, size_t> node_value_map_;
+  size_t workspace_elements_{0};
+  size_t max_slot_num_{0};
+
+  // Buffers bound for the duration of one Launch.
+  std::vector<void *> input_addrs_;
+  std::vector<void *> output_addrs_;
+  float *workspace_addr_{nullptr};
+  // Per-chunk tile slots and reduce partials, sized for the largest stage at init time.
+  std::vector<float> scratch_;
+  std::vector<float> partials_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GRAPH_KERNEL_CPU_KERNEL_H_
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/lookup_engine.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Indices ahead of the current one whose rows are prefetched.
+constexpr size_t kLookupPrefetchDistance = 8;
+// Leading bytes of a row that are prefetched, the hardware prefetcher follows the rest of a long row.
+constexpr size_t kLookupPrefetchBytes = 512;
+constexpr size_t kCacheLineSize = 64;
+// Tables above the size of a last level cache read their rows in address order.
+constexpr size_t kLookupSortTableSize = 32 * 1024 * 1024;
+// Bytes of output a task writes at least before the work is given to another thread.
+constexpr size_t kLookupParallelBytes = 32 * 1024;
+// Row of the indices out of the table when they give zeros, it sorts after all the table rows.
+constexpr size_t kZeroRow = std::numeric_limits<size_t>::max();
+}  // namespace
+
+void LookupEngine::Init(size_t outer_size, size_t table_rows, size_t row_size, bool zero_invalid) {
+  outer_size_ = outer_size;
+  table_rows_ = table_rows;
+  row_size_ = row_size;
+  zero_invalid_ = zero_invalid;
+}
+
+template <typename I>
+bool LookupEngine::GetRow(I index, I offset, size_t *row) const {
+  auto table_rows = static_cast<int64_t>(table_rows_);
+  auto pos = static_cast<int64_t>(index) - static_cast<int64_t>(offset);
+  if (!zero_invalid_ && pos < 0) {
+    pos += table_rows;
+  }
+  if (pos >= 0 && pos < table_rows) {
+    *row = static_cast<size_t>(pos);
+    return true;
+  }
+  *row = kZeroRow;
+  return zero_invalid_;
+}
+
+void LookupEngine::PrefetchRow(const int8_t *table, size_t row) const {
+  if (row == kZeroRow) {
+    return;
+  }
+  const int8_t *addr = table + row * row_size_;
+  size_t size = std::min(row_size_, kLookupPrefetchBytes);
+  for (size_t offset = 0; offset < size; offset += kCacheLineSize) {
+    __builtin_prefetch(addr + offset);
+  }
+}
+
+bool LookupEngine::CopyRow(const int8_t *table, size_t row, int8_t *output) const {
+  if (row == kZeroRow) {
+    return memset_s(output, row_size_, 0, row_size_) == EOK;
+  }
+  return memcpy_s(output, row_size_, table + row * row_size_, row_size_) == EOK;
+}
+
+template <typename I>
+bool LookupEngine::LookupInOrder(const int8_t *table, const I *indices, size_t index_num, I offset,
+                                 int8_t *output) const {
+  size_t row = 0;
+  for (size_t i = 0; i < index_num; ++i) {
+    if (i + kLookupPrefetchDistance < index_num) {
+      size_t next_row = 0;
+      (void)GetRow(indices[i + kLookupPrefetchDistance], offset, &next_row);
+      PrefetchRow(table, next_row);
+    }
+    if (!GetRow(indices[i], offset, &row) || !CopyRow(table, row, output + i * row_size_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename I>
+bool LookupEngine::LookupSorted(const int8_t *table, const I *indices, size_t index_num, I offset,
+                                int8_t *output) const {
+  // Pairs of the row and the output position.
+  std::vector<std::pair<size_t, size_t>> rows(index_num);
+  for (size_t i = 0; i < index_num; ++i) {
+    if (!GetRow(indices[i], offset, &rows[i].first)) {
+      return false;
+    }
+    rows[i].second = i;
+  }
+  std::sort(rows.begin(), rows.end());
+  const int8_t *first_output = nullptr;
+  for (size_t i = 0; i < index_num; ++i) {
+    if (i + kLookupPrefetchDistance < index_num) {
+      PrefetchRow(table, rows[i + kLookupPrefetchDistance].first);
+    }
+    int8_t *row_output = output + rows[i].second * row_size_;
+    if (i > 0 && rows[i].first == rows[i - 1].first) {
+      if (memcpy_s(row_output, row_size_, first_output, row_size_) != EOK) {
+        return false;
+      }
+      continue;
+    }
+    if (!CopyRow(table, rows[i].first, row_output)) {
+      return false;
+    }
+    first_output = row_output;
+  }
+  return true;
+}
+
+template <typename I>
+bool LookupEngine::Lookup(const void *table, const I *indices, size_t index_num, I offset, void *output) const {
+  if (index_num == 0 || row_size_ == 0) {
+    return true;
+  }
+  auto table_addr = static_cast<const int8_t *>(table);
+  auto output_addr = static_cast<int8_t *>(output);
+  bool sorted = table_rows_ * row_size_ > kLookupSortTableSize;
+  std::atomic<bool> valid{true};
+  auto task = [&](size_t start, size_t end) {
+    size_t pos = start;
+    while (pos < end) {
+      size_t outer = pos / index_num;
+      size_t begin = pos % index_num;
+      size_t count = std::min(index_num - begin, end - pos);
+      const int8_t *outer_table = table_addr + outer * table_rows_ * row_size_;
+      int8_t *outer_output = output_addr + pos * row_size_;
+      bool ret = sorted ? LookupSorted(outer_table, indices + begin, count, offset, outer_output)
+                        : LookupInOrder(outer_table, indices + begin, count, offset, outer_output);
+      if (!ret) {
+        valid = false;
+        return;
+      }
+      pos += count;
+    }
+  };
+  float block_size = std::max(1.0f, static_cast<float>(kLookupParallelBytes) / row_size_);
+  ParallelLaunch(task, outer_size_ * index_num, block_size);
+  return valid;
+}
+
+template bool LookupEngine::Lookup<int32_t>(const void *table, const int32_t *indices, size_t index_num,
+                                            int32_t offset, void *output) const;
+template bool LookupEngine::Lookup<int64_t>(const void *table, const int64_t *indices, size_t index_num,
+                                            int64_t offset, void *output) const;
+}  // namespace kernel
+}  // namespace mindspore
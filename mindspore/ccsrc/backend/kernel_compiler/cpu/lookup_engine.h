@@ -0,0 +1,60 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_LOOKUP_ENGINE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_LOOKUP_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+namespace kernel {
+// Copy of the table rows picked by indices, shared by EmbeddingLookup and Gather. The rows of the next indices are
+// prefetched while the current row is copied. The indices of a task on a table larger than the last level cache
+// are sorted first, so the table is read in address order and a repeated index reads its row once, the repeats copy
+// the output row written for the first one.
+class LookupEngine {
+ public:
+  LookupEngine() = default;
+  ~LookupEngine() = default;
+
+  // The table is [outer_size, table_rows, row_size bytes] and the output [outer_size, index_num, row_size bytes].
+  // With zero_invalid the indices out of [0, table_rows) give rows of zeros, otherwise the negative indices count
+  // from the end and the other ones fail the lookup.
+  void Init(size_t outer_size, size_t table_rows, size_t row_size, bool zero_invalid);
+
+  // Indices are shifted by offset before the lookup. Return false when an index is invalid.
+  template <typename I>
+  bool Lookup(const void *table, const I *indices, size_t index_num, I offset, void *output) const;
+
+ private:
+  template <typename I>
+  bool GetRow(I index, I offset, size_t *row) const;
+  void PrefetchRow(const int8_t *table, size_t row) const;
+  bool CopyRow(const int8_t *table, size_t row, int8_t *output) const;
+  template <typename I>
+  bool LookupInOrder(const int8_t *table, const I *indices, size_t index_num, I offset, int8_t *output) const;
+  template <typename I>
+  bool LookupSorted(const int8_t *table, const I *indices, size_t index_num, I offset, int8_t *output) const;
+
+  size_t outer_size_{1};
+  size_t table_rows_{0};
+  size_t row_size_{0};
+  bool zero_invalid_{false};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_LOOKUP_ENGINE_H_
@@ -24,7 +24,7 @@ void BatchNormCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   CPUKernel::InitInputOutputSize(kernel_node);
   MS_EXCEPTION_IF_NULL(kernel_node);
   size_t type_size = sizeof(float);
-  std::vector<size_t> shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> shape = GetInputShape(kernel_node, 0);
   size_t tensor_size = shape[1] * 2 * type_size;  // [2, c] to store scale and bias
   workspace_size_list_.emplace_back(tensor_size);
 }
@@ -33,7 +33,7 @@ void BatchNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   is_train = AnfAlgo::GetNodeAttr<bool>(kernel_node, "is_training");
   momentum = AnfAlgo::GetNodeAttr<float>(kernel_node, "momentum");
-  std::vector<size_t> x_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> x_shape = GetInputShape(kernel_node, 0);
   if (x_shape.size() == 2) {
     x_shape.insert(x_shape.end(), 2, 1);
   } else if (x_shape.size() != 4) {
@@ -43,7 +43,7 @@ void BatchNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   channel = x_shape[1];
   hw_size = x_shape[2] * x_shape[3];
   nhw_size = x_shape[0] * hw_size;
-  dnnl::memory::desc x_desc = GetDefaultMemDesc(x_shape);
+  dnnl::memory::desc x_desc = GetFormattedMemDesc(x_shape, AnfAlgo::GetInputFormat(kernel_node, 0));
   dnnl::memory::desc scale_bias_desc = GetDefaultMemDesc({2, channel});
   auto epsilon = AnfAlgo::GetNodeAttr<float>(kernel_node, "epsilon");
   auto prop_kind = dnnl::prop_kind::forward_inference;
@@ -23,15 +23,16 @@
 namespace mindspore {
 namespace kernel {
 constexpr size_t kConvInputTensorNum = 2;
+constexpr size_t kBiasIndex = 2;
 constexpr size_t kShapeSize4D = 4;
 constexpr size_t kShapeSize5D = 5;
 constexpr size_t kKernelStartAxis = 2;
 
 void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_shape = GetInputShape(kernel_node, 0);
   std::vector<size_t> weight_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
-  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  std::vector<size_t> dst_shape = GetOutputShape(kernel_node, 0);
   size_t src_dim = src_shape.size();
   size_t weight_dim = weight_shape.size();
   if (src_dim < kShapeSize4D || src_dim > kShapeSize5D || src_dim != weight_dim) {
@@ -49,9 +50,18 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     (void)weight_shape.insert(weight_shape.begin(), group);
     weight_shape[1] = weight_shape[1] / group;
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0);
   dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc dst_desc = GetOutputMemDesc(kernel_node, 0);
+  // With a blocked src or a reduced compute type the primitive picks the layouts of the converted operands.
+  auto compute_type = GetComputeDataType(kernel_node, false);
+  bool blocked = AnfAlgo::GetInputFormat(kernel_node, 0) == kOpFormat_NC1HWC0;
+  bool reduced = compute_type != dnnl::memory::data_type::f32;
+  dnnl::memory::desc prim_src_desc =
+    reduced ? dnnl::memory::desc(src_desc.dims(), compute_type, dnnl::memory::format_tag::any) : src_desc;
+  dnnl::memory::desc prim_weights_desc =
+    blocked || reduced ? dnnl::memory::desc(weights_desc.dims(), compute_type, dnnl::memory::format_tag::any)
+                       : weights_desc;
   std::vector<int> stride_ori;
   std::vector<int> dilation_ori;
   auto stride_attr = src_dim == kShapeSize4D ? STRIDE : STRIDES;
@@ -98,14 +108,35 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     padding_l.emplace_back(int_padding_l[i]);
     padding_r.emplace_back(int_padding_r[i]);
   }
+  has_bias_ = AnfAlgo::GetCNodeName(kernel_node) == kFusedConv2DOpName &&
+              AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrHasBias);
+  dnnl::memory::desc bias_desc = GetDefaultMemDesc({dst_shape[1]});
   dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    has_bias_ ? dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                                prim_src_desc, prim_weights_desc, bias_desc, dst_desc, strides,
+                                                dilates, padding_l, padding_r)
+              : dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                                prim_src_desc, prim_weights_desc, dst_desc, strides, dilates,
+                                                padding_l, padding_r);
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  auto attr = GetPostOpsAttr(kernel_node, has_bias_ ? kBiasIndex + 1 : kBiasIndex, dst_desc);
+  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, attr, MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  if (prim_desc.src_desc() != src_desc) {
+    AddConvertedArgument(DNNL_ARG_SRC, src_desc, prim_desc.src_desc());
+  } else {
+    AddArgument(DNNL_ARG_SRC, src_desc);
+  }
+  if (prim_desc.weights_desc() != weights_desc) {
+    bool is_weight_const = AnfAlgo::HasNodeAttr(kAttrIsWeightConst, kernel_node) &&
+                           AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrIsWeightConst);
+    AddConvertedArgument(DNNL_ARG_WEIGHTS, weights_desc, prim_desc.weights_desc(), false, is_weight_const);
+  } else {
+    AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  }
+  if (has_bias_) {
+    AddArgument(DNNL_ARG_BIAS, bias_desc);
+  }
   AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
@@ -117,6 +148,13 @@ bool ConvCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   }
   SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+  if (has_bias_) {
+    if (inputs.size() <= kBiasIndex) {
+      MS_LOG(EXCEPTION) << "Conv with bias needs at least " << (kBiasIndex + 1) << " inputs, but got " << inputs.size();
+    }
+    SetArgumentHandle(DNNL_ARG_BIAS, inputs[kBiasIndex]->addr);
+  }
+  SetPostOpsArgumentHandle(inputs);
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
   ExecutePrimitive();
   return true;
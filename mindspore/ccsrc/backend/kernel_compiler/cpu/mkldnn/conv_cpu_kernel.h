@@ -31,10 +31,16 @@ class ConvCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool has_bias_{false};
 };
 
 MS_REG_CPU_KERNEL(Conv2D, KernelAttr(), ConvCPUKernel);
 MS_REG_CPU_KERNEL(Conv3D, KernelAttr(), ConvCPUKernel);
+MS_REG_CPU_KERNEL(FusedConv2D,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  ConvCPUKernel);
 
 }  // namespace kernel
 }  // namespace mindspore
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/mkldnn/fused_matmul_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/dynamic_quantize.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kMatMulInputTensorNum = 2;
+constexpr size_t kMatMulRank = 2;
+constexpr size_t kBiasIndex = 2;
+}  // namespace
+
+void FusedMatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<size_t> a_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> b_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  std::vector<size_t> o_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  if (a_shape.size() != kMatMulRank || b_shape.size() != kMatMulRank || o_shape.size() != kMatMulRank) {
+    MS_LOG(EXCEPTION) << "FusedMatMul only supports 2D inputs and output!";
+  }
+  bool trans_a = AnfAlgo::GetNodeAttr<bool>(kernel_node, TRANSPOSE_A);
+  bool trans_b = AnfAlgo::GetNodeAttr<bool>(kernel_node, TRANSPOSE_B);
+  trans_b_ = trans_b;
+  has_bias_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrHasBias);
+  auto dim_m = static_cast<dnnl::memory::dim>(o_shape[0]);
+  auto dim_n = static_cast<dnnl::memory::dim>(o_shape[1]);
+  auto dim_k = static_cast<dnnl::memory::dim>(trans_a ? a_shape[0] : a_shape[1]);
+
+  // A transposed operand is described by its logical dims with swapped strides, so no reorder is needed.
+  auto src_tag = trans_a ? dnnl::memory::format_tag::ba : dnnl::memory::format_tag::ab;
+  auto weights_tag = trans_b ? dnnl::memory::format_tag::ba : dnnl::memory::format_tag::ab;
+  dnnl::memory::desc src_desc = formatted_md({dim_m, dim_k}, src_tag);
+  dnnl::memory::desc weights_desc = formatted_md({dim_k, dim_n}, weights_tag);
+  dnnl::memory::desc bias_desc = formatted_md({1, dim_n}, dnnl::memory::format_tag::ab);
+  dnnl::memory::desc dst_desc = formatted_md({dim_m, dim_n}, dnnl::memory::format_tag::ab);
+  is_weight_const_ = AnfAlgo::HasNodeAttr(kAttrIsWeightConst, kernel_node) &&
+                     AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrIsWeightConst);
+
+  auto compute_type = GetComputeDataType(kernel_node, true);
+  is_int8_ = compute_type == dnnl::memory::data_type::s8;
+  dnnl::memory::desc prim_src_desc(src_desc.dims(), compute_type, src_tag);
+  dnnl::memory::desc prim_weights_desc(weights_desc.dims(), compute_type, weights_tag);
+  dnnl::post_ops post_ops;
+  if (is_int8_ && has_bias_) {
+    // Output scales apply to the int8 accumulator, so the float32 bias is added after them as the first post op.
+    bias_arg_key_ = DNNL_ARG_ATTR_MULTIPLE_POST_OP(post_ops.len()) | DNNL_ARG_SRC_1;
+    post_ops.append_binary(dnnl::algorithm::binary_add, bias_desc);
+  }
+  bool bias_in_desc = has_bias_ && !is_int8_;
+  dnnl::matmul::desc desc = bias_in_desc ? dnnl::matmul::desc(prim_src_desc, prim_weights_desc, bias_desc, dst_desc)
+                                         : dnnl::matmul::desc(prim_src_desc, prim_weights_desc, dst_desc);
+
+  auto attr = GetPostOpsAttr(kernel_node, has_bias_ ? kBiasIndex + 1 : kBiasIndex, dst_desc, post_ops);
+  if (is_int8_) {
+    // Scales of the dynamically quantized operands are only known at launch.
+    constexpr int kPerColumnMask = 1 << 1;
+    attr.set_output_scales(kPerColumnMask, {DNNL_RUNTIME_F32_VAL});
+    AddArgument(DNNL_ARG_ATTR_OUTPUT_SCALES, formatted_md({dim_n}, dnnl::memory::format_tag::a), true);
+    weights_scales_.resize(LongToSize(dim_n));
+  }
+  auto prim_desc = dnnl::matmul::primitive_desc(desc, attr, MKLKernelEngine::Get().engine());
+  primitive_ = std::make_shared<dnnl::matmul>(prim_desc);
+  if (compute_type == dnnl::memory::data_type::bf16) {
+    AddConvertedArgument(DNNL_ARG_SRC, src_desc, prim_src_desc);
+    AddConvertedArgument(DNNL_ARG_WEIGHTS, weights_desc, prim_weights_desc, false, is_weight_const_);
+  } else {
+    AddArgument(DNNL_ARG_SRC, prim_src_desc, is_int8_);
+    AddArgument(DNNL_ARG_WEIGHTS, prim_weights_desc, is_int8_);
+  }
+  if (has_bias_) {
+    AddArgument(bias_arg_key_, bias_desc);
+  }
+  AddArgument(DNNL_ARG_DST, dst_desc);
+}
+
+void FusedMatMulCPUKernel::QuantizeInputs(const float *src, const float *weights) {
+  auto src_dims = arguments_[DNNL_ARG_SRC].get_desc().dims();
+  auto weights_dims = arguments_[DNNL_ARG_WEIGHTS].get_desc().dims();
+  size_t dim_k = LongToSize(weights_dims[0]);
+  size_t dim_n = LongToSize(weights_dims[1]);
+  float src_scale = QuantizeTensor(src, LongToSize(src_dims[0]) * dim_k,
+                                   reinterpret_cast<int8_t *>(arguments_[DNNL_ARG_SRC].get_data_handle()));
+  uint64_t weight_version = device::DeviceAddress::weight_version();
+  if (!is_weight_const_ || weights != quantized_weights_addr_ || weight_version != quantized_weight_version_) {
+    auto quantized_weights = reinterpret_cast<int8_t *>(arguments_[DNNL_ARG_WEIGHTS].get_data_handle());
+    QuantizeColumns(weights, dim_k, dim_n, trans_b_, quantized_weights, &weights_scales_);
+    quantized_weights_addr_ = weights;
+    quantized_weight_version_ = weight_version;
+  }
+  auto output_scales = reinterpret_cast<float *>(arguments_[DNNL_ARG_ATTR_OUTPUT_SCALES].get_data_handle());
+  for (size_t i = 0; i < dim_n; ++i) {
+    output_scales[i] = 1.f / (src_scale * weights_scales_[i]);
+  }
+}
+
+bool FusedMatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                  const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                  const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < kMatMulInputTensorNum || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "FusedMatMul error input output size!";
+  }
+  if (is_int8_) {
+    QuantizeInputs(reinterpret_cast<float *>(inputs[0]->addr), reinterpret_cast<float *>(inputs[1]->addr));
+  } else {
+    SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+  }
+  if (has_bias_) {
+    if (inputs.size() <= kBiasIndex) {
+      MS_LOG(EXCEPTION) << "FusedMatMul with bias needs at least " << (kBiasIndex + 1) << " inputs, but got "
+                        << inputs.size();
+    }
+    SetArgumentHandle(bias_arg_key_, inputs[kBiasIndex]->addr);
+  }
+  SetPostOpsArgumentHandle(inputs);
+  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+  ExecutePrimitive();
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_MATMUL_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_MATMUL_CPU_KERNEL_H_
+
+#include <vector>
+#include <memory>
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+// MatMul fused with BiasAdd, residual Add and activations by PostOpFusionCPU, run as one dnnl matmul primitive.
+// In int8 precision mode the operands are quantized symmetrically: the src per tensor at every launch, the weights
+// per column, only again for a read-only weight when its address or the weight version changes.
+class FusedMatMulCPUKernel : public MKLCPUKernel {
+ public:
+  FusedMatMulCPUKernel() = default;
+  ~FusedMatMulCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  void QuantizeInputs(const float *src, const float *weights);
+
+  bool has_bias_{false};
+  bool trans_b_{false};
+  bool is_int8_{false};
+  bool is_weight_const_{false};
+  int bias_arg_key_{DNNL_ARG_BIAS};
+  const float *quantized_weights_addr_{nullptr};
+  uint64_t quantized_weight_version_{0};
+  std::vector<float> weights_scales_;
+};
+
+MS_REG_CPU_KERNEL(FusedMatMul,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  FusedMatMulCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_MATMUL_CPU_KERNEL_H_
@@ -78,9 +78,14 @@ void LstmCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (!is_training) {
     prop_kind = dnnl::prop_kind::forward_inference;
   }
+  // Reduced precision only applies to inference. The layer input and output and the hidden states are converted at the
+  // kernel boundary, the cell states and the bias stay float32.
+  auto layer_type = GetComputeDataType(kernel_node, false);
+  auto layer_md = [layer_type](const dim &dims, tag layout) { return dnnl::memory::desc(dims, layer_type, layout); };
   auto desc = std::make_shared<dnnl::lstm_forward::desc>(
-    prop_kind, direction, src_desc, src_h_desc, src_c_desc, formatted_md(weights_dims_, tag::any),
-    formatted_md(weights_h_dims_, tag::any), bias_desc, dst_desc, dst_h_desc, dst_c_desc);
+    prop_kind, direction, layer_md(src_dims, tag::tnc), layer_md(src_h_dims, tag::ldnc), src_c_desc,
+    layer_md(weights_dims_, tag::any), layer_md(weights_h_dims_, tag::any), bias_desc, layer_md(dst_dims, tag::tnc),
+    layer_md(dst_h_dims, tag::ldnc), dst_c_desc);
   prim_desc_ = dnnl::lstm_forward::primitive_desc(*desc, eng);
   primitive_ = std::make_shared<dnnl::lstm_forward>(prim_desc_);
   if (is_training) {
@@ -89,14 +94,21 @@ void LstmCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   } else {
     reserve_size_ = 1;
   }
-  AddArgument(DNNL_ARG_SRC_LAYER, src_desc);
-  AddArgument(DNNL_ARG_SRC_ITER, src_h_desc);
+  if (layer_type != dnnl::memory::data_type::f32) {
+    AddConvertedArgument(DNNL_ARG_SRC_LAYER, src_desc, prim_desc_.src_layer_desc());
+    AddConvertedArgument(DNNL_ARG_SRC_ITER, src_h_desc, prim_desc_.src_iter_desc());
+    AddConvertedArgument(DNNL_ARG_DST_LAYER, dst_desc, prim_desc_.dst_layer_desc(), true);
+    AddConvertedArgument(DNNL_ARG_DST_ITER, dst_h_desc, prim_desc_.dst_iter_desc(), true);
+  } else {
+    AddArgument(DNNL_ARG_SRC_LAYER, src_desc);
+    AddArgument(DNNL_ARG_SRC_ITER, src_h_desc);
+    AddArgument(DNNL_ARG_DST_LAYER, dst_desc);
+    AddArgument(DNNL_ARG_DST_ITER, dst_h_desc);
+  }
   AddArgument(DNNL_ARG_SRC_ITER_C, src_c_desc);
   AddArgument(DNNL_ARG_WEIGHTS_LAYER, prim_desc_.weights_layer_desc());
   AddArgument(DNNL_ARG_WEIGHTS_ITER, prim_desc_.weights_iter_desc());
   AddArgument(DNNL_ARG_BIAS, bias_desc);
-  AddArgument(DNNL_ARG_DST_LAYER, dst_desc);
-  AddArgument(DNNL_ARG_DST_ITER, dst_h_desc);
   AddArgument(DNNL_ARG_DST_ITER_C, dst_c_desc);
 }
 
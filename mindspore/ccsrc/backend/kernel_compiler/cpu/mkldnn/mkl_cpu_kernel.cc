@@ -21,6 +21,22 @@
 
 namespace mindspore {
 namespace kernel {
+namespace {
+struct EltwisePostOpParam {
+  dnnl::algorithm algorithm;
+  float alpha = 0.f;
+  float beta = 0.f;
+};
+
+const std::unordered_map<std::string, EltwisePostOpParam> kEltwisePostOps = {
+  {prim::kPrimRelu->name(), EltwisePostOpParam{dnnl::algorithm::eltwise_relu}},
+  {prim::kPrimRelu6->name(), EltwisePostOpParam{dnnl::algorithm::eltwise_clip, 0.f, 6.f}},
+  {prim::kPrimGeLU->name(), EltwisePostOpParam{dnnl::algorithm::eltwise_gelu_tanh}},
+  {prim::kPrimSigmoid->name(), EltwisePostOpParam{dnnl::algorithm::eltwise_logistic}},
+  {prim::kPrimTanh->name(), EltwisePostOpParam{dnnl::algorithm::eltwise_tanh}},
+};
+}  // namespace
+
 void MKLCPUKernel::GetPadding(const CNodePtr &kernel_node, const std::string &pad_mode,
                               const std::vector<size_t> &src_shape, const std::vector<size_t> &kernel_size,
                               const std::vector<int> &stride, std::vector<int> *padding_l, std::vector<int> *padding_r,
@@ -135,18 +151,132 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+std::vector<size_t> MKLCPUKernel::GetInputShape(const CNodePtr &kernel_node, size_t index) const {
+  if (AnfAlgo::GetInputFormat(kernel_node, index) == kOpFormat_NC1HWC0) {
+    return AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, index);
+  }
+  return AnfAlgo::GetInputDeviceShape(kernel_node, index);
+}
+
+std::vector<size_t> MKLCPUKernel::GetOutputShape(const CNodePtr &kernel_node, size_t index) const {
+  if (AnfAlgo::GetOutputFormat(kernel_node, index) == kOpFormat_NC1HWC0) {
+    return AnfAlgo::GetOutputInferShape(kernel_node, index);
+  }
+  return AnfAlgo::GetOutputDeviceShape(kernel_node, index);
+}
+
+dnnl::memory::desc MKLCPUKernel::GetFormattedMemDesc(const std::vector<size_t> &shape, const std::string &format) {
+  if (format != kOpFormat_NC1HWC0) {
+    return GetDefaultMemDesc(shape);
+  }
+  dnnl::memory::dims dims(shape.begin(), shape.end());
+  return formatted_md(dims, kBlockedFormatTag);
+}
+
+dnnl::memory::desc MKLCPUKernel::GetInputMemDesc(const CNodePtr &kernel_node, size_t index) {
+  return GetFormattedMemDesc(GetInputShape(kernel_node, index), AnfAlgo::GetInputFormat(kernel_node, index));
+}
+
+dnnl::memory::desc MKLCPUKernel::GetOutputMemDesc(const CNodePtr &kernel_node, size_t index) {
+  return GetFormattedMemDesc(GetOutputShape(kernel_node, index), AnfAlgo::GetOutputFormat(kernel_node, index));
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
 
+void MKLCPUKernel::AddConvertedArgument(int arg_key, const dnnl::memory::desc &user_desc,
+                                        const dnnl::memory::desc &mem_desc, bool is_output, bool cached) {
+  AddArgument(arg_key, mem_desc, true);
+  ConvertedArgument converted_argument;
+  converted_argument.user_memory = MKLKernelEngine::Get().CreateMemory(user_desc);
+  converted_argument.is_output = is_output;
+  converted_argument.cached = cached;
+  converted_arguments_[arg_key] = converted_argument;
+}
+
+dnnl::memory::data_type MKLCPUKernel::GetComputeDataType(const CNodePtr &kernel_node, bool support_int8) const {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (!kernel_node->HasAttr(kAttrIsTraining) || GetValue<bool>(kernel_node->GetAttr(kAttrIsTraining))) {
+    return dnnl::memory::data_type::f32;
+  }
+  auto data_type = MKLKernelEngine::Get().GetInferComputeType();
+  if (data_type == dnnl::memory::data_type::s8 && !support_int8) {
+    return dnnl::memory::data_type::f32;
+  }
+  return data_type;
+}
+
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  auto converted_iter = converted_arguments_.find(arg_key);
+  if (converted_iter != converted_arguments_.end()) {
+    converted_iter->second.user_memory.set_data_handle(ptr);
+    return;
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
   }
 }
 
-void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+dnnl::primitive_attr MKLCPUKernel::GetPostOpsAttr(const CNodePtr &kernel_node, size_t residual_input_index,
+                                                  const dnnl::memory::desc &dst_desc, dnnl::post_ops post_ops) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  dnnl::primitive_attr attr;
+  post_op_inputs_.clear();
+  if (!AnfAlgo::HasNodeAttr(kAttrPostOps, kernel_node)) {
+    attr.set_post_ops(post_ops);
+    return attr;
+  }
+  auto post_op_names = AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, kAttrPostOps);
+  for (const auto &name : post_op_names) {
+    if (name == prim::kPrimAdd->name()) {
+      // The residual has the output shape, a binary post op reads it in place instead of copying it into dst first.
+      int arg_key = DNNL_ARG_ATTR_MULTIPLE_POST_OP(post_ops.len()) | DNNL_ARG_SRC_1;
+      post_ops.append_binary(dnnl::algorithm::binary_add, dst_desc);
+      AddArgument(arg_key, dst_desc);
+      post_op_inputs_.emplace_back(arg_key, residual_input_index++);
+      continue;
+    }
+    auto iter = kEltwisePostOps.find(name);
+    if (iter == kEltwisePostOps.end()) {
+      MS_LOG(EXCEPTION) << "Unsupported post op " << name << " of " << AnfAlgo::GetCNodeName(kernel_node);
+    }
+    post_ops.append_eltwise(1.f, iter->second.algorithm, iter->second.alpha, iter->second.beta);
+  }
+  attr.set_post_ops(post_ops);
+  return attr;
+}
+
+void MKLCPUKernel::SetPostOpsArgumentHandle(const std::vector<AddressPtr> &inputs) {
+  for (const auto &post_op_input : post_op_inputs_) {
+    if (post_op_input.second >= inputs.size()) {
+      MS_LOG(EXCEPTION) << "Post op input index " << post_op_input.second << " is out of range " << inputs.size();
+    }
+    SetArgumentHandle(post_op_input.first, inputs[post_op_input.second]->addr);
+  }
+}
+
+void MKLCPUKernel::ExecutePrimitive() {
+  uint64_t weight_version = device::DeviceAddress::weight_version();
+  for (auto &converted : converted_arguments_) {
+    auto &argument = converted.second;
+    void *user_addr = argument.user_memory.get_data_handle();
+    if (argument.is_output || (argument.cached && user_addr == argument.converted_addr &&
+                               weight_version == argument.converted_weight_version)) {
+      continue;
+    }
+    Reorder(&argument.user_memory, &arguments_[converted.first]);
+    argument.converted_addr = user_addr;
+    argument.converted_weight_version = weight_version;
+  }
+  MKLKernelEngine::Get().Execute(primitive_, arguments_);
+  for (auto &converted : converted_arguments_) {
+    if (converted.second.is_output) {
+      Reorder(&arguments_[converted.first], &converted.second.user_memory);
+    }
+  }
+}
 
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
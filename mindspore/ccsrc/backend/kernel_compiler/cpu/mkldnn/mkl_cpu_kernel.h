@@ -16,13 +16,16 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKL_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKL_CPU_KERNEL_H_
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <utility>
 #include <vector>
 #include "dnnl.hpp"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "runtime/device/device_address.h"
 
 namespace mindspore {
 namespace kernel {
@@ -41,9 +44,42 @@ class MKLCPUKernel : public CPUKernel {
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // A tensor in the blocked kOpFormat_NC1HWC0 layout keeps its NCHW shape and is described with kBlockedFormatTag,
+  // other tensors use their device shape and the default layout.
+  std::vector<size_t> GetInputShape(const CNodePtr &kernel_node, size_t index) const;
+  std::vector<size_t> GetOutputShape(const CNodePtr &kernel_node, size_t index) const;
+  dnnl::memory::desc GetFormattedMemDesc(const std::vector<size_t> &shape, const std::string &format);
+  dnnl::memory::desc GetInputMemDesc(const CNodePtr &kernel_node, size_t index);
+  dnnl::memory::desc GetOutputMemDesc(const CNodePtr &kernel_node, size_t index);
+  // Binds arg_key to a primitive memory of mem_desc that ExecutePrimitive converts from the float32 tensor of
+  // user_desc before running the primitive, or back into it afterwards for an output. A cached input is only converted
+  // again when its address or the weight version of DeviceAddress changes, which is meant for weights that the graph
+  // never writes but the host may load again, possibly into the same memory.
+  void AddConvertedArgument(int arg_key, const dnnl::memory::desc &user_desc, const dnnl::memory::desc &mem_desc,
+                            bool is_output = false, bool cached = false);
+  // Data type the primitive computes in. Tensors stay float32, a kernel converts them at its boundary when
+  // the infer_precision_mode context option asks for a reduced type that the kernel and the cpu support.
+  // A node that is trained, or not known to be inferred only, always computes in float32.
+  dnnl::memory::data_type GetComputeDataType(const CNodePtr &kernel_node, bool support_int8) const;
   void ExecutePrimitive();
+  // Post ops of a node fused by PostOpFusionCPU. Residual adds read the kernel inputs starting at
+  // residual_input_index, in the order they appear in the post op list, after the given leading post ops.
+  dnnl::primitive_attr GetPostOpsAttr(const CNodePtr &kernel_node, size_t residual_input_index,
+                                      const dnnl::memory::desc &dst_desc,
+                                      dnnl::post_ops post_ops = dnnl::post_ops());
+  void SetPostOpsArgumentHandle(const std::vector<AddressPtr> &inputs);
   std::unordered_map<int, dnnl::memory> arguments_;
+  // Argument key and kernel input index of each residual post op.
+  std::vector<std::pair<int, size_t>> post_op_inputs_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
+  struct ConvertedArgument {
+    dnnl::memory user_memory;
+    bool is_output{false};
+    bool cached{false};
+    void *converted_addr{nullptr};
+    uint64_t converted_weight_version{0};
+  };
+  std::unordered_map<int, ConvertedArgument> converted_arguments_;
   inline dnnl::memory::desc formatted_md(const dnnl::memory::dims &dimensions, dnnl::memory::format_tag layout) {
     return dnnl::memory::desc{{dimensions}, dnnl::memory::data_type::f32, layout};
   }
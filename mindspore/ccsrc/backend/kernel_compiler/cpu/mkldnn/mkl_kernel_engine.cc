@@ -15,6 +15,7 @@
  */
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 #include "utils/log_adapter.h"
+#include "utils/ms_context.h"
 #include "dnnl.hpp"
 
 namespace mindspore {
@@ -36,5 +37,50 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
 }
+
+bool MKLKernelEngine::IsBlockedLayoutPreferred() const {
+  // Let dnnl choose the layouts of a typical 3x3 convolution and check what it prefers for the activations.
+  const dnnl::memory::dims src_dims = {1, 64, 28, 28};
+  const dnnl::memory::dims weights_dims = {64, 64, 3, 3};
+  const dnnl::memory::dims strides = {1, 1};
+  const dnnl::memory::dims padding = {1, 1};
+  auto any_desc = [](const dnnl::memory::dims &dims) {
+    return dnnl::memory::desc(dims, dnnl::memory::data_type::f32, dnnl::memory::format_tag::any);
+  };
+  try {
+    dnnl::convolution_forward::desc desc(dnnl::prop_kind::forward_inference, dnnl::algorithm::convolution_direct,
+                                         any_desc(src_dims), any_desc(weights_dims), any_desc(src_dims), strides,
+                                         padding, padding);
+    dnnl::convolution_forward::primitive_desc prim_desc(desc, engine_);
+    return prim_desc.src_desc() == dnnl::memory::desc(src_dims, dnnl::memory::data_type::f32, kBlockedFormatTag);
+  } catch (const dnnl::error &e) {
+    MS_LOG(INFO) << "Query the preferred convolution layout failed: " << e.what();
+    return false;
+  }
+}
+
+void MKLKernelEngine::InitIsaSupport() {
+  auto isa = dnnl::get_effective_cpu_isa();
+  bf16_supported_ = isa == dnnl::cpu_isa::avx512_core_bf16 || isa == dnnl::cpu_isa::avx512_core_amx;
+  int8_supported_ = bf16_supported_ || isa == dnnl::cpu_isa::avx512_core_vnni;
+}
+
+dnnl::memory::data_type MKLKernelEngine::GetInferComputeType() const {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto precision_mode = context->get_param<std::string>(MS_CTX_INFER_PRECISION_MODE);
+  if (precision_mode == kInferPrecisionBF16) {
+    if (bf16_supported_) {
+      return dnnl::memory::data_type::bf16;
+    }
+    MS_LOG(INFO) << "The cpu has no native bf16 support, compute in float32.";
+  } else if (precision_mode == kInferPrecisionInt8) {
+    if (int8_supported_) {
+      return dnnl::memory::data_type::s8;
+    }
+    MS_LOG(INFO) << "The cpu has no VNNI int8 support, compute in float32.";
+  }
+  return dnnl::memory::data_type::f32;
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -27,6 +27,13 @@
 
 namespace mindspore {
 namespace kernel {
+// Values of the infer_precision_mode context option that the cpu kernels act on.
+constexpr auto kInferPrecisionBF16 = "bf16";
+constexpr auto kInferPrecisionInt8 = "int8";
+
+// Channel blocked layout that kOpFormat_NC1HWC0 stands for on cpu, its C0 of 16 matches the device shape.
+constexpr auto kBlockedFormatTag = dnnl::memory::format_tag::nChw16c;
+
 class MKLKernelEngine {
  public:
   static MKLKernelEngine &Get() {
@@ -43,11 +50,26 @@ class MKLKernelEngine {
                const std::unordered_map<int, dnnl::memory> &arguments);
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
+  // Whether dnnl picks kBlockedFormatTag for convolution activations on this cpu.
+  bool blocked_layout_preferred() const { return blocked_layout_preferred_; }
+
+  // Reduced data type asked by the infer_precision_mode context option when this cpu runs it natively (bf16 or
+  // VNNI int8 instructions), f32 otherwise.
+  dnnl::memory::data_type GetInferComputeType() const;
+
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine()
+      : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_), blocked_layout_preferred_(IsBlockedLayoutPreferred()) {
+    InitIsaSupport();
+  }
   ~MKLKernelEngine() = default;
+  bool IsBlockedLayoutPreferred() const;
+  void InitIsaSupport();
   dnnl::engine engine_;
   dnnl::stream stream_;
+  bool blocked_layout_preferred_{false};
+  bool bf16_supported_{false};
+  bool int8_supported_{false};
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -29,10 +29,9 @@ void PoolingCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
 
 void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  std::vector<size_t> src_shape = GetInputShape(kernel_node, 0);
+  dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0);
+  dnnl::memory::desc dst_desc = GetOutputMemDesc(kernel_node, 0);
   std::vector<int> origin_kernel_sizes;
   std::vector<int> strides;
   std::vector<int64_t> kernel_sizes_me = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, KERNEL_SIZE);
@@ -0,0 +1,52 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/mkldnn/trans_data_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace kernel {
+void TransDataCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input_format = AnfAlgo::GetInputFormat(kernel_node, 0);
+  auto output_format = AnfAlgo::GetOutputFormat(kernel_node, 0);
+  if (input_format != kOpFormat_NC1HWC0 && output_format != kOpFormat_NC1HWC0) {
+    MS_LOG(EXCEPTION) << "TransData only supports transforming from or to " << kOpFormat_NC1HWC0 << ", but got "
+                      << input_format << " to " << output_format;
+  }
+  if (GetInputShape(kernel_node, 0).size() != 4) {
+    MS_LOG(EXCEPTION) << "TransData only supports 4D input!";
+  }
+  dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0);
+  dnnl::memory::desc dst_desc = GetOutputMemDesc(kernel_node, 0);
+  AddArgument(DNNL_ARG_FROM, src_desc);
+  AddArgument(DNNL_ARG_TO, dst_desc);
+  primitive_ = std::make_shared<dnnl::reorder>(arguments_[DNNL_ARG_FROM], arguments_[DNNL_ARG_TO]);
+}
+
+bool TransDataCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "Error input output size!";
+  }
+  SetArgumentHandle(DNNL_ARG_FROM, inputs[0]->addr);
+  SetArgumentHandle(DNNL_ARG_TO, outputs[0]->addr);
+  ExecutePrimitive();
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
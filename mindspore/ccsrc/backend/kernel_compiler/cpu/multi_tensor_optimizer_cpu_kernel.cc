@@ -0,0 +1,242 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/multi_tensor_optimizer_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <string>
+#include "nnacl/fp32/adam_fp32.h"
+#include "utils/convert_utils_base.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Elements a task updates at least before the work is given to another thread.
+constexpr float kMultiTensorParallelBlock = 16384;
+
+constexpr size_t kAdamInputNum = 10;
+constexpr size_t kAdamWeightDecayInputNum = 9;
+constexpr size_t kApplyMomentumInputNum = 5;
+
+enum AdamInput {
+  kAdamVar,
+  kAdamM,
+  kAdamV,
+  kAdamBeta1Power,
+  kAdamBeta2Power,
+  kAdamLr,
+  kAdamBeta1,
+  kAdamBeta2,
+  kAdamEpsilon,
+  kAdamGrad
+};
+enum AdamWeightDecayInput {
+  kDecayVar,
+  kDecayM,
+  kDecayV,
+  kDecayLr,
+  kDecayBeta1,
+  kDecayBeta2,
+  kDecayEpsilon,
+  kDecayDecay,
+  kDecayGrad
+};
+enum ApplyMomentumInput { kMomentumVar, kMomentumAccum, kMomentumLr, kMomentumGrad, kMomentumMomentum };
+
+size_t GetInputNum(MultiTensorOptimizerType optimizer_type) {
+  switch (optimizer_type) {
+    case MultiTensorOptimizerType::kAdam:
+      return kAdamInputNum;
+    case MultiTensorOptimizerType::kAdamWeightDecay:
+      return kAdamWeightDecayInputNum;
+    default:
+      return kApplyMomentumInputNum;
+  }
+}
+
+float *GetTensor(const std::vector<AddressPtr> &inputs, size_t index) {
+  return reinterpret_cast<float *>(inputs[index]->addr);
+}
+
+float GetScalar(const std::vector<AddressPtr> &inputs, size_t index) {
+  return reinterpret_cast<float *>(inputs[index]->addr)[0];
+}
+}  // namespace
+
+void MultiTensorOptimizerCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  MultiTensorOptimizerType optimizer_type;
+  if (kernel_name == kMultiTensorAdamOpName) {
+    optimizer_type = MultiTensorOptimizerType::kAdam;
+    use_nesterov_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "use_nesterov");
+  } else if (kernel_name == kMultiTensorAdamWeightDecayOpName) {
+    optimizer_type = MultiTensorOptimizerType::kAdamWeightDecay;
+  } else if (kernel_name == kMultiTensorApplyMomentumOpName) {
+    optimizer_type = MultiTensorOptimizerType::kApplyMomentum;
+  } else {
+    MS_LOG(EXCEPTION) << "Multi tensor optimizer does not support " << kernel_name;
+  }
+  auto tensor_num = LongToSize(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kAttrN));
+  size_t input_stride = GetInputNum(optimizer_type);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  if (input_num != tensor_num * input_stride) {
+    MS_LOG(EXCEPTION) << "Input number is " << input_num << ", but " << kernel_name << " of " << tensor_num
+                      << " tensors needs " << tensor_num * input_stride << " inputs.";
+  }
+  std::vector<size_t> tensor_sizes(tensor_num);
+  for (size_t i = 0; i < tensor_num; ++i) {
+    auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i * input_stride);
+    tensor_sizes[i] = std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+  }
+  InitTensors(optimizer_type, tensor_sizes);
+}
+
+void MultiTensorOptimizerCPUKernel::InitTensors(MultiTensorOptimizerType optimizer_type,
+                                                const std::vector<size_t> &tensor_sizes) {
+  optimizer_type_ = optimizer_type;
+  tensor_num_ = tensor_sizes.size();
+  input_stride_ = GetInputNum(optimizer_type);
+  offsets_.assign(tensor_num_ + 1, 0);
+  for (size_t i = 0; i < tensor_num_; ++i) {
+    offsets_[i + 1] = offsets_[i] + tensor_sizes[i];
+  }
+  lrs_.assign(tensor_num_, 0.0f);
+}
+
+void MultiTensorOptimizerCPUKernel::CheckInputs(const std::vector<AddressPtr> &inputs) const {
+  if (inputs.size() != tensor_num_ * input_stride_) {
+    MS_LOG(EXCEPTION) << "Input number is " << inputs.size() << ", but the multi tensor optimizer of " << tensor_num_
+                      << " tensors needs " << tensor_num_ * input_stride_ << " inputs.";
+  }
+  // The var, m, v, accum and grad inputs take the size of the tensor, the other ones are scalars.
+  size_t tensor_input_num = optimizer_type_ == MultiTensorOptimizerType::kApplyMomentum ? 2 : 3;
+  size_t grad_index = input_stride_ - 1;
+  if (optimizer_type_ == MultiTensorOptimizerType::kApplyMomentum) {
+    grad_index = kMomentumGrad;
+  }
+  for (size_t i = 0; i < tensor_num_; ++i) {
+    size_t tensor_size = (offsets_[i + 1] - offsets_[i]) * sizeof(float);
+    for (size_t j = 0; j < input_stride_; ++j) {
+      bool is_tensor = j < tensor_input_num || j == grad_index;
+      size_t expect_size = is_tensor ? tensor_size : sizeof(float);
+      size_t input_size = inputs[i * input_stride_ + j]->size;
+      if (input_size != expect_size) {
+        MS_LOG(EXCEPTION) << "The size of input " << j << " of tensor " << i << " is " << input_size
+                          << ", but it should be " << expect_size;
+      }
+    }
+  }
+}
+
+template <typename F>
+void MultiTensorOptimizerCPUKernel::ParallelForTensors(const F &update) const {
+  size_t total = offsets_.back();
+  if (total == 0) {
+    return;
+  }
+  auto task = [this, &update](size_t start, size_t end) {
+    auto iter = std::upper_bound(offsets_.begin(), offsets_.end(), start);
+    size_t tensor = static_cast<size_t>(iter - offsets_.begin()) - 1;
+    for (size_t pos = start; pos < end; ++tensor) {
+      size_t tensor_end = std::min(end, offsets_[tensor + 1]);
+      if (tensor_end > pos) {
+        update(tensor, pos - offsets_[tensor], tensor_end - offsets_[tensor]);
+        pos = tensor_end;
+      }
+    }
+  };
+  ParallelLaunch(task, total, kMultiTensorParallelBlock);
+}
+
+void MultiTensorOptimizerCPUKernel::LaunchAdam(const std::vector<AddressPtr> &inputs) {
+  constexpr float ONE = 1.0;
+  for (size_t i = 0; i < tensor_num_; ++i) {
+    size_t base = i * input_stride_;
+    float beta1_power = GetScalar(inputs, base + kAdamBeta1Power);
+    float beta2_power = GetScalar(inputs, base + kAdamBeta2Power);
+    if (beta1_power - ONE == 0) {
+      MS_LOG(EXCEPTION) << "The beta1_power can't be set 1.";
+    }
+    lrs_[i] = GetScalar(inputs, base + kAdamLr) * std::sqrt(ONE - beta2_power) / (ONE - beta1_power);
+  }
+  ParallelForTensors([this, &inputs](size_t tensor, size_t begin, size_t end) {
+    size_t base = tensor * input_stride_;
+    (void)AdamFp32(GetTensor(inputs, base + kAdamVar), GetTensor(inputs, base + kAdamM),
+                   GetTensor(inputs, base + kAdamV), lrs_[tensor], GetScalar(inputs, base + kAdamBeta1),
+                   GetScalar(inputs, base + kAdamBeta2), GetScalar(inputs, base + kAdamEpsilon),
+                   GetTensor(inputs, base + kAdamGrad), begin, end, use_nesterov_);
+  });
+}
+
+void MultiTensorOptimizerCPUKernel::LaunchAdamWeightDecay(const std::vector<AddressPtr> &inputs) {
+  ParallelForTensors([this, &inputs](size_t tensor, size_t begin, size_t end) {
+    size_t base = tensor * input_stride_;
+    auto var = GetTensor(inputs, base + kDecayVar);
+    auto m = GetTensor(inputs, base + kDecayM);
+    auto v = GetTensor(inputs, base + kDecayV);
+    auto gradient = GetTensor(inputs, base + kDecayGrad);
+    auto lr = GetScalar(inputs, base + kDecayLr);
+    auto beta1 = GetScalar(inputs, base + kDecayBeta1);
+    auto beta2 = GetScalar(inputs, base + kDecayBeta2);
+    auto epsilon = GetScalar(inputs, base + kDecayEpsilon);
+    auto decay = GetScalar(inputs, base + kDecayDecay);
+    size_t i = AdamWeightDecayFp32(var, m, v, lr, beta1, beta2, epsilon, decay, gradient, begin, end);
+    // remaining
+    const auto beta1_minus = 1 - beta1;
+    const auto beta2_minus = 1 - beta2;
+    for (; i < end; i++) {
+      m[i] += (gradient[i] - m[i]) * beta1_minus;
+      v[i] += (gradient[i] * gradient[i] - v[i]) * beta2_minus;
+      float update = m[i] / (std::sqrt(v[i]) + epsilon);
+      update += decay * var[i];
+      var[i] -= lr * update;
+    }
+  });
+}
+
+void MultiTensorOptimizerCPUKernel::LaunchApplyMomentum(const std::vector<AddressPtr> &inputs) {
+  ParallelForTensors([this, &inputs](size_t tensor, size_t begin, size_t end) {
+    size_t base = tensor * input_stride_;
+    auto weight = GetTensor(inputs, base + kMomentumVar);
+    auto accumulate = GetTensor(inputs, base + kMomentumAccum);
+    auto gradient = GetTensor(inputs, base + kMomentumGrad);
+    float learning_rate = GetScalar(inputs, base + kMomentumLr);
+    float moment = GetScalar(inputs, base + kMomentumMomentum);
+    for (size_t i = begin; i < end; ++i) {
+      accumulate[i] = accumulate[i] * moment + gradient[i];
+      weight[i] -= accumulate[i] * learning_rate;
+    }
+  });
+}
+
+bool MultiTensorOptimizerCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                           const std::vector<kernel::AddressPtr> &,
+                                           const std::vector<kernel::AddressPtr> &) {
+  CheckInputs(inputs);
+  if (optimizer_type_ == MultiTensorOptimizerType::kAdam) {
+    LaunchAdam(inputs);
+  } else if (optimizer_type_ == MultiTensorOptimizerType::kAdamWeightDecay) {
+    LaunchAdamWeightDecay(inputs);
+  } else {
+    LaunchApplyMomentum(inputs);
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,73 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MULTI_TENSOR_OPTIMIZER_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MULTI_TENSOR_OPTIMIZER_CPU_KERNEL_H_
+
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+enum class MultiTensorOptimizerType { kAdam, kAdamWeightDecay, kApplyMomentum };
+
+// Updates of n float32 parameters by one optimizer in a single launch. The inputs are the inputs of the n original
+// Adam, AdamWeightDecay or ApplyMomentum nodes one after another. The parameters are seen as one flattened list, cut
+// into equal blocks for the threads, so a thread may finish one tensor and go on with the next and the many small
+// tensors of a model do not each pay a launch and a thread pool round trip.
+class MultiTensorOptimizerCPUKernel : public CPUKernel {
+ public:
+  MultiTensorOptimizerCPUKernel() = default;
+  ~MultiTensorOptimizerCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  void InitTensors(MultiTensorOptimizerType optimizer_type, const std::vector<size_t> &tensor_sizes);
+  void CheckInputs(const std::vector<AddressPtr> &inputs) const;
+  void LaunchAdam(const std::vector<AddressPtr> &inputs);
+  void LaunchAdamWeightDecay(const std::vector<AddressPtr> &inputs);
+  void LaunchApplyMomentum(const std::vector<AddressPtr> &inputs);
+  // Call update(tensor, begin, end) for the element ranges of the tensors in each block of the flattened list.
+  template <typename F>
+  void ParallelForTensors(const F &update) const;
+
+  MultiTensorOptimizerType optimizer_type_{MultiTensorOptimizerType::kAdam};
+  size_t tensor_num_{0};
+  // Inputs of one original node.
+  size_t input_stride_{0};
+  bool use_nesterov_{false};
+  // Offsets of the tensors in the flattened list, the last one is the total number of elements.
+  std::vector<size_t> offsets_;
+  // Learning rate of each tensor, computed at launch from the scalar inputs.
+  std::vector<float> lrs_;
+};
+
+MS_REG_CPU_KERNEL(MultiTensorAdam,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  MultiTensorOptimizerCPUKernel);
+MS_REG_CPU_KERNEL(MultiTensorAdamWeightDecay,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  MultiTensorOptimizerCPUKernel);
+MS_REG_CPU_KERNEL(MultiTensorApplyMomentum,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  MultiTensorOptimizerCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MULTI_TENSOR_OPTIMIZER_CPU_KERNEL_H_
@@ -18,13 +18,27 @@
 #include <string.h>
 #include "nnacl/int8/fixed_point.h"
 #include "nnacl/int8/common_func_int8.h"
+#ifdef ENABLE_AVX
+#include "nnacl/intrinsics/avx/common_utils.h"
+#endif
 
 /*conv depthwise int8 begin*/
 #ifndef ENABLE_ARM
 void ConvDwInt8Row(int32_t *output_ptr, const int8_t *input_ptr, const int16_t *weight_ptr, int num_pixels,
                    int output_channel, int input_step, int8_t input_zp) {
   for (int i = 0; i < num_pixels; i++) {
-    for (int c = 0; c < output_channel; c++) {
+    int c = 0;
+#ifdef ENABLE_AVX
+    const __m256i zp_vec = _mm256_set1_epi32(input_zp);
+    for (; c <= output_channel - C8NUM; c += C8NUM) {
+      __m256i in = _mm256_sub_epi32(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(input_ptr + c))), zp_vec);
+      __m256i w = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(weight_ptr + c)));
+      __m256i out = _mm256_loadu_si256((__m256i *)output_ptr);
+      _mm256_storeu_si256((__m256i *)output_ptr, _mm256_add_epi32(out, _mm256_mullo_epi32(in, w)));
+      output_ptr += C8NUM;
+    }
+#endif
+    for (; c < output_channel; c++) {
       const int16_t input = input_ptr[c] - input_zp;
       *output_ptr++ += input * weight_ptr[c];
     }
@@ -33,6 +47,38 @@ void ConvDwInt8Row(int32_t *output_ptr, const int8_t *input_ptr, const int16_t *
 }
 #endif
 
+#ifdef ENABLE_AVX
+static void ConvDwInt8PostAlign8Avx(int8_t *dst, const int32_t *buffer, int num, int32_t output_zp,
+                                    int32_t out_multiplier, int32_t left_shift, int32_t right_shift, int32_t acc_min,
+                                    int32_t acc_max) {
+  const __m256i multiplier = _mm256_set1_epi32(out_multiplier);
+  const __m256i left = _mm256_set1_epi32(left_shift);
+  const __m256i right = _mm256_set1_epi32(right_shift);
+  const __m256i zp = _mm256_set1_epi32(output_zp);
+  const __m256i min = _mm256_set1_epi32(acc_min);
+  const __m256i max = _mm256_set1_epi32(acc_max);
+  for (int i = 0; i < num; i += C8NUM) {
+    __m256i value = _mm256_loadu_si256((const __m256i *)(buffer + i));
+    _mm_storel_epi64((__m128i *)(dst + i), RequantizeToInt8Avx(value, multiplier, left, right, zp, min, max));
+  }
+}
+
+static void ConvDwInt8PostAlign8PerChannelAvx(int8_t *dst, const int32_t *buffer, int channel, int32_t output_zp,
+                                              const int32_t *out_multiplier, const int32_t *left_shift,
+                                              const int32_t *right_shift, int32_t acc_min, int32_t acc_max) {
+  const __m256i zp = _mm256_set1_epi32(output_zp);
+  const __m256i min = _mm256_set1_epi32(acc_min);
+  const __m256i max = _mm256_set1_epi32(acc_max);
+  for (int c = 0; c < channel; c += C8NUM) {
+    __m256i value = _mm256_loadu_si256((const __m256i *)(buffer + c));
+    __m256i multiplier = _mm256_loadu_si256((const __m256i *)(out_multiplier + c));
+    __m256i left = _mm256_loadu_si256((const __m256i *)(left_shift + c));
+    __m256i right = _mm256_loadu_si256((const __m256i *)(right_shift + c));
+    _mm_storel_epi64((__m128i *)(dst + c), RequantizeToInt8Avx(value, multiplier, left, right, zp, min, max));
+  }
+}
+#endif
+
 void ConvDwInt8Post(int8_t *dst, int32_t *buffer, int output_w, int channel, int32_t output_zp, int32_t *out_multiplier,
                     int32_t *left_shift, int32_t *right_shift, int32_t acc_min, int32_t acc_max, bool per_channel) {
   if (per_channel) {
@@ -43,6 +89,10 @@ void ConvDwInt8Post(int8_t *dst, int32_t *buffer, int output_w, int channel, int
       channel4 = channel / 4 * 4;
       ConvDwInt8PostAlign4PerChannel(dst, buffer, channel4, output_zp, out_multiplier, left_shift, right_shift, acc_min,
                                      acc_max);
+#elif defined(ENABLE_AVX)
+      channel4 = channel / C8NUM * C8NUM;
+      ConvDwInt8PostAlign8PerChannelAvx(dst, buffer, channel4, output_zp, out_multiplier, left_shift, right_shift,
+                                        acc_min, acc_max);
 #endif
       for (int c = channel4; c < channel; c++) {
         buffer[c] = RoundingDivideByPOT(
@@ -63,6 +113,10 @@ void ConvDwInt8Post(int8_t *dst, int32_t *buffer, int output_w, int channel, int
     align_num = num_pixels / 4 * 4;
     ConvDwInt8PostAlign4(dst, buffer, align_num, output_zp, out_multiplier[0], left_shift[0], right_shift[0], acc_min,
                          acc_max);
+#elif defined(ENABLE_AVX)
+    align_num = num_pixels / C8NUM * C8NUM;
+    ConvDwInt8PostAlign8Avx(dst, buffer, align_num, output_zp, out_multiplier[0], left_shift[0], right_shift[0],
+                            acc_min, acc_max);
 #endif
     for (int i = align_num; i < num_pixels; i++) {
       buffer[i] = RoundingDivideByPOT(
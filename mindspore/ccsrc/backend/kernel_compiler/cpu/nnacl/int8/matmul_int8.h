@@ -73,6 +73,31 @@ void MatmulInt8Neon64(const int8_t *a, const int8_t *b, int8_t *dst, int row4, i
 void MatMulR4Int8Neon64(const int8_t *a, const int8_t *b, int32_t *dst, int row4, int col4, int deep16,
                         const int *input_sum, const int *bias);
 #endif
+#ifdef ENABLE_AVX
+#if !defined(SUPPORT_MSVC) && ((defined(__clang__) && __clang_major__ >= 10) || \
+                               (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 9))
+#define ENABLE_AVX512_VNNI_DISPATCH
+#endif
+/* MatmulInt8OptAvx picks the vnni kernel when the cpu supports it, the avx2 one otherwise */
+void MatmulInt8OptAvx(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int *a_sums,
+                      const int *bias, int mini, int maxi, int out_zp, const int32_t *multiplier,
+                      const int32_t *left_shift, const int32_t *right_shift, size_t stride, size_t filter_peroc,
+                      const int32_t *filter_zp);
+void MatMulInt8_8x8_rAvx(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                         size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                         const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                         int32_t maxi, size_t per_channel);
+void MatmulInt8OptAvx2(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int *a_sums,
+                       const int *bias, int mini, int maxi, int out_zp, const int32_t *multiplier,
+                       const int32_t *left_shift, const int32_t *right_shift, size_t stride, size_t filter_peroc,
+                       const int32_t *filter_zp);
+#ifdef ENABLE_AVX512_VNNI_DISPATCH
+void MatmulInt8OptAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                             const int *a_sums, const int *bias, int mini, int maxi, int out_zp,
+                             const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                             size_t stride, size_t filter_peroc, const int32_t *filter_zp);
+#endif
+#endif
 #ifdef ENABLE_ARM32
 void MatmulInt8Neon32(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
                       const int *input_sums, const int *weight_bias, int act_min, int act_max, int out_zp,
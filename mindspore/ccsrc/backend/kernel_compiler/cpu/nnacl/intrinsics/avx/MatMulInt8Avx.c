@@ -0,0 +1,270 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include <string.h>
+#include "nnacl/intrinsics/avx/common_utils.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/op_base.h"
+
+typedef struct RequantArgs {
+  __m256i multiplier_;
+  __m256i left_shift_;
+  __m256i right_shift_;
+  __m256i bias_;
+  __m256i out_zp_;
+  __m256i act_min_;
+  __m256i act_max_;
+} RequantArgs;
+
+// load up to C8NUM int32 values, lanes past num are zero
+static inline __m256i LoadInt32Tail(const int32_t *src, int num) {
+  if (num >= C8NUM) {
+    return _mm256_loadu_si256((const __m256i *)src);
+  }
+  int32_t tmp[C8NUM] = {0};
+  memcpy(tmp, src, num * sizeof(int32_t));
+  return _mm256_loadu_si256((const __m256i *)tmp);
+}
+
+// broadcast the first C4NUM-lane group of an 8-lane vector to both halves
+static inline __m256i DupLow128(__m256i value) { return _mm256_permute2x128_si256(value, value, 0); }
+
+static inline void InitRequantArgs(RequantArgs *args, const int32_t *bias, const int32_t *multiplier,
+                                   const int32_t *left_shift, const int32_t *right_shift, int32_t out_zp,
+                                   int32_t act_min, int32_t act_max, size_t per_channel, int c, int col_num) {
+  args->bias_ = LoadInt32Tail(bias + c, col_num);
+  if (per_channel) {
+    args->multiplier_ = LoadInt32Tail(multiplier + c, col_num);
+    args->left_shift_ = LoadInt32Tail(left_shift + c, col_num);
+    args->right_shift_ = LoadInt32Tail(right_shift + c, col_num);
+  } else {
+    args->multiplier_ = _mm256_set1_epi32(multiplier[0]);
+    args->left_shift_ = _mm256_set1_epi32(left_shift[0]);
+    args->right_shift_ = _mm256_set1_epi32(right_shift[0]);
+  }
+  args->out_zp_ = _mm256_set1_epi32(out_zp);
+  args->act_min_ = _mm256_set1_epi32(act_min);
+  args->act_max_ = _mm256_set1_epi32(act_max);
+}
+
+static inline void StoreInt8Tail(int8_t *dst, __m128i value, int num) {
+  if (num >= C8NUM) {
+    _mm_storel_epi64((__m128i *)dst, value);
+    return;
+  }
+  int8_t tmp[C16NUM];
+  _mm_storeu_si128((__m128i *)tmp, value);
+  memcpy(dst, tmp, num);
+}
+
+// sum the eight int32 lanes of each of a0..a3 into the four lanes of the result
+static inline __m128i ReduceAdd4(__m256i a0, __m256i a1, __m256i a2, __m256i a3) {
+  __m256i sum = _mm256_hadd_epi32(_mm256_hadd_epi32(a0, a1), _mm256_hadd_epi32(a2, a3));
+  return _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+}
+
+// requantize two rows of C4NUM columns held in the low and high halves of value
+static void PostRow2x4(int8_t *dst, __m256i value, const int32_t *a_sums, const int32_t *filter_zp, int r,
+                       int row_num, int col_num, size_t stride, size_t filter_peroc, const RequantArgs *args) {
+  int32_t sum0 = a_sums[r];
+  int32_t sum1 = row_num > 1 ? a_sums[r + 1] : 0;
+  __m256i input_sum;
+  if (filter_peroc) {
+    __m256i zp = DupLow128(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)filter_zp)));
+    input_sum = _mm256_mullo_epi32(_mm256_set_m128i(_mm_set1_epi32(sum1), _mm_set1_epi32(sum0)), zp);
+  } else {
+    input_sum = _mm256_set_m128i(_mm_set1_epi32(sum1), _mm_set1_epi32(sum0));
+  }
+  value = _mm256_add_epi32(_mm256_sub_epi32(value, input_sum), args->bias_);
+  __m128i res = RequantizeToInt8Avx(value, args->multiplier_, args->left_shift_, args->right_shift_, args->out_zp_,
+                                    args->act_min_, args->act_max_);
+  int8_t tmp[C16NUM];
+  _mm_storeu_si128((__m128i *)tmp, res);
+  int num = MSMIN(col_num, C4NUM);
+  memcpy(dst + r * stride, tmp, num);
+  if (row_num > 1) {
+    memcpy(dst + (r + 1) * stride, tmp + C4NUM, num);
+  }
+}
+
+/* row4x16-major * row16x4-major => (int8)row-major, same contract as MatmulInt8Opt */
+void MatmulInt8OptAvx2(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int *a_sums,
+                       const int *bias, int mini, int maxi, int out_zp, const int32_t *multiplier,
+                       const int32_t *left_shift, const int32_t *right_shift, size_t stride, size_t filter_peroc,
+                       const int32_t *filter_zp) {
+  int deep_block = deep16 / C16NUM;
+  for (int c = 0; c < col; c += C4NUM) {
+    int col_num = MSMIN(col - c, C4NUM);
+    const int8_t *b_col = b + c * deep16;
+    RequantArgs args;
+    InitRequantArgs(&args, bias, multiplier, left_shift, right_shift, out_zp, mini, maxi, filter_peroc, c, col_num);
+    args.bias_ = DupLow128(args.bias_);
+    args.multiplier_ = DupLow128(args.multiplier_);
+    args.left_shift_ = DupLow128(args.left_shift_);
+    args.right_shift_ = DupLow128(args.right_shift_);
+    int32_t zp_tmp[C4NUM] = {0};
+    if (filter_peroc) {
+      memcpy(zp_tmp, filter_zp + c, col_num * sizeof(int32_t));
+    }
+    for (int r = 0; r < row; r += C2NUM) {
+      // two rows of the same row4 block share one pass over deep
+      const int8_t *a_row = a + (r / C4NUM) * deep16 * C4NUM + (r % C4NUM) * C16NUM;
+      __m256i acc00 = _mm256_setzero_si256(), acc01 = _mm256_setzero_si256();
+      __m256i acc02 = _mm256_setzero_si256(), acc03 = _mm256_setzero_si256();
+      __m256i acc10 = _mm256_setzero_si256(), acc11 = _mm256_setzero_si256();
+      __m256i acc12 = _mm256_setzero_si256(), acc13 = _mm256_setzero_si256();
+      for (int d = 0; d < deep_block; ++d) {
+        const int8_t *a_ptr = a_row + d * C4NUM * C16NUM;
+        const int8_t *b_ptr = b_col + d * C4NUM * C16NUM;
+        __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)a_ptr));
+        __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a_ptr + C16NUM)));
+        __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)b_ptr));
+        __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C16NUM)));
+        acc00 = _mm256_add_epi32(acc00, _mm256_madd_epi16(a0, b0));
+        acc10 = _mm256_add_epi32(acc10, _mm256_madd_epi16(a1, b0));
+        acc01 = _mm256_add_epi32(acc01, _mm256_madd_epi16(a0, b1));
+        acc11 = _mm256_add_epi32(acc11, _mm256_madd_epi16(a1, b1));
+        __m256i b2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C2NUM * C16NUM)));
+        __m256i b3 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C3NUM * C16NUM)));
+        acc02 = _mm256_add_epi32(acc02, _mm256_madd_epi16(a0, b2));
+        acc12 = _mm256_add_epi32(acc12, _mm256_madd_epi16(a1, b2));
+        acc03 = _mm256_add_epi32(acc03, _mm256_madd_epi16(a0, b3));
+        acc13 = _mm256_add_epi32(acc13, _mm256_madd_epi16(a1, b3));
+      }
+      __m256i value =
+        _mm256_set_m128i(ReduceAdd4(acc10, acc11, acc12, acc13), ReduceAdd4(acc00, acc01, acc02, acc03));
+      PostRow2x4(dst + c, value, a_sums, zp_tmp, r, MSMIN(row - r, C2NUM), col_num, stride, filter_peroc, &args);
+    }
+  }
+}
+
+#ifdef ENABLE_AVX512_VNNI_DISPATCH
+/* vpdpbusd multiplies unsigned by signed bytes, so a is biased by 128 and 128 * sum(b) is subtracted again */
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512vnni"))) void MatmulInt8OptAvx512Vnni(
+  const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int *a_sums, const int *bias,
+  int mini, int maxi, int out_zp, const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+  size_t stride, size_t filter_peroc, const int32_t *filter_zp) {
+  int deep_block = deep16 / C16NUM;
+  const __m512i sign_bias = _mm512_set1_epi8((char)0x80);
+  for (int c = 0; c < col; c += C4NUM) {
+    int col_num = MSMIN(col - c, C4NUM);
+    const int8_t *b_col = b + c * deep16;
+    RequantArgs args;
+    InitRequantArgs(&args, bias, multiplier, left_shift, right_shift, out_zp, mini, maxi, filter_peroc, c, col_num);
+    args.bias_ = DupLow128(args.bias_);
+    args.multiplier_ = DupLow128(args.multiplier_);
+    args.left_shift_ = DupLow128(args.left_shift_);
+    args.right_shift_ = DupLow128(args.right_shift_);
+    int32_t zp_tmp[C4NUM] = {0};
+    if (filter_peroc) {
+      memcpy(zp_tmp, filter_zp + c, col_num * sizeof(int32_t));
+    }
+    __m512i b_bias = _mm512_setzero_si512();
+    for (int d = 0; d < deep_block; ++d) {
+      b_bias = _mm512_dpbusd_epi32(b_bias, sign_bias, _mm512_loadu_si512(b_col + d * C4NUM * C16NUM));
+    }
+    for (int r = 0; r < row; r += C2NUM) {
+      const int8_t *a_row = a + (r / C4NUM) * deep16 * C4NUM + (r % C4NUM) * C16NUM;
+      __m512i acc0 = _mm512_setzero_si512();
+      __m512i acc1 = _mm512_setzero_si512();
+      for (int d = 0; d < deep_block; ++d) {
+        const int8_t *a_ptr = a_row + d * C4NUM * C16NUM;
+        __m512i b_blk = _mm512_loadu_si512(b_col + d * C4NUM * C16NUM);
+        __m512i a0 = _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)a_ptr)), sign_bias);
+        __m512i a1 =
+          _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_ptr + C16NUM))), sign_bias);
+        acc0 = _mm512_dpbusd_epi32(acc0, a0, b_blk);
+        acc1 = _mm512_dpbusd_epi32(acc1, a1, b_blk);
+      }
+      acc0 = _mm512_sub_epi32(acc0, b_bias);
+      acc1 = _mm512_sub_epi32(acc1, b_bias);
+      // each 128 bit lane of accX holds the four partial sums of one column
+      __m256i sum = _mm256_hadd_epi32(
+        _mm256_hadd_epi32(_mm512_castsi512_si256(acc0), _mm512_extracti64x4_epi64(acc0, 1)),
+        _mm256_hadd_epi32(_mm512_castsi512_si256(acc1), _mm512_extracti64x4_epi64(acc1, 1)));
+      // sum = [r0c0 r0c2 r1c0 r1c2 | r0c1 r0c3 r1c1 r1c3]
+      __m256i value = _mm256_permutevar8x32_epi32(sum, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+      PostRow2x4(dst + c, value, a_sums, zp_tmp, r, MSMIN(row - r, C2NUM), col_num, stride, filter_peroc, &args);
+    }
+  }
+}
+#endif
+
+void MatmulInt8OptAvx(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int *a_sums,
+                      const int *bias, int mini, int maxi, int out_zp, const int32_t *multiplier,
+                      const int32_t *left_shift, const int32_t *right_shift, size_t stride, size_t filter_peroc,
+                      const int32_t *filter_zp) {
+#ifdef ENABLE_AVX512_VNNI_DISPATCH
+  if (__builtin_cpu_supports("avx512vnni")) {
+    MatmulInt8OptAvx512Vnni(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                            right_shift, stride, filter_peroc, filter_zp);
+    return;
+  }
+#endif
+  MatmulInt8OptAvx2(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                    right_shift, stride, filter_peroc, filter_zp);
+}
+
+/* row8x4-major * row4x8-major => (int8)row-major, same contract as MatMulInt8_8x8_r */
+void MatMulInt8_8x8_rAvx(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                         size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                         const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                         int32_t maxi, size_t per_channel) {
+  int deep_block = (int)deep_4 / C4NUM;
+  size_t row8 = UP_ROUND(row, C8NUM);
+  for (int c = 0; c < (int)col; c += C8NUM) {
+    int col_num = MSMIN((int)col - c, C8NUM);
+    const int8_t *b_col = b + c * deep_4;
+    RequantArgs args;
+    InitRequantArgs(&args, bias, multiplier, left_shift, right_shift, output_zp, mini, maxi, per_channel, c,
+                    col_num);
+    for (int r = 0; r < (int)row; r += C4NUM) {
+      // four rows of the same row8 block share one pass over deep
+      const int8_t *a_row = a + (r / C8NUM) * deep_4 * C8NUM + (r % C8NUM) * C4NUM;
+      __m256i acc[C4NUM][C2NUM];
+      for (int i = 0; i < C4NUM; ++i) {
+        acc[i][0] = _mm256_setzero_si256();
+        acc[i][1] = _mm256_setzero_si256();
+      }
+      for (int d = 0; d < deep_block; ++d) {
+        const int8_t *a_ptr = a_row + d * C8NUM * C4NUM;
+        const int8_t *b_ptr = b_col + d * C8NUM * C4NUM;
+        __m256i b_lo = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)b_ptr));
+        __m256i b_hi = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C16NUM)));
+        for (int i = 0; i < C4NUM; ++i) {
+          int32_t a_word;
+          memcpy(&a_word, a_ptr + i * C4NUM, sizeof(int32_t));
+          __m256i a_val = _mm256_cvtepi8_epi16(_mm_set1_epi32(a_word));
+          acc[i][0] = _mm256_add_epi32(acc[i][0], _mm256_madd_epi16(a_val, b_lo));
+          acc[i][1] = _mm256_add_epi32(acc[i][1], _mm256_madd_epi16(a_val, b_hi));
+        }
+      }
+      int row_num = MSMIN((int)row - r, C4NUM);
+      for (int i = 0; i < row_num; ++i) {
+        // hadd yields [c0 c1 c4 c5 | c2 c3 c6 c7]
+        __m256i value = _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc[i][0], acc[i][1]), 0xD8);
+        __m256i cur_input_sum =
+          per_channel ? LoadInt32Tail(input_sum + (c / C8NUM) * row8 * C8NUM + (r + i) * C8NUM, C8NUM)
+                      : _mm256_set1_epi32(input_sum[r + i]);
+        value = _mm256_add_epi32(_mm256_sub_epi32(value, cur_input_sum), args.bias_);
+        __m128i res = RequantizeToInt8Avx(value, args.multiplier_, args.left_shift_, args.right_shift_, args.out_zp_,
+                                          args.act_min_, args.act_max_);
+        StoreInt8Tail(dst + (r + i) * stride + c, res, col_num);
+      }
+    }
+  }
+}
+#endif
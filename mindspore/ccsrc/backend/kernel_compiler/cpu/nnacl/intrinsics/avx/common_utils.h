@@ -21,6 +21,7 @@
 #else
 #include <x86intrin.h>
 #endif
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +43,43 @@ __m128i _mm_rshr_epi32(__m128i a, int shift);
 
 // Signed saturating Rounding Doubling Multiply return High half
 __m128i _mm_qrdmulh_epi32(__m128i a, __m128i b);
+
+// Lane-wise MultiplyByQuantizedMultiplier, bit exact with the scalar version in nnacl/int8/fixed_point.c.
+// right_shift holds the non-positive shifts as stored in the quant args.
+static inline __m256i MultiplyByQuantizedMultiplierAvx(__m256i value, __m256i multiplier, __m256i left_shift,
+                                                       __m256i right_shift) {
+  const __m256i int_min = _mm256_set1_epi32(INT32_MIN);
+  const __m256i rounding = _mm256_set1_epi64x(1ll << 30);
+  value = _mm256_sllv_epi32(value, left_shift);
+
+  // SaturatingRoundingDoublingHighMul: (a * b + 2^30) >> 31 on the 64 bit products of even and odd lanes
+  __m256i even = _mm256_mul_epi32(value, multiplier);
+  __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(value, 32), _mm256_srli_epi64(multiplier, 32));
+  even = _mm256_srli_epi64(_mm256_add_epi64(even, rounding), 31);
+  odd = _mm256_slli_epi64(_mm256_add_epi64(odd, rounding), 1);
+  __m256i high_mul = _mm256_blend_epi32(even, odd, 0xAA);
+  const __m256i overflow =
+    _mm256_and_si256(_mm256_cmpeq_epi32(value, int_min), _mm256_cmpeq_epi32(multiplier, int_min));
+  high_mul = _mm256_blendv_epi8(high_mul, _mm256_set1_epi32(INT32_MAX), overflow);
+
+  // RoundingDivideByPOT
+  const __m256i exponent = _mm256_sub_epi32(_mm256_setzero_si256(), right_shift);
+  const __m256i mask = _mm256_sub_epi32(_mm256_sllv_epi32(_mm256_set1_epi32(1), exponent), _mm256_set1_epi32(1));
+  const __m256i remainder = _mm256_and_si256(high_mul, mask);
+  const __m256i threshold =
+    _mm256_sub_epi32(_mm256_srli_epi32(mask, 1), _mm256_cmpgt_epi32(_mm256_setzero_si256(), high_mul));
+  return _mm256_sub_epi32(_mm256_srav_epi32(high_mul, exponent), _mm256_cmpgt_epi32(remainder, threshold));
+}
+
+// requantize eight int32 accumulators and narrow them to int8, the result is in the low 64 bits
+static inline __m128i RequantizeToInt8Avx(__m256i value, __m256i multiplier, __m256i left_shift, __m256i right_shift,
+                                          __m256i out_zp, __m256i act_min, __m256i act_max) {
+  value = MultiplyByQuantizedMultiplierAvx(value, multiplier, left_shift, right_shift);
+  value = _mm256_add_epi32(value, out_zp);
+  value = _mm256_min_epi32(_mm256_max_epi32(value, act_min), act_max);
+  __m128i res16 = _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+  return _mm_packs_epi16(res16, res16);
+}
 #ifdef __cplusplus
 }
 #endif
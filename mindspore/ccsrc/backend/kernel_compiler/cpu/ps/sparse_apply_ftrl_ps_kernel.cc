@@ -68,7 +68,6 @@ void SparseApplyFtrlPSKernel::InitKernel(
   }
   workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
   workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
-  workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
   workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
 }
 
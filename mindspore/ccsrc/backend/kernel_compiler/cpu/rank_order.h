@@ -0,0 +1,43 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RANK_ORDER_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RANK_ORDER_H_
+
+namespace mindspore {
+namespace kernel {
+// Whether value_1 is greater than value_2 when NaN is greater than every number and equal to itself, the raw
+// comparison is no strict weak order with NaN and breaks std::sort, nth_element and the heap algorithms.
+template <typename T>
+bool RankGreater(const T &value_1, const T &value_2) {
+  bool nan_1 = value_1 != value_1;
+  bool nan_2 = value_2 != value_2;
+  if (nan_1 || nan_2) {
+    return nan_1 && !nan_2;
+  }
+  return value_1 > value_2;
+}
+
+// Whether the element (value_1, index_1) ranks before (value_2, index_2) in a descending or an ascending order by
+// RankGreater, the lower index first among equal values, which is the order of a stable sort.
+template <typename T>
+bool RankBefore(const T &value_1, int index_1, const T &value_2, int index_2, bool descending = true) {
+  bool before = descending ? RankGreater(value_1, value_2) : RankGreater(value_2, value_1);
+  bool after = descending ? RankGreater(value_2, value_1) : RankGreater(value_1, value_2);
+  return before || (!after && index_1 < index_2);
+}
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RANK_ORDER_H_
@@ -18,13 +18,9 @@
 #include <string>
 #include <vector>
 #include <algorithm>
-#include <utility>
-#include "nnacl/fp32/reduce_fp32.h"
 
 namespace mindspore {
 namespace kernel {
-constexpr size_t kReduceSmallVectorSize = 200000;
-
 template <typename T>
 void ReduceCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
@@ -45,157 +41,64 @@ void ReduceCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   // Delete the duplicate axis.
   auto last = std::unique(axis_.begin(), axis_.end());
   axis_.erase(last, axis_.end());
+  // No axis reduces all of them.
+  if (axis_.empty()) {
+    for (int i = 0; i < dimension; ++i) {
+      axis_.emplace_back(i);
+    }
+  }
   auto kernel_name = AnfAlgo::GetCNodeName(kernel_node);
 
+  ReduceOpType op_type = ReduceOpType::kSum;
   if constexpr (std::is_same<T, bool>::value) {
     if (kernel_name == "ReduceAll") {
-      reduce_type_ = kReduceAll;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out &= input[pos]; };
+      op_type = ReduceOpType::kAll;
     } else if (kernel_name == "ReduceAny") {
-      reduce_type_ = kReduceAny;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out |= input[pos]; };
+      op_type = ReduceOpType::kAny;
     } else {
       MS_LOG(EXCEPTION) << "Unsupported reduce operation: " << fullname_ << " for bool.";
     }
   } else {
     if (kernel_name == "ReduceMax") {
-      reduce_type_ = kReduceMax;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out = std::max(input[pos], *out); };
+      op_type = ReduceOpType::kMax;
     } else if (kernel_name == "ReduceMin") {
-      reduce_type_ = kReduceMin;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out = std::min(input[pos], *out); };
+      op_type = ReduceOpType::kMin;
     } else if (kernel_name == "ReduceSum") {
-      reduce_type_ = kReduceSum;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out += input[pos]; };
+      op_type = ReduceOpType::kSum;
     } else if (kernel_name == "ReduceMean") {
-      reduce_type_ = kReduceMean;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out += input[pos]; };
+      op_type = ReduceOpType::kMean;
     } else {
       MS_LOG(EXCEPTION) << "Unsupported reduce operation:  " << kernel_name;
     }
   }
+  engine_.Init(input_shape_, axis_, op_type);
+}
 
-  // special accelerate for axis = 1 and input has 2 dims
-  if constexpr (std::is_same<T, float>::value) {
-    if ((reduce_type_ == kReduceMean || reduce_type_ == kReduceSum) && axis_.size() == 1 && axis_[0] == 1 &&
-        input_shape_.size() == 2) {
-      simple_execute_ = true;
-    }
+template <typename T>
+void ReduceCPUKernel<T>::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  if (engine_.GetWorkspaceSize() > 0) {
+    workspace_size_list_.emplace_back(engine_.GetWorkspaceSize());
   }
 }
 
 template <typename T>
-bool ReduceCPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+bool ReduceCPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> &workspace,
                                 const std::vector<kernel::AddressPtr> &outputs) {
   size_t input_size = inputs[0]->size / sizeof(T);
   if (input_size == 0) {
     MS_LOG(EXCEPTION) << "Input data size is 0.";
   }
+  if (engine_.GetWorkspaceSize() > 0 && (workspace.empty() || workspace[0]->size < engine_.GetWorkspaceSize())) {
+    MS_LOG(EXCEPTION) << "Reduce needs a workspace of " << engine_.GetWorkspaceSize() << " bytes.";
+  }
 
   auto input_addr = reinterpret_cast<T *>(inputs[0]->addr);
   auto output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  if (axis_.empty() || input_shape_.empty() || input_shape_.size() == 1) {
-    if (input_size < kReduceSmallVectorSize) {
-      // Get one ret
-      *output_addr = input_addr[0];
-      for (size_t i = 1; i < input_size; ++i) {
-        reduce_func_(input_addr, i, output_addr);
-      }
-      if (reduce_type_ == kReduceMean) {
-        *output_addr /= input_size;
-      }
-    } else {
-      AccelerateLongVector(input_addr, output_addr, input_size);
-    }
-  } else {
-    // Calculate transpose axes and stride
-    int dimension = input_shape_.size();
-    size_t stride = 1;
-    std::vector<size_t> axes(input_shape_.size());
-    size_t j = 0;
-    size_t k = 0;
-    for (int i = 0; i < dimension; ++i) {
-      if (j == axis_.size() || i != axis_[j]) {
-        axes[k] = i;
-        ++k;
-      } else {
-        stride *= input_shape_[i];
-        ++j;
-      }
-    }
-    for (auto &it : axis_) {
-      axes[k] = it;
-      ++k;
-    }
-
-    size_t output_size = outputs[0]->size / sizeof(T);
-    if constexpr (std::is_same<T, float>::value) {
-      if (simple_execute_) {
-        auto task = [&](size_t start, size_t end) {
-          for (size_t i = start; i < end; ++i) {
-            ReduceSumDim2Axis1(stride, input_addr + i * stride, output_addr + i);
-            if (reduce_type_ == kReduceMean) {
-              output_addr[i] /= stride;
-            }
-          }
-        };
-        ParallelLaunchAutoSearch(task, output_size, this, &parallel_search_info_);
-        return true;
-      }
-    }
-    // Calculate transpose shape
-    std::vector<size_t> transpose_shape(input_shape_.size());
-    for (int i = 0; i < dimension; ++i) {
-      transpose_shape[i] = input_shape_[axes[i]];
-    }
-    TransposeIterator base_iter(std::move(transpose_shape), std::move(axes), input_shape_);
-    auto task = [this, &base_iter, input_addr, output_addr, stride](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start * stride);
-      for (size_t i = start; i < end; ++i) {
-        output_addr[i] = input_addr[iter.GetPos()];
-        iter.GenNextPos();
-        for (size_t j = 1; j < stride; ++j) {
-          reduce_func_(input_addr, iter.GetPos(), &output_addr[i]);
-          iter.GenNextPos();
-        }
-        if (reduce_type_ == kReduceMean) {
-          output_addr[i] /= stride;
-        }
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size);
-  }
+  auto workspace_addr = workspace.empty() ? nullptr : reinterpret_cast<T *>(workspace[0]->addr);
+  engine_.Execute(input_addr, output_addr, workspace_addr);
   return true;
 }
-
-template <typename T>
-void ReduceCPUKernel<T>::AccelerateLongVector(T *input_addr, T *output_addr, size_t input_size) {
-  // init output_addr
-  *output_addr = input_addr[0];
-  std::mutex task_mutex;
-  auto task = [this, input_addr, output_addr, &task_mutex](size_t start, size_t end) {
-    if (start == 0) {
-      ++start;
-    }
-    if (start == end) {
-      return;
-    }
-    auto block_output = input_addr[start];
-    size_t i = start + 1;
-    while (i < end) {
-      reduce_func_(input_addr, i, &block_output);
-      ++i;
-    }
-    {
-      std::lock_guard<std::mutex> task_lock(task_mutex);
-      reduce_func_(&block_output, 0, output_addr);
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, input_size);
-  if (reduce_type_ == kReduceMean) {
-    *output_addr /= input_size;
-  }
-}
 }  // namespace kernel
 }  // namespace mindspore
@@ -18,9 +18,9 @@
 #include <vector>
 #include <memory>
 #include <string>
-#include <functional>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/reduce_engine.h"
 
 namespace mindspore {
 namespace kernel {
@@ -33,15 +33,13 @@ class ReduceCPUKernel : public CPUKernel {
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
 
- private:
-  void AccelerateLongVector(T *input_addr, T *output_addr, size_t input_size);
+ protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
 
-  enum ReduceType { kReduceAll, kReduceAny, kReduceMax, kReduceMin, kReduceSum, kReduceMean };
+ private:
   std::vector<size_t> input_shape_;
   std::vector<int64_t> axis_;
-  ReduceType reduce_type_{kReduceAll};
-  std::function<void(const T *, size_t, T *)> reduce_func_;
-  bool simple_execute_{false};
+  ReduceEngine<T> engine_;
 };
 
 MS_REG_CPU_KERNEL_T(ReduceMean, KernelAttr(), ReduceCPUKernel, float);
@@ -0,0 +1,294 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/reduce_engine.h"
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Elements of an inner row that one task accumulates, small enough to stay in the L1 cache.
+constexpr size_t kReduceInnerBlock = 1024;
+// Elements a task reads at least before the work is given to another thread.
+constexpr size_t kReduceParallelBlock = 16384;
+// Independent accumulators of a contiguous row, they break the dependency chain of the loop.
+constexpr size_t kReduceRowAccumulatorNum = 8;
+
+struct SumOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct MaxOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a < b ? b : a;
+  }
+};
+
+struct MinOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return b < a ? b : a;
+  }
+};
+
+struct AndOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a && b;
+  }
+};
+
+struct OrOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a || b;
+  }
+};
+
+template <typename Op, typename T>
+T ReduceRow(const T *row, size_t size) {
+  if (size < kReduceRowAccumulatorNum) {
+    T result = row[0];
+    for (size_t i = 1; i < size; ++i) {
+      result = Op::Apply(result, row[i]);
+    }
+    return result;
+  }
+  T acc[kReduceRowAccumulatorNum];
+  for (size_t j = 0; j < kReduceRowAccumulatorNum; ++j) {
+    acc[j] = row[j];
+  }
+  size_t i = kReduceRowAccumulatorNum;
+  for (; i + kReduceRowAccumulatorNum <= size; i += kReduceRowAccumulatorNum) {
+    for (size_t j = 0; j < kReduceRowAccumulatorNum; ++j) {
+      acc[j] = Op::Apply(acc[j], row[i + j]);
+    }
+  }
+  for (; i < size; ++i) {
+    acc[0] = Op::Apply(acc[0], row[i]);
+  }
+  for (size_t width = kReduceRowAccumulatorNum / 2; width > 0; width /= 2) {
+    for (size_t j = 0; j < width; ++j) {
+      acc[j] = Op::Apply(acc[j], acc[j + width]);
+    }
+  }
+  return acc[0];
+}
+}  // namespace
+
+template <typename T>
+void ReduceEngine<T>::Init(const std::vector<size_t> &shape, const std::vector<int64_t> &axes, ReduceOpType op_type) {
+  bool bool_op = op_type == ReduceOpType::kAll || op_type == ReduceOpType::kAny;
+  if (bool_op != std::is_same<T, bool>::value) {
+    MS_LOG(EXCEPTION) << "Reduce operation " << static_cast<int>(op_type) << " does not support the data type.";
+  }
+  op_type_ = op_type;
+  passes_.clear();
+  input_size_ = 1;
+  reduce_count_ = 1;
+  buffer_size_[0] = 0;
+  buffer_size_[1] = 0;
+  partial_size_ = 0;
+  thread_num_ = std::max(1U, std::thread::hardware_concurrency());
+
+  // Blocks of adjacent axes that are all reduced or all kept, the axes of size 1 are left out.
+  std::vector<size_t> block_sizes;
+  std::vector<bool> block_reduced;
+  size_t axis_index = 0;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    bool reduced = axis_index < axes.size() && axes[axis_index] == SizeToLong(i);
+    if (reduced) {
+      ++axis_index;
+      reduce_count_ *= shape[i];
+    }
+    input_size_ *= shape[i];
+    if (shape[i] == 1) {
+      continue;
+    }
+    if (!block_sizes.empty() && block_reduced.back() == reduced) {
+      block_sizes.back() *= shape[i];
+    } else {
+      block_sizes.emplace_back(shape[i]);
+      block_reduced.emplace_back(reduced);
+    }
+  }
+  if (axis_index != axes.size()) {
+    MS_LOG(EXCEPTION) << "The reduce axes should be sorted, unique and less than the rank " << shape.size();
+  }
+
+  // The kept blocks inside a reduced block are the inner rows of its pass.
+  size_t inner = 1;
+  for (size_t i = block_sizes.size(); i > 0; --i) {
+    if (!block_reduced[i - 1]) {
+      inner *= block_sizes[i - 1];
+      continue;
+    }
+    size_t outer = 1;
+    for (size_t j = 0; j + 1 < i; ++j) {
+      outer *= block_sizes[j];
+    }
+    ReducePass pass;
+    pass.outer = outer;
+    pass.reduce = block_sizes[i - 1];
+    pass.inner = inner;
+    pass.split_rows = pass.reduce;
+    PlanSplit(&pass);
+    passes_.emplace_back(pass);
+  }
+  for (size_t i = 0; i < passes_.size(); ++i) {
+    const auto &pass = passes_[i];
+    if (i + 1 < passes_.size()) {
+      buffer_size_[i % 2] = std::max(buffer_size_[i % 2], pass.outer * pass.inner);
+    }
+    if (pass.split > 1) {
+      partial_size_ = std::max(partial_size_, pass.split * pass.outer * pass.inner);
+    }
+  }
+}
+
+template <typename T>
+void ReduceEngine<T>::PlanSplit(ReducePass *pass) const {
+  size_t inner_block = std::min(pass->inner, kReduceInnerBlock);
+  size_t unit_num = pass->outer * ((pass->inner + kReduceInnerBlock - 1) / kReduceInnerBlock);
+  if (unit_num >= thread_num_) {
+    return;
+  }
+  size_t min_rows = std::max<size_t>(2, kReduceParallelBlock / inner_block);
+  size_t split = std::min((thread_num_ + unit_num - 1) / unit_num, pass->reduce / min_rows);
+  if (split < 2) {
+    return;
+  }
+  pass->split_rows = (pass->reduce + split - 1) / split;
+  pass->split = (pass->reduce + pass->split_rows - 1) / pass->split_rows;
+}
+
+template <typename T>
+template <typename Op>
+void ReduceEngine<T>::ReduceBlock(const ReducePass &pass, const T *src, T *dst, size_t row_begin, size_t row_end,
+                                  size_t inner_begin, size_t inner_end) const {
+  if (pass.inner == 1) {
+    dst[0] = ReduceRow<Op>(src + row_begin, row_end - row_begin);
+    return;
+  }
+  size_t size = inner_end - inner_begin;
+  T *out = dst + inner_begin;
+  const T *in = src + row_begin * pass.inner + inner_begin;
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = in[i];
+  }
+  for (size_t row = row_begin + 1; row < row_end; ++row) {
+    in += pass.inner;
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = Op::Apply(out[i], in[i]);
+    }
+  }
+}
+
+template <typename T>
+template <typename Op>
+void ReduceEngine<T>::RunPass(const ReducePass &pass, const T *src, T *dst, T *partial, bool divide) const {
+  size_t inner_blocks = (pass.inner + kReduceInnerBlock - 1) / kReduceInnerBlock;
+  size_t outer_units = pass.outer * inner_blocks;
+  T *out = pass.split > 1 ? partial : dst;
+  bool divide_out = divide && pass.split == 1;
+  auto task = [this, &pass, src, out, inner_blocks, outer_units, divide_out](size_t start, size_t end) {
+    for (size_t unit = start; unit < end; ++unit) {
+      size_t slice = unit / outer_units;
+      size_t outer = unit % outer_units / inner_blocks;
+      size_t inner_begin = unit % inner_blocks * kReduceInnerBlock;
+      size_t inner_end = std::min(pass.inner, inner_begin + kReduceInnerBlock);
+      size_t row_begin = slice * pass.split_rows;
+      size_t row_end = std::min(pass.reduce, row_begin + pass.split_rows);
+      T *out_row = out + (slice * pass.outer + outer) * pass.inner;
+      ReduceBlock<Op>(pass, src + outer * pass.reduce * pass.inner, out_row, row_begin, row_end, inner_begin,
+                      inner_end);
+      if (divide_out) {
+        auto count = static_cast<T>(reduce_count_);
+        for (size_t i = inner_begin; i < inner_end; ++i) {
+          out_row[i] = out_row[i] / count;
+        }
+      }
+    }
+  };
+  size_t unit_size = pass.split_rows * std::min(pass.inner, kReduceInnerBlock);
+  float block_size = std::max(1.0f, static_cast<float>(kReduceParallelBlock) / unit_size);
+  ParallelLaunch(task, pass.split * outer_units, block_size);
+  if (pass.split > 1) {
+    // Combine the partial results of the slices, they lie as (split, outer * inner).
+    ReducePass combine;
+    combine.reduce = pass.split;
+    combine.inner = pass.outer * pass.inner;
+    combine.split_rows = combine.reduce;
+    RunPass<Op>(combine, partial, dst, nullptr, divide);
+  }
+}
+
+template <typename T>
+template <typename Op>
+void ReduceEngine<T>::ExecuteWithOp(const T *input, T *output, T *workspace) const {
+  if (passes_.empty()) {
+    (void)std::copy(input, input + input_size_, output);
+    return;
+  }
+  T *buffers[2] = {workspace, workspace + buffer_size_[0]};
+  T *partial = workspace + buffer_size_[0] + buffer_size_[1];
+  bool mean = op_type_ == ReduceOpType::kMean;
+  const T *src = input;
+  for (size_t i = 0; i < passes_.size(); ++i) {
+    bool last = i + 1 == passes_.size();
+    T *dst = last ? output : buffers[i % 2];
+    RunPass<Op>(passes_[i], src, dst, partial, last && mean);
+    src = dst;
+  }
+}
+
+template <typename T>
+void ReduceEngine<T>::Execute(const T *input, T *output, T *workspace) const {
+  if (workspace == nullptr && GetWorkspaceSize() > 0) {
+    MS_LOG(EXCEPTION) << "Reduce needs a workspace of " << GetWorkspaceSize() << " bytes.";
+  }
+  if constexpr (std::is_same<T, bool>::value) {
+    if (op_type_ == ReduceOpType::kAll) {
+      ExecuteWithOp<AndOp>(input, output, workspace);
+    } else {
+      ExecuteWithOp<OrOp>(input, output, workspace);
+    }
+  } else {
+    if (op_type_ == ReduceOpType::kMax) {
+      ExecuteWithOp<MaxOp>(input, output, workspace);
+    } else if (op_type_ == ReduceOpType::kMin) {
+      ExecuteWithOp<MinOp>(input, output, workspace);
+    } else {
+      ExecuteWithOp<SumOp>(input, output, workspace);
+    }
+  }
+}
+
+template class ReduceEngine<bool>;
+template class ReduceEngine<int32_t>;
+template class ReduceEngine<int64_t>;
+template class ReduceEngine<float>;
+template class ReduceEngine<double>;
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_ENGINE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+enum class ReduceOpType { kSum, kMean, kMax, kMin, kAll, kAny };
+
+// Reduction of a dense tensor over an arbitrary set of axes. Init drops the axes of size 1 and merges the adjacent
+// axes that are all reduced or all kept, then plans one (outer, reduce, inner) pass per reduced block, innermost
+// block first. A pass with inner 1 reduces contiguous rows, other passes accumulate whole inner rows elementwise so
+// the loops run over contiguous memory. Passes with too little outer and inner work for the threads split the
+// reduce extent and combine the partial results in a second pass.
+template <typename T>
+class ReduceEngine {
+ public:
+  ReduceEngine() = default;
+  ~ReduceEngine() = default;
+
+  // The axes are in [0, shape.size()), sorted and unique.
+  void Init(const std::vector<size_t> &shape, const std::vector<int64_t> &axes, ReduceOpType op_type);
+  // Bytes of the intermediate results and partial results that Execute needs.
+  size_t GetWorkspaceSize() const { return (buffer_size_[0] + buffer_size_[1] + partial_size_) * sizeof(T); }
+  void Execute(const T *input, T *output, T *workspace) const;
+
+ private:
+  struct ReducePass {
+    size_t outer{1};
+    size_t reduce{1};
+    size_t inner{1};
+    // Number of slices of the reduce extent run in parallel, and the rows of each slice.
+    size_t split{1};
+    size_t split_rows{1};
+  };
+
+  template <typename Op>
+  void ExecuteWithOp(const T *input, T *output, T *workspace) const;
+  // Partial takes the results of the slices when the pass splits its reduce extent. With divide the results are
+  // turned into means.
+  template <typename Op>
+  void RunPass(const ReducePass &pass, const T *src, T *dst, T *partial, bool divide) const;
+  template <typename Op>
+  void ReduceBlock(const ReducePass &pass, const T *src, T *dst, size_t row_begin, size_t row_end, size_t inner_begin,
+                   size_t inner_end) const;
+  void PlanSplit(ReducePass *pass) const;
+
+  ReduceOpType op_type_{ReduceOpType::kSum};
+  std::vector<ReducePass> passes_;
+  size_t input_size_{1};
+  size_t reduce_count_{1};
+  size_t buffer_size_[2]{0, 0};
+  size_t partial_size_{0};
+  size_t thread_num_{1};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_ENGINE_H_
@@ -14,11 +14,17 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/sort_cpu_kernel.h"
+#include <algorithm>
+#include <thread>
 #include <vector>
-#include "common/thread_pool.h"
+#include "backend/kernel_compiler/cpu/rank_order.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Rows up to this length are sorted by insertion, which is cheaper than std::sort for them.
+constexpr size_t kInsertionSortMaxSize = 16;
+}  // namespace
 
 template <typename T>
 void SortCpuKernel<T>::InitKernel(const CNodePtr &kernel_node) {
@@ -60,6 +66,43 @@ void SortCpuKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   }
 }
 
+template <typename T>
+void SortCpuKernel<T>::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  size_t row_num = outer_size_ * inner_size_;
+  size_t max_thread_num = std::max(1U, std::thread::hardware_concurrency());
+  task_num_ = std::max<size_t>(1, std::min(row_num, max_thread_num));
+  workspace_size_list_.emplace_back(task_num_ * axis_size_ * sizeof(SortElement));
+}
+
+template <typename T>
+void SortCpuKernel<T>::SortRow(const T *input, SortElement *scratch, T *output, int *indices) const {
+  // Gather the strided row, ties keep the index order as a stable sort does and NaN sorts as the greatest value.
+  for (size_t k = 0; k < axis_size_; ++k) {
+    scratch[k] = {input[k * inner_size_], SizeToInt(k)};
+  }
+  bool descending = descending_;
+  auto comp = [descending](const SortElement &a, const SortElement &b) {
+    return RankBefore(a.value, a.index, b.value, b.index, descending);
+  };
+  if (axis_size_ <= kInsertionSortMaxSize) {
+    for (size_t k = 1; k < axis_size_; ++k) {
+      auto element = scratch[k];
+      size_t pos = k;
+      for (; pos > 0 && comp(element, scratch[pos - 1]); --pos) {
+        scratch[pos] = scratch[pos - 1];
+      }
+      scratch[pos] = element;
+    }
+  } else {
+    std::sort(scratch, scratch + axis_size_, comp);
+  }
+  for (size_t k = 0; k < axis_size_; ++k) {
+    output[k * inner_size_] = scratch[k].value;
+    indices[k * inner_size_] = scratch[k].index;
+  }
+}
+
 template <typename T>
 bool SortCpuKernel<T>::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
                               const std::vector<AddressPtr> &outputs) {
@@ -70,47 +113,31 @@ bool SortCpuKernel<T>::Launch(const std::vector<AddressPtr> &inputs, const std::
   if (inputs[0]->size != outer_size_ * axis_size_ * inner_size_ * sizeof(T)) {
     MS_LOG(EXCEPTION) << "Error input data size!";
   }
+  if (workspace.empty() || workspace[0]->size < task_num_ * axis_size_ * sizeof(SortElement)) {
+    MS_LOG(EXCEPTION) << "Error workspace size!";
+  }
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
   auto indices = reinterpret_cast<int *>(outputs[1]->addr);
+  auto scratch = reinterpret_cast<SortElement *>(workspace[0]->addr);
 
   if (outputs[0]->size != inputs[0]->size) {
     MS_LOG(EXCEPTION) << "Error output data size!";
   }
 
-  std::function<bool(size_t, size_t)> comparator;
-  if (descending_) {
-    comparator = [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; };
-  } else {
-    comparator = [&input](size_t index_1, size_t index_2) { return input[index_1] < input[index_2]; };
-  }
-
-  std::vector<common::Task> tasks;
-  tasks.reserve(outer_size_ * inner_size_);
-  for (size_t i = 0; i < outer_size_; ++i) {
-    const auto out_offset = i * axis_size_ * inner_size_;
-    for (size_t j = 0; j < inner_size_; ++j) {
-      const auto axis_offset = out_offset + j;
-      auto task = [this, axis_offset, &input, &indices, &output, &comparator]() {
-        std::vector<size_t> idx(axis_size_);
-        // fill idx starts with out_offset + j, step inner_size_
-        for (size_t k = 0; k < axis_size_; ++k) {
-          idx[k] = axis_offset + k * inner_size_;
-        }
-
-        std::stable_sort(idx.begin(), idx.end(), comparator);
-
-        for (size_t k = 0; k < axis_size_; ++k) {
-          const auto index = axis_offset + k * inner_size_;
-          indices[index] = (SizeToInt(idx[k]) - SizeToInt(axis_offset)) / inner_size_;
-          output[index] = input[idx[k]];
-        }
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
+  size_t row_num = outer_size_ * inner_size_;
+  size_t rows_per_task = (row_num + task_num_ - 1) / task_num_;
+  auto task = [&](size_t start, size_t end) {
+    for (size_t task_id = start; task_id < end; ++task_id) {
+      size_t row_end = std::min(row_num, (task_id + 1) * rows_per_task);
+      for (size_t row = task_id * rows_per_task; row < row_end; ++row) {
+        // Row (i, j) starts at i * axis_size_ * inner_size_ + j and steps by inner_size_.
+        size_t offset = row / inner_size_ * axis_size_ * inner_size_ + row % inner_size_;
+        SortRow(input + offset, scratch + task_id * axis_size_, output + offset, indices + offset);
+      }
     }
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  };
+  ParallelLaunch(task, task_num_, 1);
   return true;
 }
 }  // namespace kernel
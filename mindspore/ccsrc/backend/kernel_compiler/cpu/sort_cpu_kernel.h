@@ -33,11 +33,24 @@ class SortCpuKernel : public CPUKernel {
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
 
+ protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
+
  private:
+  struct SortElement {
+    T value;
+    int index;
+  };
+
+  void SortRow(const T *input, SortElement *scratch, T *output, int *indices) const;
+
   size_t inner_size_{1};
   size_t outer_size_{1};
   size_t axis_size_{1};
   bool descending_{false};
+  // The rows along the axis are split into task_num_ tasks, each of them sorts in its own axis_size_ elements of the
+  // workspace.
+  size_t task_num_{1};
 };
 
 MS_REG_CPU_KERNEL_T(
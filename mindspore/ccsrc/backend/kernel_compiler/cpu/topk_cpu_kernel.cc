@@ -15,12 +15,76 @@
  */
 
 #include "backend/kernel_compiler/cpu/topk_cpu_kernel.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include "backend/kernel_compiler/cpu/rank_order.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Rows that keep no more than kHeapMaxK elements, and at most 1 / kHeapMinRatio of the row, are selected with a heap
+// of the kept elements, the others with nth_element over an index array.
+constexpr size_t kHeapMaxK = 128;
+constexpr size_t kHeapMinRatio = 8;
+// A sorted TopK that keeps more than this fraction of the row sorts the whole row.
+constexpr float kSortAllFraction = 0.5;
+
+template <typename T>
+struct TopKElement {
+  T value;
+  int index;
+};
+}  // namespace
+
 template <typename T>
-void TopKCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
+void TopKCPUKernel::TopKRow(const T *input, size_t k_num, void *scratch, T *output, int *indices) const {
+  if (k_num <= kHeapMaxK && k_num * kHeapMinRatio <= inner_size_) {
+    // The heap keeps the best k elements seen so far with the worst one on top.
+    auto heap = reinterpret_cast<TopKElement<T> *>(scratch);
+    auto heap_comp = [](const TopKElement<T> &a, const TopKElement<T> &b) {
+      return RankBefore(a.value, a.index, b.value, b.index);
+    };
+    for (size_t i = 0; i < k_num; ++i) {
+      heap[i] = {input[i], SizeToInt(i)};
+    }
+    std::make_heap(heap, heap + k_num, heap_comp);
+    for (size_t i = k_num; i < inner_size_; ++i) {
+      if (RankGreater(input[i], heap[0].value)) {
+        std::pop_heap(heap, heap + k_num, heap_comp);
+        heap[k_num - 1] = {input[i], SizeToInt(i)};
+        std::push_heap(heap, heap + k_num, heap_comp);
+      }
+    }
+    std::sort_heap(heap, heap + k_num, heap_comp);
+    for (size_t i = 0; i < k_num; ++i) {
+      output[i] = heap[i].value;
+      indices[i] = heap[i].index;
+    }
+    return;
+  }
+
+  auto idx = reinterpret_cast<int *>(scratch);
+  std::iota(idx, idx + inner_size_, 0);
+  auto comp = [input](int index_1, int index_2) { return RankBefore(input[index_1], index_1, input[index_2], index_2); };
+  if (sorted_ && k_num > inner_size_ * kSortAllFraction) {
+    std::sort(idx, idx + inner_size_, comp);
+  } else {
+    std::nth_element(idx, idx + k_num, idx + inner_size_, comp);
+    if (sorted_) {
+      std::sort(idx, idx + k_num, comp);
+    }
+  }
+  for (size_t i = 0; i < k_num; ++i) {
+    indices[i] = idx[i];
+    output[i] = input[idx[i]];
+  }
+}
+
+template <typename T>
+void TopKCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                                 const std::vector<AddressPtr> &outputs) {
   if (inputs.size() != 2 || outputs.size() != 2) {
     MS_LOG(EXCEPTION) << "TopK needs 2 inputs and 2 outputs, but get inputs: " << inputs.size()
                       << "outputs: " << outputs.size();
@@ -31,10 +95,14 @@ void TopKCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const st
   if (inputs[1]->size != sizeof(int)) {
     MS_LOG(EXCEPTION) << "Input K must be int!";
   }
+  if (workspace.empty() || workspace[0]->size < task_num_ * scratch_size_) {
+    MS_LOG(EXCEPTION) << "Error workspace size!";
+  }
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
   int k = reinterpret_cast<int *>(inputs[1]->addr)[0];
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
   auto indices = reinterpret_cast<int *>(outputs[1]->addr);
+  auto scratch = reinterpret_cast<uint8_t *>(workspace[0]->addr);
   if (k < 1) {
     MS_LOG(EXCEPTION) << "Input k must > 0!";
   }
@@ -42,35 +110,18 @@ void TopKCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const st
   if (outputs[0]->size != outer_size_ * k_num * sizeof(T)) {
     MS_LOG(EXCEPTION) << "Error output data size!";
   }
-  for (size_t i = 0; i < outer_size_; ++i) {
-    std::vector<size_t> idx(inner_size_);
-    auto base_input = i * inner_size_;
-    std::iota(idx.begin(), idx.end(), base_input);
 
-    if (sorted_) {
-      constexpr float fraction = 0.5;
-      const size_t threshold = inner_size_ * fraction;
-      // fall back to stable_sort
-      if (k_num > threshold) {
-        stable_sort(idx.begin(), idx.end(),
-                    [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; });
-      } else {
-        nth_element(idx.begin(), idx.begin() + SizeToLong(k_num), idx.end(),
-                    [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; });
-        stable_sort(idx.begin(), idx.begin() + SizeToLong(k_num),
-                    [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; });
+  size_t rows_per_task = (outer_size_ + task_num_ - 1) / task_num_;
+  auto task = [&](size_t start, size_t end) {
+    for (size_t task_id = start; task_id < end; ++task_id) {
+      size_t row_end = std::min(outer_size_, (task_id + 1) * rows_per_task);
+      for (size_t row = task_id * rows_per_task; row < row_end; ++row) {
+        TopKRow(input + row * inner_size_, k_num, scratch + task_id * scratch_size_, output + row * k_num,
+                indices + row * k_num);
       }
-    } else {
-      nth_element(idx.begin(), idx.begin() + SizeToLong(k_num), idx.end(),
-                  [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; });
     }
-
-    auto base_output = i * k_num;
-    for (size_t j = 0; j < k_num; ++j) {
-      indices[base_output + j] = SizeToInt(idx[j]) - SizeToInt(base_input);
-      output[base_output + j] = input[idx[j]];
-    }
-  }
+  };
+  ParallelLaunch(task, task_num_, 1);
 }
 
 void TopKCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -82,14 +133,25 @@ void TopKCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   inner_size_ = x_shape_[x_shape_.size() - 1];
   sorted_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "sorted");
   dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  size_t max_thread_num = std::max(1U, std::thread::hardware_concurrency());
+  task_num_ = std::max<size_t>(1, std::min(outer_size_, max_thread_num));
+}
+
+void TopKCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  // Enough for the index array of a row or for the heap of the largest k selected with a heap.
+  size_t element_size = dtype_ == kNumberTypeFloat16 ? sizeof(TopKElement<float16>) : sizeof(TopKElement<float>);
+  scratch_size_ = std::max(inner_size_ * sizeof(int), kHeapMaxK * element_size);
+  workspace_size_list_.emplace_back(task_num_ * scratch_size_);
 }
 
-bool TopKCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+bool TopKCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> &workspace,
                            const std::vector<kernel::AddressPtr> &outputs) {
   if (dtype_ == kNumberTypeFloat16) {
-    LaunchKernel<float16>(inputs, outputs);
+    LaunchKernel<float16>(inputs, workspace, outputs);
   } else if (dtype_ == kNumberTypeFloat32) {
-    LaunchKernel<float>(inputs, outputs);
+    LaunchKernel<float>(inputs, workspace, outputs);
   }
   return true;
 }
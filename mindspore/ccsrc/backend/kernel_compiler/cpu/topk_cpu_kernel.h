@@ -31,13 +31,22 @@ class TopKCPUKernel : public CPUKernel {
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
 
+ protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
+
  private:
   template <typename T>
-  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                    const std::vector<AddressPtr> &outputs);
+  template <typename T>
+  void TopKRow(const T *input, size_t k_num, void *scratch, T *output, int *indices) const;
   size_t outer_size_{1};
   size_t inner_size_{1};
   bool sorted_{false};
   TypeId dtype_{kTypeUnknown};
+  // The rows are split into task_num_ tasks, each of them owns scratch_size_ bytes of the workspace.
+  size_t task_num_{1};
+  size_t scratch_size_{0};
 };
 
 MS_REG_CPU_KERNEL(TopK, KernelAttr(), TopKCPUKernel)
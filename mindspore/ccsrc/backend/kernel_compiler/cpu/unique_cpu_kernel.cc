@@ -15,11 +15,11 @@
  */
 
 #include "backend/kernel_compiler/cpu/unique_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/bucket_partition.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
-constexpr size_t kBucketSortThreshold = 100000;
 void UniqueCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   node_wpt_ = kernel_node;
   CheckParam(kernel_node);
@@ -33,9 +33,8 @@ void UniqueCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 
 void UniqueCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   CPUKernel::InitInputOutputSize(kernel_node);
-  workspace_size_list_.emplace_back(input_size_ * sizeof(int64_t));
-  workspace_size_list_.emplace_back(input_size_ * sizeof(int64_t));
-  workspace_size_list_.emplace_back(input_size_ * sizeof(int64_t));
+  // Bucket positions and ranks of the first appearances.
+  workspace_size_list_.emplace_back(2 * input_size_ * sizeof(int64_t));
 }
 
 bool UniqueCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -76,35 +75,17 @@ void UniqueCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const
   if (inputs.size() < 1) {
     MS_LOG(EXCEPTION) << "Input size should be large than 0!";
   }
-  if (workspace.size() < 3) {
-    MS_LOG(EXCEPTION) << "Workspace size should be large than 2!";
+  if (workspace.size() < 1) {
+    MS_LOG(EXCEPTION) << "Workspace size should be large than 0!";
   }
   if (outputs.size() < 2) {
     MS_LOG(EXCEPTION) << "Output size should be large than 1!";
   }
-  auto params = std::make_shared<UniqueParam<DataType, IndexType>>();
-  params->input_ = reinterpret_cast<DataType *>(inputs[0]->addr);
-  params->input_idx_ = reinterpret_cast<IndexType *>(workspace[0]->addr);
-  params->workspace_ = reinterpret_cast<DataType *>(workspace[1]->addr);
-  params->workspace_idx_ = reinterpret_cast<IndexType *>(workspace[2]->addr);
-  params->output_ = reinterpret_cast<DataType *>(outputs[0]->addr);
-  params->inverse_idx_ = reinterpret_cast<IndexType *>(outputs[1]->addr);
-  params->input_size_ = static_cast<IndexType>(input_size_);
-  params->output_size_ = 0;
-
-  params->thread_num_ = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  if (sorted_) {
-    params->need_sort_ = true;
-    if (input_size_ < kBucketSortThreshold) {
-      Unique(params);
-    } else {
-      BucketUnique(params);
-    }
-  } else {
-    params->need_sort_ = false;
-    Unique(params);
-  }
-  output_size_ = static_cast<size_t>(params->output_size_);
+  auto input = reinterpret_cast<DataType *>(inputs[0]->addr);
+  auto workspace_idx = reinterpret_cast<IndexType *>(workspace[0]->addr);
+  auto output = reinterpret_cast<DataType *>(outputs[0]->addr);
+  auto inverse_idx = reinterpret_cast<IndexType *>(outputs[1]->addr);
+  output_size_ = UniqueByBucket(input, input_size_, sorted_, output, inverse_idx, workspace_idx);
 }
 
 void UniqueCPUKernel::CheckParam(const CNodePtr &kernel_node) {
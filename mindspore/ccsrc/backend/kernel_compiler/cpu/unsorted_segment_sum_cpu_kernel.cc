@@ -15,8 +15,8 @@
  */
 
 #include "backend/kernel_compiler/cpu/unsorted_segment_sum_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/bucket_partition.h"
 #include "runtime/device/cpu/cpu_device_address.h"
-#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -41,52 +41,62 @@ void UnsortedSegmentSumCPUKernel::InitKernel(const CNodePtr &kernel_node) {
       input_dim1_ *= input_shape[i];
     }
   }
+  for (size_t i = 0; i < segment_ids_shape.size(); ++i) {
+    segment_ids_num_ *= segment_ids_shape[i];
+  }
   output_dim0_ = output_shape[0];
   for (size_t j = 1; j < output_shape.size(); j++) {
     output_dim1_ *= output_shape[j];
   }
+  if (output_dim1_ != input_dim1_) {
+    MS_LOG(EXCEPTION) << "The output row size " << output_dim1_ << " of UnsortedSegmentSum should be the input one "
+                      << input_dim1_;
+  }
+}
+
+void UnsortedSegmentSumCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  // Bucket positions of the segment ids.
+  workspace_size_list_.emplace_back(segment_ids_num_ * sizeof(int64_t));
 }
 
 bool UnsortedSegmentSumCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                                         const std::vector<kernel::AddressPtr> &,
+                                         const std::vector<kernel::AddressPtr> &workspace,
                                          const std::vector<kernel::AddressPtr> &outputs) {
-  bool ret{true};
-  void *input_addr = inputs[0]->addr;
-  void *indices_addr = inputs[1]->addr;
   void *output_addr = outputs[0]->addr;
-  auto ret1 = memset_s(output_addr, outputs[0]->size, 0, outputs[0]->size);
-  if (ret1 != EOK) {
-    MS_LOG(ERROR) << "Output buff memset fail. ret:" << ret1;
+  auto ret = memset_s(output_addr, outputs[0]->size, 0, outputs[0]->size);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "Output buff memset fail. ret:" << ret;
     return false;
   }
 
   if (dtype_ == kNumberTypeInt32 && segment_ids_dtype_ == kNumberTypeInt32) {
-    ret1 = UnsortedSegmentSum(int, int, static_cast<const int *>(input_addr), unit_num_, input_dim1_,
-                              static_cast<const int *>(indices_addr), static_cast<int *>(output_addr), output_dim0_,
-                              output_dim1_);
+    LaunchKernel<int, int>(inputs, workspace, outputs);
   } else if (dtype_ == kNumberTypeFloat32 && segment_ids_dtype_ == kNumberTypeInt32) {
-    ret1 = UnsortedSegmentSum(float, int, static_cast<const float *>(input_addr), unit_num_, input_dim1_,
-                              static_cast<const int *>(indices_addr), static_cast<float *>(output_addr), output_dim0_,
-                              output_dim1_);
+    LaunchKernel<float, int>(inputs, workspace, outputs);
   } else if (dtype_ == kNumberTypeInt32 && segment_ids_dtype_ == kNumberTypeInt64) {
-    ret1 = UnsortedSegmentSum(int, int64_t, static_cast<const int *>(input_addr), unit_num_, input_dim1_,
-                              static_cast<const int64_t *>(indices_addr), static_cast<int *>(output_addr), output_dim0_,
-                              output_dim1_);
+    LaunchKernel<int, int64_t>(inputs, workspace, outputs);
   } else if (dtype_ == kNumberTypeFloat32 && segment_ids_dtype_ == kNumberTypeInt64) {
-    ret1 = UnsortedSegmentSum(float, int64_t, static_cast<const float *>(input_addr), unit_num_, input_dim1_,
-                              static_cast<const int64_t *>(indices_addr), static_cast<float *>(output_addr),
-                              output_dim0_, output_dim1_);
+    LaunchKernel<float, int64_t>(inputs, workspace, outputs);
   } else {
     MS_LOG(ERROR) << "Only support input_x int32 and float32, indices int32 and int64";
     return false;
   }
+  return true;
+}
 
-  if (ret1 != EOK) {
-    MS_LOG(ERROR) << "unsortedSegmentSum failed. ret:" << ret1;
-    return false;
+template <typename S, typename T>
+void UnsortedSegmentSumCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
+                                               const std::vector<AddressPtr> &workspace,
+                                               const std::vector<kernel::AddressPtr> &outputs) {
+  if (unit_num_ == 0) {
+    return;
   }
-
-  return ret;
+  auto input = reinterpret_cast<const S *>(inputs[0]->addr);
+  auto segment_ids = reinterpret_cast<const T *>(inputs[1]->addr);
+  auto output = reinterpret_cast<S *>(outputs[0]->addr);
+  auto positions = reinterpret_cast<T *>(workspace[0]->addr);
+  SegmentSumByBucket(input, segment_ids, segment_ids_num_, input_dim1_, output_dim0_, output, positions);
 }
 }  // namespace kernel
 }  // namespace mindspore
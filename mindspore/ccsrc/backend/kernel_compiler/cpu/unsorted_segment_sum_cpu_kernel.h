@@ -17,11 +17,8 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_UNSORTED_SEGMENT_SUM_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_UNSORTED_SEGMENT_SUM_CPU_KERNEL_H_
 #include <vector>
-#include <memory>
-#include <unordered_map>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
-#include "nnacl/base/unsorted_segment_sum_base.h"
 
 namespace mindspore {
 namespace kernel {
@@ -31,15 +28,18 @@ class UnsortedSegmentSumCPUKernel : public CPUKernel {
   ~UnsortedSegmentSumCPUKernel() override = default;
 
   void InitKernel(const CNodePtr &kernel_node) override;
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
   template <typename S, typename T>
-  bool LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &outputs);
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                    const std::vector<kernel::AddressPtr> &outputs);
 
  private:
   TypeId dtype_{kTypeUnknown};
   TypeId segment_ids_dtype_{kTypeUnknown};
+  size_t segment_ids_num_{1};
   size_t unit_num_{1};
   size_t input_dim1_{1};
   size_t output_dim0_{1};
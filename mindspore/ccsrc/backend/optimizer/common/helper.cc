@@ -23,7 +23,9 @@
 #include <set>
 #include <deque>
 #include "utils/utils.h"
+#include "utils/flags.h"
 #include "base/base_ref.h"
+#include "ir/param_info.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "base/core_ops.h"
 #include "backend/kernel_compiler/tbe/tbe_dynaminc_shape_util.h"
@@ -1018,5 +1020,40 @@ int64_t GetNodeOutputTotalUsedNum(const session::KernelGraph &kernel_graph, cons
   auto output_used_num = GetNodeOutputUsedNum(kernel_graph, node);
   return std::accumulate(output_used_num.begin(), output_used_num.end(), int64_t(0));
 }
+
+ParameterPtr GetLoadedParameter(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto param_node = node;
+  if (IsPrimitiveCNode(node, prim::kPrimLoad)) {
+    param_node = node->cast<CNodePtr>()->input(1);
+  }
+  return param_node->cast<ParameterPtr>();
+}
+
+bool IsWrittenParameter(const FuncGraphManagerPtr &manager, const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(manager);
+  auto param = GetLoadedParameter(node);
+  if (param == nullptr) {
+    return false;
+  }
+  auto iter = manager->node_users().find(param);
+  if (iter == manager->node_users().end()) {
+    return false;
+  }
+  // A parameter is only written in place by ops with memory side effects, such as Assign and the optimizers.
+  return std::any_of(iter->second.begin(), iter->second.end(), [](const std::pair<AnfNodePtr, int> &user) {
+    auto prim = GetCNodePrimitive(user.first);
+    return prim != nullptr && prim->HasAttr(GRAPH_FLAG_SIDE_EFFECT_MEM);
+  });
+}
+
+bool IsReadOnlyWeight(const FuncGraphManagerPtr &manager, const AnfNodePtr &node) {
+  auto param = GetLoadedParameter(node);
+  if (param == nullptr || !param->has_default() || param->param_info() == nullptr ||
+      param->param_info()->requires_grad()) {
+    return false;
+  }
+  return !IsWrittenParameter(manager, param);
+}
 }  // namespace opt
 }  // namespace mindspore
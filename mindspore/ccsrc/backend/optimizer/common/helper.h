@@ -226,6 +226,16 @@ std::vector<int64_t> GetNodeOutputUsedNum(const session::KernelGraph &kernel_gra
 
 // Get total used number of node's output
 int64_t GetNodeOutputTotalUsedNum(const session::KernelGraph &kernel_graph, const AnfNodePtr &node);
+
+// Get the parameter that node is or loads, nullptr for other nodes
+ParameterPtr GetLoadedParameter(const AnfNodePtr &node);
+
+// Whether node is, or loads, a parameter that a node of the graph with memory side effects writes in place
+bool IsWrittenParameter(const FuncGraphManagerPtr &manager, const AnfNodePtr &node);
+
+// Whether node is, or loads, a parameter with a default value that is not trained and no node of the graph writes.
+// Only writers matter: the parameter may also be read by any other node, e.g. a weight shared by a Conv2D and a MatMul.
+bool IsReadOnlyWeight(const FuncGraphManagerPtr &manager, const AnfNodePtr &node);
 }  // namespace opt
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_COMMON_HELPER_H_
@@ -0,0 +1,195 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/optimizer/cpu/layout_propagation_cpu.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "backend/kernel_compiler/kernel_build_info.h"
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kBlockedRank = 4;
+constexpr size_t kConvWeightIndex = 2;
+constexpr size_t kFusedConvResidualStart = 2;
+constexpr int kDependAttachInputIndex = 2;
+
+// Kernels that may start a blocked region.
+const std::unordered_set<std::string> kBlockedSeedOps = {prim::kPrimConv2D->name(), kFusedConv2DOpName};
+// Kernels that join a blocked region when their first input comes from it.
+const std::unordered_set<std::string> kBlockedFollowOps = {
+  prim::kPrimBatchNorm->name(), prim::kPrimMaxPool->name(), prim::kPrimAvgPool->name(), prim::kPrimRelu->name(),
+  prim::kPrimRelu6->name(),     prim::kPrimSigmoid->name(), prim::kPrimTanh->name(),    prim::kPrimElu->name()};
+
+bool IsBlockedShape(const std::vector<size_t> &shape) { return shape.size() == kBlockedRank; }
+
+bool IsBlockedCapable(const CNodePtr &cnode) {
+  if (AnfAlgo::IsNodeDynamicShape(cnode) || AnfAlgo::GetInputTensorNum(cnode) == 0) {
+    return false;
+  }
+  if (AnfAlgo::HasNodeAttr(kAttrFormat, cnode) &&
+      AnfAlgo::GetNodeAttr<std::string>(cnode, kAttrFormat) != kOpFormat_NCHW) {
+    return false;
+  }
+  return AnfAlgo::GetPrevNodeOutputInferDataType(cnode, 0) == kNumberTypeFloat32 &&
+         AnfAlgo::GetOutputInferDataType(cnode, 0) == kNumberTypeFloat32 &&
+         IsBlockedShape(AnfAlgo::GetPrevNodeOutputInferShape(cnode, 0)) &&
+         IsBlockedShape(AnfAlgo::GetOutputInferShape(cnode, 0));
+}
+
+// A blocked output may only be read by kernels, a TransData is put in front of those that want the default layout.
+// Graph outputs and other non-kernel users would see the raw blocked data, so they keep the node out of the region.
+bool UsersAcceptBlocked(const FuncGraphManagerPtr &manager, const AnfNodePtr &node) {
+  auto iter = manager->node_users().find(node);
+  if (iter == manager->node_users().end()) {
+    return true;
+  }
+  for (const auto &user : iter->second) {
+    if (IsPrimitiveCNode(user.first, prim::kPrimTupleGetItem)) {
+      auto getitem = user.first->cast<CNodePtr>();
+      MS_EXCEPTION_IF_NULL(getitem);
+      if (AnfAlgo::GetTupleGetItemOutIndex(getitem) == 0 && !UsersAcceptBlocked(manager, getitem)) {
+        return false;
+      }
+      continue;
+    }
+    if (AnfAlgo::IsRealCNodeKernel(user.first) || IsPrimitiveCNode(user.first, prim::kPrimUpdateState) ||
+        (IsPrimitiveCNode(user.first, prim::kPrimDepend) && user.second == kDependAttachInputIndex)) {
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+bool IsFromBlockedRegion(const CNodePtr &cnode, const std::unordered_set<AnfNodePtr> &blocked_nodes) {
+  auto prev = AnfAlgo::VisitKernelWithReturnType(cnode->input(1), 0);
+  return prev.second == 0 && blocked_nodes.count(prev.first) != 0;
+}
+
+void SetBlockedFormat(const CNodePtr &cnode) {
+  auto builder = kernel::KernelBuildInfo::KernelBuildInfoBuilder(AnfAlgo::GetSelectKernelBuildInfo(cnode));
+  builder.SetInputFormat(kOpFormat_NC1HWC0, 0);
+  // Residual inputs of a fused convolution are read with the dst layout.
+  if (AnfAlgo::GetCNodeName(cnode) == kFusedConv2DOpName) {
+    size_t residual_start = kFusedConvResidualStart + (AnfAlgo::GetNodeAttr<bool>(cnode, kAttrHasBias) ? 1 : 0);
+    for (size_t i = residual_start; i < AnfAlgo::GetInputTensorNum(cnode); ++i) {
+      builder.SetInputFormat(kOpFormat_NC1HWC0, i);
+    }
+  }
+  builder.SetOutputFormat(kOpFormat_NC1HWC0, 0);
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), cnode.get());
+}
+
+CNodePtr NewTransDataNode(const FuncGraphPtr &graph, const CNodePtr &cnode, size_t input_idx,
+                          const std::string &input_format, const std::string &output_format) {
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(prim::KPrimTransData->name())),
+                                    cnode->input(input_idx + 1)};
+  auto trans_data = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(trans_data);
+  auto dtype = AnfAlgo::GetPrevNodeOutputInferDataType(cnode, input_idx);
+  AnfAlgo::SetOutputInferTypeAndShape({dtype}, {AnfAlgo::GetPrevNodeOutputInferShape(cnode, input_idx)},
+                                      trans_data.get());
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat({input_format});
+  builder.SetInputsDeviceType({dtype});
+  builder.SetOutputsFormat({output_format});
+  builder.SetOutputsDeviceType({dtype});
+  builder.SetKernelType(UNKNOWN_KERNEL_TYPE);
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), trans_data.get());
+  return trans_data;
+}
+
+// Puts a TransData on every kernel input whose layout differs from its producer across the region border, one per
+// producer output and target layout.
+bool InsertTransData(const FuncGraphPtr &graph, const std::vector<AnfNodePtr> &node_list) {
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  bool changed = false;
+  std::map<std::pair<AnfNodePtr, std::string>, CNodePtr> trans_data_cache;
+  for (const auto &node : node_list) {
+    if (!AnfAlgo::IsRealCNodeKernel(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(cnode); ++i) {
+      auto input_format = AnfAlgo::GetInputFormat(cnode, i);
+      auto prev_format = AnfAlgo::GetPrevNodeOutputFormat(cnode, i);
+      if (input_format == prev_format || (input_format != kOpFormat_NC1HWC0 && prev_format != kOpFormat_NC1HWC0)) {
+        continue;
+      }
+      auto key = std::make_pair(cnode->input(i + 1), input_format);
+      auto iter = trans_data_cache.find(key);
+      if (iter == trans_data_cache.end()) {
+        iter = trans_data_cache.emplace(key, NewTransDataNode(graph, cnode, i, prev_format, input_format)).first;
+      }
+      manager->SetEdge(cnode, SizeToInt(i + 1), iter->second);
+      changed = true;
+    }
+  }
+  return changed;
+}
+}  // namespace
+
+bool LayoutPropagationCPU::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (!kernel::MKLKernelEngine::Get().blocked_layout_preferred()) {
+    return false;
+  }
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::unordered_set<AnfNodePtr> blocked_nodes;
+  std::vector<AnfNodePtr> node_list = TopoSort(graph->get_return());
+  for (const auto &node : node_list) {
+    if (!AnfAlgo::IsRealCNodeKernel(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto op_name = AnfAlgo::GetCNodeName(cnode);
+    bool is_seed = kBlockedSeedOps.count(op_name) != 0;
+    if (!is_seed && (kBlockedFollowOps.count(op_name) == 0 || !IsFromBlockedRegion(cnode, blocked_nodes))) {
+      continue;
+    }
+    if (!IsBlockedCapable(cnode) || !UsersAcceptBlocked(manager, cnode)) {
+      continue;
+    }
+    SetBlockedFormat(cnode);
+    // The kernel caches the reordered copy of a weight that is never written.
+    if (is_seed && IsReadOnlyWeight(manager, cnode->input(kConvWeightIndex))) {
+      AnfAlgo::SetNodeAttr(kAttrIsWeightConst, MakeValue(true), cnode);
+    }
+    (void)blocked_nodes.insert(cnode);
+  }
+  if (blocked_nodes.empty()) {
+    return false;
+  }
+  MS_LOG(INFO) << "Propagate " << kOpFormat_NC1HWC0 << " layout to " << blocked_nodes.size() << " kernels";
+  (void)InsertTransData(graph, node_list);
+  return true;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,283 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/multi_tensor_optimizer_fusion_cpu.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/cpu/kernel_select_cpu.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kAdamInputNum = 10;
+constexpr size_t kAdamWeightDecayInputNum = 9;
+constexpr size_t kApplyMomentumInputNum = 5;
+constexpr auto kAttrUseNesterov = "use_nesterov";
+
+struct OptimizerGroup {
+  std::string fused_op_name;
+  bool use_nesterov{false};
+  std::vector<CNodePtr> nodes;
+};
+
+// The fused op of an optimizer node, empty when the node is not fused.
+std::string GetFusedOpName(const CNodePtr &cnode) {
+  auto op_name = AnfAlgo::GetCNodeName(cnode);
+  std::string fused_op_name;
+  size_t input_num = 0;
+  if (op_name == kApplyAdamOpName) {
+    fused_op_name = kMultiTensorAdamOpName;
+    input_num = kAdamInputNum;
+  } else if (op_name == kAdamWeightDecayName) {
+    fused_op_name = kMultiTensorAdamWeightDecayOpName;
+    input_num = kAdamWeightDecayInputNum;
+  } else if (op_name == kApplyMomentumOpName) {
+    fused_op_name = kMultiTensorApplyMomentumOpName;
+    input_num = kApplyMomentumInputNum;
+  } else {
+    return "";
+  }
+  if (AnfAlgo::IsNodeDynamicShape(cnode) || AnfAlgo::GetInputTensorNum(cnode) != input_num) {
+    return "";
+  }
+  for (size_t i = 0; i < input_num; ++i) {
+    if (AnfAlgo::GetPrevNodeOutputInferDataType(cnode, i) != kNumberTypeFloat32) {
+      return "";
+    }
+  }
+  return fused_op_name;
+}
+
+// Whether the node is an UpdateState which attaches only members of the group, directly or in a MakeTuple. Auto monad
+// chains the updates of an optimizer this way: upd_i(..., u_i), u_i+1 = UpdateState(u_i, upd_i).
+bool IsMemberUpdateState(const AnfNodePtr &node, const std::unordered_set<AnfNodePtr> &members) {
+  if (!IsPrimitiveCNode(node, prim::kPrimUpdateState)) {
+    return false;
+  }
+  auto &inputs = node->cast<CNodePtr>()->inputs();
+  if (inputs.size() <= static_cast<size_t>(kUpdateStateRealInput)) {
+    return false;
+  }
+  for (size_t i = static_cast<size_t>(kUpdateStateRealInput); i < inputs.size(); ++i) {
+    const auto &input = inputs[i];
+    if (members.count(input) != 0) {
+      continue;
+    }
+    if (!IsPrimitiveCNode(input, prim::kPrimMakeTuple)) {
+      return false;
+    }
+    auto &tuple_inputs = input->cast<CNodePtr>()->inputs();
+    if (!std::all_of(tuple_inputs.begin() + 1, tuple_inputs.end(),
+                     [&members](const AnfNodePtr &item) { return members.count(item) != 0; })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The monad a member waits for before the UpdateStates of the chain of the group, which the fused node waits for.
+AnfNodePtr GetChainHead(const AnfNodePtr &monad, const std::unordered_set<AnfNodePtr> &members) {
+  auto head = monad;
+  while (IsMemberUpdateState(head, members)) {
+    head = head->cast<CNodePtr>()->input(kUpdateStateStateInput);
+  }
+  return head;
+}
+
+// Whether the tensor or monad inputs of the node depend on a member of the group. Such a node would make a cycle once
+// the group is fused, as the fused node takes the inputs of all the members. The UpdateStates which chain the members
+// on the monad path of the node are passed through, the fused node waits for the head of the chain instead. The nodes
+// before the first member in the topological order can not depend on a member and are not searched.
+bool DependsOnGroup(const CNodePtr &cnode, const std::unordered_set<AnfNodePtr> &members,
+                    const std::unordered_map<AnfNodePtr, size_t> &topo_index, size_t first_index) {
+  // The nodes to search with whether they are on the monad path of the node.
+  std::vector<std::pair<AnfNodePtr, bool>> todo;
+  size_t input_num = AnfAlgo::GetInputTensorNum(cnode);
+  for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+    todo.emplace_back(cnode->input(i), i > input_num && HasAbstractMonad(cnode->input(i)));
+  }
+  std::unordered_set<AnfNodePtr> visited;
+  std::unordered_set<AnfNodePtr> visited_monads;
+  while (!todo.empty()) {
+    auto [node, on_monad_path] = todo.back();
+    todo.pop_back();
+    if (node == nullptr || !node->isa<CNode>()) {
+      continue;
+    }
+    if (on_monad_path && IsMemberUpdateState(node, members)) {
+      if (visited_monads.insert(node).second) {
+        todo.emplace_back(node->cast<CNodePtr>()->input(kUpdateStateStateInput), true);
+      }
+      continue;
+    }
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    if (members.count(node) != 0) {
+      return true;
+    }
+    auto iter = topo_index.find(node);
+    if (iter != topo_index.end() && iter->second < first_index) {
+      continue;
+    }
+    auto &inputs = node->cast<CNodePtr>()->inputs();
+    for (const auto &input : inputs) {
+      todo.emplace_back(input, false);
+    }
+  }
+  return false;
+}
+
+std::vector<OptimizerGroup> GetOptimizerGroups(const std::vector<AnfNodePtr> &node_list) {
+  std::unordered_map<AnfNodePtr, size_t> topo_index;
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    topo_index[node_list[i]] = i;
+  }
+  // Groups by the fused op and the attributes of the kernel, with the topological index of their first member.
+  std::map<std::string, OptimizerGroup> groups;
+  std::map<std::string, std::unordered_set<AnfNodePtr>> group_members;
+  std::map<std::string, size_t> group_first_index;
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    const auto &node = node_list[i];
+    if (!AnfAlgo::IsRealCNodeKernel(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto fused_op_name = GetFusedOpName(cnode);
+    if (fused_op_name.empty()) {
+      continue;
+    }
+    bool use_nesterov = fused_op_name == kMultiTensorAdamOpName && AnfAlgo::HasNodeAttr(kAttrUseNesterov, cnode) &&
+                        AnfAlgo::GetNodeAttr<bool>(cnode, kAttrUseNesterov);
+    auto key = fused_op_name + (use_nesterov ? "_nesterov" : "");
+    auto &group = groups[key];
+    auto &members = group_members[key];
+    if (group.nodes.empty()) {
+      group.fused_op_name = fused_op_name;
+      group.use_nesterov = use_nesterov;
+      group_first_index[key] = i;
+    } else if (DependsOnGroup(cnode, members, topo_index, group_first_index[key])) {
+      continue;
+    }
+    group.nodes.emplace_back(cnode);
+    (void)members.insert(cnode);
+  }
+  std::vector<OptimizerGroup> result;
+  for (auto &iter : groups) {
+    if (iter.second.nodes.size() > 1) {
+      result.emplace_back(iter.second);
+    }
+  }
+  return result;
+}
+
+CNodePtr CreateFusedNode(const FuncGraphPtr &graph, const OptimizerGroup &group) {
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(group.fused_op_name))};
+  AbstractBasePtrList output_abstracts;
+  for (const auto &cnode : group.nodes) {
+    size_t input_num = AnfAlgo::GetInputTensorNum(cnode);
+    for (size_t i = 0; i < input_num; ++i) {
+      inputs.emplace_back(AnfAlgo::GetInputNode(cnode, i));
+    }
+    auto abstract = cnode->abstract();
+    MS_EXCEPTION_IF_NULL(abstract);
+    if (abstract->isa<abstract::AbstractTuple>()) {
+      auto elements = abstract->cast<abstract::AbstractTuplePtr>()->elements();
+      (void)output_abstracts.insert(output_abstracts.end(), elements.begin(), elements.end());
+    } else {
+      output_abstracts.emplace_back(abstract);
+    }
+  }
+  // The updates keep their place after the side effects any member waits for, so the fused node takes the distinct
+  // monads of all the members. A member chained after the others waits for the head of the chain, the UpdateStates of
+  // the chain then attach the outputs of the fused node once the members are replaced.
+  std::unordered_set<AnfNodePtr> members(group.nodes.begin(), group.nodes.end());
+  std::unordered_set<AnfNodePtr> monads;
+  for (const auto &cnode : group.nodes) {
+    for (size_t i = AnfAlgo::GetInputTensorNum(cnode) + 1; i < cnode->inputs().size(); ++i) {
+      if (!HasAbstractMonad(cnode->input(i))) {
+        continue;
+      }
+      auto monad = GetChainHead(cnode->input(i), members);
+      if (monads.insert(monad).second) {
+        inputs.emplace_back(monad);
+      }
+    }
+  }
+  const auto &first = group.nodes.front();
+  auto fused_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_abstract(std::make_shared<abstract::AbstractTuple>(output_abstracts));
+  fused_node->set_scope(first->scope());
+  AnfAlgo::SetNodeAttr(kAttrN, MakeValue(SizeToLong(group.nodes.size())), fused_node);
+  if (group.fused_op_name == kMultiTensorAdamOpName) {
+    AnfAlgo::SetNodeAttr(kAttrUseNesterov, MakeValue(group.use_nesterov), fused_node);
+  }
+  device::cpu::SetKernelInfo(fused_node);
+  return fused_node;
+}
+
+// Hands the outputs of the fused node back to the users of the original ones.
+void ReplaceGroup(const FuncGraphPtr &graph, const FuncGraphManagerPtr &manager, const OptimizerGroup &group,
+                  const CNodePtr &fused_node) {
+  size_t output_index = 0;
+  for (const auto &cnode : group.nodes) {
+    size_t output_num = AnfAlgo::GetOutputTensorNum(cnode);
+    AnfNodePtr replacement = nullptr;
+    if (cnode->abstract()->isa<abstract::AbstractTuple>()) {
+      std::vector<AnfNodePtr> make_tuple_inputs = {NewValueNode(prim::kPrimMakeTuple)};
+      for (size_t i = 0; i < output_num; ++i) {
+        make_tuple_inputs.emplace_back(CreatTupleGetItemNode(graph, fused_node, output_index + i));
+      }
+      replacement = graph->NewCNode(make_tuple_inputs);
+      replacement->set_abstract(cnode->abstract());
+    } else {
+      replacement = CreatTupleGetItemNode(graph, fused_node, output_index);
+    }
+    output_index += output_num;
+    if (!manager->Replace(cnode, replacement)) {
+      MS_LOG(EXCEPTION) << "Replace " << cnode->fullname_with_scope() << " by " << fused_node->fullname_with_scope()
+                        << " failed.";
+    }
+  }
+}
+}  // namespace
+
+bool MultiTensorOptimizerFusionCPU::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<AnfNodePtr> node_list = TopoSort(graph->get_return());
+  auto groups = GetOptimizerGroups(node_list);
+  for (const auto &group : groups) {
+    auto fused_node = CreateFusedNode(graph, group);
+    MS_LOG(INFO) << "Fuse " << group.nodes.size() << " optimizer updates into " << fused_node->fullname_with_scope();
+    ReplaceGroup(graph, manager, group, fused_node);
+  }
+  return !groups.empty();
+}
+}  // namespace opt
+}  // namespace mindspore
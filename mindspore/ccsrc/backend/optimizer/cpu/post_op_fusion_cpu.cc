@@ -0,0 +1,193 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/optimizer/cpu/post_op_fusion_cpu.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/cpu/kernel_select_cpu.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kConv2DRank = 4;
+constexpr size_t kMatMulRank = 2;
+constexpr int kFirstDataInputIndex = 1;
+constexpr int kSecondDataInputIndex = 2;
+
+const std::unordered_set<std::string> kActivationPostOps = {prim::kPrimRelu->name(), prim::kPrimRelu6->name(),
+                                                            prim::kPrimGeLU->name(), prim::kPrimSigmoid->name(),
+                                                            prim::kPrimTanh->name()};
+
+struct PostOpChain {
+  bool has_bias{false};
+  AnfNodePtr bias{nullptr};
+  std::vector<std::string> post_ops;
+  std::vector<AnfNodePtr> residuals;
+  AnfNodePtr tail{nullptr};
+};
+
+bool IsFloat32Output(const AnfNodePtr &node) {
+  return AnfAlgo::GetOutputTensorNum(node) == 1 && AnfAlgo::GetOutputInferDataType(node, 0) == kNumberTypeFloat32;
+}
+
+bool IsFloat32Input(const AnfNodePtr &node, size_t input_idx) {
+  return AnfAlgo::GetPrevNodeOutputInferDataType(node, input_idx) == kNumberTypeFloat32;
+}
+
+// Every node of the chain except the tail is dropped, so it must not have any other user, not even a monad one.
+AnfNodePtr GetSingleUser(const FuncGraphManagerPtr &manager, const AnfNodePtr &node, int *input_index) {
+  auto iter = manager->node_users().find(node);
+  if (iter == manager->node_users().end() || iter->second.size() != 1) {
+    return nullptr;
+  }
+  const auto &user = iter->second.front();
+  if (!AnfAlgo::IsRealCNodeKernel(user.first)) {
+    return nullptr;
+  }
+  *input_index = user.second;
+  return user.first;
+}
+
+bool IsFusionHead(const CNodePtr &cnode) {
+  if (AnfAlgo::IsNodeDynamicShape(cnode) || !IsFloat32Output(cnode) || AnfAlgo::GetInputTensorNum(cnode) != 2 ||
+      !IsFloat32Input(cnode, 0) || !IsFloat32Input(cnode, 1)) {
+    return false;
+  }
+  auto op_name = AnfAlgo::GetCNodeName(cnode);
+  if (op_name == prim::kPrimConv2D->name()) {
+    if (AnfAlgo::HasNodeAttr(kAttrFormat, cnode) &&
+        AnfAlgo::GetNodeAttr<std::string>(cnode, kAttrFormat) != kOpFormat_NCHW) {
+      return false;
+    }
+    return AnfAlgo::GetOutputInferShape(cnode, 0).size() == kConv2DRank;
+  }
+  if (op_name == prim::kPrimMatMul->name()) {
+    return AnfAlgo::GetPrevNodeOutputInferShape(cnode, 0).size() == kMatMulRank &&
+           AnfAlgo::GetPrevNodeOutputInferShape(cnode, 1).size() == kMatMulRank;
+  }
+  return false;
+}
+
+// Walks the single user chain of head: at most one BiasAdd right after it, then residual Adds of the same shape and
+// activations in any order.
+bool CollectPostOps(const FuncGraphManagerPtr &manager, const CNodePtr &head, PostOpChain *chain) {
+  AnfNodePtr cur = head;
+  int input_index = 0;
+  auto user = GetSingleUser(manager, cur, &input_index);
+  while (user != nullptr && IsFloat32Output(user)) {
+    auto user_cnode = user->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(user_cnode);
+    auto op_name = AnfAlgo::GetCNodeName(user);
+    if (op_name == prim::kPrimBiasAdd->name()) {
+      if (chain->has_bias || !chain->post_ops.empty() || input_index != kFirstDataInputIndex ||
+          AnfAlgo::GetInputTensorNum(user) != 2 || !IsFloat32Input(user, 1) ||
+          AnfAlgo::GetPrevNodeOutputInferShape(user, 1).size() != 1) {
+        break;
+      }
+      chain->has_bias = true;
+      chain->bias = user_cnode->input(kSecondDataInputIndex);
+    } else if (op_name == prim::kPrimAdd->name()) {
+      if (AnfAlgo::GetInputTensorNum(user) != 2) {
+        break;
+      }
+      int other_index = input_index == kFirstDataInputIndex ? kSecondDataInputIndex : kFirstDataInputIndex;
+      size_t other_input_idx = IntToSize(other_index - 1);
+      if (!IsFloat32Input(user, other_input_idx) ||
+          AnfAlgo::GetPrevNodeOutputInferShape(user, other_input_idx) != AnfAlgo::GetOutputInferShape(cur, 0)) {
+        break;
+      }
+      chain->post_ops.emplace_back(op_name);
+      chain->residuals.emplace_back(user_cnode->input(IntToSize(other_index)));
+    } else if (kActivationPostOps.count(op_name) != 0) {
+      chain->post_ops.emplace_back(op_name);
+    } else {
+      break;
+    }
+    cur = user;
+    user = GetSingleUser(manager, cur, &input_index);
+  }
+  chain->tail = cur;
+  return cur != head;
+}
+
+CNodePtr CreateFusedNode(const FuncGraphPtr &graph, const FuncGraphManagerPtr &manager, const CNodePtr &head,
+                         const PostOpChain &chain) {
+  auto op_name =
+    AnfAlgo::GetCNodeName(head) == prim::kPrimConv2D->name() ? kFusedConv2DOpName : kFusedMatMulOpName;
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(op_name)),
+                                    head->input(kFirstDataInputIndex), head->input(kSecondDataInputIndex)};
+  if (chain.has_bias) {
+    inputs.emplace_back(chain.bias);
+  }
+  (void)inputs.insert(inputs.end(), chain.residuals.begin(), chain.residuals.end());
+  auto fused_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_abstract(chain.tail->abstract());
+  fused_node->set_scope(chain.tail->scope());
+  AnfAlgo::CopyNodeAttrs(head, fused_node);
+  // The training attr lives on the node instead of its primitive.
+  if (head->HasAttr(kAttrIsTraining)) {
+    fused_node->AddAttr(kAttrIsTraining, head->GetAttr(kAttrIsTraining));
+  }
+  AnfAlgo::SetNodeAttr(kAttrHasBias, MakeValue(chain.has_bias), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrPostOps, MakeValue(chain.post_ops), fused_node);
+  if (IsReadOnlyWeight(manager, head->input(kSecondDataInputIndex))) {
+    AnfAlgo::SetNodeAttr(kAttrIsWeightConst, MakeValue(true), fused_node);
+  }
+  device::cpu::SetKernelInfo(fused_node);
+  return fused_node;
+}
+}  // namespace
+
+bool PostOpFusionCPU::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  bool changed = false;
+  // Only the fused kernel computes a MatMul in a reduced precision, so a MatMul without post ops is converted as well.
+  bool fuse_single_matmul = kernel::MKLKernelEngine::Get().GetInferComputeType() != dnnl::memory::data_type::f32;
+  std::vector<AnfNodePtr> node_list = TopoSort(graph->get_return());
+  for (const auto &node : node_list) {
+    if (!AnfAlgo::IsRealCNodeKernel(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    PostOpChain chain;
+    if (!IsFusionHead(cnode)) {
+      continue;
+    }
+    if (!CollectPostOps(manager, cnode, &chain) &&
+        !(fuse_single_matmul && AnfAlgo::GetCNodeName(cnode) == prim::kPrimMatMul->name())) {
+      continue;
+    }
+    auto fused_node = CreateFusedNode(graph, manager, cnode, chain);
+    MS_LOG(INFO) << "Fuse " << chain.post_ops.size() << " post ops" << (chain.has_bias ? " and bias" : "") << " into "
+                 << fused_node->fullname_with_scope();
+    (void)manager->Replace(chain.tail, fused_node);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_POST_OP_FUSION_CPU_H
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_POST_OP_FUSION_CPU_H
+
+#include <string>
+#include "backend/optimizer/common/optimizer.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Folds the BiasAdd, residual Add and activation chain that follows a Conv2D or MatMul into a FusedConv2D or
+// FusedMatMul node, whose cpu kernel runs the chain as dnnl post ops instead of one memory pass per op.
+class PostOpFusionCPU : public Pass {
+ public:
+  explicit PostOpFusionCPU(const std::string &name) : Pass("post_op_fusion_cpu") {}
+  ~PostOpFusionCPU() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_POST_OP_FUSION_CPU_H
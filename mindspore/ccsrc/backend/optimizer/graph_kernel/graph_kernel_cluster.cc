@@ -19,6 +19,7 @@
 #include <map>
 #include <unordered_map>
 #include <set>
+#include <string>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -26,7 +27,9 @@
 
 #include "base/core_ops.h"
 #include "ir/graph_utils.h"
+#include "ir/tensor.h"
 #include "debug/common.h"
+#include "utils/ms_context.h"
 #include "utils/context/graph_kernel_flags.h"
 #include "backend/kernel_compiler/common_utils.h"
 #include "backend/session/anf_runtime_algorithm.h"
@@ -37,7 +40,83 @@
 namespace mindspore {
 namespace opt {
 namespace {
-std::vector<PrimitivePtr> GetClusterableOpList() {
+bool IsCpuTarget() {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  return context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice;
+}
+
+// Ops run by the cpu graph kernel interpreter, keep in sync with GraphKernelCPUKernel.
+std::vector<PrimitivePtr> GetCpuClusterableOpList() {
+  return {
+    prim::kPrimAbs,
+    prim::kPrimAdd,
+    prim::kPrimCast,
+    prim::kPrimEqual,
+    prim::kPrimExp,
+    prim::kPrimGreater,
+    prim::kPrimGreaterEqual,
+    prim::kPrimLess,
+    prim::kPrimLessEqual,
+    prim::kPrimLog,
+    prim::kPrimMaximum,
+    prim::kPrimMinimum,
+    prim::kPrimMul,
+    prim::kPrimNeg,
+    prim::kPrimNotEqual,
+    prim::kPrimPow,
+    prim::kPrimRealDiv,
+    prim::kPrimReciprocal,
+    prim::kPrimReduceMax,
+    prim::kPrimReduceMin,
+    prim::kPrimReduceSum,
+    prim::kPrimRelu,
+    prim::kPrimReshape,
+    prim::kPrimRound,
+    prim::kPrimRsqrt,
+    prim::kPrimSigmoid,
+    prim::kPrimSqrt,
+    prim::kPrimSquare,
+    prim::kPrimSub,
+    prim::kPrimTanh,
+  };
+}
+
+// The cpu interpreter computes in float32, so only types that convert to float32 exactly are clustered.
+bool IsCpuSupportedType(const AnfNodePtr &node) {
+  auto is_supported = [](TypeId type) {
+    return type == kNumberTypeFloat32 || type == kNumberTypeFloat16 || type == kNumberTypeBool;
+  };
+  auto input_types = AnfAlgo::GetAllInputDeviceTypes(node);
+  auto output_types = AnfAlgo::GetAllOutputDeviceTypes(node);
+  if (!std::all_of(input_types.begin(), input_types.end(), is_supported) ||
+      !std::all_of(output_types.begin(), output_types.end(), is_supported)) {
+    return false;
+  }
+  // The cpu graph kernel reads plain tensors only, nodes in a blocked layout region are left to oneDNN.
+  auto is_plain_format = [](const std::string &format) { return format != kOpFormat_NC1HWC0; };
+  auto input_formats = AnfAlgo::GetAllInputFormats(node);
+  auto output_formats = AnfAlgo::GetAllOutputFormats(node);
+  return std::all_of(input_formats.begin(), input_formats.end(), is_plain_format) &&
+         std::all_of(output_formats.begin(), output_formats.end(), is_plain_format);
+}
+
+// The cpu interpreter folds constant inputs into scalars, a tensor constant with more elements can not be clustered.
+bool HasNonScalarConstInput(const AnfNodePtr &node) {
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  const auto &inputs = cnode->inputs();
+  return std::any_of(inputs.begin() + 1, inputs.end(), [](const AnfNodePtr &input) {
+    auto value_node = input->cast<ValueNodePtr>();
+    if (value_node == nullptr) {
+      return false;
+    }
+    auto tensor = value_node->value()->cast<tensor::TensorPtr>();
+    return tensor != nullptr && tensor->DataSize() != 1;
+  });
+}
+
+std::vector<PrimitivePtr> GetAkgClusterableOpList() {
   std::vector<PrimitivePtr> clusterable_ops = {
     prim::kPrimAbs,
     prim::kPrimAdd,
@@ -102,6 +181,11 @@ std::vector<PrimitivePtr> GetClusterableOpList() {
     prim::kPrimStridedSlice,
 #endif
   };
+  return clusterable_ops;
+}
+
+std::vector<PrimitivePtr> GetClusterableOpList() {
+  auto clusterable_ops = IsCpuTarget() ? GetCpuClusterableOpList() : GetAkgClusterableOpList();
   const auto &flags = context::GraphKernelFlags::GetInstance();
   OpListFilter(&clusterable_ops, flags.enable_cluster_ops_only, flags.enable_cluster_ops, flags.disable_cluster_ops);
   return clusterable_ops;
@@ -133,6 +217,9 @@ bool IsClusterableOp(const AnfNodePtr &node) {
     return false;
   }
 #endif
+  if (IsCpuTarget() && (!IsCpuSupportedType(node) || HasNonScalarConstInput(node))) {
+    return false;
+  }
   return true;
 }
 
@@ -33,16 +33,27 @@
 #include "pipeline/jit/parse/python_adapter.h"
 #include "pipeline/jit/action.h"
 #include "utils/context/graph_kernel_flags.h"
+#include "utils/ms_context.h"
 #include "vm/segment_runner.h"
 #if ENABLE_D
 #include "runtime/device/ascend/kernel_select_ascend.h"
 #elif ENABLE_GPU
 #include "runtime/device/gpu/kernel_info_setter.h"
+#elif ENABLE_CPU
+#include "runtime/device/cpu/kernel_select_cpu.h"
 #endif
 
 namespace mindspore {
 namespace opt {
 namespace {
+// Composite kernels are compiled by akg on gpu and ascend, and interpreted by a cpu kernel on cpu.
+KernelType GetGraphKernelType() {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  return context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice ? KernelType::CPU_KERNEL
+                                                                                  : KernelType::AKG_KERNEL;
+}
+
 bool IsMakeTupleOut(const AnfNodePtr &out, AnfNodePtrList *real_outs) {
   MS_EXCEPTION_IF_NULL(real_outs);
   if (IsPrimitiveCNode(out, prim::kPrimMakeTuple)) {
@@ -294,7 +305,7 @@ kernel::KernelBuildInfoPtr BuildSelectKernelBuildInfo(const std::vector<std::str
   graph_info_builder.SetOutputsFormat(output_formats);
   graph_info_builder.SetOutputsDeviceType(output_types);
   graph_info_builder.SetProcessor(AnfAlgo::GetProcessor(node));
-  graph_info_builder.SetKernelType(KernelType::AKG_KERNEL);
+  graph_info_builder.SetKernelType(GetGraphKernelType());
   graph_info_builder.SetFusionType(kernel::FusionType::OPAQUE);
   return graph_info_builder.Build();
 }
@@ -310,7 +321,7 @@ kernel::KernelBuildInfoPtr BuildSelectKernelBuildInfo(const std::vector<std::str
   graph_info_builder.SetOutputsFormat(output_formats);
   graph_info_builder.SetOutputsDeviceType(output_types);
   graph_info_builder.SetProcessor(kernel::GetProcessorFromContext());
-  graph_info_builder.SetKernelType(KernelType::AKG_KERNEL);
+  graph_info_builder.SetKernelType(GetGraphKernelType());
   graph_info_builder.SetFusionType(kernel::FusionType::OPAQUE);
   return graph_info_builder.Build();
 }
@@ -340,7 +351,7 @@ void SetNewKernelInfo(const AnfNodePtr &new_node, const FuncGraphPtr &fg, const
     kernel::KernelBuildInfo::KernelBuildInfoBuilder para_info_builder;
     para_info_builder.SetOutputsFormat({graph_input_format.back()});
     para_info_builder.SetOutputsDeviceType({graph_input_type.back()});
-    para_info_builder.SetKernelType(KernelType::AKG_KERNEL);
+    para_info_builder.SetKernelType(GetGraphKernelType());
     para_info_builder.SetProcessor(kernel::GetProcessorFromContext());
     AnfAlgo::SetSelectKernelBuildInfo(para_info_builder.Build(), fg->parameters()[i].get());
   }
@@ -364,7 +375,7 @@ void SetNewKernelInfo(const AnfNodePtr &new_node, const FuncGraphPtr &fg, const
   graph_info_builder.SetOutputsFormat(graph_output_format);
   graph_info_builder.SetOutputsDeviceType(graph_output_type);
   graph_info_builder.SetProcessor(kernel::GetProcessorFromContext());
-  graph_info_builder.SetKernelType(KernelType::AKG_KERNEL);
+  graph_info_builder.SetKernelType(GetGraphKernelType());
   graph_info_builder.SetFusionType(kernel::FusionType::OPAQUE);
   auto graph_selected_info = graph_info_builder.Build();
   AnfAlgo::SetSelectKernelBuildInfo(graph_selected_info, new_node.get());
@@ -609,6 +620,9 @@ void ResetKernelInfo(const AnfNodePtr &node, KernelType kernel_type) {
 #elif ENABLE_GPU
   cnode->set_kernel_info(std::make_shared<device::KernelInfo>());
   device::gpu::SetKernelInfo(cnode, kernel_type);
+#elif ENABLE_CPU
+  cnode->set_kernel_info(std::make_shared<device::KernelInfo>());
+  device::cpu::SetKernelInfo(cnode);
 #endif
 }
 
@@ -746,7 +760,7 @@ CNodePtr CreateCNode(const std::vector<AnfNodePtr> &inputs, const FuncGraphPtr &
   info_builder.SetOutputsFormat(output_formats);
   info_builder.SetOutputsDeviceType(output_types);
   info_builder.SetProcessor(kernel::GetProcessorFromContext());
-  info_builder.SetKernelType(KernelType::AKG_KERNEL);
+  info_builder.SetKernelType(GetGraphKernelType());
   info_builder.SetFusionType(kernel::FusionType::OPAQUE);
   auto selected_info = info_builder.Build();
   AnfAlgo::SetSelectKernelBuildInfo(selected_info, cnode.get());
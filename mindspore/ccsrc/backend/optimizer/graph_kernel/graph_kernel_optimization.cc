@@ -82,8 +82,8 @@ PassManagerPtr GraphKernelOptimizer::Cluster() const {
   // Expand complex op to composite kernels
   pm->AddPass(std::make_shared<GraphKernelComplexExpander>(), OptLevel_1, false);
 
-  // Expand complex basic kernels to composite kernels
-  pm->AddPass(std::make_shared<GraphKernelExpander>(), OptLevel_1);
+  // Expand complex basic kernels to composite kernels, cpu only clusters the basic kernels it can interpret
+  pm->AddPass(std::make_shared<GraphKernelExpander>(), OptLevel_1, !is_cpu);
 
   // Cluster basic kernels and composite kernels
   pm->AddPass(std::make_shared<GraphKernelCluster>(), OptLevel_1);
@@ -106,11 +106,11 @@ PassManagerPtr GraphKernelOptimizer::HighLevelOpt1() const {
   pm->AddPass(std::make_shared<AxisNormalizer>(), OptLevel_1);
 
   // Replace Assign with InplaceAssign, and replace original output with overridden parameters
-  pm->AddPass(std::make_shared<OptimizeAssign>(), OptLevel_2);
+  pm->AddPass(std::make_shared<OptimizeAssign>(), OptLevel_2, !is_cpu);
   pm->AddPass(std::make_shared<EliminateRedundantOutput>(), OptLevel_2);
 
-  // Cast the input of ReduceSum from float16 to float32 for higher precision
-  pm->AddPass(std::make_shared<RaiseReductionPrecision>(), OptLevel_2);
+  // Cast the input of ReduceSum from float16 to float32 for higher precision, cpu always accumulates in float32
+  pm->AddPass(std::make_shared<RaiseReductionPrecision>(), OptLevel_2, !is_cpu);
 
   // Insert PadAkg and UnPadAkg Ops for MatMul
   pm->AddPass(std::make_shared<InsertPadOps>(), OptLevel_1, is_gpu);
@@ -136,7 +136,7 @@ PassManagerPtr GraphKernelOptimizer::Split() const {
   pm->AddPass(std::make_shared<ShapeOpsSplitter>(duplicated_ops), OptLevel_1);
 
   // Split kernel according to costmodel
-  pm->AddPass(std::make_shared<GraphKernelSplitter>(), OptLevel_1);
+  pm->AddPass(std::make_shared<GraphKernelSplitter>(), OptLevel_1, !is_cpu);
 
   // After Simplify and Splitter, a lot of redundant getitem/maketuple
   // will be exposed, use GetitemTuple Pass to delete them.
@@ -152,7 +152,7 @@ PassManagerPtr GraphKernelOptimizer::Split() const {
 PassManagerPtr GraphKernelOptimizer::HighLevelOpt2() const {
   auto pm = std::make_shared<GraphKernelPassManager>(4, "highlevelopt2");
   // Enable atomic add
-  pm->AddPass(std::make_shared<AtomicCleanInsertter>(), OptLevel_2);
+  pm->AddPass(std::make_shared<AtomicCleanInsertter>(), OptLevel_2, !is_cpu);
 
   // Enable atomic add for stitch nodes.
   auto level = GetPassLevelByFlag(context::GraphKernelFlags::GetInstance().enable_stitch_fusion);
@@ -160,7 +160,7 @@ PassManagerPtr GraphKernelOptimizer::HighLevelOpt2() const {
 
   // Enable low precision
   auto level_low_precision = GetPassLevelByFlag(context::GraphKernelFlags::GetInstance().enable_low_precision);
-  pm->AddPass(std::make_shared<DecreaseTransferPrecision>(), level_low_precision);
+  pm->AddPass(std::make_shared<DecreaseTransferPrecision>(), level_low_precision, !is_cpu);
   pm->AddPass(std::make_shared<DecreaseComputePrecision>(), level_low_precision, is_ascend);
   return pm;
 }
@@ -193,6 +193,7 @@ void GraphKernelOptimizer::Run(const KernelGraphPtr &kernel_graph) {
   MS_EXCEPTION_IF_NULL(context_ptr);
   is_gpu = (context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kGPUDevice);
   is_ascend = (context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kAscendDevice);
+  is_cpu = (context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice);
 
   auto optimizer = std::make_shared<GraphOptimizer>("graph_kernel_optimizer");
   optimizer->AddPassManager(PreProcess());
@@ -34,6 +34,10 @@ namespace {
 std::unordered_map<std::string, std::unordered_set<std::string>> MarkOp{
   {"LSTM", {"LSTMGradWeight", "LSTMGrad", "LSTMGradData"}}};
 
+// The gradients of these ops read the inputs of the op instead of its outputs.
+std::unordered_map<std::string, std::unordered_set<std::string>> MarkInputOp{
+  {"Conv2D", {"Conv2DBackpropInput", "Conv2DBackpropFilter"}}, {"MatMul", {}}};
+
 bool CheckOP(const FuncGraphManagerPtr &manager, const AnfNodePtr &cnode, const std::unordered_set<std::string> &set) {
   for (const auto &node_index : manager->node_users()[cnode]) {
     auto output = node_index.first;
@@ -65,6 +69,21 @@ void AddAttrTraining(const FuncGraphPtr &func_graph, const CNodePtr &cnode) {
     cnode->AddAttr(kAttrIsTraining, MakeValue(false));
   }
 }
+
+// An input is trained when a gradient op reads it or the graph updates the parameter it loads.
+void AddAttrTrainingByInputs(const FuncGraphPtr &func_graph, const CNodePtr &cnode) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  MS_EXCEPTION_IF_NULL(cnode);
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  const auto &set = MarkInputOp[AnfAlgo::GetCNodeName(cnode)];
+  bool is_training = false;
+  for (size_t i = 1; i < cnode->inputs().size() && !is_training; ++i) {
+    auto input = cnode->input(i);
+    is_training = CheckOP(manager, input, set) || IsWrittenParameter(manager, input);
+  }
+  cnode->AddAttr(kAttrIsTraining, MakeValue(is_training));
+}
 }  // namespace
 
 const AnfNodePtr AddTrainingAttr::Process(const FuncGraphPtr &func_graph, const AnfNodePtr &node,
@@ -77,11 +96,15 @@ const AnfNodePtr AddTrainingAttr::Process(const FuncGraphPtr &func_graph, const
     return nullptr;
   }
   auto name = AnfAlgo::GetCNodeName(node);
+  auto cnode = node->cast<CNodePtr>();
+  if (MarkInputOp.find(name) != MarkInputOp.end()) {
+    AddAttrTrainingByInputs(func_graph, cnode);
+    return cnode;
+  }
   auto iter = MarkOp.find(name);
   if (iter == MarkOp.end()) {
     return nullptr;
   }
-  auto cnode = node->cast<CNodePtr>();
   AddAttrTraining(func_graph, cnode);
   return cnode;
 }
@@ -29,8 +29,13 @@
 #include "backend/optimizer/common/pass_manager.h"
 #include "backend/optimizer/cpu/insert_cast_cpu.h"
 #include "backend/optimizer/cpu/insert_format_transform_op.h"
+#include "backend/optimizer/cpu/post_op_fusion_cpu.h"
+#include "backend/optimizer/cpu/multi_tensor_optimizer_fusion_cpu.h"
+#include "backend/optimizer/cpu/layout_propagation_cpu.h"
 #include "backend/optimizer/pass/replace_node_by_proxy.h"
 #include "backend/optimizer/pass/erase_visit_attr.h"
+#include "backend/optimizer/graph_kernel/graph_kernel_optimization.h"
+#include "utils/context/graph_kernel_flags.h"
 #include "debug/anf_ir_dump.h"
 #include "debug/dump_proto.h"
 #include "debug/data_dump/dump_json_parser.h"
@@ -91,12 +96,23 @@ void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
     }
   }
 #endif
+  pm->AddPass(std::make_shared<opt::PostOpFusionCPU>("post_op_fusion_cpu"));
+  pm->AddPass(std::make_shared<opt::MultiTensorOptimizerFusionCPU>("multi_tensor_optimizer_fusion_cpu"));
   pm->AddPass(std::make_shared<opt::InsertFormatTransformOpCPU>("insert_format_transform_op_cpu"));
+  pm->AddPass(std::make_shared<opt::LayoutPropagationCPU>("layout_propagation_cpu"));
   optimizer->AddPassManager(pm);
   (void)optimizer->Optimize(kernel_graph);
   kernel_graph->SetExecOrderByDefault();
 }
 
+void CPUSession::GraphKernelOptimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
+  if (!context::GraphKernelFlags::GetInstance().IsEnableGraphKernel()) {
+    return;
+  }
+  opt::GraphKernelOptimize(kernel_graph);
+  kernel_graph->SetExecOrderByDefault();
+}
+
 void CPUSession::ProcessCast(const std::shared_ptr<KernelGraph> &kernel_graph) {
   auto optimizer = std::make_shared<opt::GraphOptimizer>();
   auto pm = std::make_shared<opt::PassManager>();
@@ -119,6 +135,7 @@ GraphId CPUSession::CompileGraphImpl(const AnfNodePtrList &lst, const AnfNodePtr
   MS_LOG(INFO) << "Set kernel info end";
   Optimize(graph);
   FinalOptimize(graph);
+  GraphKernelOptimize(graph);
   MS_LOG(INFO) << "Build kernel";
   BuildKernel(graph.get());
   ProcessCast(graph);
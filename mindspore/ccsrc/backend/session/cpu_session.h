@@ -53,6 +53,7 @@ class CPUSession : public SessionBasic {
 
  private:
   void Reorder(std::vector<CNodePtr> *node_list);
+  void GraphKernelOptimize(const std::shared_ptr<KernelGraph> &kernel_graph);
   void ProcessCast(const std::shared_ptr<KernelGraph> &kernel_graph);
   void SetKernelInfo(const KernelGraph *kernel_graph);
   void BuildKernel(const KernelGraph *kernel_graph);
@@ -24,7 +24,7 @@ void CPUE2eDump::DumpCNodeData(const CNodePtr &node, uint32_t graph_id) {
   MS_EXCEPTION_IF_NULL(node);
   auto &dump_json_parser = DumpJsonParser::GetInstance();
   std::string kernel_name = GetKernelNodeName(node);
-  if (!dump_json_parser.NeedDump(kernel_name)) {
+  if (!dump_json_parser.NeedDump(kernel_name) || !IsWatchedKernel(kernel_name, node)) {
     return;
   }
 
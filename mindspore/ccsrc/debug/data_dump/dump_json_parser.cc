@@ -21,6 +21,7 @@
 #include "utils/convert_utils_base.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "debug/data_dump/npy_header.h"
+#include "debug/data_dump/dump_service.h"
 #include "debug/anf_ir_utils.h"
 #include "utils/comm_manager.h"
 
@@ -38,6 +39,12 @@ constexpr auto kSupportDevice = "support_device";
 constexpr auto kEnable = "enable";
 constexpr auto kOpDebugMode = "op_debug_mode";
 constexpr auto kTransFlag = "trans_flag";
+constexpr auto kSampleInterval = "sample_interval";
+constexpr auto kBackgroundWrite = "background_write";
+constexpr auto kStagingMemory = "staging_memory_mb";
+constexpr auto kWatchpointFilter = "watchpoint_filter";
+constexpr size_t kDumpWriterNum = 4;
+constexpr size_t kMegaByte = 1 << 20;
 constexpr auto kDumpInputAndOutput = 0;
 constexpr auto kDumpInputOnly = 1;
 constexpr auto kDumpOutputOnly = 2;
@@ -119,6 +126,9 @@ void DumpJsonParser::Parse() {
   ParseE2eDumpSetting(j);
   ParseCommonDumpSetting(j);
   JudgeDumpEnabled();
+  if (e2e_dump_enabled_ && background_write_) {
+    DumpService::GetInstance().Start(kDumpWriterNum, staging_memory_mb_ * kMegaByte);
+  }
 }
 
 void DumpJsonParser::CopyJsonToDir(uint32_t rank_id) {
@@ -268,6 +278,7 @@ void DumpJsonParser::ParseCommonDumpSetting(const nlohmann::json &content) {
   ParseInputOutput(*input_output);
   ParseKernels(*kernels);
   ParseSupportDevice(*support_device);
+  ParseSampleInterval(*common_dump_settings);  // The sample_interval field is optional.
   if (!e2e_dump_enabled_) {
     ParseOpDebugMode(*op_debug_mode);
   }
@@ -290,6 +301,7 @@ void DumpJsonParser::ParseE2eDumpSetting(const nlohmann::json &content) {
     MS_LOG(WARNING) << "Deprecated: Synchronous dump mode is deprecated and will be removed in a future release";
   }
   trans_flag_ = ParseEnable(*trans_flag);
+  ParseE2eWriteSetting(*e2e_dump_setting);
 }
 
 void CheckJsonUnsignedType(const nlohmann::json &content, const std::string &key) {
@@ -304,6 +316,12 @@ void CheckJsonStringType(const nlohmann::json &content, const std::string &key)
   }
 }
 
+void CheckJsonBoolType(const nlohmann::json &content, const std::string &key) {
+  if (!content.is_boolean()) {
+    MS_LOG(EXCEPTION) << "Dump config parse failed, " << key << " should be boolean type";
+  }
+}
+
 void CheckJsonArrayType(const nlohmann::json &content, const std::string &key) {
   if (!content.is_array()) {
     MS_LOG(EXCEPTION) << "Dump config parse failed, " << key << " should be array type";
@@ -375,6 +393,9 @@ void DumpJsonParser::ParseIteration(const nlohmann::json &content) {
 
 bool DumpJsonParser::IsDumpIter(uint32_t iteration) const {
   // bool DumpJsonParser::IsDumpIter(uint32_t iteration) --> checks if iteration should be dumped or not.
+  if (iteration % sample_interval_ != 0) {
+    return false;
+  }
   if (iteration_ == "all") {
     return true;
   }
@@ -452,6 +473,39 @@ void DumpJsonParser::ParseSupportDevice(const nlohmann::json &content) {
   }
 }
 
+void DumpJsonParser::ParseSampleInterval(const nlohmann::json &content) {
+  auto json_iter = content.find(kSampleInterval);
+  if (json_iter == content.end()) {
+    return;
+  }
+  CheckJsonUnsignedType(*json_iter, kSampleInterval);
+  sample_interval_ = *json_iter;
+  if (sample_interval_ == 0) {
+    MS_LOG(EXCEPTION) << "Dump config parse failed, sample_interval should be positive.";
+  }
+}
+
+void DumpJsonParser::ParseE2eWriteSetting(const nlohmann::json &content) {
+  auto background_write = content.find(kBackgroundWrite);
+  if (background_write != content.end()) {
+    CheckJsonBoolType(*background_write, kBackgroundWrite);
+    background_write_ = *background_write;
+  }
+  auto staging_memory = content.find(kStagingMemory);
+  if (staging_memory != content.end()) {
+    CheckJsonUnsignedType(*staging_memory, kStagingMemory);
+    staging_memory_mb_ = *staging_memory;
+    if (staging_memory_mb_ == 0) {
+      MS_LOG(EXCEPTION) << "Dump config parse failed, staging_memory_mb should be positive.";
+    }
+  }
+  auto watchpoint_filter = content.find(kWatchpointFilter);
+  if (watchpoint_filter != content.end()) {
+    CheckJsonBoolType(*watchpoint_filter, kWatchpointFilter);
+    watchpoint_filter_ = *watchpoint_filter;
+  }
+}
+
 bool DumpJsonParser::ParseEnable(const nlohmann::json &content) {
   if (!content.is_boolean()) {
     MS_LOG(EXCEPTION) << "Dump Json Parse Failed. 'enable' should be boolean type";
@@ -484,6 +538,14 @@ void DumpJsonParser::JsonConfigToString() {
   cur_config.append(std::to_string(e2e_dump_enabled_));
   cur_config.append(" async_dump_enable:");
   cur_config.append(std::to_string(async_dump_enabled_));
+  cur_config.append(" sample_interval:");
+  cur_config.append(std::to_string(sample_interval_));
+  cur_config.append(" background_write:");
+  cur_config.append(std::to_string(background_write_));
+  cur_config.append(" staging_memory_mb:");
+  cur_config.append(std::to_string(staging_memory_mb_));
+  cur_config.append(" watchpoint_filter:");
+  cur_config.append(std::to_string(watchpoint_filter_));
   MS_LOG(INFO) << cur_config;
 }
 
@@ -55,6 +55,9 @@ class DumpJsonParser {
   uint32_t input_output() const { return input_output_; }
   uint32_t op_debug_mode() const { return op_debug_mode_; }
   bool trans_flag() const { return trans_flag_; }
+  uint32_t sample_interval() const { return sample_interval_; }
+  bool background_write() const { return background_write_; }
+  bool watchpoint_filter() const { return watchpoint_filter_; }
   uint32_t cur_dump_iter() const { return cur_dump_iter_; }
   void UpdateDumpIter() { ++cur_dump_iter_; }
   bool GetIterDumpFlag() const;
@@ -84,6 +87,13 @@ class DumpJsonParser {
   std::set<uint32_t> support_devices_;
   uint32_t op_debug_mode_{0};
   bool trans_flag_{false};
+  // Only the iterations that are a multiple of the interval are dumped.
+  uint32_t sample_interval_{1};
+  // Write the e2e dump files on background threads, staging the data in at most staging_memory_mb_ of host memory.
+  bool background_write_{false};
+  size_t staging_memory_mb_{1024};
+  // Only dump the kernels the watchpoints of the debugger check, when the debugger is enabled.
+  bool watchpoint_filter_{false};
   uint32_t cur_dump_iter_{0};
   bool already_parsed_{false};
 
@@ -105,6 +115,8 @@ class DumpJsonParser {
   void ParseSupportDevice(const nlohmann::json &content);
   bool ParseEnable(const nlohmann::json &content);
   void ParseOpDebugMode(const nlohmann::json &content);
+  void ParseSampleInterval(const nlohmann::json &content);
+  void ParseE2eWriteSetting(const nlohmann::json &content);
 
   void JudgeDumpEnabled();
   void JsonConfigToString();
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "debug/data_dump/dump_service.h"
+
+#include <cstring>
+#include <utility>
+#include "debug/data_dump/dump_json_parser.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+void DumpService::Start(size_t thread_num, size_t memory_budget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!writers_.empty()) {
+    return;
+  }
+  if (thread_num == 0 || memory_budget == 0) {
+    MS_LOG(EXCEPTION) << "The dump writer thread number and staging memory should be positive, but got " << thread_num
+                      << " and " << memory_budget;
+  }
+  MS_LOG(INFO) << "Start " << thread_num << " dump writers with " << memory_budget << " bytes of staging memory.";
+  memory_budget_ = memory_budget;
+  stop_ = false;
+  for (size_t i = 0; i < thread_num; ++i) {
+    writers_.emplace_back(&DumpService::WriteLoop, this);
+  }
+}
+
+void DumpService::Stop() {
+  std::vector<std::thread> writers;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (writers_.empty()) {
+      return;
+    }
+    done_cond_.wait(lock, [this]() { return pending_num_ == 0; });
+    stop_ = true;
+    writers.swap(writers_);
+  }
+  task_cond_.notify_all();
+  space_cond_.notify_all();
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  MS_LOG(INFO) << "Dump writers stopped, " << failed_num_ << " files failed to be written.";
+}
+
+bool DumpService::running() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !writers_.empty();
+}
+
+bool DumpService::DumpToFile(const std::string &filename, const void *data, size_t len, const ShapeVector &shape,
+                             TypeId type) {
+  if (filename.empty() || data == nullptr || len == 0) {
+    return DumpJsonParser::DumpToFile(filename, data, len, shape, type);
+  }
+  {
+    // A tensor larger than the whole budget is staged alone.
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_cond_.wait(lock, [this, len]() {
+      return writers_.empty() || staging_bytes_ == 0 || staging_bytes_ + len <= memory_budget_;
+    });
+    if (writers_.empty()) {
+      lock.unlock();
+      return DumpJsonParser::DumpToFile(filename, data, len, shape, type);
+    }
+    staging_bytes_ += len;
+    ++pending_num_;
+  }
+  DumpTask task;
+  task.filename = filename;
+  task.data = std::make_unique<uint8_t[]>(len);
+  (void)memcpy(task.data.get(), data, len);
+  task.len = len;
+  task.shape = shape;
+  task.type = type;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push(std::move(task));
+  }
+  task_cond_.notify_one();
+  return true;
+}
+
+void DumpService::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cond_.wait(lock, [this]() { return pending_num_ == 0; });
+}
+
+size_t DumpService::staging_bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return staging_bytes_;
+}
+
+size_t DumpService::failed_num() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return failed_num_;
+}
+
+void DumpService::WriteLoop() {
+  while (true) {
+    DumpTask task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    bool ret = DumpJsonParser::DumpToFile(task.filename, task.data.get(), task.len, task.shape, task.type);
+    if (!ret) {
+      MS_LOG(ERROR) << "Write dump file " << task.filename << " failed.";
+    }
+    task.data.reset();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      staging_bytes_ -= task.len;
+      --pending_num_;
+      failed_num_ += ret ? 0 : 1;
+    }
+    space_cond_.notify_all();
+    done_cond_.notify_all();
+  }
+}
+}  // namespace mindspore
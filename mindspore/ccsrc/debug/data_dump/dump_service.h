@@ -0,0 +1,86 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_DUMP_SERVICE_H_
+#define MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_DUMP_SERVICE_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/ms_utils.h"
+#include "utils/shape_utils.h"
+#include "ir/dtype/type_id.h"
+
+namespace mindspore {
+// Writes the dump files on background threads. The data of a tensor is copied into a staging buffer when it is
+// submitted, so the kernel may reuse its memory at once, and the staging buffers of the files not written yet are kept
+// within a memory budget: a submission that does not fit waits for the writers to release buffers.
+class DumpService {
+ public:
+  static DumpService &GetInstance() {
+    static DumpService instance;
+    return instance;
+  }
+
+  // Start the writer threads, nothing is done when they are running already.
+  void Start(size_t thread_num, size_t memory_budget);
+  // Wait for the files submitted so far and stop the writer threads.
+  void Stop();
+  bool running();
+
+  // Dump the data to filename.npy as DumpJsonParser::DumpToFile does, in the background when the service is running.
+  // The returned value only tells whether the data was accepted, a failed background write is logged by the writer.
+  bool DumpToFile(const std::string &filename, const void *data, size_t len, const ShapeVector &shape, TypeId type);
+  // Wait until all the files submitted so far are written.
+  void Flush();
+
+  size_t staging_bytes();
+  size_t failed_num();
+
+ private:
+  struct DumpTask {
+    std::string filename;
+    std::unique_ptr<uint8_t[]> data;
+    size_t len{0};
+    ShapeVector shape;
+    TypeId type{kTypeUnknown};
+  };
+
+  DumpService() = default;
+  ~DumpService() { Stop(); }
+  DISABLE_COPY_AND_ASSIGN(DumpService)
+
+  void WriteLoop();
+
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable space_cond_;
+  std::condition_variable done_cond_;
+  std::queue<DumpTask> tasks_;
+  std::vector<std::thread> writers_;
+  size_t memory_budget_{0};
+  // The bytes of the submitted tasks not written yet, and their number.
+  size_t staging_bytes_{0};
+  size_t pending_num_{0};
+  size_t failed_num_{0};
+  bool stop_{false};
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_DUMP_SERVICE_H_
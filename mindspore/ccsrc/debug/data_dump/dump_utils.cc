@@ -22,8 +22,12 @@
 #include "utils/ms_context.h"
 #include "debug/anf_ir_utils.h"
 #include "debug/data_dump/dump_json_parser.h"
+#include "debug/data_dump/dump_service.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "runtime/device/kernel_runtime_manager.h"
+#ifdef ENABLE_DEBUGGER
+#include "debug/debugger/debugger.h"
+#endif
 
 namespace mindspore {
 uint32_t ConvertPhysicalDeviceId(uint32_t device_id) {
@@ -115,8 +119,31 @@ void GetDumpIntShape(const AnfNodePtr &node, size_t index, NotNull<ShapeVector *
   }
 }
 
+bool IsWatchedKernel(const std::string &kernel_name, const CNodePtr &kernel) {
+#ifdef ENABLE_DEBUGGER
+  if (!DumpJsonParser::GetInstance().watchpoint_filter()) {
+    return true;
+  }
+  auto debugger = Debugger::GetInstance();
+  if (debugger == nullptr || !debugger->debugger_enabled()) {
+    return true;
+  }
+  return debugger->DebugServicesIsWatchPoint(kernel_name, kernel);
+#else
+  return true;
+#endif
+}
+
 void DumpMemToFile(const std::string &file_path, const device::DeviceAddress &addr, const ShapeVector &int_shapes,
                    const TypeId &type, bool trans_flag) {
+  // The memory of a cpu address is on the host already, the background writers take a copy of it.
+  auto &dump_service = DumpService::GetInstance();
+  if (addr.DeviceType() == device::DeviceAddressType::kCPU && dump_service.running()) {
+    if (!dump_service.DumpToFile(file_path + '.' + addr.format(), addr.GetPtr(), addr.GetSize(), int_shapes, type)) {
+      MS_LOG(ERROR) << "DumpMemToFile Failed: path:" << file_path;
+    }
+    return;
+  }
   auto format = kOpFormat_DEFAULT;
   auto ret = addr.DumpMemToFile(file_path, format, int_shapes, type, trans_flag);
   if (!ret) {
@@ -35,6 +35,10 @@ void GetConstantId(const session::KernelGraph *graph, std::map<std::string, size
 
 void GetDumpIntShape(const AnfNodePtr &node, size_t index, NotNull<ShapeVector *> int_shapes, bool trans_flag = false);
 
+// Whether the kernel passes the watchpoint filter of the dump, which only lets the kernels the watchpoints of the
+// debugger check through.
+bool IsWatchedKernel(const std::string &kernel_name, const CNodePtr &kernel);
+
 void DumpMemToFile(const std::string &file_path, const device::DeviceAddress &addr, const ShapeVector &int_shapes,
                    const TypeId &type, bool trans_flag = false);
 // Get time stamp since epoch in microseconds
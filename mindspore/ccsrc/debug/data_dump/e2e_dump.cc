@@ -69,7 +69,7 @@ void E2eDump::DumpOutput(const session::KernelGraph *graph, const std::string &d
   for (const auto &node : apply_kernels) {
     MS_EXCEPTION_IF_NULL(node);
     std::string kernel_name = GetKernelNodeName(node);
-    if (!dump_json_parser.NeedDump(kernel_name)) {
+    if (!dump_json_parser.NeedDump(kernel_name) || !IsWatchedKernel(kernel_name, node)) {
       continue;
     }
     DumpJsonParser::GetInstance().MatchKernel(kernel_name);
@@ -85,7 +85,7 @@ void E2eDump::DumpOutputSingleNode(const CNodePtr &node, const std::string &dump
   bool trans_flag = dump_json_parser.trans_flag();
   MS_EXCEPTION_IF_NULL(node);
   std::string kernel_name = GetKernelNodeName(node);
-  if (!dump_json_parser.NeedDump(kernel_name)) {
+  if (!dump_json_parser.NeedDump(kernel_name) || !IsWatchedKernel(kernel_name, node)) {
     return;
   }
   DumpJsonParser::GetInstance().MatchKernel(kernel_name);
@@ -136,7 +136,7 @@ void E2eDump::DumpInput(const session::KernelGraph *graph, const std::string &du
   for (const auto &node : apply_kernels) {
     MS_EXCEPTION_IF_NULL(node);
     std::string kernel_name = GetKernelNodeName(node);
-    if (!dump_json_parser.NeedDump(kernel_name)) {
+    if (!dump_json_parser.NeedDump(kernel_name) || !IsWatchedKernel(kernel_name, node)) {
       continue;
     }
     DumpJsonParser::GetInstance().MatchKernel(kernel_name);
@@ -152,7 +152,7 @@ void E2eDump::DumpInputSingleNode(const CNodePtr &node, const std::string &dump_
   bool trans_flag = dump_json_parser.trans_flag();
   MS_EXCEPTION_IF_NULL(node);
   std::string kernel_name = GetKernelNodeName(node);
-  if (!dump_json_parser.NeedDump(kernel_name)) {
+  if (!dump_json_parser.NeedDump(kernel_name) || !IsWatchedKernel(kernel_name, node)) {
     return;
   }
   DumpJsonParser::GetInstance().MatchKernel(kernel_name);
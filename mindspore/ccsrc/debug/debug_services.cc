@@ -85,44 +85,47 @@ void DebugServices::RemoveWatchpoint(unsigned int id) {
 std::unique_ptr<ITensorSummary> GetSummaryPtr(const std::shared_ptr<TensorData> &tensor,
                                               void *const previous_tensor_ptr, uint32_t num_elements,
                                               int tensor_dtype) {
+  void *data_ptr = tensor->GetDataPtr();
+  // the statistics computed when the tensor was loaded or checked before, if any
+  auto statistics = tensor->GetStatistics();
   switch (tensor_dtype) {
     case DbgDataType::DT_UINT8: {
-      return std::make_unique<TensorSummary<uint8_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<uint8_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_INT8: {
-      return std::make_unique<TensorSummary<int8_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<int8_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_UINT16: {
-      return std::make_unique<TensorSummary<uint16_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<uint16_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_INT16: {
-      return std::make_unique<TensorSummary<int16_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<int16_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_UINT32: {
-      return std::make_unique<TensorSummary<uint32_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<uint32_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_INT32:
     case DbgDataType::DT_BASE_INT: {
-      return std::make_unique<TensorSummary<int32_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<int32_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_UINT64: {
-      return std::make_unique<TensorSummary<uint64_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<uint64_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_INT64: {
-      return std::make_unique<TensorSummary<int64_t>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<int64_t>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_FLOAT16: {
-      return std::make_unique<TensorSummary<float16>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<float16>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_FLOAT32:
     case DbgDataType::DT_BASE_FLOAT: {
-      return std::make_unique<TensorSummary<float>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<float>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_FLOAT64: {
-      return std::make_unique<TensorSummary<double>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<double>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     case DbgDataType::DT_BOOL: {
-      return std::make_unique<TensorSummary<bool>>(tensor->GetDataPtr(), previous_tensor_ptr, num_elements);
+      return std::make_unique<TensorSummary<bool>>(data_ptr, previous_tensor_ptr, num_elements, statistics);
     }
     default:
       MS_LOG(INFO) << "Unsupported tensor type";
@@ -159,6 +162,37 @@ void *DebugServices::GetPrevTensor(const std::shared_ptr<TensorData> &tensor, bo
   }
   return previous_tensor_ptr;
 }
+
+std::string DebugServices::GetStatisticsKey(const std::shared_ptr<TensorData> &tensor) {
+  return tensor->GetName() + ":" + std::to_string(tensor->GetSlot()) + ":" + std::to_string(tensor->GetIteration()) +
+         ":" + std::to_string(tensor->GetDeviceId()) + ":" + std::to_string(tensor->GetRootGraphId()) + ":" +
+         std::to_string(tensor->GetIsOutput());
+}
+
+std::shared_ptr<TensorData> DebugServices::GetCachedStatistics(const std::string &statistics_key) {
+  std::lock_guard<std::mutex> lg(statistics_lock_);
+  auto iter = statistics_cache_.find(statistics_key);
+  return iter == statistics_cache_.end() ? nullptr : iter->second;
+}
+
+void DebugServices::AddCachedStatistics(const std::string &statistics_key, const std::shared_ptr<TensorData> &tensor) {
+  if (tensor->GetStatistics() == nullptr) {
+    return;
+  }
+  // the data buffer is released after the check, only the description and the statistics are kept
+  auto cached_tensor = std::make_shared<TensorData>(*tensor);
+  cached_tensor->SetDataPtr(nullptr);
+  std::lock_guard<std::mutex> lg(statistics_lock_);
+  statistics_cache_[statistics_key] = cached_tensor;
+}
+
+void DebugServices::ResetCachedStatistics(unsigned int iteration) {
+  std::lock_guard<std::mutex> lg(statistics_lock_);
+  if (iteration != statistics_iteration_) {
+    statistics_cache_.clear();
+    statistics_iteration_ = iteration;
+  }
+}
 #endif
 
 void DebugServices::AddWatchPointsToCheck(bool init_dbg_suspend, bool step_end, bool recheck,
@@ -216,27 +250,9 @@ void DebugServices::CheckWatchpointsForTensor(
   std::vector<unsigned int> *root_graph_id) {
   for (int i = begin; i < end; i++) {
     auto &tensor = (*tensor_list)[i];
-#ifdef OFFLINE_DBG_MODE
-    // read data in offline mode
-    std::vector<std::shared_ptr<TensorData>> result_list;
-    ReadDumpedTensor(std::vector<std::string>{tensor->GetName()}, std::vector<size_t>{tensor->GetSlot()},
-                     std::vector<unsigned int>{tensor->GetDeviceId()},
-                     std::vector<unsigned int>{tensor->GetIteration()},
-                     std::vector<unsigned int>{tensor->GetRootGraphId()}, std::vector<bool>{tensor->GetIsOutput()},
-                     async_file_pool, &result_list);
-    tensor = result_list[0];
-    if (!tensor->GetByteSize()) {
-      tensor.reset();
-      continue;
-    }
-#endif
     const auto tensor_name = tensor->GetName();
     const auto tensor_name_no_slot = tensor_name.substr(0, tensor_name.find_first_of(':'));
     const auto tensor_slot = std::to_string(tensor->GetSlot());
-    // no elements to analyze
-    if (tensor->GetByteSize() == 0) continue;
-    (*chunk_tensor_byte_size)[chunk_id] += tensor->GetByteSize();
-    int tensor_dtype = tensor->GetType();
     std::vector<watchpoint_t> watchpoints_to_check;
     std::string qualified_tensor_name;
     bool previous_iter_tensor_needed = false;
@@ -246,6 +262,38 @@ void DebugServices::CheckWatchpointsForTensor(
                           &previous_iter_tensor_needed, &qualified_tensor_name, &watchpoints_to_check);
     // no wp set on current tensor
     if (watchpoints_to_check.empty()) continue;
+#ifdef OFFLINE_DBG_MODE
+    // the watchpoints needing only the statistics of a tensor checked before do not read its dump file again
+    const auto statistics_key = GetStatisticsKey(tensor);
+    auto cached_statistics = GetCachedStatistics(statistics_key);
+    bool statistics_only = std::all_of(watchpoints_to_check.begin(), watchpoints_to_check.end(),
+                                       [](const watchpoint_t &wp) { return wp.statistics_only(); });
+    if (cached_statistics == nullptr || !statistics_only) {
+      // read data in offline mode
+      std::vector<std::shared_ptr<TensorData>> result_list;
+      ReadDumpedTensor(std::vector<std::string>{tensor->GetName()}, std::vector<size_t>{tensor->GetSlot()},
+                       std::vector<unsigned int>{tensor->GetDeviceId()},
+                       std::vector<unsigned int>{tensor->GetIteration()},
+                       std::vector<unsigned int>{tensor->GetRootGraphId()}, std::vector<bool>{tensor->GetIsOutput()},
+                       async_file_pool, &result_list);
+      tensor = result_list[0];
+      if (!tensor->GetByteSize()) {
+        tensor.reset();
+        continue;
+      }
+      if (cached_statistics != nullptr) {
+        tensor->SetStatistics(cached_statistics->GetStatistics());
+      }
+    } else {
+      tensor = cached_statistics;
+    }
+#endif
+    // no elements to analyze
+    if (tensor->GetByteSize() == 0) continue;
+    if (tensor->GetDataPtr() != nullptr) {
+      (*chunk_tensor_byte_size)[chunk_id] += tensor->GetByteSize();
+    }
+    int tensor_dtype = tensor->GetType();
     uint32_t num_elements = tensor->GetNumElements();
 #ifdef OFFLINE_DBG_MODE
     void *previous_tensor_ptr = GetPrevTensor(tensor, previous_iter_tensor_needed);
@@ -259,6 +307,13 @@ void DebugServices::CheckWatchpointsForTensor(
       base_summary_ptr = GetSummaryPtr(tensor, previous_tensor_ptr, num_elements, tensor_dtype);
       if (base_summary_ptr != nullptr) {
         base_summary_ptr->SummarizeTensor(watchpoints_to_check);
+        // keep the statistics with the tensor, a re-check of the tensor does not compute them again
+        tensor->SetStatistics(base_summary_ptr->GetStatistics());
+#ifdef OFFLINE_DBG_MODE
+        if (cached_statistics == nullptr) {
+          AddCachedStatistics(statistics_key, tensor);
+        }
+#endif
       }
     }
     for (auto &wp : watchpoints_to_check) {
@@ -854,6 +909,8 @@ std::string DebugServices::GetStrippedFilename(const std::string &file_name) {
 
 std::vector<std::shared_ptr<TensorData>> DebugServices::ReadNeededDumpedTensors(
   unsigned int iteration, std::vector<std::string> *async_file_pool) {
+  // the statistics of the other iterations are not checked again
+  ResetCachedStatistics(iteration);
   // get a list of nodes and the devices they are on to monitor
   std::vector<std::shared_ptr<TensorData>> tensor_list;
   std::map<std::tuple<uint32_t, uint32_t>, std::vector<std::tuple<std::string, bool>>> device_and_graph_to_nodes;
@@ -1045,6 +1102,19 @@ bool DebugServices::DumpTensorToFile(const std::string &tensor_name, bool trans_
 #endif
 
 bool DebugServices::LoadNewTensor(const std::shared_ptr<TensorData> &tensor, bool keep_prev) {
+  bool has_watchpoint = false;
+  {
+    std::lock_guard<std::mutex> lg(lock_);
+    has_watchpoint = !watchpoint_table_.empty();
+  }
+  // compute the statistics while the data is hot in the cache, the check of the watchpoints only looks them up
+  if (has_watchpoint && tensor->GetStatistics() == nullptr && tensor->GetByteSize() != 0) {
+    auto summary_ptr = GetSummaryPtr(tensor, nullptr, tensor->GetNumElements(), tensor->GetType());
+    if (summary_ptr != nullptr) {
+      summary_ptr->SummarizeTensor({});
+      tensor->SetStatistics(summary_ptr->GetStatistics());
+    }
+  }
   return tensor_loader_->LoadNewTensor(tensor, keep_prev);
 }
 
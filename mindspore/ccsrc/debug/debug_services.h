@@ -184,6 +184,8 @@ class DebugServices {
     bool change_condition() const {
       return condition.type == CHANGE_TOO_LARGE || condition.type == CHANGE_TOO_SMALL || condition.type == NOT_CHANGED;
     }
+    // the condition is decided by the statistics of the tensor alone
+    bool statistics_only() const { return !change_condition() && !range_enabled(); }
   };
 
   void AddWatchpoint(
@@ -238,6 +240,16 @@ class DebugServices {
 
   void *GetPrevTensor(const std::shared_ptr<TensorData> &tensor, bool previous_iter_tensor_needed);
 
+  std::string GetStatisticsKey(const std::shared_ptr<TensorData> &tensor);
+
+  // returns a tensor without data holding the statistics of a tensor checked before, or nullptr
+  std::shared_ptr<TensorData> GetCachedStatistics(const std::string &statistics_key);
+
+  void AddCachedStatistics(const std::string &statistics_key, const std::shared_ptr<TensorData> &tensor);
+
+  // keeps the cached statistics only while the same iteration is checked again
+  void ResetCachedStatistics(unsigned int iteration);
+
   void ReadTensorFromNpy(const std::string &file_name, std::string *tensor_type, std::size_t *size,
                          std::vector<int64_t> *shape, std::vector<char> **data_buffer);
 
@@ -341,6 +353,13 @@ class DebugServices {
   bool is_sync_mode_;
 
   std::shared_ptr<TensorLoader> tensor_loader_;
+#ifdef OFFLINE_DBG_MODE
+  std::mutex statistics_lock_;
+  // the statistics of the tensors read from the dump files, a re-check of the statistics conditions uses them instead
+  // of reading the files again
+  std::unordered_map<std::string, std::shared_ptr<TensorData>> statistics_cache_;
+  unsigned int statistics_iteration_ = std::numeric_limits<unsigned int>::max();
+#endif
 };
 #ifdef ONLINE_DBG_MODE
 }  // namespace mindspore
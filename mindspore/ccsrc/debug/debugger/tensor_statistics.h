@@ -0,0 +1,121 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEBUG_DEBUGGER_TENSOR_STATISTICS_H_
+#define MINDSPORE_CCSRC_DEBUG_DEBUGGER_TENSOR_STATISTICS_H_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#ifdef ONLINE_DBG_MODE
+namespace mindspore {
+#endif
+// Statistics of the current value of a tensor. They answer every watchpoint condition that needs neither the value of
+// the previous iteration nor a range, so they are computed once per tensor and shared by all its watchpoints.
+struct TensorStatistics {
+  uint64_t num_elements{0};
+  double min{std::numeric_limits<double>::max()};
+  double max{std::numeric_limits<double>::lowest()};
+  uint64_t nan_count{0};
+  uint64_t inf_count{0};
+  uint64_t zero_count{0};
+  double mean{0.0};
+  double variance{0.0};
+  double abs_mean{0.0};
+
+  double sd() const { return std::sqrt(variance); }
+};
+
+// Computes the statistics in one pass. The elements are spread over independent lanes which the compiler maps onto
+// vector registers: the comparisons are selects, the counts are sums of the comparison results and the variance is
+// taken from sums shifted by the first finite element, so no lane waits on another one. NaN is left out of min and
+// max like std::min and std::max leave it out.
+template <typename T>
+TensorStatistics CalculateTensorStatistics(const T *data, uint64_t num_elements) {
+  constexpr size_t kLanes = 8;
+  const double inf = std::numeric_limits<double>::infinity();
+  TensorStatistics statistics;
+  statistics.num_elements = num_elements;
+  if (data == nullptr || num_elements == 0) {
+    return statistics;
+  }
+  double shift = 0.0;
+  for (uint64_t i = 0; i < num_elements; ++i) {
+    auto value = static_cast<double>(data[i]);
+    if (std::isfinite(value)) {
+      shift = value;
+      break;
+    }
+  }
+  double min[kLanes];
+  double max[kLanes];
+  double nan_count[kLanes] = {0};
+  double inf_count[kLanes] = {0};
+  double zero_count[kLanes] = {0};
+  double sum[kLanes] = {0};
+  double square_sum[kLanes] = {0};
+  double abs_sum[kLanes] = {0};
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    min[lane] = statistics.min;
+    max[lane] = statistics.max;
+  }
+  auto accumulate = [&](size_t lane, double value) {
+    min[lane] = value < min[lane] ? value : min[lane];
+    max[lane] = value > max[lane] ? value : max[lane];
+    nan_count[lane] += value != value;
+    inf_count[lane] += std::abs(value) == inf;
+    zero_count[lane] += value == 0;
+    double shifted = value - shift;
+    sum[lane] += shifted;
+    square_sum[lane] += shifted * shifted;
+    abs_sum[lane] += std::abs(value);
+  };
+  uint64_t vector_end = num_elements - num_elements % kLanes;
+  for (uint64_t i = 0; i < vector_end; i += kLanes) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      accumulate(lane, static_cast<double>(data[i + lane]));
+    }
+  }
+  for (uint64_t i = vector_end; i < num_elements; ++i) {
+    accumulate(i - vector_end, static_cast<double>(data[i]));
+  }
+  double total_sum = 0.0;
+  double total_square_sum = 0.0;
+  double total_abs_sum = 0.0;
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    statistics.min = min[lane] < statistics.min ? min[lane] : statistics.min;
+    statistics.max = max[lane] > statistics.max ? max[lane] : statistics.max;
+    statistics.nan_count += static_cast<uint64_t>(nan_count[lane]);
+    statistics.inf_count += static_cast<uint64_t>(inf_count[lane]);
+    statistics.zero_count += static_cast<uint64_t>(zero_count[lane]);
+    total_sum += sum[lane];
+    total_square_sum += square_sum[lane];
+    total_abs_sum += abs_sum[lane];
+  }
+  auto count = static_cast<double>(num_elements);
+  statistics.mean = shift + total_sum / count;
+  statistics.abs_mean = total_abs_sum / count;
+  if (num_elements > 1) {
+    // Rounding may take the difference of the sums slightly below zero.
+    double variance = (total_square_sum - total_sum * total_sum / count) / (count - 1);
+    statistics.variance = variance < 0 ? 0.0 : variance;
+  }
+  return statistics;
+}
+#ifdef ONLINE_DBG_MODE
+}  // namespace mindspore
+#endif
+#endif  // MINDSPORE_CCSRC_DEBUG_DEBUGGER_TENSOR_STATISTICS_H_
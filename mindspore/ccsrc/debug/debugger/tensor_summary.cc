@@ -69,55 +69,29 @@ void MeanCalculator::ProcessElement(double value) {
 
 double MeanCalculator::GetMean() const { return mean; }
 
-VarianceAndMeanCalculator::VarianceAndMeanCalculator() : mean(0.0), count(0), m2(0.0) {}
-
-void VarianceAndMeanCalculator::ProcessElement(double value) {
-  count += 1;
-  double delta = value - mean;
-  mean += delta / count;
-  m2 += delta * (value - mean);
-}
-
-double VarianceAndMeanCalculator::GetMean() const { return mean; }
-
-double VarianceAndMeanCalculator::GetVariance() const {
-  if (count > 1) {
-    return m2 / (count - 1);
-  } else {
-    return 0.0;
-  }
-}
-
-double VarianceAndMeanCalculator::GetStandardDeviation() { return sqrt(GetVariance()); }
-
 template <typename T>
-TensorSummary<T>::TensorSummary(void *current_tensor_ptr, void *const previous_tensor_ptr, uint32_t num_elements)
+TensorSummary<T>::TensorSummary(void *current_tensor_ptr, void *const previous_tensor_ptr, uint32_t num_elements,
+                                const std::shared_ptr<TensorStatistics> &statistics)
     : current_tensor_ptr(reinterpret_cast<T *>(current_tensor_ptr)),
       prev_tensor_ptr(reinterpret_cast<T *>(previous_tensor_ptr)),
       num_elements(num_elements),
-      min(std::numeric_limits<double>::max()),
-      max(std::numeric_limits<double>::lowest()),
-      inf_count(0),
-      nan_count(0),
-      zero_count(0),
       epsilon(1.0e-9),
-      mean_sd_cal_enabled(false) {}
+      statistics(statistics) {}
 
 template <typename T>
 void TensorSummary<T>::SummarizeTensor(const std::vector<DebugServices::watchpoint_t> &wps) {
   InitCalculators(wps);
+  if (statistics == nullptr) {
+    statistics = std::make_shared<TensorStatistics>(CalculateTensorStatistics(current_tensor_ptr, num_elements));
+  }
+  // The calculators left depend on the previous tensor or on the parameters of a watchpoint.
+  if (all_close.empty() && range_counts.empty() && means.empty()) {
+    return;
+  }
   for (size_t i = 0; i < num_elements; ++i) {
     auto current_value = static_cast<double>(current_tensor_ptr[i]);
     double previous_value =
       prev_tensor_ptr ? static_cast<double>(prev_tensor_ptr[i]) : std::numeric_limits<double>::quiet_NaN();
-    inf_count += std::isinf(current_value);
-    nan_count += std::isnan(current_value);
-    zero_count += (current_value == 0);
-    max = std::max(max, current_value);
-    min = std::min(min, current_value);
-    if (mean_sd_cal_enabled) {
-      current_mean_variance.ProcessElement(current_value);
-    }
     for (auto &it : all_close) {
       it.second->ProcessElement(current_value, previous_value);
     }
@@ -129,8 +103,6 @@ void TensorSummary<T>::SummarizeTensor(const std::vector<DebugServices::watchpoi
         mean.second->ProcessElement(std::abs(current_value - previous_value));
       } else if (mean.first == "abs_prev_mean") {
         mean.second->ProcessElement(std::abs(previous_value));
-      } else if (mean.first == "abs_current_mean") {
-        mean.second->ProcessElement(std::abs(current_value));
       }
     }
   }
@@ -144,6 +116,8 @@ std::tuple<bool, int, std::vector<DebugServices::parameter_t>> TensorSummary<T>:
   const uint8_t bit_size = 32;
   std::bitset<bit_size> error_code;
   CONDITION_TYPE type = wp.condition.type;
+  auto nan_count = statistics->nan_count;
+  auto inf_count = statistics->inf_count;
   // bit 0 denotes presence of nan
   error_code.set(0, nan_count > 0);
   // bit 1 denotes presence of inf
@@ -196,19 +170,17 @@ double_t TensorSummary<T>::StatLookup(const std::string &parameter_name, const D
   }
 
   if (param_type == "max") {
-    return max;
+    return statistics->max;
   } else if (param_type == "min") {
-    return min;
+    return statistics->min;
   } else if (param_type == "max_min") {
-    return max - min;
+    return statistics->max - statistics->min;
   } else if (param_type == "mean") {
-    return current_mean_variance.GetMean();
+    return statistics->mean;
   } else if (param_type == "sd") {
-    return current_mean_variance.GetStandardDeviation();
+    return statistics->sd();
   } else if (param_type == "abs_mean") {
-    if (means.find("abs_current_mean") != means.end()) {
-      return means["abs_current_mean"]->GetMean();
-    }
+    return statistics->abs_mean;
   } else if (param_type == "abs_mean_update_ratio" && prev_tensor_ptr) {
     if (means.find("curr_prev_diff_mean") != means.end() && means.find("abs_prev_mean") != means.end()) {
       return means["curr_prev_diff_mean"]->GetMean() / (means["abs_prev_mean"]->GetMean() + epsilon);
@@ -227,33 +199,32 @@ template <typename T>
 double_t TensorSummary<T>::StatLookup(const DebugServices::watchpoint_t &wp) {
   CONDITION_TYPE type = wp.condition.type;
   if (type == CONDITION_TYPE::MAX_LT || type == CONDITION_TYPE::MAX_GT) {
-    return max;
+    return statistics->max;
   } else if (type == CONDITION_TYPE::MIN_LT || type == CONDITION_TYPE::MIN_GT) {
-    return min;
+    return statistics->min;
   } else if (type == CONDITION_TYPE::MEAN_LT || type == CONDITION_TYPE::MEAN_GT) {
-    return current_mean_variance.GetMean();
+    return statistics->mean;
   } else if (type == CONDITION_TYPE::SD_LT || type == CONDITION_TYPE::SD_GT) {
-    return current_mean_variance.GetStandardDeviation();
+    return statistics->sd();
   } else if (type == CONDITION_TYPE::MAX_MIN_GT || type == CONDITION_TYPE::MAX_MIN_LT) {
-    return max - min;
+    return statistics->max - statistics->min;
   }
   return std::numeric_limits<double_t>::quiet_NaN();
 }
 
 template <typename T>
 double_t TensorSummary<T>::GetZeroValPercent() {
-  if (num_elements == 0) {
+  if (statistics->num_elements == 0) {
     return 0;
   }
 
-  return (zero_count * 100.0) / num_elements;
+  return (statistics->zero_count * 100.0) / statistics->num_elements;
 }
 
 template <typename T>
 void TensorSummary<T>::InitCalculators(const std::vector<DebugServices::watchpoint_t> &wps) {
   for (auto &wp : wps) {
     auto wp_id = wp.id;
-    mean_sd_cal_enabled = mean_sd_cal_enabled || wp.mean_sd_enabled();
     if (wp.allclose_enabled() && prev_tensor_ptr) {
       all_close[wp_id] = std::make_unique<AllCloseCalculator>();
       if (!wp.parameter_list[0].disabled) {
@@ -273,8 +244,6 @@ void TensorSummary<T>::InitCalculators(const std::vector<DebugServices::watchpoi
     } else if (wp.tensor_update_ratio_mean_enabled() && prev_tensor_ptr) {
       means.insert({"curr_prev_diff_mean", std::make_unique<MeanCalculator>()});
       means.insert({"abs_prev_mean", std::make_unique<MeanCalculator>()});
-    } else if (wp.abs_mean_enabled()) {
-      means.insert({"abs_current_mean", std::make_unique<MeanCalculator>()});
     }
   }
 }
@@ -23,6 +23,7 @@
 #include <string>
 
 #include "debug/debug_services.h"
+#include "debug/debugger/tensor_statistics.h"
 
 #ifdef ONLINE_DBG_MODE
 namespace mindspore {
@@ -70,21 +71,6 @@ class MeanCalculator {
   int count;
 };
 
-class VarianceAndMeanCalculator {
- public:
-  VarianceAndMeanCalculator();
-  ~VarianceAndMeanCalculator() = default;
-  void ProcessElement(double value);
-  double GetStandardDeviation();
-  double GetVariance() const;
-  double GetMean() const;
-
- private:
-  double mean;
-  int count;
-  double m2;
-};
-
 class ITensorSummary {
  public:
   enum WatchpointPos { eHitPos = 0, eErrorCodePos = 1, eParamListPos = 2 };
@@ -92,6 +78,8 @@ class ITensorSummary {
   virtual void SummarizeTensor(const std::vector<DebugServices::watchpoint_t> &) = 0;
   virtual std::tuple<bool, int32_t, std::vector<DebugServices::parameter_t>> IsWatchpointHit(
     DebugServices::watchpoint_t) = 0;
+  // The statistics of the current tensor, valid after SummarizeTensor.
+  virtual std::shared_ptr<TensorStatistics> GetStatistics() const = 0;
 };
 
 template <typename T>
@@ -99,23 +87,19 @@ class TensorSummary : public ITensorSummary {
  public:
   TensorSummary() = default;
   ~TensorSummary() override = default;
-  TensorSummary(void *, void *, uint32_t);
+  // The statistics of the current tensor are computed by SummarizeTensor unless they are given.
+  TensorSummary(void *, void *, uint32_t, const std::shared_ptr<TensorStatistics> &statistics = nullptr);
   void SummarizeTensor(const std::vector<DebugServices::watchpoint_t> &) override;
   // returns hit, error_code, parameter_list
   std::tuple<bool, int, std::vector<DebugServices::parameter_t>> IsWatchpointHit(DebugServices::watchpoint_t) override;
+  std::shared_ptr<TensorStatistics> GetStatistics() const override { return statistics; }
 
  private:
   T *current_tensor_ptr;
   T *prev_tensor_ptr;
   uint32_t num_elements;
-  double min;
-  double max;
-  uint32_t inf_count;
-  uint32_t nan_count;
-  uint32_t zero_count;
   double epsilon;
-  bool mean_sd_cal_enabled;
-  VarianceAndMeanCalculator current_mean_variance;
+  std::shared_ptr<TensorStatistics> statistics;
   std::unordered_map<std::string, std::unique_ptr<MeanCalculator>> means;
   std::unordered_map<uint32_t, std::unique_ptr<AllCloseCalculator>> all_close;
   std::unordered_map<uint32_t, std::unique_ptr<RangeCountCalculator>> range_counts;
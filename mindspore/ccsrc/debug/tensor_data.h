@@ -21,6 +21,8 @@
 #include <string>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include "debug/debugger/tensor_statistics.h"
 #ifdef OFFLINE_DBG_MODE
 #include "debugger/offline_debug/offline_logger.h"
 #else
@@ -174,6 +176,7 @@ class TensorData {
     this->data_ptr_ = obj.data_ptr_;
     this->root_graph_id_ = obj.root_graph_id_;
     this->is_output_ = obj.is_output_;
+    this->statistics_ = obj.statistics_;
 #ifdef ONLINE_DBG_MODE
     this->tensor_ptr_ = obj.tensor_ptr_;
 #endif
@@ -233,6 +236,11 @@ class TensorData {
 
   void SetIsOutput(bool is_output) { this->is_output_ = is_output; }
 
+  // The statistics of the data, computed once when the tensor is checked or loaded.
+  std::shared_ptr<TensorStatistics> GetStatistics() const { return this->statistics_; }
+
+  void SetStatistics(const std::shared_ptr<TensorStatistics> &statistics) { this->statistics_ = statistics; }
+
   void ConvertMsToDbgType(uint32_t type) {
     switch (type) {
       case MsTypeId::kNumberTypeBool:
@@ -420,6 +428,7 @@ class TensorData {
   unsigned int root_graph_id_;
   bool is_output_;
   int execution_order_;
+  std::shared_ptr<TensorStatistics> statistics_;
 #ifdef ONLINE_DBG_MODE
   mindspore::tensor::TensorPtr tensor_ptr_;
 #endif
@@ -29,6 +29,7 @@
 #include "debug/tensor_data.h"
 #ifdef ONLINE_DBG_MODE
 #include "debug/data_dump/dump_json_parser.h"
+#include "debug/data_dump/dump_service.h"
 namespace mindspore {
 #endif
 class TensorLoader {
@@ -179,7 +180,7 @@ class TensorLoader {
       std::shared_ptr<TensorData> node = iter->second;
       size_t host_size = node->GetByteSize();
 
-      return DumpJsonParser::DumpToFile(path, node->GetDataPtr(), host_size, host_shape, host_type);
+      return DumpService::GetInstance().DumpToFile(path, node->GetDataPtr(), host_size, host_shape, host_type);
     }
     MS_LOG(INFO) << "Tensor name:" << tensor_name << " not found in tensor_list_map_";
     return true;
@@ -193,7 +193,12 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
               changes_since_last_renorm = true;
             }
           };
+          size_t recompute_count = AnalysisRecomputeCount();
           use_profile ? (WITH(MsProfile::GetProfile()->Step(pass_names_[i])) opt_func) : opt_func();
+          if (AnalysisRecomputeCount() > recompute_count) {
+            MS_LOG(INFO) << "Optimizer " << name_ << " pass " << pass_names_[i] << " recomputed "
+                         << (AnalysisRecomputeCount() - recompute_count) << " manager analyses.";
+          }
           static const auto enable_dump_pass_ir = (common::GetEnv("ENV_DUMP_PASS_IR") == "1");
           if (enable_dump_pass_ir && MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG)) {
             auto fg_name =
@@ -255,6 +260,14 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
   bool is_on_debug_{false};
 
  private:
+  // Number of times the analyses of the resource manager have been recomputed, logged for each pass.
+  size_t AnalysisRecomputeCount() const {
+    if (resource_ == nullptr || resource_->manager() == nullptr) {
+      return 0;
+    }
+    return resource_->manager()->analysis_recompute_count();
+  }
+
   const std::string name_;
   pipeline::ResourceBasePtr resource_;
   std::vector<OptPass> passes_;
@@ -45,6 +45,9 @@
 #include "backend/session/executor_manager.h"
 #include "debug/trace.h"
 #include "debug/draw.h"
+#ifndef ENABLE_SECURITY
+#include "debug/data_dump/dump_service.h"
+#endif
 #include "pipeline/pynative/pynative_execute.h"
 #include "frontend/optimizer/py_pass_manager.h"
 #include "pybind_api/pybind_patch.h"
@@ -1313,6 +1316,10 @@ void ClearResAtexit() {
 #endif
 #ifdef ENABLE_DUMP_IR
   mindspore::RDR::ResetRecorder();
+#endif
+#ifndef ENABLE_SECURITY
+  // Write the pending dump files before the graphs and the devices are released.
+  DumpService::GetInstance().Stop();
 #endif
   session::ExecutorManager::Instance().Clear();
   device::KernelRuntimeManager::Instance().ClearRuntimeResource();
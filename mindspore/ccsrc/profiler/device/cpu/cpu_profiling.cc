@@ -19,6 +19,7 @@
 #include <cxxabi.h>
 #include <cmath>
 #include <ctime>
+#include "actor/actor.h"
 #include "profiler/device/cpu/cpu_data_saver.h"
 #include "pybind_api/api_register.h"
 #include "utils/log_adapter.h"
@@ -39,30 +40,65 @@ void CPUProfiler::Init(const std::string &profileDataPath = "") {
   MS_LOG(INFO) << " Host start time(ns): " << base_time_ << " profile data path: " << profile_data_path_;
 }
 
+namespace {
+// The op a thread is launching, kernel actors on different threads launch their ops at the same time.
+struct OpLaunch {
+  uint64_t start{0};
+  uint32_t name_id{0};
+  uint32_t pid{0};
+};
+thread_local OpLaunch op_launch;
+
+// The actor stamps the messages with the steady clock, only the wait is taken from it, the span ends now on the clock
+// of the recorder.
+void RecordActorMessage(const ActorBase *actor, uint64_t enqueue_time, uint64_t dequeue_time) {
+  auto end = TraceRecorder::Now();
+  auto wait_time = std::min(dequeue_time - enqueue_time, end);
+  TraceRecorder::GetInstance().Record(TraceEventType::kActorMessage, actor->GetAID().Name(), end - wait_time, end);
+}
+}  // namespace
+
 void CPUProfiler::StepProfilingEnable(const bool enable_flag) {
   MS_LOG(INFO) << "CPU Profiler enable flag: " << enable_flag;
   enable_flag_ = enable_flag;
+  auto &recorder = TraceRecorder::GetInstance();
+  ActorBase::SetMessageLatencyHook(enable_flag ? RecordActorMessage : nullptr);
+  if (enable_flag) {
+    // The kernel launches are summed up at every collection, the recorder keeps only the newest events for the trace.
+    recorder.SetCollectHook([this](const std::vector<TraceEvent> &events) { SetRunTimeData(events); });
+    recorder.SetEnable(true);
+  } else {
+    recorder.SetEnable(false);
+    recorder.Collect();
+    recorder.SetCollectHook(nullptr);
+  }
 }
 
-void CPUProfiler::SetRunTimeData(const std::string &op_name, const uint32_t pid) {
-  auto iter = op_info_map_.find(op_name);
-  if (iter != op_info_map_.end()) {
+void CPUProfiler::SetRunTimeData(const std::vector<TraceEvent> &events) {
+  auto &recorder = TraceRecorder::GetInstance();
+  for (const auto &event : events) {
+    if (event.type != TraceEventType::kKernelLaunch) {
+      continue;
+    }
+    auto op_name = recorder.GetName(event.name_id);
+    auto iter = op_info_map_.find(op_name);
+    if (iter == op_info_map_.end()) {
+      OpInfo op_info;
+      op_info.op_name = op_name;
+      op_info.pid = static_cast<uint32_t>(event.arg);
+      iter = op_info_map_.emplace(op_name, op_info).first;
+    }
+    float op_time_elapsed = (event.end - event.begin) / kNanosecondToMillisecond;
     iter->second.op_count += 1;
-  } else {
-    OpInfo op_info;
-    op_info.op_name = op_name;
-    op_info.pid = pid;
-    op_info.op_count = 1;
-    op_info_map_[op_name] = op_info;
+    iter->second.op_host_cost_time += op_time_elapsed;
+    iter->second.start_duration.emplace_back(StartDuration({event.begin, op_time_elapsed}));
   }
-  op_name_ = op_name;
-  pid_ = pid;
 }
 
 void CPUProfiler::OpDataProducerBegin(const std::string op_name, const uint32_t pid) {
-  op_time_start_ = GetHostMonoTimeStamp();
-  op_time_mono_start_ = GetHostMonoTimeStamp();
-  SetRunTimeData(op_name, pid);
+  op_launch.name_id = TraceRecorder::GetInstance().GetNameId(op_name);
+  op_launch.pid = pid;
+  op_launch.start = TraceRecorder::Now();
 
 #if ENABLE_GPU
   if (MsContext::GetInstance()->get_param<bool>(MS_CTX_ENABLE_MINDRT)) {
@@ -77,16 +113,13 @@ void CPUProfiler::OpDataProducerBegin(const std::string op_name, const uint32_t
 }
 
 void CPUProfiler::OpDataProducerEnd() {
-  float op_time_elapsed = 0;
-  op_time_stop_ = GetHostMonoTimeStamp();
-  op_time_elapsed = (op_time_stop_ - op_time_start_) / kNanosecondToMillisecond;
-  MS_LOG(DEBUG) << "Host Time Elapsed(ms)," << op_name_ << "," << op_time_elapsed;
-  Profiler::SetRunTimeData(op_name_, op_time_elapsed);
-  Profiler::SetRunTimeData(op_name_, op_time_mono_start_, op_time_elapsed);
+  TraceRecorder::GetInstance().Record(TraceEventType::kKernelLaunch, op_launch.name_id, op_launch.start,
+                                      TraceRecorder::Now(), op_launch.pid);
 }
 
 void CPUProfiler::Stop() {
   MS_LOG(INFO) << "Stop CPU Profiling";
+  StepProfilingEnable(false);
   SaveProfileData();
   ClearInst();
 }
@@ -99,10 +132,16 @@ void CPUProfiler::SaveProfileData() {
     MS_EXCEPTION_IF_NULL(cpu_data_saver_inst);
     cpu_data_saver_inst->ParseOpInfo(op_info_map_);
     cpu_data_saver_inst->WriteFile(profile_data_path_);
+    auto device_id = MsContext::GetInstance()->get_param<uint32_t>(MS_CTX_DEVICE_ID);
+    (void)TraceRecorder::GetInstance().ExportChromeTrace(profile_data_path_ + "/cpu_trace_" +
+                                                         std::to_string(device_id) + ".json");
   }
 }
 
-void CPUProfiler::ClearInst() { op_info_map_.clear(); }
+void CPUProfiler::ClearInst() {
+  op_info_map_.clear();
+  TraceRecorder::GetInstance().ClearEvents();
+}
 
 REGISTER_PYBIND_DEFINE(CPUProfiler_, ([](const py::module *m) {
                          (void)py::class_<CPUProfiler, std::shared_ptr<CPUProfiler>>(*m, "CPUProfiler")
@@ -23,7 +23,9 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include "profiler/device/profiling.h"
+#include "profiler/device/trace_recorder.h"
 #if ENABLE_GPU
 #include "profiler/device/gpu/gpu_profiling.h"
 #endif
@@ -48,18 +50,13 @@ class CPUProfiler : public Profiler {
   void OpDataProducerEnd() override;
 
  private:
-  void SetRunTimeData(const std::string &op_name, const uint32_t pid);
+  // Add the kernel launches the trace recorder collected to the op infos.
+  void SetRunTimeData(const std::vector<TraceEvent> &events);
   void SaveProfileData() override;
   void ClearInst() override;
 
   static std::shared_ptr<CPUProfiler> profiler_inst_;
   uint64_t base_time_;
-  std::string op_name_;
-  uint32_t pid_;
-
-  uint64_t op_time_start_;
-  uint64_t op_time_mono_start_;
-  uint64_t op_time_stop_;
 };
 }  // namespace cpu
 }  // namespace profiler
@@ -19,6 +19,7 @@
 #include <cxxabi.h>
 #include <cmath>
 #include <ctime>
+#include "profiler/device/trace_recorder.h"
 #include "pybind_api/api_register.h"
 #include "utils/log_adapter.h"
 #include "utils/utils.h"
@@ -30,7 +31,7 @@ namespace mindspore {
 namespace profiler {
 std::shared_ptr<ProfilerManager> ProfilerManager::profiler_manager_inst_ = std::make_shared<ProfilerManager>();
 
-uint64_t Profiler::GetHostMonoTimeStamp() const {
+uint64_t Profiler::GetHostMonoTimeStamp() {
   struct timespec ts;
 #if defined(_WIN32) || defined(_WIN64)
   if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
@@ -94,12 +95,19 @@ std::shared_ptr<ProfilerManager> &ProfilerManager::GetInstance() {
 
 bool ProfilerManager::GetEnableRecorderActorFlag() {
 #if ENABLE_GPU
-  return profiler::gpu::GPUProfiler::GetInstance()->GetEnableFlag();
+  if (profiler::gpu::GPUProfiler::GetInstance()->GetEnableFlag()) {
+    return true;
+  }
 #endif
-  return false;
+  return TraceRecorder::GetInstance().enabled();
 }
 
 void ProfilerManager::RecordOneStepStartEndInfo() {
+  // Merge the events the threads recorded in this step, so the buffers of the threads do not spill.
+  auto &trace_recorder = TraceRecorder::GetInstance();
+  if (trace_recorder.enabled()) {
+    trace_recorder.Collect();
+  }
 #if ENABLE_GPU
   auto gpu_profiler_inst = profiler::gpu::GPUProfiler::GetInstance();
   if (gpu_profiler_inst->GetEnableFlag()) {
@@ -78,6 +78,7 @@ class Profiler {
   void RecordOneStepStartEndInfo();
   bool GetEnableFlag() const { return enable_flag_; }
   std::string ProfileDataPath() const { return profile_data_path_; }
+  static uint64_t GetHostMonoTimeStamp();
   void RecordOneStepStartEndInfo(std::string op_name);
   std::pair<double, double> GetSingleOpLaunchTime() { return single_op_launch_start_time_end_time_; }
   void SetSingleOpLaunchTime(const std::pair<double, double> &launch_start_end) {
@@ -87,7 +88,6 @@ class Profiler {
  protected:
   void SetRunTimeData(const std::string &op_name, const float time_elapsed);
   void SetRunTimeData(const std::string &op_name, const uint64_t start, const float duration);
-  uint64_t GetHostMonoTimeStamp() const;
   virtual void SaveProfileData() = 0;
   virtual void ClearInst() = 0;
   std::pair<double, double> single_op_launch_start_time_end_time_;
@@ -0,0 +1,240 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler/device/trace_recorder.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include "profiler/device/profiling.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace profiler {
+namespace {
+constexpr double kNanosecondToMicrosecond = 1000.0;
+
+const char *GetCategory(TraceEventType type) {
+  switch (type) {
+    case TraceEventType::kKernelLaunch:
+      return "kernel";
+    case TraceEventType::kActorMessage:
+      return "actor_message";
+    case TraceEventType::kMemoryAlloc:
+      return "memory_alloc";
+    case TraceEventType::kMemoryFree:
+      return "memory_free";
+    default:
+      return "data_queue";
+  }
+}
+
+void WriteJsonString(std::ostream &os, const std::string &str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << ' ';
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+}  // namespace
+
+void TraceBuffer::Push(const TraceEvent &event) {
+  size_t head = head_.load(std::memory_order_relaxed);
+  if (head - tail_.load(std::memory_order_acquire) == kCapacity) {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    DrainLocked(&spilled_);
+  }
+  auto &slot = events_[head % kCapacity];
+  slot = event;
+  slot.tid = tid_;
+  head_.store(head + 1, std::memory_order_release);
+}
+
+void TraceBuffer::DrainLocked(std::vector<TraceEvent> *events) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  size_t head = head_.load(std::memory_order_acquire);
+  for (; tail < head; ++tail) {
+    events->emplace_back(events_[tail % kCapacity]);
+  }
+  tail_.store(tail, std::memory_order_release);
+}
+
+void TraceBuffer::Drain(std::vector<TraceEvent> *events) {
+  std::lock_guard<std::mutex> lock(drain_mutex_);
+  (void)events->insert(events->end(), spilled_.begin(), spilled_.end());
+  spilled_.clear();
+  DrainLocked(events);
+}
+
+TraceRecorder &TraceRecorder::GetInstance() {
+  static TraceRecorder instance;
+  return instance;
+}
+
+uint64_t TraceRecorder::Now() { return Profiler::GetHostMonoTimeStamp(); }
+
+void TraceRecorder::SetEnable(bool enable) {
+  MS_LOG(INFO) << "Trace recorder enable flag: " << enable;
+  enabled_.store(enable, std::memory_order_relaxed);
+}
+
+uint32_t TraceRecorder::GetNameId(const std::string &name) {
+  thread_local std::unordered_map<std::string, uint32_t> name_cache;
+  auto cache_iter = name_cache.find(name);
+  if (cache_iter != name_cache.end()) {
+    return cache_iter->second;
+  }
+  uint32_t name_id = 0;
+  {
+    std::lock_guard<std::mutex> lock(name_mutex_);
+    auto iter = name_ids_.find(name);
+    if (iter != name_ids_.end()) {
+      name_id = iter->second;
+    } else {
+      name_id = static_cast<uint32_t>(names_.size());
+      names_.emplace_back(name);
+      name_ids_[name] = name_id;
+    }
+  }
+  name_cache[name] = name_id;
+  return name_id;
+}
+
+std::string TraceRecorder::GetName(uint32_t name_id) {
+  std::lock_guard<std::mutex> lock(name_mutex_);
+  return name_id < names_.size() ? names_[name_id] : "";
+}
+
+TraceBuffer *TraceRecorder::GetThreadBuffer() {
+  thread_local TraceBuffer *buffer = nullptr;
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    buffers_.emplace_back(std::make_unique<TraceBuffer>(static_cast<uint32_t>(buffers_.size())));
+    buffer = buffers_.back().get();
+  }
+  return buffer;
+}
+
+void TraceRecorder::Record(TraceEventType type, uint32_t name_id, uint64_t begin, uint64_t end, uint64_t arg) {
+  TraceEvent event;
+  event.begin = begin;
+  event.end = end;
+  event.arg = arg;
+  event.name_id = name_id;
+  event.type = type;
+  GetThreadBuffer()->Push(event);
+}
+
+void TraceRecorder::SetCollectHook(const CollectHook &hook) {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  collect_hook_ = hook;
+}
+
+void TraceRecorder::Collect() {
+  std::lock_guard<std::mutex> collect_lock(collect_mutex_);
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+    for (auto &buffer : buffers_) {
+      buffer->Drain(&events);
+    }
+  }
+  if (collect_hook_ != nullptr) {
+    collect_hook_(events);
+  }
+  (void)collected_.insert(collected_.end(), events.begin(), events.end());
+  if (collected_.size() > kMaxCollectedEvents) {
+    if (dropped_num_ == 0) {
+      MS_LOG(WARNING) << "The trace recorder keeps the newest " << kMaxCollectedEvents
+                      << " events, the older ones are dropped from the exported trace.";
+    }
+    auto drop_num = collected_.size() - kMaxCollectedEvents;
+    (void)collected_.erase(collected_.begin(), collected_.begin() + drop_num);
+    dropped_num_ += drop_num;
+  }
+}
+
+std::vector<TraceEvent> TraceRecorder::GetCollectedEvents() {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  // The events of a thread are already in order, a stable sort keeps the order of the nested spans.
+  std::stable_sort(collected_.begin(), collected_.end(),
+                   [](const TraceEvent &a, const TraceEvent &b) { return a.begin < b.begin; });
+  return std::vector<TraceEvent>(collected_.begin(), collected_.end());
+}
+
+void TraceRecorder::ClearEvents() {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  collected_.clear();
+  dropped_num_ = 0;
+}
+
+bool TraceRecorder::ExportChromeTrace(const std::string &file_path) {
+  auto events = GetCollectedEvents();
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return false;
+  }
+  uint64_t base_time = events.empty() ? 0 : events.front().begin;
+  auto pid = getpid();
+  uint32_t thread_num = 0;
+  uint64_t async_id = 0;
+  ofs << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto &event : events) {
+    ofs << (first ? "\n" : ",\n") << "{\"name\":";
+    first = false;
+    auto name = GetName(event.name_id);
+    WriteJsonString(ofs, name);
+    ofs << ",\"cat\":\"" << GetCategory(event.type) << "\"";
+    if (event.type == TraceEventType::kActorMessage) {
+      // A message waits from its enqueue on another thread until the dequeue, the span overlaps the kernels of the
+      // dequeuing thread, so it goes to an async track of its own instead of the thread.
+      ofs << ",\"ph\":\"b\",\"id\":" << async_id << ",\"ts\":" << (event.begin - base_time) / kNanosecondToMicrosecond
+          << ",\"pid\":" << pid << ",\"tid\":" << event.tid << "},\n{\"name\":";
+      WriteJsonString(ofs, name);
+      ofs << ",\"cat\":\"" << GetCategory(event.type) << "\",\"ph\":\"e\",\"id\":" << async_id++
+          << ",\"ts\":" << (event.end - base_time) / kNanosecondToMicrosecond << ",\"pid\":" << pid
+          << ",\"tid\":" << event.tid << "}";
+      continue;
+    }
+    ofs << ",\"ph\":\"X\",\"ts\":" << (event.begin - base_time) / kNanosecondToMicrosecond
+        << ",\"dur\":" << (event.end - event.begin) / kNanosecondToMicrosecond << ",\"pid\":" << pid
+        << ",\"tid\":" << event.tid;
+    if (event.type == TraceEventType::kMemoryAlloc || event.type == TraceEventType::kMemoryFree) {
+      ofs << ",\"args\":{\"bytes\":" << event.arg << "}";
+    }
+    ofs << "}";
+    thread_num = std::max(thread_num, event.tid + 1);
+  }
+  for (uint32_t tid = 0; tid < thread_num; ++tid) {
+    ofs << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+        << ",\"args\":{\"name\":\"runtime thread " << tid << "\"}}";
+    first = false;
+  }
+  ofs << "\n]}\n";
+  ofs.close();
+  return true;
+}
+}  // namespace profiler
+}  // namespace mindspore
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PROFILER_DEVICE_TRACE_RECORDER_H
+#define MINDSPORE_CCSRC_PROFILER_DEVICE_TRACE_RECORDER_H
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mindspore {
+namespace profiler {
+enum class TraceEventType : uint8_t { kKernelLaunch, kActorMessage, kMemoryAlloc, kMemoryFree, kDataQueueWait };
+
+// A span on one thread, the times are nanoseconds of the host monotonic raw clock the other profiler data use.
+struct TraceEvent {
+  uint64_t begin{0};
+  uint64_t end{0};
+  // Bytes of a memory event, process id of a kernel launch.
+  uint64_t arg{0};
+  uint32_t name_id{0};
+  uint32_t tid{0};
+  TraceEventType type{TraceEventType::kKernelLaunch};
+};
+
+// Ring of the events of one thread. The owner thread pushes without a lock, a collector drains the events from any
+// thread. When the ring is full the owner drains it to a spill list itself, under the lock the collector takes, so
+// the ring never has two concurrent readers.
+class TraceBuffer {
+ public:
+  static constexpr size_t kCapacity = 8192;
+
+  explicit TraceBuffer(uint32_t tid) : tid_(tid), events_(kCapacity) {}
+  ~TraceBuffer() = default;
+
+  void Push(const TraceEvent &event);
+  // Append the events pushed so far to events, oldest first.
+  void Drain(std::vector<TraceEvent> *events);
+
+ private:
+  void DrainLocked(std::vector<TraceEvent> *events);
+
+  uint32_t tid_;
+  std::vector<TraceEvent> events_;
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::mutex drain_mutex_;
+  std::vector<TraceEvent> spilled_;
+};
+
+// Process wide recorder of the runtime events: kernel launches, the time messages wait in the mailbox of an actor,
+// memory allocations and data queue waits. Each thread records into its own buffer, the buffers are merged at the
+// end of a step and the merged events are exported in the Chrome trace event format, which chrome://tracing and
+// Perfetto load. A disabled recorder costs one relaxed load per event site. Only the newest kMaxCollectedEvents
+// merged events are kept for the export, a collect hook sees all of them.
+class TraceRecorder {
+ public:
+  static constexpr size_t kMaxCollectedEvents = 1 << 20;
+  using CollectHook = std::function<void(const std::vector<TraceEvent> &events)>;
+
+  static TraceRecorder &GetInstance();
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+  static uint64_t Now();
+
+  void SetEnable(bool enable);
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // Id of a name, the first lookup of a name on a thread takes a lock, the next ones hit a thread local cache.
+  uint32_t GetNameId(const std::string &name);
+  std::string GetName(uint32_t name_id);
+
+  void Record(TraceEventType type, uint32_t name_id, uint64_t begin, uint64_t end, uint64_t arg = 0);
+  void Record(TraceEventType type, const std::string &name, uint64_t begin, uint64_t end, uint64_t arg = 0) {
+    Record(type, GetNameId(name), begin, end, arg);
+  }
+
+  // Called with the events each collection merges, before the oldest collected events are dropped.
+  void SetCollectHook(const CollectHook &hook);
+  // Move the events of all the threads to the collected ones.
+  void Collect();
+  // The collected events ordered by their begin time.
+  std::vector<TraceEvent> GetCollectedEvents();
+  // Write the collected events as a Chrome trace, return false when the file can not be written.
+  bool ExportChromeTrace(const std::string &file_path);
+  void ClearEvents();
+
+ private:
+  TraceRecorder() = default;
+  ~TraceRecorder() = default;
+  TraceBuffer *GetThreadBuffer();
+
+  std::atomic<bool> enabled_{false};
+  std::mutex name_mutex_;
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, uint32_t> name_ids_;
+  std::mutex buffer_mutex_;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+  std::mutex collect_mutex_;
+  CollectHook collect_hook_;
+  std::deque<TraceEvent> collected_;
+  size_t dropped_num_{0};
+};
+
+// Records a span from its construction to its destruction, when the recorder is enabled at the construction.
+class TraceScope {
+ public:
+  TraceScope(TraceEventType type, const std::string &name, uint64_t arg = 0)
+      : type_(type), arg_(arg), name_(TraceRecorder::GetInstance().enabled() ? &name : nullptr) {
+    if (name_ != nullptr) {
+      begin_ = TraceRecorder::Now();
+    }
+  }
+  ~TraceScope() {
+    if (name_ != nullptr) {
+      TraceRecorder::GetInstance().Record(type_, *name_, begin_, TraceRecorder::Now(), arg_);
+    }
+  }
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+ private:
+  TraceEventType type_;
+  uint64_t arg_;
+  const std::string *name_;
+  uint64_t begin_{0};
+};
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PROFILER_DEVICE_TRACE_RECORDER_H
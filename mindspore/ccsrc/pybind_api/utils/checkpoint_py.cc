@@ -0,0 +1,55 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "utils/checkpoint_engine.h"
+#include "pybind_api/api_register.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+void SaveIndexedCheckpoint(const std::string &file_name, const std::vector<NamedTensor> &tensors, bool async_save) {
+  // the data of the tensors is copied with the GIL released, the copy may wait for the device
+  py::gil_scoped_release gil_release;
+  auto &saver = CheckpointSaver::GetInstance();
+  saver.SaveAsync(file_name, tensors);
+  if (!async_save) {
+    saver.Wait();
+  }
+}
+
+void WaitIndexedCheckpoint() {
+  py::gil_scoped_release gil_release;
+  CheckpointSaver::GetInstance().Wait();
+}
+}  // namespace
+}  // namespace checkpoint
+
+REGISTER_PYBIND_DEFINE(CheckpointEngine, ([](const py::module *m) {
+                         (void)m->def("_save_indexed_checkpoint", &checkpoint::SaveIndexedCheckpoint,
+                                      py::arg("file_name"), py::arg("tensors"), py::arg("async_save") = false,
+                                      "Save the tensors in the indexed checkpoint format.");
+                         (void)m->def("_wait_indexed_checkpoint", &checkpoint::WaitIndexedCheckpoint,
+                                      "Wait for the indexed checkpoint saved in the background.");
+                         (void)py::class_<checkpoint::CheckpointReader, std::shared_ptr<checkpoint::CheckpointReader>>(
+                                 *m, "CheckpointReader_")
+                           .def(py::init<const std::string &>(), py::arg("file_name"))
+                           .def("tensor_names", &checkpoint::CheckpointReader::GetTensorNames)
+                           .def("read_tensor", &checkpoint::CheckpointReader::ReadTensor, py::arg("name"));
+                       }));
+}  // namespace mindspore
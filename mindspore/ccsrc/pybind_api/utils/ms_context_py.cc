@@ -98,6 +98,8 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("max_call_depth", MsCtxParam::MS_CTX_MAX_CALL_DEPTH)
                            .value("env_config_path", MsCtxParam::MS_CTX_ENV_CONFIG_PATH)
                            .value("graph_kernel_flags", MsCtxParam::MS_CTX_GRAPH_KERNEL_FLAGS)
+                           .value("infer_precision_mode", MsCtxParam::MS_CTX_INFER_PRECISION_MODE)
+                           .value("intra_op_thread_num", MsCtxParam::MS_CTX_INTRA_OP_THREAD_NUM)
                            .value("grad_for_scalar", MsCtxParam::MS_CTX_GRAD_FOR_SCALAR)
                            .value("save_compile_cache", MsCtxParam::MS_CTX_SAVE_COMPILE_CACHE)
                            .value("load_compile_cache", MsCtxParam::MS_CTX_LOAD_COMPILE_CACHE)
@@ -342,6 +342,10 @@ void CPUKernelRuntime::BindInputTensorAddressPtr(const session::KernelGraph &ker
       AnfAlgo::SetOutputInferTypeAndShape({AnfAlgo::GetOutputInferDataType(item, 0)}, {shape_tmp}, item.get());
     }
     address->ref_count_ = INIT_NODE_REF;
+    // A weight tensor which is not bound to the address yet was loaded by the host since the last run.
+    if (AnfAlgo::IsParameterWeight(item->cast<ParameterPtr>()) && tensor->device_address() != address) {
+      DeviceAddress::IncreaseWeightVersion();
+    }
     tensor->set_device_address(address);
   }
 }
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_DEVICE_TENSOR_H
 #define MINDSPORE_DEVICE_TENSOR_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
@@ -86,6 +87,10 @@ class DeviceAddress : public mindspore::DeviceSync {
                              TypeId host_type, bool trans_flag) const {
     return true;
   }
+  // Increased whenever the host loads a weight into device memory. A kernel caching a conversion of a weight that the
+  // graph never writes converts it again once the version changes, instead of reading the weight at every launch.
+  static uint64_t weight_version() { return weight_version_.load(std::memory_order_acquire); }
+  static void IncreaseWeightVersion() { (void)weight_version_.fetch_add(1, std::memory_order_acq_rel); }
 #ifdef ENABLE_DEBUGGER
   virtual bool LoadMemToHost(const std::string &tensor_name, int execution_order, const std::string &host_fmt,
                              const ShapeVector &host_shape, TypeId host_type, size_t slot, bool keep_prev) const {
@@ -110,6 +115,7 @@ class DeviceAddress : public mindspore::DeviceSync {
   ShapeVector host_shape_{};
   // {node, out_index}
   std::pair<AnfNodeWeakPtr, size_t> node_index_{AnfNodePtr(nullptr), 0};
+  static std::atomic<uint64_t> weight_version_;
   friend class KernelRuntime;
   friend class MemoryManager;
   friend class mindspore::device::ascend::tasksink::TaskGenerator;
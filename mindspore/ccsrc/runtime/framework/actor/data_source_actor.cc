@@ -22,6 +22,7 @@
 #include "runtime/framework/actor/debug_actor.h"
 #include "mindrt/include/async/async.h"
 #include "common/trans.h"
+#include "profiler/device/trace_recorder.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -38,6 +39,8 @@ void DataSourceActor::Init() {
 void DataSourceActor::FetchData(OpContext<DeviceTensor> *const context) {
   MS_LOG(INFO) << "Data source actor(" << GetAID().Name() << ") fetches data.";
   MS_EXCEPTION_IF_NULL(context);
+  auto &trace_recorder = profiler::TraceRecorder::GetInstance();
+  fetch_start_time_ = trace_recorder.enabled() ? profiler::TraceRecorder::Now() : 0;
   // Pop the data of last time.
   if (!buffers_.empty()) {
     buffers_.pop();
@@ -65,6 +68,13 @@ void DataSourceActor::SendOutput(OpContext<DeviceTensor> *const context) {
     SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), "The data queue is empty.");
   }
 
+  auto &trace_recorder = profiler::TraceRecorder::GetInstance();
+  if (fetch_start_time_ != 0 && trace_recorder.enabled()) {
+    trace_recorder.Record(profiler::TraceEventType::kDataQueueWait, GetAID().Name(), fetch_start_time_,
+                          profiler::TraceRecorder::Now());
+    fetch_start_time_ = 0;
+  }
+
   // Must be the execution order: send result --> send data --> send control, avoid the illegal timing problem.
   // 1.Send graph output result.
   SendResult(context);
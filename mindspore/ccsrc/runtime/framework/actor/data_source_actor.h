@@ -92,6 +92,9 @@ class DataSourceActor : public DebugAwareActor {
 
   //  The output_data_ corresponds to the output_data_arrows_ one by one.
   std::vector<OpDataUniquePtr<DeviceTensor>> output_data_;
+
+  // The time the data fetching began, the wait until the data is ready is recorded by the trace recorder.
+  uint64_t fetch_start_time_{0};
 };
 
 // The class represents that the data source is device queue.
@@ -15,11 +15,13 @@
  */
 
 #include "runtime/framework/actor/kernel_actor.h"
+#include <chrono>
 #include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/framework/actor/output_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
 #include "runtime/framework/actor/debug_actor.h"
 #include "mindrt/include/async/async.h"
+#include "mindrt/src/thread/actor_threadpool.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -202,6 +204,8 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(device_context_);
   PreLaunchKernel(context);
 
+  ActorThreadPool::SetIntraOpThreadBudget(intra_op_thread_budget_.load(std::memory_order_relaxed));
+  auto launch_start = std::chrono::steady_clock::now();
   try {
     auto ret = device_context_->LaunchKernel(kernel_, launch_info_.inputs_, launch_info_.workspaces_,
                                              launch_info_.outputs_, is_dynamic_shape_);
@@ -214,6 +218,8 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
     std::string error_info = "Launch kernel exception: " + kernel_->fullname_with_scope();
     SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
   }
+  launch_cost_ = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - launch_start).count();
+  ActorThreadPool::SetIntraOpThreadBudget(0);
 
   // Debug actor is blocked, must wait debug actor callback message to process continue.
   if (debug_aid_ != nullptr && strategy_ == GraphExecutionStrategy::kPipeline) {
@@ -22,6 +22,7 @@
 #include <memory>
 #include <utility>
 #include <unordered_map>
+#include <atomic>
 #include "runtime/framework/actor/actor_common.h"
 #include "runtime/framework/actor/debug_aware_actor.h"
 #include "runtime/hardware/device_context.h"
@@ -129,6 +130,12 @@ class KernelActor : public DebugAwareActor {
   // The dependent messages number of actor running.
   int running_dependent_msg_num_;
 
+  // The time in us that the last kernel launch took, the graph scheduler weights the critical path with it.
+  double launch_cost_{0.0};
+  // The threads the kernel may use in one launch, zero shares the kernel threads with the concurrent launches. The
+  // graph scheduler refines it after the first step.
+  std::atomic<size_t> intra_op_thread_budget_{0};
+
   // The execution strategy of kernel actor.
   // In pipeline mode, kernel actor executes asynchronously.
   // In step mode, kernel actor executes synchronously.
@@ -15,6 +15,8 @@
  */
 
 #include "runtime/framework/graph_scheduler.h"
+#include <limits>
+#include <queue>
 #include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/framework/actor/debug_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
@@ -184,6 +186,8 @@ void PrepareDataForWeightNode(const AnfNodePtr &backend_node, const AnfNodePtr &
   auto host_tensor_address = std::dynamic_pointer_cast<DeviceTensor>(tensor->device_address());
   // Use the device address of host tensor to set device tensor.
   if (host_tensor_address != device_tensor) {
+    // The host loaded the weight since the last run, possibly into the memory of the old device tensor.
+    DeviceTensor::IncreaseWeightVersion();
     if (host_tensor_address == nullptr) {
       MS_EXCEPTION_IF_NULL(device_tensor);
       host_tensor_address = device_context->CreateDeviceAddress(nullptr, device_tensor->GetSize(),
@@ -215,6 +219,7 @@ void PrepareDataForWeightNode(const AnfNodePtr &backend_node, const AnfNodePtr &
                                                tensor->data_c(), tensor->device_info().host_format_)) {
       MS_LOG(EXCEPTION) << "SyncHostToDevice failed, node name: " << backend_node->fullname_with_scope();
     }
+    DeviceTensor::IncreaseWeightVersion();
   }
 
   // Allocate another device memory and copy data from host tensor to another device(if exist).
@@ -501,6 +506,8 @@ void GraphScheduler::Clear(const ActorInfo &actor_info, const std::vector<Kernel
   // Clear global maps of actor info.
   (void)actors_.erase(actor_info);
   (void)actor_to_host_queue_.erase(actor_info);
+  (void)priority_profiled_actor_sets_.erase(actor_info);
+  (void)actor_thread_budgets_.erase(actor_info);
 }
 
 void GraphScheduler::Clear() {
@@ -517,6 +524,8 @@ void GraphScheduler::Clear() {
   actor_name_to_actor_.clear();
   actor_to_host_queue_.clear();
   device_tensor_to_actor_.clear();
+  priority_profiled_actor_sets_.clear();
+  actor_thread_budgets_.clear();
 }
 
 void GraphScheduler::Initialize() {
@@ -826,7 +835,16 @@ bool GraphScheduler::Run(const ActorSet *actor_set, GraphExecutionStrategy strat
   auto result_future = result[0].GetFuture();
   result_future.Wait();
   MsException::Instance().CheckException();
-  return result_future.IsOK();
+  if (!result_future.IsOK()) {
+    return false;
+  }
+
+  // Refine the priorities and the thread budget by the kernel launch time measured in the first step.
+  if (priority_profiled_actor_sets_.insert(actor_set->name_).second) {
+    SetKernelActorPriority(actor_set, true);
+    SetKernelActorThreadBudget(actor_set, true);
+  }
+  return true;
 }
 
 ActorSet *GraphScheduler::Fetch(const ActorInfo &actor_info) const {
@@ -970,6 +988,20 @@ void GraphScheduler::Link(ActorSet *actor_set, const GraphCompilerInfo &graph_co
 
   // Link the output result arrows for output actors.
   LinkOutputResultArrowForOutputActor(actor_set->output_actor_.get(), graph_compiler_info);
+
+  // The priorities order the ready actors in the pipeline mode, the step mode runs one actor at a time.
+  if (graph_compiler_info.strategy_ == GraphExecutionStrategy::kPipeline) {
+    SetKernelActorPriority(actor_set, false);
+    auto context_ptr = MsContext::GetInstance();
+    MS_EXCEPTION_IF_NULL(context_ptr);
+    auto intra_op_thread_num = context_ptr->get_param<uint32_t>(MS_CTX_INTRA_OP_THREAD_NUM);
+    if (intra_op_thread_num > 0) {
+      actor_thread_budgets_[actor_set->name_] = intra_op_thread_num;
+    } else {
+      (void)actor_thread_budgets_.erase(actor_set->name_);
+    }
+    SetKernelActorThreadBudget(actor_set, false);
+  }
 }
 
 std::vector<DataSourceActorPtr> GraphScheduler::BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
@@ -1837,6 +1869,182 @@ void GraphScheduler::LinkControlArrowByCommunicationNode(const std::vector<CNode
   }
 }
 
+void GraphScheduler::CollectKernelActorEdges(const std::vector<KernelActorPtr> &kernel_actors,
+                                             std::vector<std::vector<size_t>> *const successors,
+                                             std::vector<std::vector<size_t>> *const predecessors) const {
+  MS_EXCEPTION_IF_NULL(successors);
+  MS_EXCEPTION_IF_NULL(predecessors);
+  std::unordered_map<std::string, size_t> actor_indexes;
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(kernel_actors[i]);
+    actor_indexes[kernel_actors[i]->GetAID().Name()] = i;
+  }
+
+  successors->assign(kernel_actors.size(), {});
+  predecessors->assign(kernel_actors.size(), {});
+  auto add_edge = [&](size_t from_index, const std::string &to_actor_name) {
+    auto iter = actor_indexes.find(to_actor_name);
+    if (iter == actor_indexes.end()) {
+      return;
+    }
+    (*successors)[from_index].emplace_back(iter->second);
+    (*predecessors)[iter->second].emplace_back(from_index);
+  };
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    for (const auto &data_arrow : kernel_actors[i]->output_data_arrows_) {
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      add_edge(i, data_arrow->to_op_id_.Name());
+    }
+    for (const auto &control_arrow : kernel_actors[i]->output_control_arrows_) {
+      add_edge(i, control_arrow.Name());
+    }
+  }
+}
+
+void GraphScheduler::SetKernelActorPriority(const ActorSet *actor_set, bool use_profiled_cost) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  const auto &kernel_actors = actor_set->kernel_actors_;
+  std::vector<std::vector<size_t>> successors;
+  std::vector<std::vector<size_t>> predecessors;
+  CollectKernelActorEdges(kernel_actors, &successors, &predecessors);
+
+  // Walk from the sinks back to the sources, the path cost of an actor is its own cost plus the largest path cost of
+  // its successors.
+  std::vector<double> path_costs(kernel_actors.size(), 0.0);
+  std::vector<size_t> pending_successor_nums(kernel_actors.size());
+  std::queue<size_t> ready_indexes;
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    pending_successor_nums[i] = successors[i].size();
+    if (pending_successor_nums[i] == 0) {
+      ready_indexes.push(i);
+    }
+  }
+  double max_path_cost = 0.0;
+  while (!ready_indexes.empty()) {
+    auto index = ready_indexes.front();
+    ready_indexes.pop();
+    double successor_path_cost = 0.0;
+    for (auto successor : successors[index]) {
+      successor_path_cost = std::max(successor_path_cost, path_costs[successor]);
+    }
+    path_costs[index] = GetKernelActorCost(kernel_actors[index].get(), use_profiled_cost) + successor_path_cost;
+    max_path_cost = std::max(max_path_cost, path_costs[index]);
+    for (auto predecessor : predecessors[index]) {
+      if (--pending_successor_nums[predecessor] == 0) {
+        ready_indexes.push(predecessor);
+      }
+    }
+  }
+
+  const double max_priority = static_cast<double>(std::numeric_limits<int>::max());
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    double priority = path_costs[i];
+    if (AnfAlgo::IsCommunicationOp(kernel_actors[i]->kernel_)) {
+      priority += max_path_cost;
+    }
+    kernel_actors[i]->set_priority(static_cast<int>(std::min(priority, max_priority)));
+  }
+}
+
+double GraphScheduler::GetKernelActorCost(const KernelActor *kernel_actor, bool use_profiled_cost) const {
+  MS_EXCEPTION_IF_NULL(kernel_actor);
+  if (use_profiled_cost && kernel_actor->launch_cost_ > 0.0) {
+    return kernel_actor->launch_cost_;
+  }
+  // Before the kernel has run, the KB it reads and writes stand in for its launch time in us.
+  const size_t kBytesPerCostUnit = 1024;
+  size_t traffic_size = 0;
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel_actor->kernel_);
+  if (kernel_mod != nullptr) {
+    for (auto size : kernel_mod->GetInputSizeList()) {
+      traffic_size += size;
+    }
+    for (auto size : kernel_mod->GetOutputSizeList()) {
+      traffic_size += size;
+    }
+  }
+  return std::max(1.0, static_cast<double>(traffic_size) / kBytesPerCostUnit);
+}
+
+size_t GraphScheduler::GetIntraOpThreadBudget(const std::vector<std::vector<size_t>> &successors,
+                                              const std::vector<std::vector<size_t>> &predecessors,
+                                              const std::vector<double> &costs, size_t actor_thread_num,
+                                              size_t kernel_thread_num) {
+  size_t kernel_num = successors.size();
+  if (predecessors.size() != kernel_num || costs.size() != kernel_num) {
+    MS_LOG(EXCEPTION) << "The kernel number of successors " << kernel_num << ", predecessors " << predecessors.size()
+                      << " and costs " << costs.size() << " are different.";
+  }
+  std::vector<size_t> levels(kernel_num, 0);
+  std::vector<size_t> pending_predecessor_nums(kernel_num);
+  std::queue<size_t> ready_indexes;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    pending_predecessor_nums[i] = predecessors[i].size();
+    if (pending_predecessor_nums[i] == 0) {
+      ready_indexes.push(i);
+    }
+  }
+  // The sum and the largest cost of the kernels on each level.
+  std::unordered_map<size_t, std::pair<double, double>> level_costs;
+  while (!ready_indexes.empty()) {
+    auto index = ready_indexes.front();
+    ready_indexes.pop();
+    auto &level_cost = level_costs[levels[index]];
+    level_cost.first += costs[index];
+    level_cost.second = std::max(level_cost.second, costs[index]);
+    for (auto successor : successors[index]) {
+      levels[successor] = std::max(levels[successor], levels[index] + 1);
+      if (--pending_predecessor_nums[successor] == 0) {
+        ready_indexes.push(successor);
+      }
+    }
+  }
+
+  // A level whose other kernels together cost less than half of its largest one counts as a chain.
+  const double kRoundingOffset = 0.5;
+  size_t graph_width = 0;
+  for (const auto &level_cost : level_costs) {
+    auto width = level_cost.second.second > 0.0 ? level_cost.second.first / level_cost.second.second : 1.0;
+    graph_width = std::max(graph_width, static_cast<size_t>(width + kRoundingOffset));
+  }
+  // No more kernels than the actor threads launch together. A chain of kernels keeps the whole pool.
+  size_t parallel_num = std::min(graph_width, std::max<size_t>(1, actor_thread_num));
+  return parallel_num > 1 ? (kernel_thread_num + parallel_num) / parallel_num : 0;
+}
+
+void GraphScheduler::SetKernelActorThreadBudget(const ActorSet *actor_set, bool use_profiled_cost) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  const auto &kernel_actors = actor_set->kernel_actors_;
+  size_t thread_budget = 0;
+  auto iter = actor_thread_budgets_.find(actor_set->name_);
+  if (iter != actor_thread_budgets_.end()) {
+    thread_budget = iter->second;
+  } else if (!kernel_actors.empty()) {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    MS_EXCEPTION_IF_NULL(actor_manager);
+    auto thread_pool = actor_manager->GetActorThreadPool();
+    if (thread_pool != nullptr) {
+      std::vector<std::vector<size_t>> successors;
+      std::vector<std::vector<size_t>> predecessors;
+      CollectKernelActorEdges(kernel_actors, &successors, &predecessors);
+      std::vector<double> costs(kernel_actors.size());
+      for (size_t i = 0; i < kernel_actors.size(); ++i) {
+        costs[i] = GetKernelActorCost(kernel_actors[i].get(), use_profiled_cost);
+      }
+      thread_budget = GetIntraOpThreadBudget(successors, predecessors, costs, thread_pool->GetActorThreadNum(),
+                                             thread_pool->GetKernelThreadNum());
+    }
+    MS_LOG(INFO) << "The intra op thread budget of the kernel actors of " << actor_set->name_ << ": " << thread_budget;
+  }
+
+  // A budget refined after a step is written while no kernel actor of the set is launching, the atomic only keeps a
+  // concurrent read from another actor set well defined.
+  for (const auto &kernel_actor : kernel_actors) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    kernel_actor->intra_op_thread_budget_.store(thread_budget, std::memory_order_relaxed);
+  }
+}
+
 void GraphScheduler::LinkControlArrowForLoopCountActor(LoopCountActor *loop_count_actor, const ActorSet *actor_set,
                                                        const ControlNodeParserPtr &parser) {
   MS_EXCEPTION_IF_NULL(actor_set);
@@ -2979,7 +3187,7 @@ void GraphScheduler::DumpKernelActor(const KernelActor *actor, std::ofstream &of
   ofs << "\tactor_name:" << actor->GetAID().Name()
       << "\tdevice_context:" << actor->device_context_->device_context_key().ToString()
       << "\tinput_data_num:" << actor->input_datas_num_ << "\tinput_controls_num:" << actor->input_controls_num_
-      << "\n";
+      << "\tpriority:" << actor->priority() << "\n";
 
   const auto &kernel = actor->kernel_;
   MS_EXCEPTION_IF_NULL(kernel);
@@ -167,6 +167,15 @@ class GraphScheduler {
   // Fetch the actor set by actor info.
   ActorSet *Fetch(const ActorInfo &actor_info) const;
 
+  // The number of threads each kernel of a DAG uses in one launch, zero shares the kernel threads between the
+  // launches in flight. The kernels of a level, one more than the largest level of their predecessors, may launch
+  // together. The width of a level counts its kernels in units of its most costly one, so that small kernels beside
+  // a large one leave it the threads. The widest level, capped by the actor threads, splits the kernel threads.
+  static size_t GetIntraOpThreadBudget(const std::vector<std::vector<size_t>> &successors,
+                                       const std::vector<std::vector<size_t>> &predecessors,
+                                       const std::vector<double> &costs, size_t actor_thread_num,
+                                       size_t kernel_thread_num);
+
  private:
   GraphScheduler() = default;
   ~GraphScheduler() = default;
@@ -231,6 +240,19 @@ class GraphScheduler {
                                            const GraphCompilerInfo &graph_compiler_info);
   void LinkDeviceTensorStoreForAutoMonadActor(const std::vector<KernelActor *> &auto_monad_actors);
 
+  // Collect the edges between kernel actors from their data arrows and control arrows, the other actors are skipped.
+  void CollectKernelActorEdges(const std::vector<KernelActorPtr> &kernel_actors,
+                               std::vector<std::vector<size_t>> *const successors,
+                               std::vector<std::vector<size_t>> *const predecessors) const;
+  // Set the priority of kernel actors to the cost of their longest path to the graph output, communication actors
+  // are raised above all the others so that their latency overlaps with the compute. The cost of a kernel is its
+  // measured launch time when use_profiled_cost is set and the kernel has run, otherwise its memory traffic.
+  void SetKernelActorPriority(const ActorSet *actor_set, bool use_profiled_cost) const;
+  double GetKernelActorCost(const KernelActor *kernel_actor, bool use_profiled_cost) const;
+  // Split the kernel threads between the kernel actors that can run at the same time, by the costs of the kernels as
+  // in SetKernelActorPriority, unless the intra op thread number of the context pinned the budget at the transform.
+  void SetKernelActorThreadBudget(const ActorSet *actor_set, bool use_profiled_cost) const;
+
   // 3. The processing of linking output result arrows.
   void LinkOutputResultArrowForOutputActor(OutputActor *to_actor, const GraphCompilerInfo &graph_compiler_info);
 
@@ -318,6 +340,10 @@ class GraphScheduler {
   std::unordered_map<ActorInfo, HostTensorQueuePtr> actor_to_host_queue_;
   // The second element of pair represents the output index of op actor corresponding to the device tensor.
   std::unordered_map<DeviceTensor *, GraphOutputPair> device_tensor_to_actor_;
+  // The actor sets whose kernel actor priorities have been refined by the launch time of the first step.
+  std::unordered_set<ActorInfo> priority_profiled_actor_sets_;
+  // The intra op thread number of the context when the actor set was transformed, if it was set.
+  std::unordered_map<ActorInfo, size_t> actor_thread_budgets_;
 
   // The local maps and vectors, will be cleared at the end of each graph transform:
   // 1.The second element of pair represents the output index of op actor corresponding to the graph output front node.
@@ -27,9 +27,15 @@
 #include "backend/optimizer/common/common_backend_optimization.h"
 #include "backend/optimizer/cpu/insert_cast_cpu.h"
 #include "backend/optimizer/cpu/insert_format_transform_op.h"
+#include "backend/optimizer/cpu/post_op_fusion_cpu.h"
+#include "backend/optimizer/cpu/multi_tensor_optimizer_fusion_cpu.h"
+#include "backend/optimizer/cpu/layout_propagation_cpu.h"
 #include "backend/optimizer/pass/replace_node_by_proxy.h"
 #include "backend/optimizer/pass/erase_visit_attr.h"
+#include "backend/optimizer/graph_kernel/graph_kernel_optimization.h"
+#include "utils/context/graph_kernel_flags.h"
 #include "profiler/device/cpu/cpu_profiling.h"
+#include "profiler/device/trace_recorder.h"
 #include "debug/data_dump/dump_json_parser.h"
 
 namespace mindspore {
@@ -57,6 +63,10 @@ void CPUDeviceContext::Initialize() {
   initialized_ = true;
 }
 
+namespace {
+const std::string kMemoryPoolTraceName = "CPUMemoryPool";
+}  // namespace
+
 void CPUDeviceContext::Destroy() {
   // Release memory.
   if (mem_manager_ != nullptr) {
@@ -68,6 +78,7 @@ void CPUDeviceContext::Destroy() {
 bool CPUDeviceContext::AllocateMemory(DeviceAddress *const &address, size_t size) const {
   MS_EXCEPTION_IF_NULL(address);
   MS_EXCEPTION_IF_NULL(mem_manager_);
+  profiler::TraceScope trace_scope(profiler::TraceEventType::kMemoryAlloc, kMemoryPoolTraceName, size);
   auto device_ptr = mem_manager_->MallocMemFromMemPool(size);
   if (!device_ptr) {
     return false;
@@ -85,6 +96,7 @@ void CPUDeviceContext::FreeMemory(DeviceAddress *const &address) const {
   if (!address->from_mem_pool()) {
     return;
   }
+  profiler::TraceScope trace_scope(profiler::TraceEventType::kMemoryFree, kMemoryPoolTraceName, address->size_);
   mem_manager_->FreeMemFromMemPool(address->ptr_);
   address->ptr_ = nullptr;
 }
@@ -103,6 +115,12 @@ void CPUDeviceContext::OptimizeGraph(const KernelGraphPtr &graph) const {
 
   // Run final optimization.
   opt::CommonFinalOptimization(graph);
+
+  // Graph kernel fusion optimization
+  if (context::GraphKernelFlags::GetInstance().IsEnableGraphKernel()) {
+    opt::GraphKernelOptimize(graph);
+    graph->SetExecOrderByDefault();
+  }
 }
 
 void CPUDeviceContext::OptimizeSingleOpGraph(const KernelGraphPtr &graph) const {
@@ -114,7 +132,10 @@ void CPUDeviceContext::OptimizeSingleOpGraph(const KernelGraphPtr &graph) const
 void CPUDeviceContext::OptimizeGraphImpl(const KernelGraphPtr &graph) const {
   auto optimizer = std::make_shared<opt::GraphOptimizer>();
   auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::PostOpFusionCPU>("post_op_fusion_cpu"));
+  pm->AddPass(std::make_shared<opt::MultiTensorOptimizerFusionCPU>("multi_tensor_optimizer_fusion_cpu"));
   pm->AddPass(std::make_shared<opt::InsertFormatTransformOpCPU>("insert_format_transform_op_cpu"));
+  pm->AddPass(std::make_shared<opt::LayoutPropagationCPU>("layout_propagation_cpu"));
   optimizer->AddPassManager(pm);
   (void)optimizer->Optimize(graph);
   graph->SetExecOrderByDefault();
@@ -239,7 +260,6 @@ bool CPUDeviceContext::LaunchKernelWithProfiling(const CNodePtr &kernel, const s
                                                  const std::vector<AddressPtr> &workspace,
                                                  const std::vector<AddressPtr> &outputs) const {
   MS_EXCEPTION_IF_NULL(kernel);
-  std::lock_guard<std::mutex> locker(launch_mutex_);
 
   auto profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
   MS_EXCEPTION_IF_NULL(profiler_inst);
@@ -19,7 +19,6 @@
 #include <vector>
 #include <memory>
 #include <string>
-#include <mutex>
 #include "runtime/hardware/device_context.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "runtime/device/memory_manager.h"
@@ -74,7 +73,6 @@ class CPUDeviceContext : public DeviceContext {
   bool DoLaunchKernel(KernelMod *const kernel_mod, const std::vector<AddressPtr> &inputs,
                       const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs) const;
 
-  mutable std::mutex launch_mutex_;
   std::shared_ptr<MemoryManager> mem_manager_;
   bool initialized_;
 };
@@ -0,0 +1,460 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/checkpoint_engine.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include "abstract/utils.h"
+#include "ir/dtype.h"
+#include "proto/checkpoint.pb.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+constexpr size_t kMagicSize = sizeof(kIndexedCheckpointMagic) - 1;
+// magic, version, tensor number, index size, file size
+constexpr size_t kHeaderSize = kMagicSize + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t);
+// Large tensors are split so that the writer threads share them.
+constexpr uint64_t kWriteChunkSize = 16 << 20;
+
+uint64_t AlignUp(uint64_t size) { return (size + kCheckpointAlign - 1) / kCheckpointAlign * kCheckpointAlign; }
+
+uint64_t GetElementNum(const ShapeVector &shape) {
+  uint64_t element_num = 1;
+  for (auto dim : shape) {
+    element_num *= static_cast<uint64_t>(dim);
+  }
+  return element_num;
+}
+
+std::string GetTypeName(TypeId type) {
+  auto type_ptr = TypeIdToType(type);
+  MS_EXCEPTION_IF_NULL(type_ptr);
+  return type_ptr->ToString();
+}
+
+TypeId GetTypeId(const std::string &type_name, const std::string &file_name) {
+  auto type_ptr = StringToType(type_name);
+  if (type_ptr == nullptr) {
+    MS_LOG(EXCEPTION) << "Unsupported tensor type " << type_name << " in checkpoint file " << file_name;
+  }
+  return type_ptr->type_id();
+}
+
+template <typename T>
+void Append(std::string *buffer, T value) {
+  (void)buffer->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void AppendString(std::string *buffer, const std::string &str) {
+  Append<uint32_t>(buffer, static_cast<uint32_t>(str.size()));
+  (void)buffer->append(str);
+}
+
+bool WriteAt(int fd, const void *data, uint64_t len, uint64_t offset) {
+  auto ptr = static_cast<const uint8_t *>(data);
+  while (len > 0) {
+    auto ret = pwrite(fd, ptr, len, static_cast<off_t>(offset));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    ptr += ret;
+    len -= static_cast<uint64_t>(ret);
+    offset += static_cast<uint64_t>(ret);
+  }
+  return true;
+}
+
+// Reads the header and the index, every read is checked against the end of the file.
+class IndexParser {
+ public:
+  IndexParser(const uint8_t *begin, const uint8_t *end, const std::string &file_name)
+      : cur_(begin), end_(end), file_name_(file_name) {}
+  ~IndexParser() = default;
+
+  template <typename T>
+  T Read() {
+    CheckSize(sizeof(T));
+    T value;
+    (void)memcpy(&value, cur_, sizeof(T));
+    cur_ += sizeof(T);
+    return value;
+  }
+
+  std::string ReadString() {
+    auto size = Read<uint32_t>();
+    CheckSize(size);
+    std::string str(reinterpret_cast<const char *>(cur_), size);
+    cur_ += size;
+    return str;
+  }
+
+ private:
+  void CheckSize(size_t size) const {
+    if (size > static_cast<size_t>(end_ - cur_)) {
+      MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " is broken, its index exceeds the file.";
+    }
+  }
+
+  const uint8_t *cur_;
+  const uint8_t *end_;
+  const std::string &file_name_;
+};
+
+// Data of a tensor in the mapping of an indexed checkpoint, the mapping lives as long as one of its tensors.
+class TensorDataMapped : public tensor::TensorData {
+ public:
+  TensorDataMapped(const std::shared_ptr<MappedFile> &file, void *data, ssize_t size, ssize_t itemsize, ssize_t ndim)
+      : file_(file), data_(data), size_(size), itemsize_(itemsize), ndim_(ndim) {}
+  ~TensorDataMapped() override = default;
+
+  ssize_t size() const override { return size_; }
+  ssize_t itemsize() const override { return itemsize_; }
+  ssize_t nbytes() const override { return size_ * itemsize_; }
+  ssize_t ndim() const override { return ndim_; }
+  void *data() override { return data_; }
+  const void *const_data() const override { return data_; }
+
+  std::string ToString(const TypeId type, const ShapeVector &shape, bool use_comma) const override {
+    // print through an owned copy, which knows how to format the elements of each type
+    tensor::Tensor copy(type, shape, data_, static_cast<size_t>(nbytes()));
+    return copy.data().ToString(type, shape, use_comma);
+  }
+
+ private:
+  std::shared_ptr<MappedFile> file_;
+  void *data_;
+  ssize_t size_;
+  ssize_t itemsize_;
+  ssize_t ndim_;
+};
+}  // namespace
+
+// A private, writable mapping of a whole file. Writes to the pages are copied and never reach the file.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string &file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(EXCEPTION) << "Open checkpoint file " << file_name << " failed, errno: " << errno;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      (void)close(fd);
+      MS_LOG(EXCEPTION) << "Get the size of checkpoint file " << file_name << " failed.";
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    data_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // the mapping keeps the file open on its own
+    (void)close(fd);
+    if (data_ == MAP_FAILED) {
+      data_ = nullptr;
+      MS_LOG(EXCEPTION) << "Map checkpoint file " << file_name << " failed, errno: " << errno;
+    }
+  }
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      (void)munmap(data_, size_);
+    }
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  uint8_t *data() const { return static_cast<uint8_t *>(data_); }
+  size_t size() const { return size_; }
+
+ private:
+  void *data_{nullptr};
+  size_t size_{0};
+};
+
+bool WriteIndexedCheckpoint(const std::string &file_name, const std::vector<NamedTensor> &tensors,
+                            size_t thread_num) {
+  std::vector<CheckpointTensorInfo> infos;
+  std::vector<std::string> type_names;
+  uint64_t index_size = 0;
+  for (auto &item : tensors) {
+    MS_EXCEPTION_IF_NULL(item.second);
+    CheckpointTensorInfo info;
+    info.name = item.first;
+    info.type = item.second->data_type();
+    info.shape = item.second->shape();
+    info.size = item.second->Size();
+    type_names.emplace_back(GetTypeName(info.type));
+    index_size += sizeof(uint32_t) + info.name.size() + sizeof(uint32_t) + type_names.back().size() + sizeof(uint32_t) +
+                  sizeof(int64_t) * info.shape.size() + sizeof(uint64_t) + sizeof(uint64_t);
+    infos.emplace_back(std::move(info));
+  }
+  uint64_t file_size = AlignUp(kHeaderSize + index_size);
+  for (auto &info : infos) {
+    info.offset = file_size;
+    file_size = AlignUp(info.offset + info.size);
+  }
+
+  std::string head(kIndexedCheckpointMagic, kMagicSize);
+  head.reserve(kHeaderSize + index_size);
+  Append<uint32_t>(&head, kIndexedCheckpointVersion);
+  Append<uint32_t>(&head, static_cast<uint32_t>(infos.size()));
+  Append<uint64_t>(&head, index_size);
+  Append<uint64_t>(&head, file_size);
+  for (size_t i = 0; i < infos.size(); ++i) {
+    AppendString(&head, infos[i].name);
+    AppendString(&head, type_names[i]);
+    Append<uint32_t>(&head, static_cast<uint32_t>(infos[i].shape.size()));
+    for (auto dim : infos[i].shape) {
+      Append<int64_t>(&head, dim);
+    }
+    Append<uint64_t>(&head, infos[i].offset);
+    Append<uint64_t>(&head, infos[i].size);
+  }
+
+  std::string temp_file_name = file_name + ".tmp";
+  int fd = open(temp_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file " << temp_file_name << " failed, errno: " << errno;
+    return false;
+  }
+  bool ret = ftruncate(fd, static_cast<off_t>(file_size)) == 0 && WriteAt(fd, head.data(), head.size(), 0);
+
+  // (tensor index, offset in the tensor) of each chunk
+  std::vector<std::pair<size_t, uint64_t>> chunks;
+  for (size_t i = 0; i < infos.size(); ++i) {
+    for (uint64_t begin = 0; begin < infos[i].size; begin += kWriteChunkSize) {
+      chunks.emplace_back(i, begin);
+    }
+  }
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> failed{!ret};
+  auto write_chunks = [&]() {
+    while (!failed.load()) {
+      size_t chunk = next_chunk.fetch_add(1);
+      if (chunk >= chunks.size()) {
+        return;
+      }
+      auto &info = infos[chunks[chunk].first];
+      uint64_t begin = chunks[chunk].second;
+      uint64_t len = std::min(kWriteChunkSize, info.size - begin);
+      auto data = static_cast<const uint8_t *>(tensors[chunks[chunk].first].second->data_c());
+      if (!WriteAt(fd, data + begin, len, info.offset + begin)) {
+        failed = true;
+      }
+    }
+  };
+  size_t writer_num = std::max<size_t>(std::min(thread_num, chunks.size()), 1);
+  std::vector<std::thread> writers;
+  for (size_t i = 1; i < writer_num; ++i) {
+    writers.emplace_back(write_chunks);
+  }
+  write_chunks();
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  ret = !failed.load() && fsync(fd) == 0;
+  ret = close(fd) == 0 && ret;
+  if (!ret) {
+    MS_LOG(ERROR) << "Write checkpoint file " << temp_file_name << " failed, errno: " << errno;
+    (void)remove(temp_file_name.c_str());
+    return false;
+  }
+  (void)chmod(temp_file_name.c_str(), S_IRUSR);
+  if (rename(temp_file_name.c_str(), file_name.c_str()) != 0) {
+    MS_LOG(ERROR) << "Rename " << temp_file_name << " to " << file_name << " failed, errno: " << errno;
+    (void)remove(temp_file_name.c_str());
+    return false;
+  }
+  MS_LOG(INFO) << "Saved " << infos.size() << " tensors to checkpoint file " << file_name << ", " << file_size
+               << " bytes.";
+  return true;
+}
+
+bool IsIndexedCheckpoint(const std::string &file_name) {
+  std::ifstream ifs(file_name, std::ios::binary);
+  char magic[kMagicSize] = {0};
+  if (!ifs.is_open() || !ifs.read(magic, kMagicSize)) {
+    return false;
+  }
+  return memcmp(magic, kIndexedCheckpointMagic, kMagicSize) == 0;
+}
+
+CheckpointSaver &CheckpointSaver::GetInstance() {
+  static CheckpointSaver instance;
+  return instance;
+}
+
+CheckpointSaver::~CheckpointSaver() {
+  if (pending_.valid()) {
+    pending_.wait();
+  }
+}
+
+void CheckpointSaver::SaveAsync(const std::string &file_name, const std::vector<NamedTensor> &tensors,
+                                size_t thread_num) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the failure of the previous save is raised by the next save, as by a wait
+  if (pending_.valid() && !pending_.get()) {
+    MS_LOG(EXCEPTION) << "Save checkpoint file " << pending_file_ << " failed.";
+  }
+  std::vector<NamedTensor> snapshot;
+  snapshot.reserve(tensors.size());
+  for (auto &item : tensors) {
+    auto &tensor = item.second;
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensor->NeedWait()) {
+      tensor->Wait();
+    }
+    tensor->data_sync();
+    snapshot.emplace_back(item.first, std::make_shared<tensor::Tensor>(tensor->data_type(), tensor->shape(),
+                                                                       tensor->data_c(), tensor->Size()));
+  }
+  pending_file_ = file_name;
+  pending_ = std::async(std::launch::async, [file_name, snapshot = std::move(snapshot), thread_num]() {
+    return WriteIndexedCheckpoint(file_name, snapshot, thread_num);
+  });
+}
+
+void CheckpointSaver::Wait() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_.valid() && !pending_.get()) {
+    MS_LOG(EXCEPTION) << "Save checkpoint file " << pending_file_ << " failed.";
+  }
+}
+
+CheckpointReader::CheckpointReader(const std::string &file_name) : file_name_(file_name) {
+  if (IsIndexedCheckpoint(file_name)) {
+    file_ = std::make_shared<MappedFile>(file_name);
+    ParseIndex();
+  } else {
+    ParseProto();
+  }
+  for (size_t i = 0; i < tensor_infos_.size(); ++i) {
+    name_to_index_[tensor_infos_[i].name] = i;
+  }
+}
+
+void CheckpointReader::ParseIndex() {
+  IndexParser parser(file_->data(), file_->data() + file_->size(), file_name_);
+  (void)parser.Read<uint64_t>();
+  auto version = parser.Read<uint32_t>();
+  if (version > kIndexedCheckpointVersion) {
+    MS_LOG(EXCEPTION) << "The version " << version << " of checkpoint file " << file_name_
+                      << " is newer than the supported version " << kIndexedCheckpointVersion;
+  }
+  auto tensor_num = parser.Read<uint32_t>();
+  (void)parser.Read<uint64_t>();
+  auto file_size = parser.Read<uint64_t>();
+  if (file_size != file_->size()) {
+    MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " is broken, its size is " << file_->size()
+                      << " but " << file_size << " is expected.";
+  }
+  for (uint32_t i = 0; i < tensor_num; ++i) {
+    CheckpointTensorInfo info;
+    info.name = parser.ReadString();
+    info.type = GetTypeId(parser.ReadString(), file_name_);
+    auto rank = parser.Read<uint32_t>();
+    for (uint32_t j = 0; j < rank; ++j) {
+      auto dim = parser.Read<int64_t>();
+      if (dim < 0) {
+        MS_LOG(EXCEPTION) << "The tensor " << info.name << " of checkpoint file " << file_name_
+                          << " has a negative dim.";
+      }
+      info.shape.push_back(dim);
+    }
+    info.offset = parser.Read<uint64_t>();
+    info.size = parser.Read<uint64_t>();
+    if (info.offset > file_size || info.size > file_size - info.offset ||
+        info.size != GetElementNum(info.shape) * abstract::TypeIdSize(info.type)) {
+      MS_LOG(EXCEPTION) << "The tensor " << info.name << " of checkpoint file " << file_name_ << " is broken.";
+    }
+    tensor_infos_.emplace_back(std::move(info));
+  }
+}
+
+void CheckpointReader::ParseProto() {
+  std::ifstream ifs(file_name_, std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(EXCEPTION) << "Open checkpoint file " << file_name_ << " failed.";
+  }
+  std::stringstream content;
+  content << ifs.rdbuf();
+  ::Checkpoint checkpoint;
+  if (!checkpoint.ParseFromString(content.str())) {
+    MS_LOG(EXCEPTION) << "Parse checkpoint file " << file_name_ << " failed, it may be encrypted or broken.";
+  }
+  // the slices of a large tensor are consecutive values with the same tag
+  int value_num = checkpoint.value_size();
+  for (int begin = 0, end = 0; begin < value_num; begin = end) {
+    const auto &value = checkpoint.value(begin);
+    std::string data;
+    for (end = begin; end < value_num && checkpoint.value(end).tag() == value.tag(); ++end) {
+      (void)data.append(checkpoint.value(end).tensor().tensor_content());
+    }
+    CheckpointTensorInfo info;
+    info.name = value.tag();
+    info.type = GetTypeId(value.tensor().tensor_type(), file_name_);
+    // dims [0] denotes a scalar
+    if (!(value.tensor().dims_size() == 1 && value.tensor().dims(0) == 0)) {
+      info.shape.assign(value.tensor().dims().begin(), value.tensor().dims().end());
+    }
+    info.size = data.size();
+    if (info.size != GetElementNum(info.shape) * abstract::TypeIdSize(info.type)) {
+      MS_LOG(EXCEPTION) << "The tensor " << info.name << " of checkpoint file " << file_name_ << " is broken.";
+    }
+    proto_tensors_[info.name] = std::make_shared<tensor::Tensor>(info.type, info.shape, data.data(), data.size());
+    tensor_infos_.emplace_back(std::move(info));
+  }
+}
+
+std::vector<std::string> CheckpointReader::GetTensorNames() const {
+  std::vector<std::string> names;
+  (void)std::transform(tensor_infos_.begin(), tensor_infos_.end(), std::back_inserter(names),
+                       [](const CheckpointTensorInfo &info) { return info.name; });
+  return names;
+}
+
+tensor::TensorPtr CheckpointReader::ReadTensor(const std::string &name) const {
+  auto iter = name_to_index_.find(name);
+  if (iter == name_to_index_.end()) {
+    MS_LOG(EXCEPTION) << "There is no tensor " << name << " in checkpoint file " << file_name_;
+  }
+  const auto &info = tensor_infos_[iter->second];
+  if (file_ == nullptr) {
+    return proto_tensors_.at(name);
+  }
+  auto itemsize = abstract::TypeIdSize(info.type);
+  auto data = std::make_shared<TensorDataMapped>(file_, file_->data() + info.offset,
+                                                 static_cast<ssize_t>(GetElementNum(info.shape)),
+                                                 static_cast<ssize_t>(itemsize),
+                                                 static_cast<ssize_t>(info.shape.size()));
+  return std::make_shared<tensor::Tensor>(info.type, info.shape, data);
+}
+}  // namespace checkpoint
+}  // namespace mindspore
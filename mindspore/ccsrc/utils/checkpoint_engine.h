@@ -0,0 +1,110 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ir/tensor.h"
+#include "utils/shape_utils.h"
+
+namespace mindspore {
+namespace checkpoint {
+// The indexed checkpoint format, the integers are stored in the byte order of the host:
+//   header  magic "MSCKPT01", uint32 version, uint32 tensor number, uint64 index size, uint64 file size
+//   index   for each tensor: uint32 name size, name, uint32 type size, type name, uint32 rank, int64 dims[rank],
+//           uint64 data offset, uint64 data size
+//   data    the raw data of the tensors, each one starting at a multiple of kCheckpointAlign
+// The type names are the ones of the protobuf checkpoint, like "Float32". The index gives the place of every tensor,
+// so a reader maps the file and only touches the pages of the tensors it uses.
+constexpr char kIndexedCheckpointMagic[] = "MSCKPT01";
+constexpr uint32_t kIndexedCheckpointVersion = 1;
+constexpr size_t kCheckpointAlign = 64;
+constexpr size_t kCheckpointWriteThreadNum = 4;
+
+struct CheckpointTensorInfo {
+  std::string name;
+  TypeId type{kTypeUnknown};
+  ShapeVector shape;
+  uint64_t offset{0};
+  uint64_t size{0};
+};
+
+using NamedTensor = std::pair<std::string, tensor::TensorPtr>;
+
+// Write the tensors to file_name in the indexed format with thread_num threads, return false when it fails. The file is
+// written under a temporary name and renamed when it is complete, so a reader never sees a partial checkpoint.
+bool WriteIndexedCheckpoint(const std::string &file_name, const std::vector<NamedTensor> &tensors,
+                            size_t thread_num = kCheckpointWriteThreadNum);
+
+bool IsIndexedCheckpoint(const std::string &file_name);
+
+// Saves indexed checkpoints in the background. A save copies the data of the tensors before it returns, so the training
+// may update them at once, and the file is written while the training goes on. One save is in flight at a time: the
+// next save waits for it and raises its failure, which bounds the memory held by the copies.
+class CheckpointSaver {
+ public:
+  static CheckpointSaver &GetInstance();
+  CheckpointSaver(const CheckpointSaver &) = delete;
+  CheckpointSaver &operator=(const CheckpointSaver &) = delete;
+
+  void SaveAsync(const std::string &file_name, const std::vector<NamedTensor> &tensors,
+                 size_t thread_num = kCheckpointWriteThreadNum);
+  // Wait for the save in flight, raise an exception when it failed.
+  void Wait();
+
+ private:
+  CheckpointSaver() = default;
+  ~CheckpointSaver();
+
+  std::mutex mutex_;
+  std::future<bool> pending_;
+  std::string pending_file_;
+};
+
+class MappedFile;
+
+// Reads the checkpoints saved in the indexed format and in the protobuf format of mindspore.save_checkpoint. The
+// tensors of an indexed checkpoint are backed by a private mapping of the file, whose pages are loaded on the first
+// access and copied on write, so only the tensors used are read. A protobuf checkpoint is parsed at once.
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(const std::string &file_name);
+  ~CheckpointReader() = default;
+
+  const std::vector<CheckpointTensorInfo> &tensor_infos() const { return tensor_infos_; }
+  std::vector<std::string> GetTensorNames() const;
+  tensor::TensorPtr ReadTensor(const std::string &name) const;
+
+ private:
+  void ParseIndex();
+  void ParseProto();
+
+  std::string file_name_;
+  std::shared_ptr<MappedFile> file_;
+  std::vector<CheckpointTensorInfo> tensor_infos_;
+  std::unordered_map<std::string, size_t> name_to_index_;
+  std::unordered_map<std::string, tensor::TensorPtr> proto_tensors_;
+};
+}  // namespace checkpoint
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
@@ -207,6 +207,11 @@ constexpr auto kAdamWeightDecayName = "AdamWeightDecay";
 constexpr auto kFusedAdamName = "FusedAdam";
 constexpr auto kFusedSparseAdamName = "FusedSparseAdam";
 constexpr auto kFusedMatMulBiasAddName = "FusedMatMulBiasAdd";
+constexpr auto kFusedConv2DOpName = "FusedConv2D";
+constexpr auto kFusedMatMulOpName = "FusedMatMul";
+constexpr auto kMultiTensorAdamOpName = "MultiTensorAdam";
+constexpr auto kMultiTensorAdamWeightDecayOpName = "MultiTensorAdamWeightDecay";
+constexpr auto kMultiTensorApplyMomentumOpName = "MultiTensorApplyMomentum";
 constexpr auto kApplyAdagradV2OpName = "ApplyAdagradV2";
 constexpr auto kSparseApplyAdagradV2OpName = "SparseApplyAdagradV2";
 constexpr auto kSparseApplyFtrlOpName = "SparseApplyFtrl";
@@ -364,6 +369,8 @@ constexpr auto kAttrFixPrecision = "fix_precision";
 constexpr auto kAttrOutputPrecision = "output_precision";
 constexpr auto kAttrOutputUsedNum = "output_used_num";
 constexpr auto kAttrHasBias = "has_bias";
+constexpr auto kAttrPostOps = "post_ops";
+constexpr auto kAttrIsWeightConst = "is_weight_const";
 constexpr auto kAttrN = "n";
 constexpr auto kAttrLabelForInsertStreamActive = "label_for_insert_stream_active";
 constexpr auto kAttrFpBpEnd = "fpbp_end";
@@ -610,6 +617,9 @@ const std::set<std::string> kOptOperatorSet = {kMomentumOpName,
                                                kLARSUpdateName,
                                                kCombineMomentumWeightOpName,
                                                kCombineMomentumOpName,
+                                               kMultiTensorAdamOpName,
+                                               kMultiTensorAdamWeightDecayOpName,
+                                               kMultiTensorApplyMomentumOpName,
                                                kSparseApplyProximalAdagradOpName};
 
 const std::set<std::string> kPosteriorOperatorSet = {kPullOpName};
@@ -263,6 +263,17 @@ class _Context:
             full_file_name = print_file_path
         self.set_param(ms_ctx_param.print_file_path, full_file_name)
 
+    def set_infer_precision_mode(self, precision_mode):
+        candidate = ["fp32", "bf16", "int8"]
+        if precision_mode not in candidate:
+            raise ValueError(f"Infer precision mode must be in {candidate}, but got {precision_mode}")
+        self.set_param(ms_ctx_param.infer_precision_mode, precision_mode)
+
+    def set_intra_op_thread_num(self, intra_op_thread_num):
+        if intra_op_thread_num < 0:
+            raise ValueError(f"Intra op thread num must be greater than or equal to 0, but got {intra_op_thread_num}")
+        self.set_param(ms_ctx_param.intra_op_thread_num, intra_op_thread_num)
+
     def set_env_config_path(self, env_config_path):
         """Check and set env_config_path."""
         if not self._context_handle.enable_dump_ir():
@@ -290,7 +301,9 @@ class _Context:
         'variable_memory_max_size': set_variable_memory_max_size,
         'max_device_memory': set_max_device_memory,
         'print_file_path': set_print_file_path,
-        'env_config_path': set_env_config_path
+        'env_config_path': set_env_config_path,
+        'infer_precision_mode': set_infer_precision_mode,
+        'intra_op_thread_num': set_intra_op_thread_num
     }
 
     @property
@@ -487,15 +500,17 @@ def _check_target_specific_cfgs(device, arg_key):
         'enable_auto_mixed_precision': ['Ascend'],
         'enable_dump': ['Ascend'],
         'save_dump_path': ['Ascend'],
-        'enable_graph_kernel': ['Ascend', 'GPU'],
-        'graph_kernel_flags': ['Ascend', 'GPU'],
+        'enable_graph_kernel': ['Ascend', 'GPU', 'CPU'],
+        'graph_kernel_flags': ['Ascend', 'GPU', 'CPU'],
         'enable_reduce_precision': ['Ascend'],
         'enable_profiling': ['Ascend'],
         'profiling_options': ['Ascend'],
         'print_file_path': ['Ascend'],
         'variable_memory_max_size': ['Ascend'],
         'auto_tune_mode': ['Ascend'],
-        'max_device_memory': ['GPU']
+        'max_device_memory': ['GPU'],
+        'infer_precision_mode': ['CPU'],
+        'intra_op_thread_num': ['CPU']
     }
     # configs not in map device_cfgs are supposed to be suitable for all devices
     if not arg_key in device_cfgs:
@@ -514,7 +529,8 @@ def _check_target_specific_cfgs(device, arg_key):
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
                  enable_sparse=bool, max_call_depth=int, env_config_path=str, graph_kernel_flags=str,
-                 save_compile_cache=bool, load_compile_cache=bool, grad_for_scalar=bool, enable_grad_cache=bool)
+                 save_compile_cache=bool, load_compile_cache=bool, grad_for_scalar=bool, enable_grad_cache=bool,
+                 infer_precision_mode=str, intra_op_thread_num=int)
 def set_context(**kwargs):
     """
     Set context for running environment.
@@ -536,24 +552,26 @@ def set_context(**kwargs):
 
     Some configurations are device specific, see the below table for details:
 
-    ===========================  ===========================  =================
-    Common(CPU/GPU/Ascend)       Ascend                       GPU
-    ===========================  ===========================  =================
-    check_bprop                  print_file_path              max_device_memory
-    device_id                    enable_dump                  enable_graph_kernel
-    device_target                save_dump_path               graph_kernel_flags
-    enable_sparse                enable_graph_kernel
-    max_call_depth               enable_reduce_precision
-    mode                         enable_profiling
-    reserve_class_name_in_scope  profiling_options
-    save_graphs                  variable_memory_max_size
-    save_graphs_path             auto_tune_mode
-    env_config_path              graph_kernel_flags
+    ===========================  ===========================  =================  ====================
+    Common(CPU/GPU/Ascend)       Ascend                       GPU                CPU
+    ===========================  ===========================  =================  ====================
+    check_bprop                  print_file_path              max_device_memory  infer_precision_mode
+    device_id                    enable_dump                                     intra_op_thread_num
+    device_target                save_dump_path
+    enable_sparse                enable_reduce_precision
+    enable_graph_kernel          enable_profiling
+    graph_kernel_flags           profiling_options
+    max_call_depth               variable_memory_max_size
+    mode                         auto_tune_mode
+    reserve_class_name_in_scope
+    save_graphs
+    save_graphs_path
+    env_config_path
     grad_for_scalar
     save_compile_cache
     load_compile_cache
     enable_grad_cache
-    ===========================  ===========================  =================
+    ===========================  ===========================  =================  ====================
 
     Args:
         mode (int): Running in GRAPH_MODE(0) or PYNATIVE_MODE(1). Default: GRAPH_MODE(0).
@@ -668,6 +686,16 @@ def set_context(**kwargs):
         enable_grad_cache (bool): Whether to use cache for grad, default True.
             The cache will cost memory for every compiled graph.
             If the input data shape is uncertian, advised to disable the cache for save memory.
+        infer_precision_mode (str): The precision that oneDNN kernels compute in for inference on CPU, tensors stay
+            float32. The value must be in ['fp32', 'bf16', 'int8']. Default: 'fp32'.
+
+            - bf16: Conv2D, MatMul and LSTM compute in bfloat16 on CPUs with AVX-512 BF16 instructions.
+            - int8: MatMul quantizes its inputs symmetrically at runtime on CPUs with AVX-512 VNNI instructions.
+
+            Kernels fall back to float32 on CPUs without these instructions.
+        intra_op_thread_num (int): The number of threads that a CPU kernel of the graphs compiled afterwards uses in
+            one launch. Graphs compiled earlier keep the value they were compiled with. 0 lets the runtime split the
+            kernel threads between the kernels that can run at the same time. Default: 0.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -692,6 +720,8 @@ def set_context(**kwargs):
         >>> context.set_context(max_call_depth=80)
         >>> context.set_context(env_config_path="./env_config.json")
         >>> context.set_context(enable_grad_cache=True)
+        >>> context.set_context(infer_precision_mode="bf16")
+        >>> context.set_context(intra_op_thread_num=4)
     """
     ctx = _context()
     # set device target first
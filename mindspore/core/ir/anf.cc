@@ -23,6 +23,7 @@
 #include <vector>
 #include <queue>
 #include <unordered_map>
+#include <utility>
 
 #include "base/core_ops.h"
 #include "ir/func_graph.h"
@@ -72,6 +73,11 @@ void CNode::set_inputs(const std::vector<AnfNodePtr> &inputs) {
   input_tensor_num_ = -1;
 }
 
+void CNode::set_inputs(std::vector<AnfNodePtr> &&inputs) {
+  inputs_ = std::move(inputs);
+  input_tensor_num_ = -1;
+}
+
 const AnfNodePtr &CNode::input(size_t i) const {
   if (i >= inputs_.size()) {
     MS_LOG(EXCEPTION) << "i:" << i << "out of range:" << inputs_.size() << ",cnode:" << DebugString();
@@ -260,6 +260,7 @@ class MS_CORE_API CNode : public AnfNode, public EffectInfoHolder {
   void add_input(const AnfNodePtr &input);
   void set_input(size_t i, const AnfNodePtr &input);
   void set_inputs(const std::vector<AnfNodePtr> &inputs);
+  void set_inputs(std::vector<AnfNodePtr> &&inputs);
 
   void add_input_value(const ValuePtr &input_value, const std::string &id) {
     inputs_value_.push_back(std::make_pair(input_value, id));
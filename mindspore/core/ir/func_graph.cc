@@ -26,6 +26,7 @@
 #include "ir/manager.h"
 #include "utils/flags.h"
 #include "utils/ordered_set.h"
+#include "utils/node_pool.h"
 #include "utils/convert_utils_base.h"
 #include "abstract/abstract_function.h"
 
@@ -85,7 +86,7 @@ const std::vector<AnfNodePtr> FuncGraph::get_inputs() const {
 
 ParameterPtr FuncGraph::add_parameter() {
   FuncGraphPtr this_func_graph = shared_from_base<FuncGraph>();
-  ParameterPtr p = std::make_shared<Parameter>(this_func_graph);
+  ParameterPtr p = MakeNode<Parameter>(this_func_graph);
   add_parameter(p);
   return p;
 }
@@ -100,7 +101,7 @@ void FuncGraph::add_parameter(const ParameterPtr &p) {
 
 ParameterPtr FuncGraph::InsertFrontParameter() {
   FuncGraphPtr this_func_graph = shared_from_base<FuncGraph>();
-  ParameterPtr p = std::make_shared<Parameter>(this_func_graph);
+  ParameterPtr p = MakeNode<Parameter>(this_func_graph);
   InsertFrontParameter(p);
   return p;
 }
@@ -115,7 +116,7 @@ void FuncGraph::InsertFrontParameter(const ParameterPtr &p) {
 
 ParameterPtr FuncGraph::AddWeightParameter(const std::string &name) {
   FuncGraphPtr this_graph = shared_from_base<FuncGraph>();
-  ParameterPtr p = std::make_shared<Parameter>(this_graph);
+  ParameterPtr p = MakeNode<Parameter>(this_graph);
   p->set_name(name);
   p->debug_info()->set_name(name);
 
@@ -151,7 +152,7 @@ ValuePtr FuncGraph::get_attr(const std::string &key) const {
 }
 
 CNodePtr FuncGraph::NewCNode(const std::vector<AnfNodePtr> &inputs) {
-  return std::make_shared<CNode>(inputs, shared_from_base<FuncGraph>());
+  return MakeNode<CNode>(inputs, shared_from_base<FuncGraph>());
 }
 
 CNodePtr FuncGraph::NewCNodeInOrder(const std::vector<AnfNodePtr> &inputs) {
@@ -23,6 +23,7 @@
 #include "base/core_ops.h"
 #include "utils/convert_utils_base.h"
 #include "utils/log_adapter.h"
+#include "utils/node_pool.h"
 #include "utils/profile.h"
 #include "utils/ms_context.h"
 #include "ir/graph_utils.h"
@@ -68,7 +69,7 @@ void Cloner::CloneParameter(const AnfNodePtr &node, const FuncGraphPtr &target,
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(target);
   TraceGuard trace_guard(node->debug_info(), relation_);
-  auto new_param = (is_add) ? target->add_parameter() : std::make_shared<Parameter>(target);
+  auto new_param = (is_add) ? target->add_parameter() : MakeNode<Parameter>(target);
   auto old_param = node->cast<ParameterPtr>();
   MS_EXCEPTION_IF_NULL(old_param);
   new_param->set_abstract(old_param->abstract());
@@ -86,7 +87,7 @@ void Cloner::CloneCNode(const AnfNodePtr &node, const FuncGraphPtr &target) {
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(target);
   TraceGuard trace_guard(node->debug_info(), relation_);
-  CNodePtr new_node = std::make_shared<CNode>(AnfNodePtrList{}, target);
+  CNodePtr new_node = MakeNode<CNode>(AnfNodePtrList{}, target);
   auto old_node = node->cast<CNodePtr>();
   new_node->CloneCNodeInfo(old_node);
   ScopePtr scope = (node->scope() != kDefaultScope) ? node->scope() : this->scope();
@@ -290,7 +291,7 @@ void Cloner::CloneParameter(const ParameterPtr &param, const AnfNodePtr &node) {
 
 ParameterPtr Cloner::AddParameter(const FuncGraphPtr &func_graph, const AnfNodePtr &node, bool is_add) {
   TraceGuard guard(std::make_shared<TraceCopy>(node->debug_info()));
-  ParameterPtr param = std::make_shared<Parameter>(func_graph);
+  ParameterPtr param = MakeNode<Parameter>(func_graph);
   CloneParameter(param, node);
   if (is_add) {
     func_graph->add_parameter(param);
@@ -632,10 +633,13 @@ void Cloner::LinkEdges() {
     CNodePtr new_node = node_pair.second;
     MS_EXCEPTION_IF_NULL(old_node);
     MS_EXCEPTION_IF_NULL(new_node);
+    std::vector<AnfNodePtr> new_inputs;
+    new_inputs.reserve(old_node->size());
     for (auto &input : old_node->inputs()) {
       auto &new_input = (repl_node_.count(input) == 0) ? input : repl_node_[input];
-      new_node->add_input(new_input);
+      new_inputs.push_back(new_input);
     }
+    new_node->set_inputs(std::move(new_inputs));
   }
 }
 
@@ -24,6 +24,7 @@
 #include "ir/manager.h"
 #include "base/core_ops.h"
 #include "utils/ordered_set.h"
+#include "utils/node_pool.h"
 #include "abstract/abstract_value.h"
 #include "abstract/abstract_function.h"
 #include "utils/flags.h"
@@ -100,7 +101,7 @@ void FuncGraph::GenerateVarParams(const FuncGraphPtr &specialized_graph, int var
     auto varg_name = specialized_graph->GetVariableArgName();
     // for python variable argument input , there is no upper limit
     for (int i = 0; i < variable_args_count; ++i) {
-      ParameterPtr p = std::make_shared<Parameter>(specialized_graph);
+      ParameterPtr p = MakeNode<Parameter>(specialized_graph);
       std::string param_name = varg_name + std::to_string(i);
       p->set_name(param_name);
       MS_EXCEPTION_IF_NULL(p->debug_info());
@@ -135,7 +136,7 @@ void FuncGraph::GenerateKwParams(const FuncGraphPtr &specialized_graph,
       if (!has_kwarg()) {
         MS_LOG(EXCEPTION) << "Got unexpected keyword argument: " << kw_param_name;
       } else {
-        ParameterPtr p = std::make_shared<Parameter>(specialized_graph);
+        ParameterPtr p = MakeNode<Parameter>(specialized_graph);
         std::string param_name = specialized_graph->GetVariableKwargName() + "[" + kw_param_name + "]";
         MS_EXCEPTION_IF_NULL(specialized_parameter_list);
         auto find_kw_arg_in_list = std::any_of(specialized_parameter_list->begin(), specialized_parameter_list->end(),
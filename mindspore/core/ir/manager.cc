@@ -82,6 +82,7 @@ void FuncGraphManager::Reset() {
   node_users_ = NodeUsersMap();
 
   signals_ = std::make_shared<Signals>();
+  changed_func_graphs_.clear();
 
   func_graph_parents_total_ = std::make_shared<FuncGraphParentsTotalComputer>(this);
   func_graph_parent_ = std::make_shared<ParentComputer>(this);
@@ -107,6 +108,7 @@ void FuncGraphManager::Init() {
 FuncGraphSet &FuncGraphManager::func_graph_parents_total(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_LOG(DEBUG) << "Start func_graph_parents_total func graph " << fg->ToString();
+  InvalidateChangedFuncGraphs();
   func_graph_parents_total_->Recompute(fg);
   MS_LOG(DEBUG) << "End func_graph_parents func graph " << fg->ToString();
   return func_graph_parents_total_->func_graph_parents_total_analysis()[fg];
@@ -116,6 +118,7 @@ FuncGraphPtr FuncGraphManager::parent(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(func_graph_parent_);
   MS_LOG(DEBUG) << "Start parents func graph " << fg->ToString();
+  InvalidateChangedFuncGraphs();
   func_graph_parent_->Recompute(fg);
   if (func_graph_parent_->parent_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager:" << fg->ToString();
@@ -129,6 +132,7 @@ FuncGraphSet &FuncGraphManager::children(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(children_);
   MS_LOG(DEBUG) << "Start child func graph " << fg->ToString();
+  InvalidateChangedFuncGraphs();
   children_->Recompute(fg);
   return children_->children_analysis()[fg];
 }
@@ -137,6 +141,7 @@ FuncGraphSet &FuncGraphManager::scopes(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(scopes_);
   MS_LOG(DEBUG) << "Start scopes func graph:" << fg->ToString();
+  InvalidateChangedFuncGraphs();
   scopes_->Recompute(fg);
   MS_LOG(DEBUG) << "End scopes func graph:" << fg->ToString();
   return scopes_->scope_analysis()[fg];
@@ -144,18 +149,21 @@ FuncGraphSet &FuncGraphManager::scopes(const FuncGraphPtr &fg) const {
 
 FVTotalMap &FuncGraphManager::free_variables_total() const {
   MS_EXCEPTION_IF_NULL(free_variables_total_);
+  InvalidateChangedFuncGraphs();
   free_variables_total_->Recompute();
   return free_variables_total_->fv_total_analysis();
 }
 
 FuncGraphSet &FuncGraphManager::func_graphs_used_total(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(func_graphs_used_total_);
+  InvalidateChangedFuncGraphs();
   func_graphs_used_total_->Recompute(fg);
   return func_graphs_used_total_->func_graph_used_total_analysis()[fg];
 }
 
 bool FuncGraphManager::recursive(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
+  InvalidateChangedFuncGraphs();
   recursive_->Recompute(fg);
   if (recursive_->recursive_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager: " << fg->ToString();
@@ -184,6 +192,7 @@ std::shared_ptr<std::list<FuncGraphPtr>> FuncGraphManager::recursive_graphs(cons
 bool FuncGraphManager::func_graph_j_total(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(j_total_);
   MS_EXCEPTION_IF_NULL(fg);
+  InvalidateChangedFuncGraphs();
   j_total_->Recompute(fg);
   if (j_total_->j_total_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager: " << fg->ToString();
@@ -228,6 +237,7 @@ void FuncGraphManager::Clear() {
   all_nodes_.clear();
   node_users_.clear();
   roots_.clear();
+  changed_func_graphs_.clear();
 
   signals_->InvalidateComputer();
 }
@@ -518,7 +528,7 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        InvalidateFuncGraph(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ)) {
@@ -526,7 +536,7 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateFuncGraph(fg);
     }
   }
 }
@@ -539,7 +549,7 @@ void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        InvalidateFuncGraph(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ)) {
@@ -547,7 +557,7 @@ void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateFuncGraph(fg);
     }
   }
 }
@@ -560,9 +570,55 @@ void FuncGraphManager::MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target) {
   target->CopyFuncGraphsUsed(source);
   target->CopyJValueNodes(source);
   source->ClearAllManagerInfo();
+  changed_func_graphs_.clear();
   signals_->InvalidateComputer();
 }
 
+void FuncGraphManager::InvalidateFuncGraph(const FuncGraphPtr &fg) {
+  MS_EXCEPTION_IF_NULL(fg);
+  changed_func_graphs_.add(fg);
+}
+
+void FuncGraphManager::InvalidateChangedFuncGraphs() const {
+  if (changed_func_graphs_.empty()) {
+    return;
+  }
+  // The analyses of a graph are derived from the graphs it reaches through func_graphs_used, so only the changed
+  // graphs and their direct or indirect users are affected. If a use on the way was dropped, the graph that dropped
+  // it is one of the changed graphs itself.
+  FuncGraphSet todo(changed_func_graphs_);
+  changed_func_graphs_.clear();
+  FuncGraphSet affected;
+  while (!todo.empty()) {
+    auto fg = todo.pop();
+    if (affected.contains(fg)) {
+      continue;
+    }
+    affected.add(fg);
+    for (auto &item : fg->func_graph_cnodes_index()) {
+      MS_EXCEPTION_IF_NULL(item.first);
+      auto &user = item.first->first;
+      if (user != nullptr && user->func_graph() != nullptr && !affected.contains(user->func_graph())) {
+        todo.add(user->func_graph());
+      }
+    }
+  }
+  MS_LOG(DEBUG) << "Invalidate the analyses of " << affected.size() << " func graphs.";
+  signals_->InvalidateFuncGraphs(affected);
+}
+
+size_t FuncGraphManager::analysis_recompute_count() const {
+  std::vector<std::shared_ptr<DepComputer>> computers = {
+    func_graph_parents_total_, func_graph_parent_, children_, scopes_, free_variables_total_, func_graphs_used_total_,
+    recursive_, j_total_};
+  size_t count = 0;
+  for (auto &computer : computers) {
+    MS_EXCEPTION_IF_NULL(computer);
+    count += computer->recompute_count();
+  }
+  return count;
+}
+
 FuncGraphTransaction FuncGraphManager::Transact() {
   auto tr = FuncGraphTransaction(this);
   return tr;
@@ -668,6 +724,8 @@ void FuncGraphManager::EraseOneGraph(FuncGraph *fg) {
   if (!erase_cnt) {
     return;
   }
+  // Drop the analyses of the erased graph at the next read.
+  InvalidateFuncGraph(fg->shared_from_base<FuncGraph>());
   fg->DecAttachedMngCnt();
   if (fg->attached_mng_cnt() == 0) {
     fg->ClearAllManagerInfo();
@@ -732,6 +790,7 @@ void FuncGraphTransaction::Commit() {
 DepComputer::DepComputer(const FuncGraphManager *const manager) : manager_(manager) {
   MS_EXCEPTION_IF_NULL(manager_);
   manager_->signals()->InvalidateComputer.connect(this, &DepComputer::OnInvalidateComputer);
+  manager_->signals()->InvalidateFuncGraphs.connect(this, &DepComputer::OnInvalidateFuncGraphs);
   validate_ = false;
 }
 
@@ -739,6 +798,7 @@ void DepComputer::Recompute() {
   if (!validate_) {
     RealRecompute();
     validate_ = true;
+    ++recompute_count_;
   }
 }
 
@@ -746,6 +806,7 @@ void DepComputer::Recompute(const FuncGraphPtr &fg) {
   if (func_graphs_validate_.count(fg) == 0 || !func_graphs_validate_[fg]) {
     RealRecompute(fg);
     func_graphs_validate_[fg] = true;
+    ++recompute_count_;
   }
 }
 
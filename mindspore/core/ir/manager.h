@@ -79,6 +79,7 @@ FuncGraphManagerPtr MakeManager(const std::vector<FuncGraphPtr> &func_graphs = {
 
 struct Signals {
   Signal<void()> InvalidateComputer;
+  Signal<void(const FuncGraphSet &)> InvalidateFuncGraphs;
 };
 
 enum EdgeProcessDirection { kDecEdge = -1, kIncEdge = 1 };
@@ -101,8 +102,22 @@ class DepComputer {
     func_graphs_validate_.clear();
   }
 
+  // Drop the results that may depend on the given func graphs, the analysis is reset entirely if it can not drop
+  // them graph by graph.
+  void Reset(const FuncGraphSet &func_graphs) {
+    if (!ExtraResetFuncGraphs(func_graphs)) {
+      Reset();
+      return;
+    }
+    for (auto &fg : func_graphs) {
+      (void)func_graphs_validate_.erase(fg);
+    }
+  }
+
   void OnInvalidateComputer() { Reset(); }
 
+  void OnInvalidateFuncGraphs(const FuncGraphSet &func_graphs) { Reset(func_graphs); }
+
   void Recompute();
 
   void Recompute(const FuncGraphPtr &fg);
@@ -111,9 +126,14 @@ class DepComputer {
 
   bool IsValidate(const FuncGraphPtr &fg) { return func_graphs_validate_[fg]; }
 
+  size_t recompute_count() const { return recompute_count_; }
+
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
+  // subclass whose result of a graph only depends on the graphs it uses directly or indirectly drops the results
+  // of the given graphs and returns true.
+  virtual bool ExtraResetFuncGraphs(const FuncGraphSet &) { return false; }
   // subclass do the real compute
   virtual void RealRecompute() {}
   virtual void RealRecompute(FuncGraphPtr) {}
@@ -121,6 +141,7 @@ class DepComputer {
   const FuncGraphManager *manager_;
   bool validate_;
   OrderedMap<FuncGraphPtr, bool> func_graphs_validate_;
+  size_t recompute_count_{0};
 
  private:
   friend FuncGraphManager;
@@ -140,6 +161,12 @@ class FuncGraphParentsTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_parents_total_analysis_.clear(); }
+  bool ExtraResetFuncGraphs(const FuncGraphSet &func_graphs) override {
+    for (auto &fg : func_graphs) {
+      (void)func_graph_parents_total_analysis_.erase(fg);
+    }
+    return true;
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -235,6 +262,12 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
+  bool ExtraResetFuncGraphs(const FuncGraphSet &func_graphs) override {
+    for (auto &fg : func_graphs) {
+      (void)func_graph_used_total_analysis_.erase(fg);
+    }
+    return true;
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -262,6 +295,13 @@ class RecursiveComputer final : public DepComputer {
     recursive_analysis_.clear();
     recursive_map_.clear();
   }
+  bool ExtraResetFuncGraphs(const FuncGraphSet &func_graphs) override {
+    for (auto &fg : func_graphs) {
+      (void)recursive_analysis_.erase(fg);
+      (void)recursive_map_.erase(fg);
+    }
+    return true;
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -279,6 +319,12 @@ class FuncGraphJTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { j_total_analysis_.clear(); }
+  bool ExtraResetFuncGraphs(const FuncGraphSet &func_graphs) override {
+    for (auto &fg : func_graphs) {
+      (void)j_total_analysis_.erase(fg);
+    }
+    return true;
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
   bool SeekJ(const FuncGraphPtr &fg, size_t seen_num);
@@ -343,6 +389,9 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager>,
 
   std::shared_ptr<Signals> signals() const { return signals_; }
 
+  // Number of times the dynamic analyses have been recomputed, a graph at a time or as a whole.
+  size_t analysis_recompute_count() const;
+
   IncludeType Limit(const AnfNodePtr &node);
 
   // Static Analysis
@@ -365,11 +414,17 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager>,
   void AddEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void DropEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target);
+  // Record that the free variables or the used graphs of fg changed, the analyses are invalidated at the next read.
+  void InvalidateFuncGraph(const FuncGraphPtr &fg);
+  // Invalidate the analyses of the changed graphs and the graphs that use them directly or indirectly.
+  void InvalidateChangedFuncGraphs() const;
 
   FuncGraphSet roots_;        // Managed roots.
   FuncGraphSet func_graphs_;  // Managed func graphs.
 
   std::shared_ptr<Signals> signals_;
+  // The graphs changed since the last read of the analyses.
+  mutable FuncGraphSet changed_func_graphs_;
 
   // Dynamic Analysis
   std::shared_ptr<FuncGraphParentsTotalComputer> func_graph_parents_total_;
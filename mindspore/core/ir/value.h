@@ -32,6 +32,7 @@
 #include "ir/dtype/ref.h"
 #include "utils/hashing.h"
 #include "utils/ms_utils.h"
+#include "utils/node_pool.h"
 
 namespace mindspore {
 class MS_CORE_API ValueSequeue : public Value {
@@ -319,7 +320,7 @@ std::vector<U> GetValue(const ValuePtr &value) {
   return rets;
 }
 
-inline ValueNodePtr NewValueNode(const ValuePtr &t) { return std::make_shared<ValueNode>(t); }
+inline ValueNodePtr NewValueNode(const ValuePtr &t) { return MakeNode<ValueNode>(t); }
 
 template <typename T, typename _ = typename std::enable_if<!std::is_base_of<Value, T>::value>::type>
 inline ValueNodePtr NewValueNode(const std::shared_ptr<T> &x) {
@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include "thread/hqueue.h"
 
@@ -87,6 +88,15 @@ class ActorBase : std::enable_shared_from_this<ActorBase> {
   // Judge if actor running by the received message number, the default is true.
   virtual bool IsActive(int msg_num) { return true; }
 
+  // Scheduling hint for the actor thread pool, a ready actor with a higher priority runs first.
+  void set_priority(int priority) { priority_ = priority; }
+  int priority() const { return priority_; }
+
+  // Called with the steady clock times in nanoseconds a message entered the mailbox of the actor and left it. The
+  // messages are only stamped while a hook is set, so a tracer can leave it unset at no cost.
+  using MessageLatencyHook = void (*)(const ActorBase *actor, uint64_t enqueue_time, uint64_t dequeue_time);
+  static void SetMessageLatencyHook(MessageLatencyHook hook);
+
  protected:
   using ActorFunction = std::function<void(const std::unique_ptr<MessageBase> &msg)>;
 
@@ -205,13 +215,14 @@ class ActorBase : std::enable_shared_from_this<ActorBase> {
   std::unique_ptr<ActorPolicy> actorPolicy;
 
   AID id;
-  std::map<std::string, ActorFunction> actionFunctions;
+  std::unordered_map<std::string, ActorFunction> actionFunctions;
   std::mutex waiterLock;
 
   std::string msgRecords[MAX_ACTOR_RECORD_SIZE];
   uint32_t recordNextPoint = 0;
 
   ActorThreadPool *pool_{nullptr};
+  int priority_{0};
 };
 
 };  // namespace mindspore
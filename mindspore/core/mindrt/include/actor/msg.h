@@ -17,10 +17,12 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <new>
 #include <utility>
 #include <string>
 
 #include "actor/aid.h"
+#include "actor/msgpool.h"
 
 namespace mindspore {
 class ActorBase;
@@ -52,6 +54,19 @@ class MessageBase {
 
   virtual ~MessageBase() {}
 
+  // Messages are created and released on the hot path of every actor, so they are served from the message pool.
+  static void *operator new(size_t size) {
+    void *ptr = MessagePool::Allocate(size);
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept { return MessagePool::Allocate(size); }
+  static void operator delete(void *ptr, size_t size) noexcept { MessagePool::Free(ptr, size); }
+  // Only reached when a constructor throws, every pool block is a plain heap block.
+  static void operator delete(void *ptr, const std::nothrow_t &) noexcept { ::operator delete(ptr); }
+
   inline std::string &Name() { return name; }
 
   inline void SetName(const std::string &aName) { this->name = aName; }
@@ -79,6 +94,8 @@ class MessageBase {
   std::string name;
   std::string body;
   Type type;
+  // Steady clock time in nanoseconds the message entered the mailbox, zero when it is not traced.
+  uint64_t enqueue_time{0};
 };
 
 }  // namespace mindspore
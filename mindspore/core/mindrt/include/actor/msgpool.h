@@ -0,0 +1,34 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSGPOOL_H
+#define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSGPOOL_H
+
+#include <cstddef>
+
+namespace mindspore {
+// Thread local free lists of fixed size blocks backing the message objects. A message is allocated by the
+// sender and released by the thread that runs the receiving actor, so every thread keeps a bounded cache and
+// hands the surplus blocks back to the heap. Blocks larger than the biggest size class bypass the cache.
+class MessagePool {
+ public:
+  static void *Allocate(size_t size) noexcept;
+  static void Free(void *ptr, size_t size) noexcept;
+};
+}  // namespace mindspore
+
+#endif
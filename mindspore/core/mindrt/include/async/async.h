@@ -19,6 +19,7 @@
 
 #include <tuple>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "actor/actor.h"
@@ -41,6 +42,28 @@ class MessageAsync : public MessageBase {
   MessageHandler handler;
 };
 
+// Typed async message: the handler is kept by value and called directly, so a message costs one pooled
+// allocation instead of a std::function on top of the message.
+template <typename F>
+class MessageClosure : public MessageBase {
+ public:
+  template <typename H>
+  explicit MessageClosure(H &&h) : MessageBase("Async", Type::KASYNC), handler(std::forward<H>(h)) {}
+  ~MessageClosure() override {}
+  void Run(ActorBase *actor) override { handler(actor); }
+
+ private:
+  F handler;
+};
+
+template <typename F>
+void SendAsyncMessage(const AID &aid, F &&handler) {
+  std::unique_ptr<MessageBase> msg(new (std::nothrow)
+                                     MessageClosure<typename std::decay<F>::type>(std::forward<F>(handler)));
+  MINDRT_OOM_EXIT(msg);
+  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+}
+
 namespace internal {
 
 template <typename R>
@@ -51,10 +74,7 @@ template <>
 struct AsyncHelper<void> {
   template <typename F>
   void operator()(const AID &aid, F &&f) {
-    std::function<void(ActorBase *)> handler = [=](ActorBase *) { f(); };
-    std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    SendAsyncMessage(aid, [=](ActorBase *) { f(); });
   }
 };
 
@@ -66,11 +86,7 @@ struct AsyncHelper<Future<R>> {
     MINDRT_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    MessageHandler handler = [=](ActorBase *) { promise->Associate(f()); };
-
-    std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    SendAsyncMessage(aid, [=](ActorBase *) { promise->Associate(f()); });
     return future;
   }
 };
@@ -83,10 +99,7 @@ struct AsyncHelper {
     MINDRT_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::function<void(ActorBase *)> handler = [=](ActorBase *) { promise->SetValue(f()); };
-    std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    SendAsyncMessage(aid, [=](ActorBase *) { promise->SetValue(f()); });
     return future;
   }
 };
@@ -96,41 +109,32 @@ struct AsyncHelper {
 // return void
 template <typename T>
 void Async(const AID &aid, void (T::*method)()) {
-  std::function<void(ActorBase *)> handler = [method](ActorBase *actor) {
+  SendAsyncMessage(aid, [method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     (t->*method)();
-  };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
 }
 
 template <typename T, typename Arg0, typename Arg1>
 void Async(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg) {
-  std::function<void(ActorBase *)> handler = [method, arg](ActorBase *actor) {
+  SendAsyncMessage(aid, [method, arg](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     (t->*method)(arg);
-  };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
 }
 
 template <typename T, typename... Args0, typename... Args1>
 void Async(const AID &aid, void (T::*method)(Args0...), std::tuple<Args1...> &&tuple) {
-  std::function<void(ActorBase *)> handler = [method, tuple](ActorBase *actor) {
+  SendAsyncMessage(aid, [method, tuple](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     Apply(t, method, tuple);
-  };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
 }
 
 template <typename T, typename... Args0, typename... Args1>
@@ -146,15 +150,12 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)()) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method](ActorBase *actor) {
+  SendAsyncMessage(aid, [promise, method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate((t->*method)());
-  };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
   return future;
 }
 
@@ -164,16 +165,12 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Arg0), Arg1 &&arg) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, arg](ActorBase *actor) {
+  SendAsyncMessage(aid, [promise, method, arg](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate((t->*method)(arg));
-  };
-
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
   return future;
 }
 
@@ -183,16 +180,12 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Args0...), std::tuple<Arg
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, tuple](ActorBase *actor) {
+  SendAsyncMessage(aid, [promise, method, tuple](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate(Apply(t, method, tuple));
-  };
-
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
   return future;
 }
 
@@ -210,16 +203,12 @@ Future<R> Async(const AID &aid, R (T::*method)()) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method](ActorBase *actor) {
+  SendAsyncMessage(aid, [promise, method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue((t->*method)());
-  };
-
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
   return future;
 }
 
@@ -231,15 +220,12 @@ Future<R> Async(const AID &aid, R (T::*method)(Arg0), Arg1 &&arg) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, arg](ActorBase *actor) {
+  SendAsyncMessage(aid, [promise, method, arg](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue((t->*method)(arg));
-  };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
   return future;
 }
 
@@ -251,15 +237,12 @@ Future<R> Async(const AID &aid, R (T::*method)(Args0...), std::tuple<Args1...> &
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, tuple](ActorBase *actor) {
+  SendAsyncMessage(aid, [promise, method, tuple](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue(Apply(t, method, tuple));
-  };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  });
   return future;
 }
 
@@ -15,11 +15,24 @@
  */
 
 #include "actor/actor.h"
+#include <atomic>
+#include <chrono>
 #include "actor/actormgr.h"
 #include "actor/actorpolicyinterface.h"
 #include "actor/iomgr.h"
 
 namespace mindspore {
+namespace {
+std::atomic<ActorBase::MessageLatencyHook> message_latency_hook{nullptr};
+
+uint64_t SteadyClockNow() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}  // namespace
+
+void ActorBase::SetMessageLatencyHook(MessageLatencyHook hook) { message_latency_hook.store(hook); }
+
 ActorBase::ActorBase() : actorPolicy(nullptr), id("", ActorMgr::GetActorMgrRef()->GetUrl()), actionFunctions() {}
 
 ActorBase::ActorBase(const std::string &name)
@@ -63,7 +76,12 @@ void ActorBase::HandlekMsg(const std::unique_ptr<MessageBase> &msg) {
                     << ",m=" << msg->Name().c_str();
   }
 }
-int ActorBase::EnqueMessage(std::unique_ptr<MessageBase> &&msg) { return actorPolicy->EnqueMessage(std::move(msg)); }
+int ActorBase::EnqueMessage(std::unique_ptr<MessageBase> &&msg) {
+  if (message_latency_hook.load(std::memory_order_relaxed) != nullptr) {
+    msg->enqueue_time = SteadyClockNow();
+  }
+  return actorPolicy->EnqueMessage(std::move(msg));
+}
 
 void ActorBase::Quit() {
   Finalize();
@@ -86,6 +104,12 @@ void ActorBase::Run() {
       }
       //            std::cout << "dequeue message]actor=" << id.Name() << ",msg=" << msg->Name() << std::endl;
       AddMsgRecord(msg->Name());
+      if (msg->enqueue_time != 0) {
+        auto hook = message_latency_hook.load(std::memory_order_relaxed);
+        if (hook != nullptr) {
+          hook(this, msg->enqueue_time, SteadyClockNow());
+        }
+      }
       switch (msg->GetType()) {
         case MessageBase::Type::KMSG:
         case MessageBase::Type::KUDP: {
@@ -23,6 +23,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #ifndef MS_COMPILE_IOS
 #include <shared_mutex>
 #endif
@@ -89,8 +90,8 @@ class ActorMgr {
   // or running on other thread pool created independently externally
   ActorThreadPool *inner_pool_{nullptr};
 
-  // Map of all local spawned and running processes.
-  std::map<std::string, ActorReference> actors;
+  // Map of all local spawned and running processes, looked up by name for every local message.
+  std::unordered_map<std::string, ActorReference> actors;
 #ifndef MS_COMPILE_IOS
   std::shared_mutex actorsMutex;
 #else
@@ -57,8 +57,8 @@ void SingleThread::Notify() {
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *SingleThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
+std::vector<std::unique_ptr<MessageBase>> *SingleThread::GetMsgs() {
+  std::vector<std::unique_ptr<MessageBase>> *result;
   std::unique_lock<std::mutex> lock(mailboxLock);
   conditionVar.wait(lock, [this] { return (!this->enqueMailbox->empty()); });
   SwapMailbox();
@@ -106,8 +106,8 @@ void ShardedThread::Notify() {
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *ShardedThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
+std::vector<std::unique_ptr<MessageBase>> *ShardedThread::GetMsgs() {
+  std::vector<std::unique_ptr<MessageBase>> *result;
   mailboxLock.lock();
 
   if (enqueMailbox->empty()) {
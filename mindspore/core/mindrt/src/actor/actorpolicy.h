@@ -16,7 +16,7 @@
 
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
-#include <list>
+#include <vector>
 #include <memory>
 #include <string>
 #include <utility>
@@ -33,7 +33,7 @@ class ShardedThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual std::vector<std::unique_ptr<MessageBase>> *GetMsgs();
   virtual void Notify();
 
  private:
@@ -50,7 +50,7 @@ class SingleThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual std::vector<std::unique_ptr<MessageBase>> *GetMsgs();
   virtual void Notify();
 
  private:
@@ -17,7 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 
-#include <list>
+#include <vector>
 #include <memory>
 
 namespace mindspore {
@@ -32,7 +32,7 @@ class ActorPolicy {
   }
   virtual ~ActorPolicy() {}
   inline void SwapMailbox() {
-    std::list<std::unique_ptr<MessageBase>> *temp;
+    std::vector<std::unique_ptr<MessageBase>> *temp;
     temp = enqueMailbox;
     enqueMailbox = dequeMailbox;
     dequeMailbox = temp;
@@ -43,11 +43,11 @@ class ActorPolicy {
   void SetRunningStatus(bool startRun);
   virtual void Terminate(const ActorBase *actor) = 0;
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg) = 0;
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs() = 0;
+  virtual std::vector<std::unique_ptr<MessageBase>> *GetMsgs() = 0;
   virtual void Notify() = 0;
 
-  std::list<std::unique_ptr<MessageBase>> *enqueMailbox;
-  std::list<std::unique_ptr<MessageBase>> *dequeMailbox;
+  std::vector<std::unique_ptr<MessageBase>> *enqueMailbox;
+  std::vector<std::unique_ptr<MessageBase>> *dequeMailbox;
 
   int msgCount;
   bool start;
@@ -56,8 +56,8 @@ class ActorPolicy {
  private:
   friend class ActorBase;
 
-  std::list<std::unique_ptr<MessageBase>> mailbox1;
-  std::list<std::unique_ptr<MessageBase>> mailbox2;
+  std::vector<std::unique_ptr<MessageBase>> mailbox1;
+  std::vector<std::unique_ptr<MessageBase>> mailbox2;
 };
 
 };  // end of namespace mindspore
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "actor/msgpool.h"
+#include <new>
+#include <vector>
+
+namespace mindspore {
+namespace {
+constexpr size_t kBlockSizes[] = {64, 128, 256, 512, 1024};
+constexpr size_t kSizeClassNum = sizeof(kBlockSizes) / sizeof(kBlockSizes[0]);
+constexpr size_t kMaxCachedBlocks = 1024;
+
+// Set once the cache of the thread is destroyed, messages released later on the thread go to the heap.
+thread_local bool cache_destroyed = false;
+
+struct BlockCache {
+  BlockCache() {
+    for (auto &blocks : free_blocks) {
+      blocks.reserve(kMaxCachedBlocks);
+    }
+  }
+  ~BlockCache() {
+    cache_destroyed = true;
+    for (auto &blocks : free_blocks) {
+      for (auto block : blocks) {
+        ::operator delete(block);
+      }
+    }
+  }
+  std::vector<void *> free_blocks[kSizeClassNum];
+};
+
+BlockCache *GetBlockCache() {
+  if (cache_destroyed) {
+    return nullptr;
+  }
+  thread_local BlockCache cache;
+  return &cache;
+}
+
+size_t GetSizeClass(size_t size) {
+  for (size_t i = 0; i < kSizeClassNum; ++i) {
+    if (size <= kBlockSizes[i]) {
+      return i;
+    }
+  }
+  return kSizeClassNum;
+}
+}  // namespace
+
+void *MessagePool::Allocate(size_t size) noexcept {
+  size_t size_class = GetSizeClass(size);
+  if (size_class == kSizeClassNum) {
+    return ::operator new(size, std::nothrow);
+  }
+  auto cache = GetBlockCache();
+  if (cache != nullptr && !cache->free_blocks[size_class].empty()) {
+    void *block = cache->free_blocks[size_class].back();
+    cache->free_blocks[size_class].pop_back();
+    return block;
+  }
+  return ::operator new(kBlockSizes[size_class], std::nothrow);
+}
+
+void MessagePool::Free(void *ptr, size_t size) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  size_t size_class = GetSizeClass(size);
+  if (size_class != kSizeClassNum) {
+    auto cache = GetBlockCache();
+    if (cache != nullptr && cache->free_blocks[size_class].size() < kMaxCachedBlocks) {
+      cache->free_blocks[size_class].push_back(ptr);
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+}  // namespace mindspore
@@ -18,18 +18,29 @@
 #include <unistd.h>
 #endif
 #include "thread/actor_threadpool.h"
+#include <algorithm>
 #include "thread/core_affinity.h"
 
 namespace mindspore {
 constexpr size_t MAX_READY_ACTOR_NR = 4096;
-void ActorWorker::CreateThread(ActorThreadPool *pool) {
+// A worker busy with its own chain still looks at the shared queue once every this many actor runs.
+constexpr size_t kSharedQueueCheckInterval = 61;
+
+namespace {
+thread_local ActorWorker *current_actor_worker = nullptr;
+thread_local size_t intra_op_thread_budget = 0;
+}  // namespace
+
+void ActorWorker::CreateThread(ActorThreadPool *pool, size_t index) {
   THREAD_RETURN_IF_NULL(pool);
   pool_ = pool;
+  index_ = index;
   thread_ = std::thread(&ActorWorker::RunWithSpin, this);
 }
 
 void ActorWorker::RunWithSpin() {
   SetAffinity();
+  current_actor_worker = this;
 #if !defined(__APPLE__) && !defined(SUPPORT_MSVC)
   static std::atomic_int index = {0};
   pthread_setname_np(pthread_self(), ("ActorThread_" + std::to_string(index++)).c_str());
@@ -50,7 +61,19 @@ void ActorWorker::RunWithSpin() {
 
 bool ActorWorker::RunQueueActorTask() {
   THREAD_ERROR_IF_NULL(pool_);
-  auto actor = pool_->PopActorFromQueue();
+  ActorBase *actor = nullptr;
+  if (++run_count_ % kSharedQueueCheckInterval == 0) {
+    actor = pool_->PopActorFromQueue();
+  }
+  if (actor == nullptr) {
+    actor = PopLocalActor();
+  }
+  if (actor == nullptr) {
+    actor = pool_->PopActorFromQueue();
+  }
+  if (actor == nullptr) {
+    actor = pool_->StealActor(this);
+  }
   if (actor == nullptr) {
     return false;
   }
@@ -58,6 +81,50 @@ bool ActorWorker::RunQueueActorTask() {
   return true;
 }
 
+bool ActorWorker::PushLocalActor(ActorBase *actor) {
+  // Only the owner touches the next slot, other workers steal from the local queue.
+  auto next = next_actor_.load();
+  if (next == nullptr) {
+    next_actor_.store(actor);
+    return false;
+  }
+  if (actor->priority() >= next->priority()) {
+    next_actor_.store(actor);
+    actor = next;
+  }
+  std::lock_guard<std::mutex> _l(local_mutex_);
+  auto pos =
+    std::upper_bound(local_actors_.begin(), local_actors_.end(), actor,
+                     [](const ActorBase *lhs, const ActorBase *rhs) { return lhs->priority() < rhs->priority(); });
+  (void)local_actors_.insert(pos, actor);
+  return true;
+}
+
+ActorBase *ActorWorker::PopLocalActor() {
+  auto actor = next_actor_.exchange(nullptr);
+  if (actor != nullptr) {
+    return actor;
+  }
+  return PopLocalQueue();
+}
+
+ActorBase *ActorWorker::PopLocalQueue() {
+  std::lock_guard<std::mutex> _l(local_mutex_);
+  if (local_actors_.empty()) {
+    return nullptr;
+  }
+  auto actor = local_actors_.back();
+  local_actors_.pop_back();
+  return actor;
+}
+
+ActorBase *ActorWorker::StealActor() { return PopLocalQueue(); }
+
+bool ActorWorker::LocalQueueEmpty() {
+  std::lock_guard<std::mutex> _l(local_mutex_);
+  return next_actor_.load() == nullptr && local_actors_.empty();
+}
+
 bool ActorWorker::Active() {
   if (status_ != kThreadIdle) {
     return false;
@@ -79,6 +146,9 @@ ActorThreadPool::~ActorThreadPool() {
       terminate = actor_queue_.empty();
 #endif
     }
+    for (size_t i = 0; terminate && i < actor_thread_num_; ++i) {
+      terminate = reinterpret_cast<ActorWorker *>(workers_[i])->LocalQueueEmpty();
+    }
     if (!terminate) {
       std::this_thread::yield();
     }
@@ -107,10 +177,61 @@ ActorBase *ActorThreadPool::PopActorFromQueue() {
 #endif
 }
 
+ActorBase *ActorThreadPool::StealActor(const ActorWorker *thief) {
+  if (thief == nullptr) {
+    return nullptr;
+  }
+  for (size_t i = 1; i < actor_thread_num_; ++i) {
+    auto victim = reinterpret_cast<ActorWorker *>(workers_[(thief->index() + i) % actor_thread_num_]);
+    auto actor = victim->StealActor();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
+ActorWorker *ActorThreadPool::CurrentActorWorker() const {
+  if (current_actor_worker == nullptr || current_actor_worker->pool() != this) {
+    return nullptr;
+  }
+  return current_actor_worker;
+}
+
+void ActorThreadPool::ActiveIdleActorWorker() {
+  for (size_t i = 0; i < actor_thread_num_; ++i) {
+    auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
+    if (worker->Active()) {
+      break;
+    }
+  }
+}
+
+void ActorThreadPool::SetIntraOpThreadBudget(size_t thread_num) { intra_op_thread_budget = thread_num; }
+
+size_t ActorThreadPool::AcquireIntraOpThreads() {
+  size_t kernel_thread_num = GetKernelThreadNum();
+  size_t launch_num = ++intra_op_launch_num_;
+  // The launching threads take part in their own kernels, so they are counted in the share.
+  size_t thread_num =
+    intra_op_thread_budget > 0 ? intra_op_thread_budget : (kernel_thread_num + launch_num) / launch_num;
+  return std::max<size_t>(1, std::min(thread_num, kernel_thread_num));
+}
+
+void ActorThreadPool::ReleaseIntraOpThreads() { --intra_op_launch_num_; }
+
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
+  auto worker = CurrentActorWorker();
+  if (worker != nullptr) {
+    // Only wake another worker when there is something left for it to steal.
+    if (worker->PushLocalActor(actor)) {
+      ActiveIdleActorWorker();
+    }
+    return;
+  }
   {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
@@ -122,12 +243,7 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   }
   THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   // active one idle actor thread if exist
-  for (size_t i = 0; i < actor_thread_num_; ++i) {
-    auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
-    if (worker->Active()) {
-      break;
-    }
-  }
+  ActiveIdleActorWorker();
 }
 
 int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list) {
@@ -156,7 +272,7 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     }
     worker->set_mask(mask);
 #endif
-    worker->CreateThread(this);
+    worker->CreateThread(this, i);
     workers_.push_back(worker);
     THREAD_INFO("create actor thread[%zu]", i);
   }
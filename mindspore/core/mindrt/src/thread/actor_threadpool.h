@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 #define MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 
+#include <deque>
 #include <queue>
 #include <vector>
 #include <mutex>
@@ -30,16 +31,35 @@
 namespace mindspore {
 class ActorThreadPool;
 
+// Every actor worker owns a run queue. An actor made ready by the actor running on the worker goes to the
+// next slot and runs right after it on the same thread, unless the actor already there has a higher priority;
+// the other one moves to the local queue. The local queue is kept sorted by priority, both the owner and the
+// idle workers that steal take its highest priority actor. The shared queue only carries actors made ready by
+// threads outside the pool.
 class ActorWorker : public Worker {
  public:
-  void CreateThread(ActorThreadPool *pool);
+  void CreateThread(ActorThreadPool *pool, size_t index);
   bool Active();
 
+  // Returns true when an actor lands in the local queue, where other workers can steal it.
+  bool PushLocalActor(ActorBase *actor);
+  ActorBase *StealActor();
+  bool LocalQueueEmpty();
+  size_t index() const { return index_; }
+  const ActorThreadPool *pool() const { return pool_; }
+
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  ActorBase *PopLocalActor();
+  ActorBase *PopLocalQueue();
 
   ActorThreadPool *pool_{nullptr};
+  size_t index_{0};
+  size_t run_count_{0};
+  std::atomic<ActorBase *> next_actor_{nullptr};
+  std::mutex local_mutex_;
+  std::deque<ActorBase *> local_actors_;
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -55,11 +75,25 @@ class ActorThreadPool : public ThreadPool {
 
   void PushActorToQueue(ActorBase *actor);
   ActorBase *PopActorFromQueue();
+  ActorBase *StealActor(const ActorWorker *thief);
+
+  size_t GetActorThreadNum() const { return actor_thread_num_; }
+
+  // Bound of the threads a kernel launched on the calling thread may use, zero leaves it to the pool.
+  static void SetIntraOpThreadBudget(size_t thread_num);
+  // Number of threads, the calling one included, that a parallel kernel launched now should use. The kernels that
+  // launch at the same time share the kernel threads evenly unless the calling thread has a budget. Every acquire
+  // is paired with a release when the launch finishes.
+  size_t AcquireIntraOpThreads();
+  void ReleaseIntraOpThreads();
 
  private:
   ActorThreadPool() {}
+  ActorWorker *CurrentActorWorker() const;
+  void ActiveIdleActorWorker();
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
   size_t actor_thread_num_{0};
+  std::atomic<size_t> intra_op_launch_num_{0};
 
   std::mutex actor_mutex_;
   std::condition_variable actor_cond_;
@@ -104,6 +104,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_GE_REF,
   MS_CTX_MAX_CALL_DEPTH,
   MS_CTX_TSD_REF,
+  MS_CTX_INTRA_OP_THREAD_NUM,  // Threads a CPU kernel uses in one launch of the graphs compiled, zero to derive it.
   MS_CTX_TYPE_UINT32_END,
 
   // parameter of type float
@@ -124,7 +125,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_ENV_CONFIG_PATH,
   MS_CTX_TUNE_MODE,
   MS_CTX_GRAPH_KERNEL_FLAGS,
-  MS_CTX_INFER_PRECISION_MODE,  // GPU inference precision mode configured by Serving or Unify API.
+  MS_CTX_INFER_PRECISION_MODE,  // Inference precision mode, set by Serving or Unify API on GPU, by context on CPU.
   MS_CTX_TYPE_STRING_END,
 
   // parameter numbers of each type
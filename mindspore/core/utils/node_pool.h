@@ -0,0 +1,238 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_UTILS_NODE_POOL_H_
+#define MINDSPORE_CORE_UTILS_NODE_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+// Pool of the ir nodes and their shared_ptr control blocks. Blocks of a size class are carved from slabs of
+// kSlabSize bytes instead of coming from the heap one by one, and freed blocks are recycled through a free list of
+// the freeing thread. A thread free list holds at most two slabs of blocks, the older half of a full list and the list
+// of an exiting thread go to a global list that the other threads refill from. Slabs whose blocks are all back on the
+// global list return to the heap once the global list of the size class has doubled since it was last trimmed.
+class NodePool {
+ public:
+  static constexpr size_t kAlignment = alignof(std::max_align_t);
+  static constexpr size_t kMaxBlockSize = 1024;
+  static constexpr size_t kSlabSize = 64 * 1024;
+  static constexpr size_t kSizeClassNum = kMaxBlockSize / kAlignment;
+  static constexpr size_t kMaxLocalSlabNum = 2;
+
+  static void *Allocate(size_t size) {
+    if (size == 0 || size > kMaxBlockSize) {
+      return ::operator new(size);
+    }
+    size_t size_class = GetSizeClass(size);
+    if (local_cache_destroyed()) {
+      return ::operator new((size_class + 1) * kAlignment);
+    }
+    auto &free_blocks = GetLocalCache().free_blocks[size_class];
+    if (free_blocks.empty()) {
+      Refill(size_class, &free_blocks);
+    }
+    void *block = free_blocks.back();
+    free_blocks.pop_back();
+    return block;
+  }
+
+  static void Free(void *ptr, size_t size) noexcept {
+    if (ptr == nullptr) {
+      return;
+    }
+    if (size == 0 || size > kMaxBlockSize) {
+      ::operator delete(ptr);
+      return;
+    }
+    size_t size_class = GetSizeClass(size);
+    if (local_cache_destroyed()) {
+      std::lock_guard<std::mutex> lock(GetGlobalCache().mutex);
+      GetGlobalCache().free_blocks[size_class].push_back(ptr);
+      return;
+    }
+    auto &free_blocks = GetLocalCache().free_blocks[size_class];
+    free_blocks.push_back(ptr);
+    if (free_blocks.size() > GetMaxLocalBlockNum(size_class)) {
+      // The recently freed blocks are the ones still in the cpu cache, give the older half away.
+      ReturnBlocks(size_class, free_blocks.size() / 2, false, &free_blocks);
+    }
+  }
+
+  // The number of slabs the pool holds, for the statistics of the memory used by the ir nodes.
+  static size_t GetSlabNum() {
+    auto &global_cache = GetGlobalCache();
+    std::lock_guard<std::mutex> lock(global_cache.mutex);
+    return global_cache.slabs.size();
+  }
+
+ private:
+  struct GlobalCache {
+    std::mutex mutex;
+    std::vector<void *> free_blocks[kSizeClassNum];
+    // The global list size of each size class after it was last trimmed.
+    size_t trimmed_block_nums[kSizeClassNum] = {0};
+    std::unordered_set<char *> slabs;
+  };
+
+  struct LocalCache {
+    ~LocalCache() {
+      local_cache_destroyed() = true;
+      for (size_t i = 0; i < kSizeClassNum; ++i) {
+        if (!free_blocks[i].empty()) {
+          ReturnBlocks(i, free_blocks[i].size(), true, &free_blocks[i]);
+        }
+      }
+    }
+    std::vector<void *> free_blocks[kSizeClassNum];
+  };
+
+  static size_t GetSizeClass(size_t size) { return (size + kAlignment - 1) / kAlignment - 1; }
+
+  static size_t GetBlockNumPerSlab(size_t size_class) { return kSlabSize / ((size_class + 1) * kAlignment); }
+
+  static size_t GetMaxLocalBlockNum(size_t size_class) { return kMaxLocalSlabNum * GetBlockNumPerSlab(size_class); }
+
+  // Nodes may be released by static destructors after the caches are gone, so the global cache is never destroyed.
+  static GlobalCache &GetGlobalCache() {
+    static GlobalCache *global_cache = new GlobalCache();
+    return *global_cache;
+  }
+
+  static bool &local_cache_destroyed() {
+    thread_local bool destroyed = false;
+    return destroyed;
+  }
+
+  static LocalCache &GetLocalCache() {
+    thread_local LocalCache local_cache;
+    return local_cache;
+  }
+
+  // Slabs are aligned to their size, so the slab of a block is its address with the offset bits cleared.
+  static char *GetSlab(const void *block) {
+    return reinterpret_cast<char *>(reinterpret_cast<uintptr_t>(block) & ~static_cast<uintptr_t>(kSlabSize - 1));
+  }
+
+  // Move the first blocks of a thread list to the global list.
+  static void ReturnBlocks(size_t size_class, size_t block_num, bool force_trim, std::vector<void *> *const blocks) {
+    auto &global_cache = GetGlobalCache();
+    std::lock_guard<std::mutex> lock(global_cache.mutex);
+    auto &global_blocks = global_cache.free_blocks[size_class];
+    auto last = blocks->begin() + static_cast<std::ptrdiff_t>(block_num);
+    (void)global_blocks.insert(global_blocks.end(), blocks->begin(), last);
+    (void)blocks->erase(blocks->begin(), last);
+    if (force_trim || global_blocks.size() >= std::max(2 * global_cache.trimmed_block_nums[size_class],
+                                                        GetBlockNumPerSlab(size_class))) {
+      Trim(size_class, &global_cache);
+    }
+  }
+
+  // Release the slabs of the size class whose blocks are all on the global list, the lock is held by the caller.
+  static void Trim(size_t size_class, GlobalCache *const global_cache) {
+    auto &global_blocks = global_cache->free_blocks[size_class];
+    // A block allocated after the caches of its thread were gone comes from the heap and has no slab.
+    std::unordered_map<char *, size_t> free_block_nums;
+    for (auto block : global_blocks) {
+      auto slab = GetSlab(block);
+      if (global_cache->slabs.count(slab) > 0) {
+        ++free_block_nums[slab];
+      }
+    }
+    size_t block_num_per_slab = GetBlockNumPerSlab(size_class);
+    std::unordered_set<char *> free_slabs;
+    for (const auto &free_block_num : free_block_nums) {
+      if (free_block_num.second == block_num_per_slab) {
+        (void)free_slabs.insert(free_block_num.first);
+      }
+    }
+    if (!free_slabs.empty()) {
+      auto in_free_slab = [&free_slabs](void *block) { return free_slabs.count(GetSlab(block)) > 0; };
+      (void)global_blocks.erase(std::remove_if(global_blocks.begin(), global_blocks.end(), in_free_slab),
+                                global_blocks.end());
+      for (auto slab : free_slabs) {
+        (void)global_cache->slabs.erase(slab);
+        ::operator delete(slab, std::align_val_t(kSlabSize));
+      }
+    }
+    global_cache->trimmed_block_nums[size_class] = global_blocks.size();
+  }
+
+  // Take at most half of the thread list capacity of the blocks other threads left in the global cache, or carve a
+  // new slab.
+  static void Refill(size_t size_class, std::vector<void *> *const free_blocks) {
+    auto &global_cache = GetGlobalCache();
+    std::lock_guard<std::mutex> lock(global_cache.mutex);
+    auto &global_blocks = global_cache.free_blocks[size_class];
+    if (!global_blocks.empty()) {
+      size_t take_num = std::min(global_blocks.size(), GetMaxLocalBlockNum(size_class) / 2);
+      auto first = global_blocks.end() - static_cast<std::ptrdiff_t>(take_num);
+      free_blocks->assign(first, global_blocks.end());
+      (void)global_blocks.erase(first, global_blocks.end());
+      auto &trimmed_block_num = global_cache.trimmed_block_nums[size_class];
+      trimmed_block_num = std::min(trimmed_block_num, global_blocks.size());
+      return;
+    }
+    size_t block_size = (size_class + 1) * kAlignment;
+    char *slab = static_cast<char *>(::operator new(kSlabSize, std::align_val_t(kSlabSize)));
+    (void)global_cache.slabs.insert(slab);
+    for (size_t offset = 0; offset + block_size <= kSlabSize; offset += block_size) {
+      free_blocks->push_back(slab + offset);
+    }
+  }
+};
+
+// Allocator of the ir nodes for std::allocate_shared, the node and its control block take one pool block.
+template <typename T>
+class NodeAllocator {
+ public:
+  using value_type = T;
+
+  NodeAllocator() = default;
+  template <typename U>
+  NodeAllocator(const NodeAllocator<U> &) noexcept {}
+
+  T *allocate(size_t n) { return static_cast<T *>(NodePool::Allocate(n * sizeof(T))); }
+  void deallocate(T *ptr, size_t n) noexcept { NodePool::Free(ptr, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const NodeAllocator<T> &, const NodeAllocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const NodeAllocator<T> &, const NodeAllocator<U> &) {
+  return false;
+}
+
+// Create an ir node in the node pool.
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeNode(Args &&... args) {
+  return std::allocate_shared<T>(NodeAllocator<T>(), std::forward<Args>(args)...);
+}
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_UTILS_NODE_POOL_H_
@@ -141,6 +141,7 @@ set(LITE_SRC
         ${LITE_DIR}/src/registry/register_kernel.cc
         ${LITE_DIR}/src/registry/register_kernel_impl.cc
         ${LITE_DIR}/src/lite_model.cc
+        ${LITE_DIR}/src/runtime/kernel/arm/base/packed_weight_cache.cc
         ${LITE_DIR}/src/ms_tensor.cc
         ${LITE_DIR}/src/tensorlist.cc
         ${LITE_DIR}/src/tensor.cc
@@ -22,6 +22,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <dirent.h>
 #endif
 
@@ -89,6 +90,51 @@ char *ReadFile(const char *file, size_t *size) {
   return buf.release();
 }
 
+char *ReadFileByMmap(const char *file, size_t *size) {
+#ifdef _WIN32
+  MS_LOG(ERROR) << "mmap is not supported on windows";
+  return nullptr;
+#else
+  if (file == nullptr) {
+    MS_LOG(ERROR) << "file is nullptr";
+    return nullptr;
+  }
+  MS_ASSERT(size != nullptr);
+  std::string real_path = RealPath(file);
+  auto fd = open(real_path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    MS_LOG(ERROR) << "file: " << real_path << " open failed";
+    return nullptr;
+  }
+  struct stat fd_stat;
+  if (fstat(fd, &fd_stat) != 0 || fd_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "get size of file: " << real_path << " failed";
+    close(fd);
+    return nullptr;
+  }
+  *size = static_cast<size_t>(fd_stat.st_size);
+  // private mapping keeps the pages shared with the page cache until someone writes to them
+  auto mmap_buffers = mmap(nullptr, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mmap_buffers == MAP_FAILED) {
+    MS_LOG(ERROR) << "mmap file: " << real_path << " failed";
+    return nullptr;
+  }
+  return reinterpret_cast<char *>(mmap_buffers);
+#endif
+}
+
+void UnmapMmapBuffer(void *buffer, size_t size) {
+#ifndef _WIN32
+  if (buffer == nullptr) {
+    return;
+  }
+  if (munmap(buffer, size) != 0) {
+    MS_LOG(ERROR) << "munmap model buffer failed";
+  }
+#endif
+}
+
 std::string RealPath(const char *path) {
   if (path == nullptr) {
     MS_LOG(ERROR) << "path is nullptr";
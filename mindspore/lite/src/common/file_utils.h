@@ -31,6 +31,12 @@ namespace mindspore {
 namespace lite {
 char *ReadFile(const char *file, size_t *size);
 
+// map the file privately into memory, writes are copied on write and never reach the file; the buffer must be
+// released by UnmapMmapBuffer
+char *ReadFileByMmap(const char *file, size_t *size);
+
+void UnmapMmapBuffer(void *buffer, size_t size);
+
 std::string RealPath(const char *path);
 
 int CreateOutputDir(std::string *dir);
@@ -15,167 +15,187 @@
  */
 
 #include "src/huffman_decode.h"
-#include <queue>
 
 namespace mindspore {
 namespace lite {
+namespace {
+constexpr int kBitsPerByte = 8;
+constexpr int kBitBufferBits = 64;
+}  // namespace
+
 STATUS HuffmanDecode::DoHuffmanDecode(const std::string &input_str, void *decoded_data, size_t data_len) {
   if (decoded_data == nullptr) {
     MS_LOG(ERROR) << "decoded_data is nullptr.";
     return RET_ERROR;
   }
 
-  int status;
-  std::string huffman_decoded_str;
   auto key_pos = input_str.find_first_of('#');
   auto code_pos = input_str.find_first_of('#', key_pos + 1);
+  if (key_pos == std::string::npos || code_pos == std::string::npos) {
+    MS_LOG(ERROR) << "huffman encoded string is invalid.";
+    return RET_ERROR;
+  }
   auto key = input_str.substr(0, key_pos);
   auto code = input_str.substr(key_pos + 1, code_pos - key_pos - 1);
-  auto encoded_data = input_str.substr(code_pos + 1);
-
-  auto root = new (std::nothrow) HuffmanNode();
-  if (root == nullptr) {
-    MS_LOG(ERROR) << "new HuffmanNode failed.";
-    return RET_MEMORY_FAILED;
-  }
-  root->left = nullptr;
-  root->right = nullptr;
-  root->parent = nullptr;
 
-  status = RebuildHuffmanTree(key, code, root);
+  std::vector<HuffmanNode> tree;
+  auto status = RebuildHuffmanTree(key, code, &tree);
   if (status != RET_OK) {
     MS_LOG(ERROR) << "Rebuild huffman tree failed.";
-    delete root;
     return status;
   }
 
-  status = DoHuffmanDecompress(root, encoded_data, &huffman_decoded_str);
+  std::vector<HuffmanLutEntry> table;
+  BuildDecodeTable(tree, &table);
+
+  auto encoded_data = reinterpret_cast<const unsigned char *>(input_str.data()) + code_pos + 1;
+  auto encoded_len = input_str.length() - code_pos - 1;
+  status = DoHuffmanDecompress(tree, table, encoded_data, encoded_len, static_cast<char *>(decoded_data), data_len);
   if (status != RET_OK) {
     MS_LOG(ERROR) << "DoHuffmanDecompress failed.";
-    delete root;
     return status;
   }
-
-  size_t len = huffman_decoded_str.length();
-  if (data_len >= len) {
-    memcpy(decoded_data, huffman_decoded_str.c_str(), len);
-  } else {
-    FreeHuffmanNodeTree(root);
-    return RET_ERROR;
-  }
-  FreeHuffmanNodeTree(root);
   return RET_OK;
 }
 
-STATUS HuffmanDecode::RebuildHuffmanTree(std::string keys, std::string codes, const HuffmanNodePtr &root) {
-  HuffmanNodePtr cur_node, tmp_node, new_node;
-
-  auto huffman_keys = Str2Vec(std::move(keys));
-  auto huffman_codes = Str2Vec(std::move(codes));
+STATUS HuffmanDecode::RebuildHuffmanTree(const std::string &keys, const std::string &codes,
+                                         std::vector<HuffmanNode> *tree) {
+  MS_ASSERT(tree != nullptr);
+  auto huffman_keys = Str2Vec(keys);
+  auto huffman_codes = Str2Vec(codes);
+  if (huffman_keys.size() != huffman_codes.size()) {
+    MS_LOG(ERROR) << "huffman keys size: " << huffman_keys.size() << " codes size: " << huffman_codes.size();
+    return RET_ERROR;
+  }
 
+  tree->clear();
+  // a full binary tree with n leaves has 2n - 1 nodes
+  tree->reserve(huffman_codes.size() * 2);
+  tree->emplace_back();
   for (size_t i = 0; i < huffman_codes.size(); ++i) {
     auto key = stoi(huffman_keys[i]);
-    auto code = huffman_codes[i];
+    const auto &code = huffman_codes[i];
     auto code_len = code.length();
-    cur_node = root;
+    int cur_node = 0;
     for (size_t j = 0; j < code_len; ++j) {
-      if (code[j] == '0') {
-        tmp_node = cur_node->left;
-      } else if (code[j] == '1') {
-        tmp_node = cur_node->right;
-      } else {
+      if (code[j] != '0' && code[j] != '1') {
         MS_LOG(ERROR) << "find huffman code is not 0 or 1";
         return RET_ERROR;
       }
-
-      if (tmp_node == nullptr) {
-        new_node = new (std::nothrow) HuffmanNode();
-        if (new_node == nullptr) {
-          MS_LOG(ERROR) << "new HuffmanNode failed.";
-          return RET_MEMORY_FAILED;
-        }
-        new_node->left = nullptr;
-        new_node->right = nullptr;
-        new_node->parent = cur_node;
-
+      int next_node = code[j] == '0' ? tree->at(cur_node).left : tree->at(cur_node).right;
+      if (next_node < 0) {
+        next_node = static_cast<int>(tree->size());
+        tree->emplace_back();
         if (j == code_len - 1) {
-          new_node->key = key;
-          new_node->code = code;
+          tree->back().key = key;
         }
-
         if (code[j] == '0') {
-          cur_node->left = new_node;
+          tree->at(cur_node).left = next_node;
         } else {
-          cur_node->right = new_node;
+          tree->at(cur_node).right = next_node;
         }
-
-        tmp_node = new_node;
       } else if (j == code_len - 1) {
         MS_LOG(ERROR) << "the huffman code is incomplete.";
         return RET_ERROR;
-      } else if (tmp_node->left == nullptr && tmp_node->right == nullptr) {
+      } else if (tree->at(next_node).IsLeaf()) {
         MS_LOG(ERROR) << "the huffman code is incomplete";
         return RET_ERROR;
       }
-      cur_node = tmp_node;
+      cur_node = next_node;
     }
   }
   return RET_OK;
 }
 
-STATUS HuffmanDecode::DoHuffmanDecompress(HuffmanNodePtr root, std::string encoded_data, std::string *decoded_str) {
-  HuffmanNodePtr cur_node = root;
-  bool pseudo_eof = false;
-  size_t pos = 0;
-  unsigned char flag;
-
-  decoded_str->clear();
-  while (pos < encoded_data.length()) {
-    auto u_char = static_cast<unsigned char>(encoded_data[pos]);
-    flag = 0x80;
-    for (size_t i = 0; i < 8; ++i) {  // traverse the 8 bit num, to find the leaf node
-      if (u_char & flag) {
-        cur_node = cur_node->right;
-      } else {
-        cur_node = cur_node->left;
+void HuffmanDecode::BuildDecodeTable(const std::vector<HuffmanNode> &tree, std::vector<HuffmanLutEntry> *table) {
+  MS_ASSERT(table != nullptr);
+  MS_ASSERT(!tree.empty());
+  table->assign(1 << kHuffmanLutBits, HuffmanLutEntry());
+  for (size_t index = 0; index < table->size(); ++index) {
+    auto &entry = table->at(index);
+    int node = 0;
+    for (int i = 0; i < kHuffmanLutBits; ++i) {
+      auto bit = (index >> static_cast<unsigned int>(kHuffmanLutBits - 1 - i)) & 1;
+      node = bit != 0 ? tree[node].right : tree[node].left;
+      if (node < 0) {
+        break;
       }
-      if (cur_node->left == nullptr && cur_node->right == nullptr) {
-        auto key = cur_node->key;
-        if (key == PSEUDO_EOF) {
-          pseudo_eof = true;
-          break;
-        } else {
-          *decoded_str += static_cast<char>(cur_node->key);
-          cur_node = root;
-        }
+      if (tree[node].IsLeaf()) {
+        entry.key = tree[node].key;
+        entry.len = i + 1;
+        entry.is_leaf = true;
+        break;
       }
-      flag = flag >> 1;
     }
-    pos++;
-    if (pseudo_eof) {
-      break;
+    entry.node = node;
+    if (!entry.is_leaf) {
+      entry.len = kHuffmanLutBits;
     }
   }
-  return RET_OK;
 }
 
-void HuffmanDecode::FreeHuffmanNodeTree(HuffmanNodePtr root) {
-  if (root == nullptr) {
-    return;
-  }
-  std::queue<HuffmanNodePtr> node_queue;
-  node_queue.push(root);
-  while (!node_queue.empty()) {
-    auto cur_node = node_queue.front();
-    node_queue.pop();
-    if (cur_node->left != nullptr) {
-      node_queue.push(cur_node->left);
+STATUS HuffmanDecode::DoHuffmanDecompress(const std::vector<HuffmanNode> &tree,
+                                          const std::vector<HuffmanLutEntry> &table, const unsigned char *encoded_data,
+                                          size_t encoded_len, char *decoded_data, size_t data_len) {
+  // bits are consumed msb first from a 64-bit window which is refilled a byte at a time
+  uint64_t bit_buffer = 0;
+  int bit_count = 0;
+  size_t pos = 0;
+  size_t decoded_len = 0;
+  auto refill = [&]() {
+    while (bit_count <= kBitBufferBits - kBitsPerByte && pos < encoded_len) {
+      bit_buffer |= static_cast<uint64_t>(encoded_data[pos++]) << static_cast<unsigned int>(kBitBufferBits -
+                                                                                              kBitsPerByte - bit_count);
+      bit_count += kBitsPerByte;
+    }
+  };
+  auto consume = [&](int bits) {
+    bit_buffer <<= static_cast<unsigned int>(bits);
+    bit_count -= bits;
+  };
+
+  while (true) {
+    refill();
+    if (bit_count == 0) {
+      break;
+    }
+    const auto &entry = table[bit_buffer >> static_cast<unsigned int>(kBitBufferBits - kHuffmanLutBits)];
+    if (entry.node < 0) {
+      MS_LOG(ERROR) << "invalid huffman code in encoded data.";
+      return RET_ERROR;
     }
-    if (cur_node->right != nullptr) {
-      node_queue.push(cur_node->right);
+    if (entry.len > bit_count) {
+      // trailing padding bits which do not form a complete code
+      break;
+    }
+    consume(entry.len);
+    int key = entry.key;
+    if (!entry.is_leaf) {
+      int node = entry.node;
+      while (!tree[node].IsLeaf()) {
+        refill();
+        if (bit_count == 0) {
+          return RET_OK;
+        }
+        node = (bit_buffer >> static_cast<unsigned int>(kBitBufferBits - 1)) != 0 ? tree[node].right : tree[node].left;
+        consume(1);
+        if (node < 0) {
+          MS_LOG(ERROR) << "invalid huffman code in encoded data.";
+          return RET_ERROR;
+        }
+      }
+      key = tree[node].key;
     }
-    delete (cur_node);
+    if (key == PSEUDO_EOF) {
+      break;
+    }
+    if (decoded_len >= data_len) {
+      MS_LOG(ERROR) << "huffman decoded data is larger than tensor size: " << data_len;
+      return RET_ERROR;
+    }
+    decoded_data[decoded_len++] = static_cast<char>(key);
   }
+  return RET_OK;
 }
 }  // namespace lite
 }  // namespace mindspore
@@ -28,17 +28,25 @@
 namespace mindspore {
 namespace lite {
 const int PSEUDO_EOF = 128;
+// number of bits resolved by one lookup in the decode table, codes no longer than this are decoded in a single step
+constexpr int kHuffmanLutBits = 10;
 
+// nodes are stored flat in a vector, children are referenced by index, a negative index means no child
 struct HuffmanNode {
-  int key;
-  unsigned int freq;
-  std::string code;
-  HuffmanNode *left = nullptr;
-  HuffmanNode *right = nullptr;
-  HuffmanNode *parent = nullptr;
+  int key = 0;
+  int left = -1;
+  int right = -1;
+  bool IsLeaf() const { return left < 0 && right < 0; }
 };
 
-using HuffmanNodePtr = HuffmanNode *;
+// entry of the decode table: when is_leaf, key is the decoded symbol and len the code length, otherwise node is the
+// tree node reached after consuming kHuffmanLutBits bits
+struct HuffmanLutEntry {
+  int key = 0;
+  int node = 0;
+  int len = 0;
+  bool is_leaf = false;
+};
 
 class HuffmanDecode {
  public:
@@ -49,13 +57,15 @@ class HuffmanDecode {
  private:
   HuffmanDecode() = default;
 
-  static void FreeHuffmanNodeTree(HuffmanNodePtr root);
+  static STATUS RebuildHuffmanTree(const std::string &keys, const std::string &codes, std::vector<HuffmanNode> *tree);
 
-  static STATUS RebuildHuffmanTree(std::string key, std::string code, const HuffmanNodePtr &root);
+  static void BuildDecodeTable(const std::vector<HuffmanNode> &tree, std::vector<HuffmanLutEntry> *table);
 
-  static STATUS DoHuffmanDecompress(HuffmanNodePtr root, std::string encoded_data, std::string *decoded_str);
+  static STATUS DoHuffmanDecompress(const std::vector<HuffmanNode> &tree, const std::vector<HuffmanLutEntry> &table,
+                                    const unsigned char *encoded_data, size_t encoded_len, char *decoded_data,
+                                    size_t data_len);
 
-  static std::vector<std::string> Str2Vec(std::string s) {
+  static std::vector<std::string> Str2Vec(const std::string &s) {
     size_t i = 0;
     std::vector<std::string> vec;
     while (i < s.length()) {
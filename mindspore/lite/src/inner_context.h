@@ -63,6 +63,11 @@ struct InnerContext : public Context {
 
   bool device_and_pkg_support_fp16() const;
 
+  // const weights stay valid in the model buffer for the whole session, so packing them can wait for the first run
+  bool delay_pack_weight() const { return delay_pack_weight_; }
+
+  void set_delay_pack_weight(bool delay) { delay_pack_weight_ = delay; }
+
  private:
   bool IsAllDeviceTypeValid() const;
 
@@ -78,6 +83,8 @@ struct InnerContext : public Context {
 
   bool device_and_pkg_support_fp16_ = false;
 
+  bool delay_pack_weight_ = false;
+
   ActorThreadPool *thread_pool_{nullptr};
 };
 
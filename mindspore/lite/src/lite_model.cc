@@ -25,6 +25,7 @@
 #include "src/common/prim_util.h"
 #include "src/common/graph_util.h"
 #include "src/common/file_utils.h"
+#include "src/runtime/kernel/arm/base/packed_weight_cache.h"
 #ifdef ENABLE_V0
 #include "src/ops/compat/compat_register.h"
 #endif
@@ -100,7 +101,13 @@ int LiteModel::ConvertAttrToTensors() {
 
 void LiteModel::Free() {
   if (this->buf != nullptr) {
-    free(this->buf);
+    // a model buffer malloced at the same address later must not hit the packed weights of this one
+    kernel::PackedWeightCache::GetInstance()->DropOrigins(this->buf, this->buf_size_);
+    if (this->model_buf_by_mmap_) {
+      UnmapMmapBuffer(this->buf, this->buf_size_);
+    } else {
+      free(this->buf);
+    }
     this->buf = nullptr;
   }
   auto nodes_size = this->all_nodes_.size();
@@ -422,15 +429,43 @@ Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf) {
   return model;
 }
 
+Model *ImportFromMmapFile(const char *filename) {
+  size_t size = 0;
+  auto buf = ReadFileByMmap(filename, &size);
+  if (buf == nullptr) {
+    return nullptr;
+  }
+  auto *model = new (std::nothrow) LiteModel();
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "new model fail!";
+    UnmapMmapBuffer(buf, size);
+    return nullptr;
+  }
+  model->buf = buf;
+  model->buf_size_ = size;
+  model->set_model_buf_by_mmap(true);
+  auto status = model->ConstructModel();
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "construct model failed.";
+    delete model;
+    return nullptr;
+  }
+  return model;
+}
+
 Model *Model::Import(const char *model_buf, size_t size) { return ImportFromBuffer(model_buf, size, false); }
 
 Model *Model::Import(const char *filename) {
+#ifndef _WIN32
+  return ImportFromMmapFile(filename);
+#else
   size_t size = -1;
   auto buf = ReadFile(filename, &size);
   if (buf == nullptr) {
     return nullptr;
   }
   return ImportFromBuffer(buf, size, true);
+#endif
 }
 
 int Model::Export(Model *model, char *buffer, size_t *len) {
@@ -51,6 +51,10 @@ class LiteModel : public Model {
 
   void set_keep_model_buf(bool keep) { this->keep_model_buf_ = keep; }
 
+  bool model_buf_by_mmap() const { return this->model_buf_by_mmap_; }
+
+  void set_model_buf_by_mmap(bool by_mmap) { this->model_buf_by_mmap_ = by_mmap; }
+
  private:
 #ifdef ENABLE_V0
   int ConvertAttrs(Model::Node *node, std::vector<schema::Tensor *> *dst_tensor);
@@ -269,9 +273,12 @@ class LiteModel : public Model {
  protected:
   std::vector<char *> attr_tensor_bufs_;
   bool keep_model_buf_ = false;
+  bool model_buf_by_mmap_ = false;
 };
 
 Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf);
+
+Model *ImportFromMmapFile(const char *filename);
 }  // namespace lite
 }  // namespace mindspore
 
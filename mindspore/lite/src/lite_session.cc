@@ -17,6 +17,8 @@
 #include "src/lite_session.h"
 #include <vector>
 #include <utility>
+#include <atomic>
+#include <algorithm>
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
 #include "src/scheduler.h"
@@ -87,6 +89,38 @@ int DecompressTensor(const schema::Tensor &src_tensor, Tensor *dst_tensor) {
 #endif
   }
 }
+
+bool NeedDecompress(const schema::Tensor &src_tensor) {
+  if (src_tensor.data() == nullptr || src_tensor.data()->size() == 0 ||
+      TypeId(src_tensor.dataType()) == kObjectTypeTensorType) {
+    return false;
+  }
+  return src_tensor.weightQunatCompressType() != schema::WeightQunatCompressType_NONE ||
+         NeedBitUppackCheck(src_tensor);
+}
+
+struct DecompressTensorsArgs {
+  const lite::Model *model = nullptr;
+  const std::vector<lite::Tensor *> *tensors = nullptr;
+  const std::vector<size_t> *indices = nullptr;
+  int task_num = 1;
+  std::atomic_int ret{RET_OK};
+};
+
+int DecompressTensorsRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  auto args = reinterpret_cast<DecompressTensorsArgs *>(cdata);
+  MS_ASSERT(args != nullptr);
+  for (size_t i = task_id; i < args->indices->size(); i += args->task_num) {
+    auto index = args->indices->at(i);
+    auto ret = DecompressTensor(*(args->model->all_tensors_.at(index)), args->tensors->at(index));
+    if (ret != RET_OK && ret != RET_NO_CHANGE) {
+      MS_LOG(ERROR) << "Decompress data of " << index << "th tensor failed: " << ret;
+      args->ret = ret;
+      return ret;
+    }
+  }
+  return RET_OK;
+}
 }  // namespace
 
 LiteSession::LiteSession() { this->is_running_.store(false); }
@@ -191,6 +225,8 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
   MS_ASSERT(!model->sub_graphs_.empty());
   auto model_input_indices = model->input_indices_;
   auto model_output_indices = model->output_indices_;
+  // compressed weights are decoded after all tensors are created, spread over the thread pool
+  std::vector<size_t> decompress_indices;
   for (uint32_t i = 0; i < tensor_count; ++i) {
     auto *src_tensor = model->all_tensors_[i];
     if (src_tensor == nullptr) {
@@ -202,11 +238,16 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
       MS_LOG(ERROR) << "Convert new " << i << "th tensor failed!";
       return RET_NULL_PTR;
     }
-    auto ret = ConvertTensorsData(model, i, src_tensor, dst_tensor);
-    if (ret != RET_OK) {
-      MS_LOG(ERROR) << "Convert data of " << i << "th tensor failed";
-      delete (dst_tensor);
-      return ret;
+    if (NeedDecompress(*src_tensor) && dst_tensor->IsConst() && !IsContain(model_input_indices, i) &&
+        !IsContain(model_output_indices, i)) {
+      decompress_indices.push_back(i);
+    } else {
+      auto ret = ConvertTensorsData(model, i, src_tensor, dst_tensor);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "Convert data of " << i << "th tensor failed";
+        delete (dst_tensor);
+        return ret;
+      }
     }
     ConvertTensorsQuantParam(src_tensor, dst_tensor);
     if (IsContain(model_input_indices, i)) {
@@ -228,6 +269,31 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
     }
     this->tensors_.emplace_back(dst_tensor);
   }
+  return DecompressTensors(model, decompress_indices);
+}
+
+int LiteSession::DecompressTensors(const lite::Model *model, const std::vector<size_t> &indices) {
+  MS_ASSERT(model != nullptr);
+  if (indices.empty()) {
+    return RET_OK;
+  }
+  DecompressTensorsArgs args;
+  args.model = model;
+  args.tensors = &this->tensors_;
+  args.indices = &indices;
+  args.task_num = 1;
+  if (context_ != nullptr && context_->thread_pool() != nullptr) {
+    args.task_num = std::min(context_->thread_num_, static_cast<int>(indices.size()));
+  }
+  if (args.task_num <= 1) {
+    args.task_num = 1;
+    return DecompressTensorsRun(&args, 0, 0, 0);
+  }
+  auto ret = ParallelLaunch(context_, DecompressTensorsRun, &args, args.task_num);
+  if (ret != RET_OK || args.ret != RET_OK) {
+    MS_LOG(ERROR) << "Decompress tensors failed.";
+    return ret != RET_OK ? ret : args.ret.load();
+  }
   return RET_OK;
 }
 
@@ -994,29 +1060,41 @@ session::LiteSession *session::LiteSession::CreateSession(const char *model_buf,
 }
 
 session::LiteSession *lite::LiteSession::CreateSession(const std::string &model_path, const lite::Context *context) {
+#ifndef _WIN32
+  // the mapped model is kept by the session, so const tensors are read in place from the mapped file
+  auto *model = lite::ImportFromMmapFile(model_path.c_str());
+#else
   size_t model_size;
   auto model_buf = lite::ReadFile(model_path.c_str(), &model_size);
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "Read model file failed";
     return nullptr;
   }
-  auto *session = session::LiteSession::CreateSession(context);
-  if (session == nullptr) {
-    MS_LOG(ERROR) << "Create session failed";
-    return nullptr;
-  }
   auto *model = lite::ImportFromBuffer(model_buf, model_size, true);
+#endif
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model failed";
     return nullptr;
   }
+  auto *session = session::LiteSession::CreateSession(context);
+  if (session == nullptr) {
+    MS_LOG(ERROR) << "Create session failed";
+    delete model;
+    return nullptr;
+  }
   (reinterpret_cast<lite::LiteModel *>(model))->set_keep_model_buf(true);
+  auto *inner_session = reinterpret_cast<lite::LiteSession *>(session);
+  if (inner_session->context_ != nullptr) {
+    inner_session->context_->set_delay_pack_weight(true);
+  }
   auto ret = session->CompileGraph(model);
   if (ret != lite::RET_OK) {
     MS_LOG(ERROR) << "Compile model failed";
+    delete session;
+    delete model;
     return nullptr;
   }
-  (reinterpret_cast<lite::LiteSession *>(session))->set_model(model);
+  inner_session->set_model(model);
   return session;
 }
 }  // namespace mindspore
@@ -86,6 +86,8 @@ class LiteSession : public session::LiteSession {
 
   int ConvertTensors(const lite::Model *model);
 
+  int DecompressTensors(const lite::Model *model, const std::vector<size_t> &indices);
+
   void InitGraphInOutTensorsMap(const lite::Model *model);
 
   void IsolateOutputTensor();
@@ -46,7 +46,10 @@ void ConvolutionBaseCPUKernel::FreeAlignedData(void **ptr) {
 }
 
 ConvolutionBaseCPUKernel::~ConvolutionBaseCPUKernel() {
-  if (addr_map.find(reinterpret_cast<uintptr_t>(packed_weight_)) != addr_map.end()) {
+  if (is_weight_shared_) {
+    PackedWeightCache::GetInstance()->ReleasePackedWeight(packed_weight_);
+    packed_weight_ = nullptr;
+  } else if (addr_map.find(reinterpret_cast<uintptr_t>(packed_weight_)) != addr_map.end()) {
     FreeAlignedData(reinterpret_cast<void **>(&packed_weight_));
   } else if (packed_weight_ != nullptr) {
     free(packed_weight_);
@@ -124,6 +127,11 @@ int ConvolutionBaseCPUKernel::InitConvWeightBias() {
     MS_LOG(WARNING) << "The shape of weight tensor is not ready, the weight and bias would be inited in runtime.";
     return lite::RET_OK;
   }
+  if (packed_weight_ == nullptr && !is_pack_delayed_ && IsDelayPack()) {
+    // origin weight is read in place from the model buffer, pack it on first run
+    is_pack_delayed_ = true;
+    return lite::RET_OK;
+  }
   if (MallocWeightBiasData() != RET_OK) {
     MS_LOG(ERROR) << "Malloc data for bias and weight failed.";
     return lite::RET_ERROR;
@@ -135,7 +143,9 @@ int ConvolutionBaseCPUKernel::InitConvWeightBias() {
     MS_ASSERT(in_tensors_.size() == kInputSize1);
   }
   if (origin_weight_ != nullptr) {
-    PackWeight();
+    if (!is_weight_shared_) {
+      PackWeight();
+    }
   } else {
     is_repack_ = true;
     MS_LOG(WARNING) << "The weight is nullptr, will pack in runtime.";
@@ -143,6 +153,48 @@ int ConvolutionBaseCPUKernel::InitConvWeightBias() {
   return lite::RET_OK;
 }
 
+bool ConvolutionBaseCPUKernel::IsWeightShareable() {
+  if (origin_weight_ == nullptr || IsTrainable() || op_parameter_->is_train_session_) {
+    return false;
+  }
+  // only a weight read in place from the model buffer is identified by its address
+  auto weight_tensor = in_tensors_.at(kWeightIndex);
+  return origin_weight_ == weight_tensor->data_c() && !weight_tensor->own_data();
+}
+
+int ConvolutionBaseCPUKernel::MallocSharedPackedWeight(const std::string &pack_type, size_t packed_size) {
+  MS_ASSERT(IsWeightShareable());
+  auto weight_tensor = in_tensors_.at(kWeightIndex);
+  auto key = PackedWeightCache::GenerateKey(pack_type, origin_weight_, weight_tensor->Size());
+  packed_weight_ = PackedWeightCache::GetInstance()->GetPackedWeight(
+    key, origin_weight_, packed_size, [this](void *packed_weight) {
+      packed_weight_ = packed_weight;
+      PackWeight();
+      return RET_OK;
+    });
+  if (packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "get shared packed weight failed.";
+    return RET_ERROR;
+  }
+  is_weight_shared_ = true;
+  return RET_OK;
+}
+
+bool ConvolutionBaseCPUKernel::IsDelayPack() {
+  if (ctx_ == nullptr || !ctx_->delay_pack_weight() || IsTrainable() || origin_weight_ == nullptr) {
+    return false;
+  }
+  auto weight_tensor = in_tensors_.at(kWeightIndex);
+  if (origin_weight_ != weight_tensor->data_c() || weight_tensor->own_data()) {
+    return false;
+  }
+  if (in_tensors_.size() == kInputSize2) {
+    auto bias_tensor = in_tensors_.at(kBiasIndex);
+    return origin_bias_ == bias_tensor->data_c() && !bias_tensor->own_data();
+  }
+  return true;
+}
+
 int ConvolutionBaseCPUKernel::RepackWeight() {
   origin_weight_ = origin_weight_ != nullptr ? origin_weight_ : in_tensors_.at(kWeightIndex)->data_c();
   if (packed_weight_ == nullptr && InitConvWeightBias() != RET_OK) {
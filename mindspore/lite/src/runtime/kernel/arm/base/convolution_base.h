@@ -30,6 +30,7 @@
 #include "src/inner_kernel.h"
 #include "include/context.h"
 #include "src/runtime/kernel/arm/base/layout_transform.h"
+#include "src/runtime/kernel/arm/base/packed_weight_cache.h"
 #include "src/weight_decoder.h"
 #include "include/errorcode.h"
 
@@ -69,6 +70,10 @@ class ConvolutionBaseCPUKernel : public InnerKernel {
  protected:
   int InitConvWeightBias();
   int RepackWeight();
+  bool IsDelayPack();
+  bool IsWeightShareable();
+  // take packed_weight_ from the process-wide cache, packing it there by PackWeight if no other kernel did yet
+  int MallocSharedPackedWeight(const std::string &pack_type, size_t packed_size);
 
   virtual int MallocWeightBiasData() { return RET_OK; }
   virtual void PackWeight() {}
@@ -82,6 +87,8 @@ class ConvolutionBaseCPUKernel : public InnerKernel {
   int tile_num_ = 0;
   int thread_count_ = 1;
   bool is_repack_ = false;
+  bool is_pack_delayed_ = false;
+  bool is_weight_shared_ = false;
   void *origin_weight_;  // do not free
   void *origin_bias_;    // do not free
 };
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/arm/base/packed_weight_cache.h"
+#include <cstdint>
+#include <cstring>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore::kernel {
+PackedWeightCache *PackedWeightCache::GetInstance() {
+  static PackedWeightCache instance;
+  return &instance;
+}
+
+PackedWeightCache::~PackedWeightCache() {
+  for (auto &iter : packed_weights_) {
+    free(iter.first);
+  }
+  packed_weights_.clear();
+  key_data_.clear();
+}
+
+std::string PackedWeightCache::GenerateKey(const std::string &pack_type, const void *origin_weight,
+                                           size_t origin_size) {
+  if (origin_weight == nullptr) {
+    return "";
+  }
+  return pack_type + "_" + std::to_string(origin_size) + "_" +
+         std::to_string(reinterpret_cast<uintptr_t>(origin_weight));
+}
+
+void *PackedWeightCache::GetPackedWeight(const std::string &key, const void *origin_weight, size_t size,
+                                         const PackWeightFunc &pack_func) {
+  if (key.empty() || origin_weight == nullptr || size == 0) {
+    MS_LOG(ERROR) << "invalid packed weight key, origin weight or size: " << size;
+    return nullptr;
+  }
+  // packing is done under the lock, so no session ever sees a half packed weight
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key_iter = key_data_.find(key);
+  if (key_iter != key_data_.end()) {
+    auto &packed_weight = packed_weights_.at(key_iter->second);
+    if (packed_weight.size != size) {
+      MS_LOG(ERROR) << "packed weight size mismatch, cached: " << packed_weight.size << " required: " << size;
+      return nullptr;
+    }
+    packed_weight.ref_count++;
+    return key_iter->second;
+  }
+  auto data = malloc(size);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "malloc packed weight failed.";
+    return nullptr;
+  }
+  memset(data, 0, size);
+  if (pack_func(data) != lite::RET_OK) {
+    MS_LOG(ERROR) << "pack weight failed.";
+    free(data);
+    return nullptr;
+  }
+  packed_weights_[data] = {key, size, origin_weight, 1};
+  key_data_[key] = data;
+  return data;
+}
+
+void PackedWeightCache::ReleasePackedWeight(void *packed_weight) {
+  if (packed_weight == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = packed_weights_.find(packed_weight);
+  if (iter == packed_weights_.end()) {
+    MS_LOG(ERROR) << "packed weight is not in cache.";
+    return;
+  }
+  if (--iter->second.ref_count > 0) {
+    return;
+  }
+  auto key_iter = key_data_.find(iter->second.key);
+  if (key_iter != key_data_.end() && key_iter->second == packed_weight) {
+    key_data_.erase(key_iter);
+  }
+  packed_weights_.erase(iter);
+  free(packed_weight);
+}
+
+void PackedWeightCache::DropOrigins(const void *buf, size_t size) {
+  if (buf == nullptr || size == 0) {
+    return;
+  }
+  auto begin = reinterpret_cast<uintptr_t>(buf);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto iter = key_data_.begin(); iter != key_data_.end();) {
+    auto origin = reinterpret_cast<uintptr_t>(packed_weights_.at(iter->second).origin);
+    if (origin >= begin && origin - begin < size) {
+      iter = key_data_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+}  // namespace mindspore::kernel
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_BASE_PACKED_WEIGHT_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_BASE_PACKED_WEIGHT_CACHE_H_
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mindspore::kernel {
+using PackWeightFunc = std::function<int(void *packed_weight)>;
+
+// Process-wide cache of packed const weights. Kernels of different sessions compiled from the same model read their
+// const weights in place from the model buffer, so the origin weight pointer identifies the weight and kernels which
+// pack it in the same layout share one refcounted packed buffer instead of each keeping its own copy.
+class PackedWeightCache {
+ public:
+  static PackedWeightCache *GetInstance();
+
+  // key of a packed weight: pack_type must identify the packing function and every parameter it depends on, and
+  // origin_weight must point into the model buffer, a weight its kernel owns is never shared
+  static std::string GenerateKey(const std::string &pack_type, const void *origin_weight, size_t origin_size);
+
+  // return the packed weight of key, or malloc a zeroed buffer of size bytes and fill it with pack_func on miss
+  void *GetPackedWeight(const std::string &key, const void *origin_weight, size_t size, const PackWeightFunc &pack_func);
+
+  void ReleasePackedWeight(void *packed_weight);
+
+  // called before a model buffer is freed: no later lookup hits a packed weight whose origin weight lies in the buffer,
+  // so a model malloced at the same address never shares it. Kernels holding it still release it as usual.
+  void DropOrigins(const void *buf, size_t size);
+
+ private:
+  PackedWeightCache() = default;
+  ~PackedWeightCache();
+
+  struct PackedWeight {
+    std::string key;
+    size_t size = 0;
+    const void *origin = nullptr;
+    int ref_count = 0;
+  };
+
+  std::mutex mutex_;
+  // packed data of the keys which may still be hit
+  std::unordered_map<std::string, void *> key_data_;
+  // every packed weight which is still referenced, by its packed data
+  std::unordered_map<void *, PackedWeight> packed_weights_;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_BASE_PACKED_WEIGHT_CACHE_H_
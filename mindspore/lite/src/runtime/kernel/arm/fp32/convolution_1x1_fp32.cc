@@ -272,12 +272,21 @@ int Convolution1x1CPUKernel::MallocWeightBiasData() {
   auto input_channel = filter_tensor->Channel();
   auto output_channel = filter_tensor->Batch();
   int size = input_channel * UP_ROUND(output_channel, col_tile_) * sizeof(float);
-  packed_weight_ = malloc(size);
-  if (packed_weight_ == nullptr) {
-    MS_LOG(ERROR) << "Conv1x1 Malloc packed_weight_ error!";
-    return RET_ERROR;
+  if (IsWeightShareable()) {
+    auto pack_type = "Convolution1x1Fp32_" + std::to_string(col_tile_) + "_" + std::to_string(output_channel) + "_" +
+                     std::to_string(input_channel);
+    if (MallocSharedPackedWeight(pack_type, size) != RET_OK) {
+      MS_LOG(ERROR) << "Conv1x1 malloc shared packed_weight_ error!";
+      return RET_ERROR;
+    }
+  } else {
+    packed_weight_ = malloc(size);
+    if (packed_weight_ == nullptr) {
+      MS_LOG(ERROR) << "Conv1x1 Malloc packed_weight_ error!";
+      return RET_ERROR;
+    }
+    memset(reinterpret_cast<char *>(packed_weight_), 0, size);
   }
-  memset(reinterpret_cast<char *>(packed_weight_), 0, size);
 
   if (in_tensors_.size() == 3) {
     size = UP_ROUND(output_channel, col_tile_) * sizeof(float);
@@ -162,12 +162,21 @@ int ConvolutionCPUKernel::MallocWeightBiasData() {
   size_t oc_block_num = UP_ROUND(out_channel, OC_BLOCK);
   size_t kernel_plane = filter_tensor->Height() * filter_tensor->Width();
   size_t pack_weight_size = oc_block_num * in_channel * kernel_plane;
-  packed_weight_ = malloc(pack_weight_size * sizeof(float));
-  if (packed_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc packed weight failed.";
-    return RET_ERROR;
+  if (IsWeightShareable()) {
+    auto pack_type = "ConvolutionFp32_" + std::to_string(OC_BLOCK) + "_" + std::to_string(out_channel) + "_" +
+                     std::to_string(in_channel * kernel_plane);
+    if (MallocSharedPackedWeight(pack_type, pack_weight_size * sizeof(float)) != RET_OK) {
+      MS_LOG(ERROR) << "malloc shared packed weight failed.";
+      return RET_ERROR;
+    }
+  } else {
+    packed_weight_ = malloc(pack_weight_size * sizeof(float));
+    if (packed_weight_ == nullptr) {
+      MS_LOG(ERROR) << "malloc packed weight failed.";
+      return RET_ERROR;
+    }
+    memset(packed_weight_, 0, pack_weight_size * sizeof(float));
   }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
 
   bias_data_ = malloc(oc_block_num * sizeof(float));
   if (bias_data_ == nullptr) {
@@ -207,6 +207,29 @@ int MatmulFp32BaseCPUKernel::InitMatrixB(const float *src_ptr) {
   return RET_OK;
 }
 
+int MatmulFp32BaseCPUKernel::InitSharedMatrixB() {
+  MS_ASSERT(src_b_ != nullptr && origin_b_ != nullptr);
+  FreeResizeBufB();
+  auto pack_type = "MatmulFp32_" + std::to_string(vec_matmul_) + "_" + std::to_string(params_->b_transpose_) + "_" +
+                   std::to_string(params_->batch) + "_" + std::to_string(params_->deep_) + "_" +
+                   std::to_string(params_->col_) + "_" + std::to_string(params_->col_align_);
+  auto origin_size = static_cast<size_t>(params_->batch * params_->deep_ * params_->col_) * sizeof(float);
+  auto key = PackedWeightCache::GenerateKey(pack_type, origin_b_, origin_size);
+  auto packed_weight = PackedWeightCache::GetInstance()->GetPackedWeight(
+    key, origin_b_, static_cast<size_t>(matrix_b_pack_size_) * sizeof(float), [this](void *packed_weight) {
+      b_pack_ptr_ = reinterpret_cast<float *>(packed_weight);
+      return InitMatrixB(src_b_);
+    });
+  if (packed_weight == nullptr) {
+    b_pack_ptr_ = nullptr;
+    MS_LOG(ERROR) << "get shared packed matrix b failed";
+    return RET_ERROR;
+  }
+  b_pack_ptr_ = reinterpret_cast<float *>(packed_weight);
+  is_b_pack_shared_ = true;
+  return RET_OK;
+}
+
 void MatmulFp32BaseCPUKernel::FreeBiasBuf() {
   if (bias_ptr_ != nullptr) {
     free(bias_ptr_);
@@ -226,7 +249,11 @@ void MatmulFp32BaseCPUKernel::FreeResizeBufA() {
 }
 
 void MatmulFp32BaseCPUKernel::FreeResizeBufB() {
-  if (!op_parameter_->is_train_session_) {
+  if (is_b_pack_shared_) {
+    PackedWeightCache::GetInstance()->ReleasePackedWeight(b_pack_ptr_);
+    b_pack_ptr_ = nullptr;
+    is_b_pack_shared_ = false;
+  } else if (!op_parameter_->is_train_session_) {
     if (b_pack_ptr_ != nullptr) {
       ms_context_->allocator->Free(b_pack_ptr_);
       b_pack_ptr_ = nullptr;
@@ -329,6 +356,8 @@ int MatmulFp32BaseCPUKernel::Init() {
     }
     memcpy(src_b_, b_tensor->data_c(),
            params_->batch * params_->deep_ * params_->col_ * static_cast<int>(sizeof(float)));
+    // only a weight read in place from the model buffer is identified by its address and shared across sessions
+    origin_b_ = (op_parameter_->is_train_session_ || b_tensor->own_data()) ? nullptr : b_tensor->data_c();
   }
   return RET_OK;
 }
@@ -354,14 +383,22 @@ int MatmulFp32BaseCPUKernel::ReSize() {
   }
 
   if (params_->b_const_ && src_b_ != nullptr) {
-    if (InitBufferB() != RET_OK) {
-      FreeBuffSrcB();
-      return RET_ERROR;
-    }
-    if (InitMatrixB(src_b_) != RET_OK) {
-      FreeBuffSrcB();
-      MS_LOG(ERROR) << "InitMatrixB failed!";
-      return RET_ERROR;
+    if (origin_b_ != nullptr) {
+      if (InitSharedMatrixB() != RET_OK) {
+        FreeBuffSrcB();
+        MS_LOG(ERROR) << "InitSharedMatrixB failed!";
+        return RET_ERROR;
+      }
+    } else {
+      if (InitBufferB() != RET_OK) {
+        FreeBuffSrcB();
+        return RET_ERROR;
+      }
+      if (InitMatrixB(src_b_) != RET_OK) {
+        FreeBuffSrcB();
+        MS_LOG(ERROR) << "InitMatrixB failed!";
+        return RET_ERROR;
+      }
     }
     FreeBuffSrcB();
   }
@@ -21,6 +21,7 @@
 #include "src/inner_kernel.h"
 #include "nnacl/matmul_parameter.h"
 #include "include/errorcode.h"
+#include "src/runtime/kernel/arm/base/packed_weight_cache.h"
 
 using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_MEMORY_FAILED;
@@ -58,6 +59,7 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
   void FreeResizeBufA();
   void FreeResizeBufB();
   void FreeBuffSrcB();
+  int InitSharedMatrixB();
   int CalBroadCastBiasDataElements();
   int InitTmpOutBuffer();
 
@@ -73,6 +75,7 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
   int thread_stride_ = 0;
   int thread_count_ = 0;
   bool vec_matmul_ = false;
+  bool is_b_pack_shared_ = false;
   float *bias_ptr_ = nullptr;
   float *batch_a_ptr_ = nullptr;
   float *batch_b_ptr_ = nullptr;
@@ -81,6 +84,7 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
   int matrix_a_pack_size_ = -1;
   int matrix_b_pack_size_ = -1;
   float *src_b_ = nullptr;
+  const void *origin_b_ = nullptr;
   MatrixPackFun matrix_a_pack_fun_ = nullptr;
   MatrixPackFun matrix_b_pack_fun_ = nullptr;
 };
@@ -288,10 +288,10 @@ int WeightDecoder::UnPackToInt(const schema::Tensor &src_tensor, lite::Tensor *d
   dst_data = dst_tensor->data_c();
   int origin_bit = quant_param->numBits();
   if (origin_bit < kBitNum8 && origin_bit >= kBitNum1) {
-    UnPackUtil<int8_t, uint8_t>(&src_tensor, origin_bit, dst_data);
+    UnPackUtil<int8_t, uint8_t>(&src_tensor, origin_bit, dst_data, static_cast<size_t>(dst_tensor->ElementsNum()));
     return RET_OK;
   } else if (origin_bit < kBitNum16 && origin_bit > kBitNum8) {
-    UnPackUtil<int16_t, uint16_t>(&src_tensor, origin_bit, dst_data);
+    UnPackUtil<int16_t, uint16_t>(&src_tensor, origin_bit, dst_data, static_cast<size_t>(dst_tensor->ElementsNum()));
     return RET_OK;
   } else {
     MS_LOG(ERROR) << "Unsupported bit number: " << origin_bit;
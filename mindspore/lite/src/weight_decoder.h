@@ -20,7 +20,6 @@
 #include <map>
 #include <utility>
 #include <vector>
-#include <queue>
 #include <limits>
 #include <string>
 #include <cmath>
@@ -228,36 +227,7 @@ class WeightDecoder {
   static int DequantWeight(lite::Tensor *input_tensor, bool channel_first, TypeId dst_data_type = kNumberTypeFloat32);
 
   template <typename T1, typename T2>
-  static void UnPackData(int origin_bit, const T2 &packed_data, std::queue<bool> *unpack_bit_data, void *unpack_int,
-                         size_t *count, bool is_last) {
-    T2 uint_result = 0;
-    T1 result;
-    UnPackFromUintToOrigin<T2>(packed_data, unpack_bit_data);
-    while (static_cast<int>(unpack_bit_data->size()) >= origin_bit) {
-      for (int k = 0; k < origin_bit; k++) {
-        bool bit_tmp = unpack_bit_data->front();
-        uint_result = (static_cast<int>(bit_tmp) << static_cast<unsigned int>(k)) + uint_result;
-        unpack_bit_data->pop();
-      }
-      result = uint_result - static_cast<T2>(pow(2, origin_bit - 1));
-      (static_cast<T1 *>(unpack_int))[*count] = result;
-      uint_result = 0;
-      (*count)++;
-    }
-    size_t remainder = unpack_bit_data->size();
-    if (is_last && remainder > 0) {
-      for (size_t i = 0; i < remainder; i++) {
-        bool bit = unpack_bit_data->front();
-        uint_result = (static_cast<unsigned int>(bit) << i) + uint_result;
-        unpack_bit_data->pop();
-      }
-      result = static_cast<T1>(uint_result - static_cast<T2>(pow(2, origin_bit - 1)));
-      (static_cast<T1 *>(unpack_int))[*count] = result;
-    }
-  }
-
-  template <typename T1, typename T2>
-  static void UnPackUtil(const schema::Tensor *input_tensor, int origin_bit, void *unpack_int_data) {
+  static void UnPackUtil(const schema::Tensor *input_tensor, int origin_bit, void *unpack_int_data, size_t unpack_num) {
     if (input_tensor == nullptr || input_tensor->data() == nullptr) {
       MS_LOG(ERROR) << "tensor data is null";
       return;
@@ -265,24 +235,26 @@ class WeightDecoder {
     auto weight_data = input_tensor->data()->data();
     int pack_size =
       input_tensor->dataType() == kNumberTypeInt8 ? input_tensor->data()->size() : input_tensor->data()->size() / 2;
-    std::queue<bool> unpack_bit_data;
+    auto packed_data = static_cast<const T2 *>(static_cast<const void *>(weight_data));
+    auto unpack_int = static_cast<T1 *>(unpack_int_data);
+    // bits are packed lsb first, so a whole packed word is shifted into the accumulator at once and every origin_bit
+    // wide field is taken from its low end. The zero bits padding the last word are not unpacked.
+    const uint64_t mask = (static_cast<uint64_t>(1) << static_cast<unsigned int>(origin_bit)) - 1;
+    const int64_t offset = static_cast<int64_t>(1) << static_cast<unsigned int>(origin_bit - 1);
+    uint64_t bit_buffer = 0;
+    int bit_count = 0;
     size_t count = 0;
-    for (int i = 0; i < pack_size; ++i) {
-      T2 pack_data = (static_cast<const T2 *>(static_cast<const void *>(weight_data)))[i];
-      bool is_last = i == pack_size - 1;
-      UnPackData<T1, T2>(origin_bit, pack_data, &unpack_bit_data, unpack_int_data, &count, is_last);
+    for (int i = 0; i < pack_size && count < unpack_num; ++i) {
+      bit_buffer |= static_cast<uint64_t>(packed_data[i]) << static_cast<unsigned int>(bit_count);
+      bit_count += static_cast<int>(sizeof(T2) * kBitNum8);
+      while (bit_count >= origin_bit && count < unpack_num) {
+        unpack_int[count++] = static_cast<T1>(static_cast<int64_t>(bit_buffer & mask) - offset);
+        bit_buffer >>= static_cast<unsigned int>(origin_bit);
+        bit_count -= origin_bit;
+      }
     }
-  }
-
-  template <typename T2>
-  static void UnPackFromUintToOrigin(const T2 &packed_data, std::queue<bool> *unpack_bit_data) {
-    auto n = packed_data;
-    size_t bit_count = 0;
-    while (bit_count < sizeof(T2) * 8) {
-      bool a = n % 2;
-      n = n >> 1;
-      bit_count++;
-      unpack_bit_data->push(a);
+    if (bit_count > 0 && count < unpack_num) {
+      unpack_int[count] = static_cast<T1>(static_cast<int64_t>(bit_buffer & mask) - offset);
     }
   }
 };
@@ -15,6 +15,8 @@
  */
 
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include "schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
@@ -24,6 +26,8 @@
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
 #include "src/lite_session.h"
+#include "src/lite_model.h"
+#include "src/common/file_utils.h"
 
 namespace mindspore {
 class InferTest : public mindspore::CommonTest {
@@ -261,4 +265,163 @@ TEST_F(InferTest, TestModel) {
   MS_LOG(INFO) << "Passed";
 }
 
+namespace {
+constexpr int kMmapModelOutChannel = 2;
+constexpr int kMmapModelInChannel = 3;
+
+// a convolution model with a const weight and bias, saved to file_name
+bool SaveConvModel(const std::string &file_name) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1, 2};
+  node->outputIndex = {3};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2DFusion;
+  auto primitive = new schema::Conv2DFusionT;
+  primitive->pad_mode = schema::PadMode_SAME;
+  primitive->in_channel = kMmapModelInChannel;
+  primitive->out_channel = kMmapModelOutChannel;
+  primitive->format = schema::Format_NHWC;
+  primitive->stride = std::vector<int64_t>{1, 1};
+  primitive->kernel_size = std::vector<int64_t>{3, 3};
+  primitive->dilation = std::vector<int64_t>{1, 1};
+  node->primitive->value.value = primitive;
+  node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {3};
+
+  auto input0 = std::make_unique<schema::TensorT>();
+  input0->nodeType = lite::NodeType_ValueNode;
+  input0->format = schema::Format_NHWC;
+  input0->dataType = TypeId::kNumberTypeFloat32;
+  input0->dims = {1, 4, 5, kMmapModelInChannel};
+  input0->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input0));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = lite::NodeType_ValueNode;
+  weight->format = schema::Format_KHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {kMmapModelOutChannel, 3, 3, kMmapModelInChannel};
+  std::vector<float> weight_data(kMmapModelOutChannel * 3 * 3 * kMmapModelInChannel);
+  for (size_t i = 0; i < weight_data.size(); ++i) {
+    weight_data[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  }
+  weight->data.resize(weight_data.size() * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto bias = std::make_unique<schema::TensorT>();
+  bias->nodeType = lite::NodeType_ValueNode;
+  bias->format = schema::Format_NHWC;
+  bias->dataType = TypeId::kNumberTypeFloat32;
+  bias->dims = {kMmapModelOutChannel};
+  std::vector<float> bias_data = {0.5f, -1.0f};
+  bias->data.resize(bias_data.size() * sizeof(float));
+  memcpy(bias->data.data(), bias_data.data(), bias->data.size());
+  bias->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(bias));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  std::ofstream ofs(file_name, std::ios::binary | std::ios::trunc);
+  ofs.write(reinterpret_cast<const char *>(builder.GetBufferPointer()), builder.GetSize());
+  return ofs.good();
+}
+
+// fill the input of the session, run it and return its output
+std::vector<float> RunConvModel(session::LiteSession *session) {
+  auto inputs = session->GetInputs();
+  if (inputs.size() != 1) {
+    return {};
+  }
+  auto input_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  for (int i = 0; i < inputs.front()->ElementsNum(); ++i) {
+    input_data[i] = static_cast<float>(i % 5 - 2);
+  }
+  if (session->RunGraph() != lite::RET_OK) {
+    return {};
+  }
+  auto output = session->GetOutputs().begin()->second;
+  auto output_data = reinterpret_cast<float *>(output->MutableData());
+  return std::vector<float>(output_data, output_data + output->ElementsNum());
+}
+}  // namespace
+
+TEST_F(InferTest, TestMmapModelFile) {
+  std::string model_path = "./mmap_model_test.ms";
+  ASSERT_TRUE(SaveConvModel(model_path));
+  size_t file_size = 0;
+  auto file_buf = lite::ReadFile(model_path.c_str(), &file_size);
+  ASSERT_NE(nullptr, file_buf);
+
+  // the mapping holds the file and is private, a write to it does not reach the file
+  size_t map_size = 0;
+  auto map_buf = lite::ReadFileByMmap(model_path.c_str(), &map_size);
+  ASSERT_NE(nullptr, map_buf);
+  ASSERT_EQ(file_size, map_size);
+  ASSERT_EQ(0, memcmp(file_buf, map_buf, map_size));
+  map_buf[0] = static_cast<char>(~map_buf[0]);
+  lite::UnmapMmapBuffer(map_buf, map_size);
+  size_t reread_size = 0;
+  auto reread_buf = lite::ReadFile(model_path.c_str(), &reread_size);
+  ASSERT_NE(nullptr, reread_buf);
+  ASSERT_EQ(file_size, reread_size);
+  ASSERT_EQ(0, memcmp(file_buf, reread_buf, file_size));
+  delete[] reread_buf;
+  delete[] file_buf;
+  ASSERT_EQ(nullptr, lite::ReadFileByMmap("./mmap_model_not_exist.ms", &map_size));
+
+  // a model imported from the file is mapped, and Free unmaps the model buffer
+  auto model = lite::Model::Import(model_path.c_str());
+  ASSERT_NE(nullptr, model);
+  auto lite_model = reinterpret_cast<lite::LiteModel *>(model);
+  ASSERT_TRUE(lite_model->model_buf_by_mmap());
+  ASSERT_NE(nullptr, model->buf);
+  model->Free();
+  ASSERT_EQ(nullptr, model->buf);
+  delete model;
+  std::remove(model_path.c_str());
+}
+
+TEST_F(InferTest, TestSessionKeepsMmapModel) {
+  std::string model_path = "./mmap_model_session_test.ms";
+  ASSERT_TRUE(SaveConvModel(model_path));
+  lite::Context context;
+  context.thread_num_ = 2;
+
+  // the session compiled from a copy of the file, which frees the model buffer once compiled
+  size_t size = 0;
+  auto model_buf = lite::ReadFile(model_path.c_str(), &size);
+  ASSERT_NE(nullptr, model_buf);
+  auto buf_session = session::LiteSession::CreateSession(model_buf, size, &context);
+  delete[] model_buf;
+  ASSERT_NE(nullptr, buf_session);
+  auto expect = RunConvModel(buf_session);
+  ASSERT_EQ(4 * 5 * kMmapModelOutChannel, expect.size());
+  delete buf_session;
+
+  // the session compiled from the path keeps the mapped model, the weight is read from it when the file is gone
+  auto session = lite::LiteSession::CreateSession(model_path, &context);
+  ASSERT_NE(nullptr, session);
+  std::remove(model_path.c_str());
+  // the weight is packed on the first run, the second run reuses it
+  for (int i = 0; i < 2; ++i) {
+    auto output = RunConvModel(session);
+    ASSERT_EQ(expect.size(), output.size());
+    ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), static_cast<int>(expect.size()), 0.0001));
+  }
+  delete session;
+}
 }  // namespace mindspore
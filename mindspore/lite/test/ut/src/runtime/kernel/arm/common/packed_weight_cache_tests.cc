@@ -0,0 +1,97 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/kernel/arm/base/packed_weight_cache.h"
+
+namespace mindspore {
+using kernel::PackedWeightCache;
+
+class TestPackedWeightCache : public mindspore::CommonTest {
+ public:
+  TestPackedWeightCache() {}
+};
+
+namespace {
+void *GetPacked(const std::vector<float> &weight, int *pack_count) {
+  auto key = PackedWeightCache::GenerateKey("TestReverse", weight.data(), weight.size() * sizeof(float));
+  return PackedWeightCache::GetInstance()->GetPackedWeight(
+    key, weight.data(), weight.size() * sizeof(float), [&weight, pack_count](void *packed_weight) {
+      auto dst = reinterpret_cast<float *>(packed_weight);
+      for (size_t i = 0; i < weight.size(); ++i) {
+        dst[i] = weight[weight.size() - 1 - i];
+      }
+      (*pack_count)++;
+      return lite::RET_OK;
+    });
+}
+}  // namespace
+
+TEST_F(TestPackedWeightCache, SameOriginShared) {
+  std::vector<float> weight = {1, 2, 3, 4};
+  int pack_count = 0;
+  auto packed = GetPacked(weight, &pack_count);
+  auto packed_again = GetPacked(weight, &pack_count);
+  ASSERT_NE(packed, nullptr);
+  ASSERT_EQ(packed, packed_again);
+  ASSERT_EQ(pack_count, 1);
+  ASSERT_EQ(reinterpret_cast<float *>(packed)[0], 4);
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(packed);
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(packed_again);
+}
+
+TEST_F(TestPackedWeightCache, OtherOriginNotShared) {
+  // a copy of the weight in another buffer is another weight, even with the same bytes
+  std::vector<float> weight = {1, 2, 3, 4};
+  std::vector<float> weight_copy = weight;
+  std::vector<float> other_weight = {5, 6, 7, 8};
+  int pack_count = 0;
+  auto packed = GetPacked(weight, &pack_count);
+  auto copy_packed = GetPacked(weight_copy, &pack_count);
+  auto other_packed = GetPacked(other_weight, &pack_count);
+  ASSERT_NE(packed, copy_packed);
+  ASSERT_NE(packed, other_packed);
+  ASSERT_EQ(pack_count, 3);
+  ASSERT_EQ(reinterpret_cast<float *>(other_packed)[0], 8);
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(packed);
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(copy_packed);
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(other_packed);
+}
+
+TEST_F(TestPackedWeightCache, DroppedOriginNotHit) {
+  // the model buffer of the weight is freed, a buffer at the same address is another model
+  std::vector<float> weight = {1, 2, 3, 4};
+  int pack_count = 0;
+  auto packed = GetPacked(weight, &pack_count);
+  PackedWeightCache::GetInstance()->DropOrigins(weight.data(), weight.size() * sizeof(float));
+  weight = {5, 6, 7, 8};
+  auto new_packed = GetPacked(weight, &pack_count);
+  ASSERT_NE(packed, new_packed);
+  ASSERT_EQ(pack_count, 2);
+  ASSERT_EQ(reinterpret_cast<float *>(packed)[0], 4);
+  ASSERT_EQ(reinterpret_cast<float *>(new_packed)[0], 8);
+
+  // releasing the dropped weight keeps the new one cached
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(packed);
+  auto new_again = GetPacked(weight, &pack_count);
+  ASSERT_EQ(new_again, new_packed);
+  ASSERT_EQ(pack_count, 2);
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(new_packed);
+  PackedWeightCache::GetInstance()->ReleasePackedWeight(new_again);
+}
+}  // namespace mindspore
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include "src/common/log_adapter.h"
+#include "common/common_test.h"
+#include "nnacl/conv_parameter.h"
+#include "src/runtime/kernel/arm/fp32/convolution_fp32.h"
+
+namespace mindspore {
+class TestConvolutionFp32 : public mindspore::CommonTest {
+ public:
+  TestConvolutionFp32() {}
+};
+
+namespace {
+constexpr int kBatch = 1;
+constexpr int kHeight = 4;
+constexpr int kWidth = 5;
+constexpr int kInChannel = 3;
+constexpr int kOutChannel = 2;
+constexpr int kKernel = 3;
+
+// a convolution kernel which exposes its packed weight
+class PackedWeightConvKernel : public kernel::ConvolutionCPUKernel {
+ public:
+  using kernel::ConvolutionCPUKernel::ConvolutionCPUKernel;
+  const void *packed_weight() const { return packed_weight_; }
+};
+
+// a 3x3 same padded convolution of NHWC input and KHWC weight
+std::vector<float> RefConv(const std::vector<float> &input, const std::vector<float> &weight,
+                           const std::vector<float> &bias) {
+  std::vector<float> output(kHeight * kWidth * kOutChannel);
+  for (int h = 0; h < kHeight; ++h) {
+    for (int w = 0; w < kWidth; ++w) {
+      for (int oc = 0; oc < kOutChannel; ++oc) {
+        float value = bias[oc];
+        for (int kh = 0; kh < kKernel; ++kh) {
+          for (int kw = 0; kw < kKernel; ++kw) {
+            int ih = h + kh - 1;
+            int iw = w + kw - 1;
+            if (ih < 0 || ih >= kHeight || iw < 0 || iw >= kWidth) {
+              continue;
+            }
+            for (int ic = 0; ic < kInChannel; ++ic) {
+              value += input[(ih * kWidth + iw) * kInChannel + ic] *
+                       weight[((oc * kKernel + kh) * kKernel + kw) * kInChannel + ic];
+            }
+          }
+        }
+        output[(h * kWidth + w) * kOutChannel + oc] = value;
+      }
+    }
+  }
+  return output;
+}
+
+// the tensors, the context and the convolution kernel of one session
+struct ConvSession {
+  std::vector<lite::Tensor *> inputs;
+  std::vector<lite::Tensor *> outputs;
+  lite::InnerContext ctx;
+  PackedWeightConvKernel *conv = nullptr;
+
+  // the weight and bias are read in place from model_buf as a session compiled from a kept model buffer does, or
+  // copied into the tensors when in_place is false
+  int Init(float *weight, float *bias, bool in_place, bool delay_pack) {
+    auto conv_param = reinterpret_cast<ConvParameter *>(malloc(sizeof(ConvParameter)));
+    if (conv_param == nullptr) {
+      return lite::RET_ERROR;
+    }
+    memset(conv_param, 0, sizeof(ConvParameter));
+    conv_param->op_parameter_.thread_num_ = 1;
+    conv_param->kernel_h_ = kKernel;
+    conv_param->kernel_w_ = kKernel;
+    conv_param->stride_h_ = 1;
+    conv_param->stride_w_ = 1;
+    conv_param->dilation_h_ = 1;
+    conv_param->dilation_w_ = 1;
+    conv_param->pad_u_ = 1;
+    conv_param->pad_d_ = 1;
+    conv_param->pad_l_ = 1;
+    conv_param->pad_r_ = 1;
+    conv_param->group_ = 1;
+    conv_param->act_type_ = ActType_No;
+
+    auto input = new lite::Tensor(kNumberTypeFloat32, {kBatch, kHeight, kWidth, kInChannel});
+    auto weight_t = new lite::Tensor(kNumberTypeFloat32, {kOutChannel, kKernel, kKernel, kInChannel},
+                                     mindspore::NHWC, lite::Tensor::Category::CONST_TENSOR);
+    auto bias_t =
+      new lite::Tensor(kNumberTypeFloat32, {kOutChannel}, mindspore::NHWC, lite::Tensor::Category::CONST_TENSOR);
+    auto output = new lite::Tensor(kNumberTypeFloat32, {kBatch, kHeight, kWidth, kOutChannel});
+    inputs = {input, weight_t, bias_t};
+    outputs = {output};
+    if (input->MallocData() != lite::RET_OK || output->MallocData() != lite::RET_OK) {
+      free(conv_param);
+      return lite::RET_ERROR;
+    }
+    for (auto *tensor : {weight_t, bias_t}) {
+      auto *data = tensor == weight_t ? weight : bias;
+      if (in_place) {
+        tensor->set_data(data);
+        tensor->set_own_data(false);
+      } else {
+        if (tensor->MallocData() != lite::RET_OK) {
+          free(conv_param);
+          return lite::RET_ERROR;
+        }
+        memcpy(tensor->data_c(), data, tensor->Size());
+      }
+    }
+
+    ctx.thread_num_ = 1;
+    if (ctx.Init() != lite::RET_OK) {
+      free(conv_param);
+      return lite::RET_ERROR;
+    }
+    ctx.set_delay_pack_weight(delay_pack);
+    conv = new PackedWeightConvKernel(reinterpret_cast<OpParameter *>(conv_param), inputs, outputs, &ctx,
+                                      reinterpret_cast<float *>(weight_t->data_c()),
+                                      reinterpret_cast<float *>(bias_t->data_c()));
+    auto ret = conv->Init();
+    if (ret != lite::RET_OK) {
+      return ret;
+    }
+    return conv->ReSize();
+  }
+
+  ~ConvSession() {
+    delete conv;
+    for (auto tensor : inputs) {
+      delete tensor;
+    }
+    for (auto tensor : outputs) {
+      delete tensor;
+    }
+  }
+};
+}  // namespace
+
+TEST_F(TestConvolutionFp32, DelayPackOnFirstRun) {
+  // the weight and bias of the model buffer the session keeps
+  std::vector<float> weight(kOutChannel * kKernel * kKernel * kInChannel);
+  std::vector<float> bias = {0.5f, -1.0f};
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  }
+  std::vector<float> input(kBatch * kHeight * kWidth * kInChannel);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  }
+  auto correct = RefConv(input, weight, bias);
+
+  ConvSession session;
+  ASSERT_EQ(lite::RET_OK, session.Init(weight.data(), bias.data(), true, true));
+  ASSERT_EQ(session.conv->packed_weight(), nullptr);
+  memcpy(session.inputs[0]->data_c(), input.data(), input.size() * sizeof(float));
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(lite::RET_OK, session.conv->Run());
+    ASSERT_NE(session.conv->packed_weight(), nullptr);
+    ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(session.outputs[0]->data_c()), correct.data(),
+                                   static_cast<int>(correct.size()), 0.0001));
+  }
+
+  // a weight the session owns may be freed with the model buffer, so it is packed at once
+  ConvSession own_session;
+  ASSERT_EQ(lite::RET_OK, own_session.Init(weight.data(), bias.data(), false, true));
+  ASSERT_NE(own_session.conv->packed_weight(), nullptr);
+
+  // without the delay the weight in the model buffer is packed at once too
+  ConvSession eager_session;
+  ASSERT_EQ(lite::RET_OK, eager_session.Init(weight.data(), bias.data(), true, false));
+  ASSERT_NE(eager_session.conv->packed_weight(), nullptr);
+  memcpy(eager_session.inputs[0]->data_c(), input.data(), input.size() * sizeof(float));
+  ASSERT_EQ(lite::RET_OK, eager_session.conv->Run());
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(eager_session.outputs[0]->data_c()), correct.data(),
+                                 static_cast<int>(correct.size()), 0.0001));
+}
+}  // namespace mindspore
@@ -216,4 +216,88 @@ TEST_F(TestFcFp32, FcTest3) {
   delete ctx;
 }
 
+namespace {
+// a fullconnection kernel which exposes its packed weight
+class PackedWeightFcKernel : public kernel::FullconnectionCPUKernel {
+ public:
+  using kernel::FullconnectionCPUKernel::FullconnectionCPUKernel;
+  const float *packed_weight() const { return b_pack_ptr_; }
+};
+
+// the tensors, the context and the fullconnection kernel of one session of FcTestInit1
+struct FcSession {
+  std::vector<lite::Tensor *> inputs;
+  std::vector<lite::Tensor *> outputs;
+  lite::InnerContext ctx;
+  PackedWeightFcKernel *fc = nullptr;
+  float *correct = nullptr;
+  int total_size = 0;
+
+  // the weight is read in place from model_buf as a session does, or owned by the session when model_buf is null
+  int Init(float *model_buf) {
+    auto matmul_param = reinterpret_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+    if (matmul_param == nullptr) {
+      return lite::RET_ERROR;
+    }
+    memset(matmul_param, 0, sizeof(MatMulParameter));
+    total_size = FcTestInit1(&inputs, &outputs, matmul_param, &correct);
+    if (model_buf != nullptr) {
+      auto weight_t = inputs[1];
+      memcpy(model_buf, weight_t->data_c(), weight_t->Size());
+      weight_t->FreeData();
+      weight_t->set_data(model_buf);
+      weight_t->set_own_data(false);
+    }
+    ctx.thread_num_ = 2;
+    matmul_param->op_parameter_.thread_num_ = 2;
+    if (ctx.Init() != lite::RET_OK) {
+      free(matmul_param);
+      return lite::RET_ERROR;
+    }
+    fc = new PackedWeightFcKernel(reinterpret_cast<OpParameter *>(matmul_param), inputs, outputs, &ctx);
+    return fc->Init();
+  }
+
+  ~FcSession() {
+    delete fc;
+    for (auto tensor : inputs) {
+      delete tensor;
+    }
+    for (auto tensor : outputs) {
+      delete tensor;
+    }
+    free(correct);
+  }
+};
+}  // namespace
+
+TEST_F(TestFcFp32, FcSharedPackedWeight) {
+  // the weight of FcTestInit1 in the model buffer two sessions are compiled from
+  std::vector<float> model_buf(3 * 8);
+  FcSession session;
+  FcSession other_session;
+  ASSERT_EQ(lite::RET_OK, session.Init(model_buf.data()));
+  ASSERT_EQ(lite::RET_OK, other_session.Init(model_buf.data()));
+  ASSERT_NE(session.fc->packed_weight(), nullptr);
+  ASSERT_EQ(session.fc->packed_weight(), other_session.fc->packed_weight());
+
+  // a weight the session owns is packed by its kernel alone
+  FcSession own_session;
+  ASSERT_EQ(lite::RET_OK, own_session.Init(nullptr));
+  ASSERT_NE(own_session.fc->packed_weight(), session.fc->packed_weight());
+
+  for (auto *fc_session : {&session, &other_session, &own_session}) {
+    ASSERT_EQ(lite::RET_OK, fc_session->fc->Run());
+    ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(fc_session->outputs[0]->MutableData()),
+                                   fc_session->correct, fc_session->total_size, 0.0001));
+  }
+
+  // the packed weight outlives the kernel of the first session
+  delete session.fc;
+  session.fc = nullptr;
+  ASSERT_EQ(lite::RET_OK, other_session.fc->Run());
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(other_session.outputs[0]->MutableData()),
+                                 other_session.correct, other_session.total_size, 0.0001));
+}
+
 }  // namespace mindspore
@@ -0,0 +1,295 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/conv_depthwise_int8.h"
+#include "nnacl/int8/fixed_point.h"
+
+namespace mindspore {
+class TestMatmulInt8Avx : public mindspore::CommonTest {
+ public:
+  TestMatmulInt8Avx() {}
+};
+
+namespace {
+using MatmulInt8OptFunc = std::function<void(const int8_t *, const int8_t *, int8_t *, int, int, int, const int *,
+                                             const int *, int, int, int, const int32_t *, const int32_t *,
+                                             const int32_t *, size_t, size_t, const int32_t *)>;
+
+// the odd sizes run the row, col and depth tails of the kernels
+const std::vector<int> kRows = {1, 2, 3, 5, 7, 9, 13};
+const std::vector<int> kCols = {1, 3, 4, 5, 7, 8, 9, 17};
+const std::vector<int> kDepths = {1, 3, 15, 17, 33};
+
+struct ActRange {
+  int mini;
+  int maxi;
+};
+// no activation, relu with out_zp 5 and a narrow range
+const std::vector<ActRange> kActRanges = {{-128, 127}, {5, 127}, {-50, 60}};
+
+struct QuantArgs {
+  std::vector<int32_t> bias;
+  std::vector<int32_t> multiplier;
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+  std::vector<int32_t> filter_zp;
+  int32_t out_zp;
+};
+
+QuantArgs RandomQuantArgs(std::mt19937 *gen, int col, bool per_channel) {
+  std::uniform_int_distribution<int32_t> bias_dist(-5000, 5000);
+  std::uniform_int_distribution<int32_t> multiplier_dist(1 << 30, INT32_MAX);
+  std::uniform_int_distribution<int32_t> left_dist(0, 1);
+  std::uniform_int_distribution<int32_t> right_dist(-12, -4);
+  std::uniform_int_distribution<int32_t> zp_dist(-20, 20);
+  QuantArgs args;
+  int quant_num = per_channel ? col : 1;
+  for (int c = 0; c < col; ++c) {
+    args.bias.push_back(bias_dist(*gen));
+    args.filter_zp.push_back(zp_dist(*gen));
+  }
+  for (int i = 0; i < quant_num; ++i) {
+    args.multiplier.push_back(multiplier_dist(*gen));
+    args.left_shift.push_back(left_dist(*gen));
+    args.right_shift.push_back(right_dist(*gen));
+  }
+  args.out_zp = zp_dist(*gen);
+  return args;
+}
+
+int32_t Requantize(int32_t value, const QuantArgs &args, int c, bool per_channel, int mini, int maxi) {
+  int index = per_channel ? c : 0;
+  value = MultiplyByQuantizedMultiplier(value, args.multiplier[index], args.left_shift[index],
+                                        args.right_shift[index]) +
+          args.out_zp;
+  return MSMAX(mini, MSMIN(maxi, value));
+}
+
+std::vector<int8_t> RandomInt8(std::mt19937 *gen, int row, int deep) {
+  std::uniform_int_distribution<int> dist(-128, 127);
+  std::vector<int8_t> data(row * deep);
+  for (auto &value : data) {
+    value = static_cast<int8_t>(dist(*gen));
+  }
+  return data;
+}
+
+// pack a row-major row x deep matrix in blocks of row_block rows by deep_block depths, padded with zeros
+std::vector<int8_t> PackBlocks(const std::vector<int8_t> &src, int row, int deep, int row_block, int deep_block) {
+  int row_up = UP_ROUND(row, row_block);
+  int deep_up = UP_ROUND(deep, deep_block);
+  std::vector<int8_t> packed(row_up * deep_up, 0);
+  for (int r = 0; r < row; ++r) {
+    for (int d = 0; d < deep; ++d) {
+      size_t index = (r / row_block) * deep_up * row_block + (d / deep_block) * row_block * deep_block +
+                     (r % row_block) * deep_block + d % deep_block;
+      packed[index] = src[r * deep + d];
+    }
+  }
+  return packed;
+}
+
+std::vector<int32_t> RowSums(const std::vector<int8_t> &a, int row, int deep) {
+  std::vector<int32_t> sums(row, 0);
+  for (int r = 0; r < row; ++r) {
+    for (int d = 0; d < deep; ++d) {
+      sums[r] += a[r * deep + d];
+    }
+  }
+  return sums;
+}
+
+// the scalar loop of MatmulInt8Opt on row-major a and the transposed b
+std::vector<int8_t> RefMatmulInt8(const std::vector<int8_t> &a, const std::vector<int8_t> &b, int row, int col,
+                                  int deep, const std::vector<int32_t> &a_sums, const QuantArgs &args,
+                                  bool per_channel, int mini, int maxi) {
+  std::vector<int8_t> dst(row * col);
+  for (int r = 0; r < row; ++r) {
+    for (int c = 0; c < col; ++c) {
+      int32_t value = 0;
+      for (int d = 0; d < deep; ++d) {
+        value += a[r * deep + d] * b[c * deep + d];
+      }
+      value -= per_channel ? a_sums[r] * args.filter_zp[c] : a_sums[r];
+      value += args.bias[c];
+      dst[r * col + c] = static_cast<int8_t>(Requantize(value, args, c, per_channel, mini, maxi));
+    }
+  }
+  return dst;
+}
+
+void CheckMatmulInt8Opt(const MatmulInt8OptFunc &func, bool per_channel) {
+  std::mt19937 gen(1);
+  for (int row : kRows) {
+    for (int col : kCols) {
+      for (int deep : kDepths) {
+        for (const auto &act : kActRanges) {
+          auto a = RandomInt8(&gen, row, deep);
+          auto b = RandomInt8(&gen, col, deep);
+          auto args = RandomQuantArgs(&gen, col, per_channel);
+          auto a_sums = RowSums(a, row, deep);
+          if (!per_channel) {
+            for (auto &sum : a_sums) {
+              sum *= args.filter_zp[0];
+            }
+          }
+          auto expect = RefMatmulInt8(a, b, row, col, deep, a_sums, args, per_channel, act.mini, act.maxi);
+          auto a_pack = PackBlocks(a, row, deep, C4NUM, C16NUM);
+          auto b_pack = PackBlocks(b, col, deep, C4NUM, C16NUM);
+          std::vector<int8_t> dst(row * col, 0);
+          func(a_pack.data(), b_pack.data(), dst.data(), row, col, UP_ROUND(deep, C16NUM), a_sums.data(),
+               args.bias.data(), act.mini, act.maxi, args.out_zp, args.multiplier.data(), args.left_shift.data(),
+               args.right_shift.data(), col, per_channel, args.filter_zp.data());
+          ASSERT_EQ(dst, expect) << "row " << row << " col " << col << " deep " << deep << " mini " << act.mini;
+        }
+      }
+    }
+  }
+}
+
+void CheckMatMulInt8_8x8_r(bool per_channel) {
+  std::mt19937 gen(2);
+  for (int row : kRows) {
+    for (int col : kCols) {
+      for (int deep : kDepths) {
+        for (const auto &act : kActRanges) {
+          auto a = RandomInt8(&gen, row, deep);
+          auto b = RandomInt8(&gen, col, deep);
+          auto args = RandomQuantArgs(&gen, col, per_channel);
+          auto row_sums = RowSums(a, row, deep);
+          // per channel sums are laid out by col8 blocks of row8 x C8NUM, as PackInputSum8x4Int8 writes them
+          int row8 = UP_ROUND(row, C8NUM);
+          std::vector<int32_t> input_sum(per_channel ? UP_ROUND(col, C8NUM) * row8 : row, 0);
+          std::vector<int32_t> a_sums(row, 0);
+          for (int r = 0; r < row; ++r) {
+            a_sums[r] = row_sums[r] * args.filter_zp[0];
+            if (!per_channel) {
+              input_sum[r] = a_sums[r];
+              continue;
+            }
+            for (int c = 0; c < col; ++c) {
+              input_sum[(c / C8NUM) * row8 * C8NUM + r * C8NUM + c % C8NUM] = row_sums[r] * args.filter_zp[c];
+            }
+          }
+          // the reference takes per channel sums as row sums times filter_zp, as MatmulInt8Opt does
+          auto expect = RefMatmulInt8(a, b, row, col, deep, per_channel ? row_sums : a_sums, args, per_channel,
+                                      act.mini, act.maxi);
+          auto a_pack = PackBlocks(a, row, deep, C8NUM, C4NUM);
+          auto b_pack = PackBlocks(b, col, deep, C8NUM, C4NUM);
+          std::vector<int8_t> dst(row * col, 0);
+          MatMulInt8_8x8_rAvx(a_pack.data(), b_pack.data(), dst.data(), row, col, UP_ROUND(deep, C4NUM), col,
+                              input_sum.data(), args.bias.data(), args.left_shift.data(), args.right_shift.data(),
+                              args.multiplier.data(), args.out_zp, act.mini, act.maxi, per_channel);
+          ASSERT_EQ(dst, expect) << "row " << row << " col " << col << " deep " << deep << " mini " << act.mini;
+        }
+      }
+    }
+  }
+}
+
+void CheckConvDwInt8Post(bool per_channel) {
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int32_t> acc_dist(-200000, 200000);
+  for (int output_w : {1, 2, 3, 5}) {
+    for (int channel : {1, 7, 8, 9, 17}) {
+      for (const auto &act : kActRanges) {
+        auto args = RandomQuantArgs(&gen, channel, per_channel);
+        std::vector<int32_t> buffer(output_w * channel);
+        for (auto &value : buffer) {
+          value = acc_dist(gen);
+        }
+        std::vector<int8_t> expect(buffer.size());
+        for (size_t i = 0; i < buffer.size(); ++i) {
+          int c = static_cast<int>(i) % channel;
+          expect[i] = static_cast<int8_t>(Requantize(buffer[i], args, c, per_channel, act.mini, act.maxi));
+        }
+        std::vector<int8_t> dst(buffer.size(), 0);
+        ConvDwInt8Post(dst.data(), buffer.data(), output_w, channel, args.out_zp, args.multiplier.data(),
+                       args.left_shift.data(), args.right_shift.data(), act.mini, act.maxi, per_channel);
+        ASSERT_EQ(dst, expect) << "output_w " << output_w << " channel " << channel << " mini " << act.mini;
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST_F(TestMatmulInt8Avx, MatmulInt8OptAvx2PerTensor) { CheckMatmulInt8Opt(MatmulInt8OptAvx2, false); }
+
+TEST_F(TestMatmulInt8Avx, MatmulInt8OptAvx2PerChannel) { CheckMatmulInt8Opt(MatmulInt8OptAvx2, true); }
+
+#ifdef ENABLE_AVX512_VNNI_DISPATCH
+TEST_F(TestMatmulInt8Avx, MatmulInt8OptAvx512Vnni) {
+  if (!__builtin_cpu_supports("avx512vnni")) {
+    std::cout << "avx512vnni is not supported, skip the vnni kernel" << std::endl;
+    return;
+  }
+  CheckMatmulInt8Opt(MatmulInt8OptAvx512Vnni, false);
+  CheckMatmulInt8Opt(MatmulInt8OptAvx512Vnni, true);
+}
+#endif
+
+// MatmulInt8Opt dispatches to one of the kernels above
+TEST_F(TestMatmulInt8Avx, MatmulInt8Opt) {
+  CheckMatmulInt8Opt(MatmulInt8Opt, false);
+  CheckMatmulInt8Opt(MatmulInt8Opt, true);
+}
+
+TEST_F(TestMatmulInt8Avx, MatMulInt8_8x8_rAvxPerTensor) { CheckMatMulInt8_8x8_r(false); }
+
+TEST_F(TestMatmulInt8Avx, MatMulInt8_8x8_rAvxPerChannel) { CheckMatMulInt8_8x8_r(true); }
+
+TEST_F(TestMatmulInt8Avx, ConvDwInt8Row) {
+  std::mt19937 gen(4);
+  std::uniform_int_distribution<int> weight_dist(-300, 300);
+  std::uniform_int_distribution<int32_t> acc_dist(-10000, 10000);
+  for (int num_pixels : {1, 3, 5}) {
+    for (int channel : {1, 7, 8, 9, 16, 17, 31}) {
+      // a strided window reads every other pixel of the input row
+      for (int input_step : {channel, 2 * channel}) {
+        int8_t input_zp = static_cast<int8_t>(weight_dist(gen) % 20);
+        auto input = RandomInt8(&gen, num_pixels, input_step);
+        std::vector<int16_t> weight(channel);
+        for (auto &value : weight) {
+          value = static_cast<int16_t>(weight_dist(gen));
+        }
+        std::vector<int32_t> output(num_pixels * channel);
+        for (auto &value : output) {
+          value = acc_dist(gen);
+        }
+        auto expect = output;
+        for (int i = 0; i < num_pixels; ++i) {
+          for (int c = 0; c < channel; ++c) {
+            expect[i * channel + c] += static_cast<int16_t>(input[i * input_step + c] - input_zp) * weight[c];
+          }
+        }
+        ConvDwInt8Row(output.data(), input.data(), weight.data(), num_pixels, channel, input_step, input_zp);
+        ASSERT_EQ(output, expect) << "num_pixels " << num_pixels << " channel " << channel;
+      }
+    }
+  }
+}
+
+TEST_F(TestMatmulInt8Avx, ConvDwInt8PostPerTensor) { CheckConvDwInt8Post(false); }
+
+TEST_F(TestMatmulInt8Avx, ConvDwInt8PostPerChannel) { CheckConvDwInt8Post(true); }
+}  // namespace mindspore
+#endif
@@ -0,0 +1,435 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "schema/inner/model_generated.h"
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/model.h"
+#include "src/huffman_decode.h"
+#include "src/lite_session.h"
+#include "src/tensor.h"
+#include "src/weight_decoder.h"
+
+namespace mindspore {
+class TestWeightDecoder : public mindspore::CommonTest {
+ public:
+  TestWeightDecoder() {}
+};
+
+namespace {
+constexpr int kBitsPerByte = 8;
+
+// the unpacker the weight decoder used before, every packed bit goes through a queue
+template <typename T1, typename T2>
+std::vector<T1> RefUnPack(const std::vector<T2> &packed_data, int origin_bit) {
+  std::vector<T1> result;
+  std::queue<bool> bits;
+  for (size_t i = 0; i < packed_data.size(); ++i) {
+    auto n = packed_data[i];
+    for (size_t j = 0; j < sizeof(T2) * kBitsPerByte; ++j) {
+      bits.push(n % 2);
+      n = n >> 1;
+    }
+    T2 uint_result = 0;
+    while (static_cast<int>(bits.size()) >= origin_bit) {
+      for (int k = 0; k < origin_bit; k++) {
+        uint_result = (static_cast<int>(bits.front()) << static_cast<unsigned int>(k)) + uint_result;
+        bits.pop();
+      }
+      result.push_back(static_cast<T1>(uint_result - static_cast<T2>(pow(2, origin_bit - 1))));
+      uint_result = 0;
+    }
+    if (i == packed_data.size() - 1 && !bits.empty()) {
+      for (size_t k = 0; !bits.empty(); ++k) {
+        uint_result = (static_cast<unsigned int>(bits.front()) << k) + uint_result;
+        bits.pop();
+      }
+      result.push_back(static_cast<T1>(uint_result - static_cast<T2>(pow(2, origin_bit - 1))));
+    }
+  }
+  return result;
+}
+
+// pack the values lsb first in words of T2 and pad the last word with zero bits, as the converter does
+template <typename T2>
+std::vector<T2> BitPack(const std::vector<int> &values, int origin_bit) {
+  std::vector<T2> packed_data;
+  uint64_t word = 0;
+  size_t word_bits = 0;
+  for (auto value : values) {
+    auto field = static_cast<uint64_t>(value + (1 << static_cast<unsigned int>(origin_bit - 1)));
+    for (int k = 0; k < origin_bit; ++k) {
+      word |= ((field >> static_cast<unsigned int>(k)) & 1) << word_bits;
+      if (++word_bits == sizeof(T2) * kBitsPerByte) {
+        packed_data.push_back(static_cast<T2>(word));
+        word = 0;
+        word_bits = 0;
+      }
+    }
+  }
+  if (word_bits > 0) {
+    packed_data.push_back(static_cast<T2>(word));
+  }
+  return packed_data;
+}
+
+std::vector<int> RandomValues(int origin_bit, size_t count, std::mt19937 *engine) {
+  std::uniform_int_distribution<int> dist(-(1 << static_cast<unsigned int>(origin_bit - 1)),
+                                          (1 << static_cast<unsigned int>(origin_bit - 1)) - 1);
+  std::vector<int> values(count);
+  for (auto &value : values) {
+    value = dist(*engine);
+  }
+  return values;
+}
+
+// a weight tensor of the values bit packed to origin_bit as the converter exports it
+std::unique_ptr<schema::TensorT> NewPackedTensor(int origin_bit, const std::vector<int> &values) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = lite::NodeType_ValueNode;
+  tensor->format = schema::Format_NHWC;
+  tensor->dims = {static_cast<int>(values.size())};
+  tensor->offset = -1;
+  auto quant_param = std::make_unique<schema::QuantParamT>();
+  quant_param->numBits = origin_bit;
+  quant_param->inited = true;
+  tensor->quantParams.emplace_back(std::move(quant_param));
+  if (origin_bit < kBitsPerByte) {
+    tensor->dataType = kNumberTypeInt8;
+    auto packed_data = BitPack<uint8_t>(values, origin_bit);
+    tensor->data.assign(packed_data.begin(), packed_data.end());
+  } else {
+    tensor->dataType = kNumberTypeInt16;
+    auto packed_data = BitPack<uint16_t>(values, origin_bit);
+    tensor->data.resize(packed_data.size() * sizeof(uint16_t));
+    memcpy(tensor->data.data(), packed_data.data(), tensor->data.size());
+  }
+  return tensor;
+}
+
+// the expected values of a packed tensor, as the unpacker of before decodes them
+std::vector<int> RefUnPackTensor(const schema::TensorT &tensor, int origin_bit) {
+  if (tensor.dataType == kNumberTypeInt8) {
+    auto unpacked = RefUnPack<int8_t, uint8_t>(tensor.data, origin_bit);
+    return std::vector<int>(unpacked.begin(), unpacked.end());
+  }
+  std::vector<uint16_t> packed_data(tensor.data.size() / sizeof(uint16_t));
+  memcpy(packed_data.data(), tensor.data.data(), packed_data.size() * sizeof(uint16_t));
+  auto unpacked = RefUnPack<int16_t, uint16_t>(packed_data, origin_bit);
+  return std::vector<int>(unpacked.begin(), unpacked.end());
+}
+
+std::vector<int> TensorValues(const lite::Tensor &tensor) {
+  std::vector<int> values(tensor.ElementsNum());
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = tensor.data_type() == kNumberTypeInt8 ? static_cast<const int8_t *>(tensor.data_c())[i]
+                                                      : static_cast<const int16_t *>(tensor.data_c())[i];
+  }
+  return values;
+}
+
+// the codes of a huffman tree built from the frequencies of the symbols, the pseudo eof symbol included
+std::map<int, std::string> HuffmanCodes(const std::map<int, size_t> &frequencies) {
+  struct Node {
+    size_t frequency;
+    std::vector<int> keys;
+  };
+  auto greater = [](const Node &lhs, const Node &rhs) { return lhs.frequency > rhs.frequency; };
+  std::priority_queue<Node, std::vector<Node>, decltype(greater)> nodes(greater);
+  for (const auto &iter : frequencies) {
+    nodes.push({iter.second, {iter.first}});
+  }
+  nodes.push({1, {lite::PSEUDO_EOF}});
+  std::map<int, std::string> codes;
+  while (nodes.size() > 1) {
+    auto left = nodes.top();
+    nodes.pop();
+    auto right = nodes.top();
+    nodes.pop();
+    for (auto key : left.keys) {
+      codes[key] = "0" + codes[key];
+    }
+    for (auto key : right.keys) {
+      codes[key] = "1" + codes[key];
+    }
+    left.keys.insert(left.keys.end(), right.keys.begin(), right.keys.end());
+    nodes.push({left.frequency + right.frequency, left.keys});
+  }
+  return codes;
+}
+
+// encode the data with the codes in the format of the converter: keys, codes and the code bits msb first
+std::string HuffmanEncode(const std::map<int, std::string> &codes, const std::vector<int8_t> &data) {
+  std::string keys_str;
+  std::string codes_str;
+  for (const auto &iter : codes) {
+    keys_str += std::to_string(iter.first) + " ";
+    codes_str += iter.second + " ";
+  }
+  std::string bits;
+  for (auto value : data) {
+    bits += codes.at(value);
+  }
+  bits += codes.at(lite::PSEUDO_EOF);
+  std::string encoded_str;
+  for (size_t i = 0; i < bits.length(); i += kBitsPerByte) {
+    unsigned char byte = 0;
+    for (size_t j = 0; j < kBitsPerByte && i + j < bits.length(); ++j) {
+      byte |= static_cast<unsigned char>((bits[i + j] == '1' ? 1 : 0) << (kBitsPerByte - 1 - j));
+    }
+    encoded_str += static_cast<char>(byte);
+  }
+  return keys_str + "#" + codes_str + "#" + encoded_str;
+}
+
+// the huffman decoder of before, which walks the code of every symbol bit by bit
+std::vector<int8_t> RefHuffmanDecode(const std::string &input_str) {
+  auto key_pos = input_str.find_first_of('#');
+  auto code_pos = input_str.find_first_of('#', key_pos + 1);
+  std::istringstream keys(input_str.substr(0, key_pos));
+  std::istringstream codes(input_str.substr(key_pos + 1, code_pos - key_pos - 1));
+  std::map<std::string, int> code_keys;
+  int key;
+  std::string code;
+  while (keys >> key && codes >> code) {
+    code_keys[code] = key;
+  }
+  std::vector<int8_t> decoded;
+  std::string cur_code;
+  for (size_t pos = code_pos + 1; pos < input_str.length(); ++pos) {
+    auto byte = static_cast<unsigned char>(input_str[pos]);
+    for (int i = kBitsPerByte - 1; i >= 0; --i) {
+      cur_code += ((byte >> static_cast<unsigned int>(i)) & 1) != 0 ? '1' : '0';
+      auto iter = code_keys.find(cur_code);
+      if (iter == code_keys.end()) {
+        continue;
+      }
+      if (iter->second == lite::PSEUDO_EOF) {
+        return decoded;
+      }
+      decoded.push_back(static_cast<int8_t>(iter->second));
+      cur_code.clear();
+    }
+  }
+  return decoded;
+}
+
+// a huffman encoded weight tensor of the data
+std::unique_ptr<schema::TensorT> NewHuffmanTensor(const std::map<int, std::string> &codes,
+                                                  const std::vector<int8_t> &data) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = lite::NodeType_ValueNode;
+  tensor->format = schema::Format_NHWC;
+  tensor->dataType = kNumberTypeInt8;
+  tensor->dims = {static_cast<int>(data.size())};
+  tensor->offset = -1;
+  tensor->enableHuffmanCode = true;
+  auto encoded_str = HuffmanEncode(codes, data);
+  tensor->data.assign(encoded_str.begin(), encoded_str.end());
+  return tensor;
+}
+
+// unpack the tensor with the weight decoder through its flatbuffer, as a session does
+int UnPackTensor(const schema::TensorT &tensor_t, lite::Tensor *dst_tensor) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+  builder.Finish(schema::Tensor::Pack(builder, &tensor_t));
+  auto src_tensor = flatbuffers::GetRoot<schema::Tensor>(builder.GetBufferPointer());
+  return lite::WeightDecoder::UnPack(*src_tensor, dst_tensor);
+}
+
+// a session which exposes how it converts the tensors of a model
+class DecodeSession : public lite::LiteSession {
+ public:
+  using lite::LiteSession::ConvertTensors;
+  const std::vector<lite::Tensor *> &tensors() const { return tensors_; }
+};
+}  // namespace
+
+TEST_F(TestWeightDecoder, UnPackBitWidths) {
+  // 8 bits weights are stored unpacked, every other width up to 15 bits is packed
+  std::mt19937 engine(0);
+  for (int origin_bit = 1; origin_bit < 16; ++origin_bit) {
+    if (origin_bit == kBitsPerByte) {
+      continue;
+    }
+    // the counts leave from none to most bits of the last packed word as padding
+    for (size_t count : {1, 2, 3, 5, 7, 15, 16, 17, 63, 1001}) {
+      auto values = RandomValues(origin_bit, count, &engine);
+      auto tensor_t = NewPackedTensor(origin_bit, values);
+      auto ref_values = RefUnPackTensor(*tensor_t, origin_bit);
+      ASSERT_GE(ref_values.size(), count);
+      ref_values.resize(count);
+      ASSERT_EQ(ref_values, values);
+
+      lite::Tensor dst_tensor(TypeId(tensor_t->dataType), {static_cast<int>(count)}, mindspore::NHWC,
+                              lite::Tensor::Category::CONST_TENSOR);
+      ASSERT_EQ(lite::RET_OK, UnPackTensor(*tensor_t, &dst_tensor));
+      ASSERT_EQ(TensorValues(dst_tensor), ref_values) << "bits: " << origin_bit << " count: " << count;
+    }
+  }
+}
+
+TEST_F(TestWeightDecoder, HuffmanDecode) {
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<int> dist(-128, 127);
+  std::vector<int8_t> data(4096);
+  std::map<int, size_t> frequencies;
+  for (auto &value : data) {
+    value = static_cast<int8_t>(dist(engine));
+    frequencies[value]++;
+  }
+  auto codes = HuffmanCodes(frequencies);
+  // the data lengths end the code bits at every position of the last byte
+  for (size_t count : {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 1023, 4096}) {
+    std::vector<int8_t> sub_data(data.begin(), data.begin() + count);
+    auto encoded_str = HuffmanEncode(codes, sub_data);
+    ASSERT_EQ(RefHuffmanDecode(encoded_str), sub_data);
+    std::vector<int8_t> decoded(count + 1, 0);
+    ASSERT_EQ(lite::RET_OK, lite::HuffmanDecode::DoHuffmanDecode(encoded_str, decoded.data(), count));
+    decoded.resize(count);
+    ASSERT_EQ(decoded, sub_data) << "count: " << count;
+  }
+}
+
+TEST_F(TestWeightDecoder, HuffmanDecodeLongCodes) {
+  // exponential frequencies give the rare symbols codes much longer than one lookup of the decode table
+  std::map<int, size_t> frequencies;
+  std::vector<int8_t> data;
+  for (int key = 0; key < 20; ++key) {
+    size_t frequency = static_cast<size_t>(1) << static_cast<unsigned int>(20 - key);
+    frequencies[key - 10] = frequency;
+  }
+  auto codes = HuffmanCodes(frequencies);
+  size_t max_len = 0;
+  for (const auto &iter : codes) {
+    max_len = std::max(max_len, iter.second.length());
+  }
+  ASSERT_GT(max_len, static_cast<size_t>(lite::kHuffmanLutBits));
+
+  // every symbol, the rare ones at the start, the end and across byte boundaries
+  for (int round = 0; round < 3; ++round) {
+    for (int key = 19; key >= 0; --key) {
+      data.push_back(static_cast<int8_t>(key - 10));
+      data.insert(data.end(), round, static_cast<int8_t>(-10));
+    }
+  }
+  for (size_t count = 0; count <= data.size(); ++count) {
+    std::vector<int8_t> sub_data(data.begin(), data.begin() + count);
+    auto encoded_str = HuffmanEncode(codes, sub_data);
+    ASSERT_EQ(RefHuffmanDecode(encoded_str), sub_data);
+    std::vector<int8_t> decoded(count + 1, 0);
+    ASSERT_EQ(lite::RET_OK, lite::HuffmanDecode::DoHuffmanDecode(encoded_str, decoded.data(), count));
+    decoded.resize(count);
+    ASSERT_EQ(decoded, sub_data) << "count: " << count;
+  }
+
+  // the weight decoder decodes a huffman tensor through the same decoder
+  auto tensor_t = NewHuffmanTensor(codes, data);
+  lite::Tensor dst_tensor(kNumberTypeInt8, {static_cast<int>(data.size())}, mindspore::NHWC,
+                          lite::Tensor::Category::CONST_TENSOR);
+  ASSERT_EQ(lite::RET_OK, UnPackTensor(*tensor_t, &dst_tensor));
+  auto values = TensorValues(dst_tensor);
+  ASSERT_EQ(values, std::vector<int>(data.begin(), data.end()));
+}
+
+#ifdef ENABLE_WEIGHT_DECODE
+TEST_F(TestWeightDecoder, DecompressTensorsParallel) {
+  // packed and huffman weights of a model, decoded across the thread pool of the session
+  std::mt19937 engine(0);
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = lite::NodeType_ValueNode;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {1, 4};
+  input->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  std::vector<std::vector<int>> expected_values;
+  std::map<int, size_t> frequencies;
+  for (int key = -128; key < 128; ++key) {
+    frequencies[key] = static_cast<size_t>(key + 129);
+  }
+  auto codes = HuffmanCodes(frequencies);
+  std::vector<int> origin_bits = {1, 3, 0, 5, 7, 0, 9, 11, 0, 13, 15, 0};
+  for (size_t i = 0; i < origin_bits.size(); ++i) {
+    auto count = 100 + 37 * i;
+    // a huffman weight in place of a bit width
+    if (origin_bits[i] == 0) {
+      std::vector<int8_t> data(count);
+      for (auto &value : data) {
+        value = static_cast<int8_t>(RandomValues(kBitsPerByte, 1, &engine)[0]);
+      }
+      expected_values.emplace_back(data.begin(), data.end());
+      meta_graph->allTensors.emplace_back(NewHuffmanTensor(codes, data));
+    } else {
+      auto values = RandomValues(origin_bits[i], count, &engine);
+      expected_values.push_back(values);
+      meta_graph->allTensors.emplace_back(NewPackedTensor(origin_bits[i], values));
+    }
+  }
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->dims = {1, 4};
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+  int output_index = static_cast<int>(meta_graph->allTensors.size()) - 1;
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0};
+  node->outputIndex = {static_cast<uint32_t>(output_index)};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Abs;
+  node->primitive->value.value = new schema::AbsT;
+  node->name = "Abs";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {static_cast<uint32_t>(output_index)};
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  auto model = lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  ASSERT_NE(nullptr, model);
+
+  lite::Context context;
+  context.thread_num_ = 4;
+  DecodeSession session;
+  ASSERT_EQ(lite::RET_OK, session.Init(&context));
+  ASSERT_EQ(lite::RET_OK, session.ConvertTensors(model));
+  ASSERT_EQ(session.tensors().size(), meta_graph->allTensors.size());
+  for (size_t i = 0; i < expected_values.size(); ++i) {
+    auto tensor = session.tensors().at(i + 1);
+    ASSERT_TRUE(tensor->own_data());
+    ASSERT_EQ(TensorValues(*tensor), expected_values[i]) << "tensor: " << i + 1;
+  }
+  delete model;
+}
+#endif
+}  // namespace mindspore
@@ -0,0 +1,275 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "schema/inner/model_generated.h"
+#include "include/context.h"
+#include "include/lite_session.h"
+#include "include/model.h"
+#include "ir/func_graph.h"
+#include "ops/concat.h"
+#include "ops/fusion/conv2d_fusion.h"
+#include "tools/converter/quantizer/post_training_quantizer.h"
+
+namespace mindspore::lite::quant {
+class PostTrainingQuantizerTest : public mindspore::CommonTest {
+ public:
+  PostTrainingQuantizerTest() = default;
+};
+
+namespace {
+constexpr size_t kBatchNum = 7;
+constexpr size_t kSessionNum = 3;
+constexpr int kInputHeight = 10;
+constexpr int kInputWidth = 10;
+constexpr int kChannel = 2;
+constexpr size_t kDataSize = kInputHeight * kInputWidth * kChannel;
+const char kConvName[] = "conv";
+const char kConcatName[] = "concat";
+const std::vector<std::string> kInputDirs = {"./ptq_calib_input_0", "./ptq_calib_input_1"};
+
+// conv reads the first input, concat joins the output of conv and the second input
+std::vector<char> MakeModel() {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto conv = std::make_unique<schema::CNodeT>();
+  conv->inputIndex = {0, 2, 3};
+  conv->outputIndex = {4};
+  conv->primitive = std::make_unique<schema::PrimitiveT>();
+  conv->primitive->value.type = schema::PrimitiveType_Conv2DFusion;
+  auto conv_primitive = new schema::Conv2DFusionT;
+  conv_primitive->pad_mode = schema::PadMode_SAME;
+  conv_primitive->in_channel = kChannel;
+  conv_primitive->out_channel = kChannel;
+  conv_primitive->format = schema::Format_NHWC;
+  conv_primitive->stride = std::vector<int64_t>{1, 1};
+  conv_primitive->kernel_size = std::vector<int64_t>{3, 3};
+  conv_primitive->dilation = std::vector<int64_t>{1, 1};
+  conv->primitive->value.value = conv_primitive;
+  conv->name = kConvName;
+  meta_graph->nodes.emplace_back(std::move(conv));
+
+  auto concat = std::make_unique<schema::CNodeT>();
+  concat->inputIndex = {4, 1};
+  concat->outputIndex = {5};
+  concat->primitive = std::make_unique<schema::PrimitiveT>();
+  concat->primitive->value.type = schema::PrimitiveType_Concat;
+  auto concat_primitive = new schema::ConcatT;
+  concat_primitive->axis = 3;
+  concat->primitive->value.value = concat_primitive;
+  concat->name = kConcatName;
+  meta_graph->nodes.emplace_back(std::move(concat));
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {5};
+
+  auto new_tensor = [&meta_graph](const std::vector<int32_t> &dims, const std::vector<float> &data, int node_type) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = node_type;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    tensor->dims = dims;
+    tensor->data.resize(data.size() * sizeof(float));
+    if (!data.empty()) {
+      memcpy(tensor->data.data(), data.data(), tensor->data.size());
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  };
+  std::vector<float> weight(kChannel * 3 * 3 * kChannel);
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  }
+  new_tensor({1, kInputHeight, kInputWidth, kChannel}, {}, NodeType_ValueNode);
+  new_tensor({1, kInputHeight, kInputWidth, kChannel}, {}, NodeType_ValueNode);
+  new_tensor({kChannel, 3, 3, kChannel}, weight, NodeType_ValueNode);
+  new_tensor({kChannel}, {0.5f, -1.0f}, NodeType_ValueNode);
+  new_tensor({}, {}, NodeType_Parameter);
+  new_tensor({}, {}, NodeType_Parameter);
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  auto content = reinterpret_cast<const char *>(builder.GetBufferPointer());
+  return std::vector<char>(content, content + builder.GetSize());
+}
+
+// a fixed calibration set, one file per batch and input, the range differs between the batches
+bool WriteCalibrationSet() {
+  uint32_t seed = 1;
+  for (size_t input = 0; input < kInputDirs.size(); input++) {
+    if (mkdir(kInputDirs[input].c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+      return false;
+    }
+    for (size_t i = 0; i < kBatchNum; i++) {
+      std::vector<float> data(kDataSize);
+      float range = 1.0f + static_cast<float>(i * 3 + input);
+      for (auto &value : data) {
+        seed = seed * 1103515245 + 12345;
+        value = (static_cast<float>((seed >> 8) % 20001) / 10000.0f - 1.0f) * range;
+        value = value * value * value / (range * range);
+      }
+      std::ofstream ofs(kInputDirs[input] + "/batch_" + std::to_string(i) + ".bin", std::ios::binary);
+      ofs.write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(float));
+      if (!ofs.good()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void RemoveCalibrationSet() {
+  for (const auto &dir : kInputDirs) {
+    for (size_t i = 0; i < kBatchNum; i++) {
+      std::remove((dir + "/batch_" + std::to_string(i) + ".bin").c_str());
+    }
+    rmdir(dir.c_str());
+  }
+}
+
+SessionModel CreateSession(const std::vector<char> &model_buf) {
+  SessionModel sm;
+  sm.model = Model::Import(model_buf.data(), model_buf.size());
+  Context context;
+  context.thread_num_ = 1;
+  sm.session = session::LiteSession::CreateSession(&context);
+  if (sm.model == nullptr || sm.session == nullptr || sm.session->CompileGraph(sm.model) != RET_OK) {
+    delete sm.session;
+    delete sm.model;
+    return {};
+  }
+  return sm;
+}
+
+// runs the calibration steps of DoQuantize on the model with a number of fp32 sessions
+class CalibrationQuantizer : public PostTrainingQuantizer {
+ public:
+  explicit CalibrationQuantizer(const FuncGraphPtr &func_graph) : PostTrainingQuantizer(func_graph, "", 8) {}
+
+  STATUS Calibrate(const std::vector<char> &model_buf, const std::vector<CNodePtr> &cnodes,
+                   const std::string &method_x, size_t session_num) {
+    auto &config = calibrator_->config_param_;
+    config.image_paths = kInputDirs;
+    config.batch_count = kBatchNum;
+    config.method_x = method_x;
+    config.calib_session_num = session_num;
+    if (calibrator_->CollectImages() != RET_OK) {
+      return RET_ERROR;
+    }
+    for (const auto &cnode : cnodes) {
+      if (calibrator_->AddQuantizedOp(cnode) != RET_OK) {
+        return RET_ERROR;
+      }
+    }
+    for (size_t i = 0; i < session_num; i++) {
+      auto sm = CreateSession(model_buf);
+      if (sm.session == nullptr) {
+        return RET_ERROR;
+      }
+      if (i == 0) {
+        fp32_session_ = sm.session;
+        fp32_model_ = sm.model;
+      } else {
+        calib_sessions_.push_back(sm);
+      }
+    }
+    if (DoInference() != RET_OK || UpdateDivergInverval() != RET_OK || CollectDataFrequency() != RET_OK) {
+      return RET_ERROR;
+    }
+    return ComputeThreshold();
+  }
+
+  std::vector<DivergInfo *> GetInfos() {
+    std::vector<DivergInfo *> infos;
+    for (auto diverg_info : {calibrator_->GetInputDivergInfo(), calibrator_->GetOutputDivergInfo()}) {
+      for (auto name : {kConvName, kConcatName}) {
+        for (auto &info : diverg_info->at(name)) {
+          infos.push_back(info.get());
+        }
+      }
+    }
+    return infos;
+  }
+};
+
+void CheckNear(float actual, float expect) {
+  ASSERT_NEAR(actual, expect, 1e-5 * std::max(1.0f, std::fabs(expect)));
+}
+}  // namespace
+
+TEST_F(PostTrainingQuantizerTest, ParallelCalibrateSameAsSerial) {
+  ASSERT_TRUE(WriteCalibrationSet());
+  auto model_buf = MakeModel();
+  // the calibrated nodes of the func graph the model is exported from, named as the nodes of the model
+  auto func_graph = std::make_shared<FuncGraph>();
+  auto conv = func_graph->NewCNode({NewValueNode(std::make_shared<ops::Conv2DFusion>()), func_graph->add_parameter()});
+  conv->set_fullname_with_scope(kConvName);
+  auto concat =
+    func_graph->NewCNode({NewValueNode(std::make_shared<ops::Concat>()), conv, func_graph->add_parameter()});
+  concat->set_fullname_with_scope(kConcatName);
+
+  for (auto method_x : {kMethodKL, kMethodMaxMin}) {
+    CalibrationQuantizer serial(func_graph);
+    ASSERT_EQ(serial.Calibrate(model_buf, {conv, concat}, method_x, 1), RET_OK);
+    CalibrationQuantizer parallel(func_graph);
+    ASSERT_EQ(parallel.Calibrate(model_buf, {conv, concat}, method_x, kSessionNum), RET_OK);
+
+    auto serial_infos = serial.GetInfos();
+    auto parallel_infos = parallel.GetInfos();
+    // the inputs and outputs of conv and concat, the concat records each of its two inputs
+    ASSERT_EQ(serial_infos.size(), 5);
+    ASSERT_EQ(parallel_infos.size(), serial_infos.size());
+    for (size_t i = 0; i < serial_infos.size(); i++) {
+      auto serial_info = serial_infos[i];
+      auto parallel_info = parallel_infos[i];
+      ASSERT_EQ(parallel_info->max, serial_info->max);
+      ASSERT_EQ(parallel_info->min, serial_info->min);
+      ASSERT_EQ(parallel_info->interval, serial_info->interval);
+      // the per batch max and min values feed RemovalOutlier, which sorts them, so only their order may differ
+      auto serial_max_datas = serial_info->max_datas;
+      auto parallel_max_datas = parallel_info->max_datas;
+      std::sort(serial_max_datas.begin(), serial_max_datas.end());
+      std::sort(parallel_max_datas.begin(), parallel_max_datas.end());
+      ASSERT_EQ(parallel_max_datas.size(), kBatchNum);
+      ASSERT_EQ(parallel_max_datas, serial_max_datas);
+      auto serial_min_datas = serial_info->min_datas;
+      auto parallel_min_datas = parallel_info->min_datas;
+      std::sort(serial_min_datas.begin(), serial_min_datas.end());
+      std::sort(parallel_min_datas.begin(), parallel_min_datas.end());
+      ASSERT_EQ(parallel_min_datas, serial_min_datas);
+      // the histograms of the sessions are summed in another order than the serial one adds up its batches
+      ASSERT_EQ(parallel_info->histogram.size(), serial_info->histogram.size());
+      for (size_t bin = 0; bin < serial_info->histogram.size(); bin++) {
+        CheckNear(parallel_info->histogram[bin], serial_info->histogram[bin]);
+      }
+      CheckNear(parallel_info->best_T, serial_info->best_T);
+      CheckNear(parallel_info->GetScale().second, serial_info->GetScale().second);
+      ASSERT_LE(std::abs(parallel_info->GetZeropoint().second - serial_info->GetZeropoint().second), 1);
+    }
+  }
+  RemoveCalibrationSet();
+}
+}  // namespace mindspore::lite::quant
@@ -79,6 +79,8 @@ class MS_API Benchmark : public BenchmarkBase {
 
   int MarkPerformance();
 
+  int MarkLoadPerformance();
+
   int MarkAccuracy();
 
  private:
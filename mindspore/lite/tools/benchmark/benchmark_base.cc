@@ -329,6 +329,7 @@ int BenchmarkBase::Init() {
   MS_LOG(INFO) << "DeviceType = " << this->flags_->device_;
   MS_LOG(INFO) << "AccuracyThreshold = " << this->flags_->accuracy_threshold_;
   MS_LOG(INFO) << "WarmUpLoopCount = " << this->flags_->warm_up_loop_count_;
+  MS_LOG(INFO) << "LoadLoopCount = " << this->flags_->load_loop_count_;
   MS_LOG(INFO) << "NumThreads = " << this->flags_->num_threads_;
   MS_LOG(INFO) << "Fp16Priority = " << this->flags_->enable_fp16_;
   MS_LOG(INFO) << "EnableParallel = " << this->flags_->enable_parallel_;
@@ -340,10 +341,16 @@ int BenchmarkBase::Init() {
   std::cout << "DeviceType = " << this->flags_->device_ << std::endl;
   std::cout << "AccuracyThreshold = " << this->flags_->accuracy_threshold_ << std::endl;
   std::cout << "WarmUpLoopCount = " << this->flags_->warm_up_loop_count_ << std::endl;
+  std::cout << "LoadLoopCount = " << this->flags_->load_loop_count_ << std::endl;
   std::cout << "NumThreads = " << this->flags_->num_threads_ << std::endl;
   std::cout << "Fp16Priority = " << this->flags_->enable_fp16_ << std::endl;
   std::cout << "EnableParallel = " << this->flags_->enable_parallel_ << std::endl;
   std::cout << "calibDataPath = " << this->flags_->benchmark_data_file_ << std::endl;
+  if (this->flags_->load_loop_count_ < 0) {
+    MS_LOG(ERROR) << "LoadLoopCount:" << this->flags_->load_loop_count_ << " must not be less than 0";
+    std::cerr << "LoadLoopCount:" << this->flags_->load_loop_count_ << " must not be less than 0" << std::endl;
+    return RET_ERROR;
+  }
   if (this->flags_->loop_count_ < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0";
     std::cerr << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0" << std::endl;
@@ -117,6 +117,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::perf_profiling_, "perfProfiling",
             "Perf event profiling(only instructions statics enabled currently)", false);
     AddFlag(&BenchmarkFlags::perf_event_, "perfEvent", "CYCLE|CACHE|STALL", "CYCLE");
+    AddFlag(&BenchmarkFlags::load_loop_count_, "loadLoopCount",
+            "Run model loading (map the model file, import and compile graph) loop count, 0 means skip", 0);
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::benchmark_data_file_, "benchmarkDataFile", "Benchmark data file path", "");
     AddFlag(&BenchmarkFlags::benchmark_data_type_, "benchmarkDataType",
@@ -146,6 +148,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   bool enable_fp16_ = false;
   bool enable_parallel_ = false;
   int warm_up_loop_count_ = 3;
+  int load_loop_count_ = 0;
   // MarkAccuracy
   std::string benchmark_data_file_;
   std::string benchmark_data_type_ = "FLOAT";
@@ -16,6 +16,7 @@
 
 #include "tools/converter/quantizer/post_training_quantizer.h"
 #include <dirent.h>
+#include <atomic>
 #include <future>
 #include <map>
 #include <memory>
@@ -295,6 +296,20 @@ STATUS DivergInfo::ComputeThreshold() {
   return RET_OK;
 }
 
+void DivergInfo::Merge(const DivergInfo &other) {
+  this->max = std::max(this->max, other.max);
+  this->min = std::min(this->min, other.min);
+  this->max_datas.insert(this->max_datas.end(), other.max_datas.begin(), other.max_datas.end());
+  this->min_datas.insert(this->min_datas.end(), other.min_datas.begin(), other.min_datas.end());
+  if (this->histogram.size() != other.histogram.size()) {
+    MS_LOG(WARNING) << cnode->fullname_with_scope() << " histogram size mismatch, skip merging histogram.";
+    return;
+  }
+  for (size_t i = 0; i < this->histogram.size(); i++) {
+    this->histogram[i] += other.histogram[i];
+  }
+}
+
 std::pair<CNodePtr, float> DivergInfo::GetScale() {
   float max_value = this->best_T;
   float min_value = -max_value;
@@ -388,13 +403,47 @@ STATUS Calibrator::RecordMaxValue(const vector<float> &data, const std::unique_p
   return RET_OK;
 }
 
+STATUS Calibrator::ParallelComputeThreshold(const std::vector<DivergInfo *> &diverg_infos) {
+  if (diverg_infos.empty()) {
+    return RET_OK;
+  }
+  // the KL search of one tensor does not depend on any other, so tensors are spread over all cores
+  size_t thread_num = std::min(static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)),
+                               diverg_infos.size());
+  std::atomic<size_t> next_index(0);
+  std::atomic<STATUS> ret(RET_OK);
+  auto compute_func = [&diverg_infos, &next_index, &ret]() {
+    for (size_t i = next_index++; i < diverg_infos.size(); i = next_index++) {
+      if (diverg_infos[i]->ComputeThreshold() != RET_OK) {
+        ret = RET_ERROR;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; i++) {
+    threads.emplace_back(compute_func);
+  }
+  compute_func();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return ret;
+}
+
 STATUS Calibrator::ComputeThreshold() {
+  std::vector<DivergInfo *> to_compute;
   for (auto &kv : this->outputs_diverg_info_) {
     auto &outputs_diverg_info = kv.second;
     for (auto &diverg_info : outputs_diverg_info) {
-      diverg_info->ComputeThreshold();
+      to_compute.push_back(diverg_info.get());
     }
   }
+  auto status = ParallelComputeThreshold(to_compute);
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "compute output threshold failed.";
+    return status;
+  }
+  to_compute.clear();
   // node A's input may be node B's output, no need to re-compute the node A's input quant param which is the same as
   for (auto &kv : this->inputs_diverg_info_) {
     auto &input_infos = kv.second;
@@ -422,10 +471,15 @@ STATUS Calibrator::ComputeThreshold() {
         }
       }
       if (!already_computed) {
-        input_infos[i]->ComputeThreshold();
+        to_compute.push_back(input_infos[i].get());
       }
     }
   }
+  status = ParallelComputeThreshold(to_compute);
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "compute input threshold failed.";
+    return status;
+  }
   return RET_OK;
 }
 
@@ -446,6 +500,41 @@ STATUS Calibrator::UpdateDataFrequency(const vector<float> &data, const std::uni
   return RET_OK;
 }
 
+void Calibrator::CloneDivergInfo(const DivergInfoMap &src, DivergInfoMap *dst) {
+  MS_ASSERT(dst != nullptr);
+  dst->clear();
+  for (const auto &kv : src) {
+    auto &dst_infos = (*dst)[kv.first];
+    for (const auto &info : kv.second) {
+      auto clone = std::make_unique<DivergInfo>(*info);
+      clone->max = -FLT_MAX;
+      clone->min = FLT_MAX;
+      clone->max_datas.clear();
+      clone->min_datas.clear();
+      std::fill(clone->histogram.begin(), clone->histogram.end(), 0.0f);
+      dst_infos.push_back(std::move(clone));
+    }
+  }
+}
+
+void Calibrator::MergeDivergInfo(const DivergInfoMap &src, DivergInfoMap *dst) {
+  MS_ASSERT(dst != nullptr);
+  for (const auto &kv : src) {
+    auto iter = dst->find(kv.first);
+    if (iter == dst->end() || iter->second.empty()) {
+      continue;
+    }
+    auto &dst_infos = iter->second;
+    // concat, add and multi-output nodes grow their info list on the first batch, from a still empty first info
+    while (dst_infos.size() < kv.second.size()) {
+      dst_infos.push_back(std::make_unique<DivergInfo>(*dst_infos.front()));
+    }
+    for (size_t i = 0; i < kv.second.size(); i++) {
+      dst_infos[i]->Merge(*kv.second[i]);
+    }
+  }
+}
+
 STATUS Calibrator::AddQuantizedOp(const CNodePtr &node) {
   if (node == nullptr) {
     MS_LOG(ERROR) << "To be quantized node is null";
@@ -500,6 +589,7 @@ PostTrainingQuantizer::PostTrainingQuantizer(FuncGraphPtr graph, string path, in
 }
 
 PostTrainingQuantizer::~PostTrainingQuantizer() {
+  FreeCalibSessions();
   delete fp32_session_;
   delete fp32_model_;
   delete int8_session_;
@@ -937,20 +1027,87 @@ STATUS PostTrainingQuantizer::CheckFp32TensorVec(const std::string &node_name,
   return RET_OK;
 }
 
+STATUS PostTrainingQuantizer::CreateCalibSessions(const FuncGraphPtr &func_graph) {
+  // every session holds a full copy of the model, so never create more than there are batches to share
+  size_t session_num = std::min(static_cast<size_t>(calibrator_->GetCalibSessionNum()), calibrator_->GetBatchNum());
+  for (size_t i = 1; i < session_num; i++) {
+    auto sm = CreateSessionByFuncGraph(func_graph, flags, calibrator_->GetThreadNum());
+    if (sm.session == nullptr || sm.model == nullptr) {
+      MS_LOG(ERROR) << "create calibration session failed!";
+      delete sm.session;
+      delete sm.model;
+      return RET_ERROR;
+    }
+    calib_sessions_.push_back(sm);
+  }
+  MS_LOG(INFO) << "calibrate with " << calib_sessions_.size() + 1 << " sessions";
+  return RET_OK;
+}
+
+void PostTrainingQuantizer::FreeCalibSessions() {
+  for (auto &sm : calib_sessions_) {
+    delete sm.session;
+    delete sm.model;
+  }
+  calib_sessions_.clear();
+}
+
+/**
+ * Split the calibration batches over fp32_session_ and calib_sessions_. Each session records into its own
+ * copy of the diverg infos, which are merged into the calibrator in session order once all sessions are done.
+ **/
+STATUS PostTrainingQuantizer::ParallelCalibrate(CalibrateFunc calibrate_func) {
+  auto input_diverg_info = calibrator_->GetInputDivergInfo();
+  auto output_diverg_info = calibrator_->GetOutputDivergInfo();
+  size_t worker_num = calib_sessions_.size() + 1;
+  if (worker_num == 1) {
+    return (this->*calibrate_func)(fp32_session_, 0, 1, input_diverg_info, output_diverg_info);
+  }
+  std::vector<DivergInfoMap> worker_inputs(worker_num);
+  std::vector<DivergInfoMap> worker_outputs(worker_num);
+  std::vector<std::future<STATUS>> results;
+  for (size_t i = 0; i < worker_num; i++) {
+    Calibrator::CloneDivergInfo(*input_diverg_info, &worker_inputs[i]);
+    Calibrator::CloneDivergInfo(*output_diverg_info, &worker_outputs[i]);
+    auto session = i == 0 ? fp32_session_ : calib_sessions_[i - 1].session;
+    results.push_back(std::async(std::launch::async, calibrate_func, this, session, i, worker_num, &worker_inputs[i],
+                                 &worker_outputs[i]));
+  }
+  STATUS ret = RET_OK;
+  for (auto &result : results) {
+    if (result.get() != RET_OK) {
+      ret = RET_ERROR;
+    }
+  }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "calibrate failed!";
+    return ret;
+  }
+  for (size_t i = 0; i < worker_num; i++) {
+    Calibrator::MergeDivergInfo(worker_inputs[i], input_diverg_info);
+    Calibrator::MergeDivergInfo(worker_outputs[i], output_diverg_info);
+  }
+  return RET_OK;
+}
+
+STATUS PostTrainingQuantizer::DoInference() { return ParallelCalibrate(&PostTrainingQuantizer::DoInference); }
+
 /**
  * 1. create input tensor
  * 2. insert callback to session
  * 3. run session
  **/
-STATUS PostTrainingQuantizer::DoInference() {
+STATUS PostTrainingQuantizer::DoInference(session::LiteSession *session, size_t worker_id, size_t worker_num,
+                                          DivergInfoMap *input_diverg_info, DivergInfoMap *output_diverg_info) {
+  MS_ASSERT(session != nullptr && input_diverg_info != nullptr && output_diverg_info != nullptr);
   // get input tensor
-  vector<mindspore::tensor::MSTensor *> inputs = fp32_session_->GetInputs();
+  vector<mindspore::tensor::MSTensor *> inputs = session->GetInputs();
   if (inputs.size() != calibrator_->GetInputNum()) {
     MS_LOG(ERROR) << "model's input tensor cnt: " << inputs.size() << " != " << calibrator_->GetInputNum();
     return RET_ERROR;
   }
 
-  for (size_t i = 0; i < calibrator_->GetBatchNum(); i++) {
+  for (size_t i = worker_id; i < calibrator_->GetBatchNum(); i += worker_num) {
     // set multi-input data
     for (size_t input_index = 0; input_index < inputs.size(); input_index++) {
       STATUS status = calibrator_->GenerateInputData(input_index, i, inputs[input_index]);
@@ -963,7 +1120,7 @@ STATUS PostTrainingQuantizer::DoInference() {
     KernelCallBack beforeCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &beforeInputs,
                                         const std::vector<mindspore::tensor::MSTensor *> &beforeOutputs,
                                         const CallBackParam &callParam) -> bool {
-      auto diverg_info_map = calibrator_->GetInputDivergInfo();
+      auto diverg_info_map = input_diverg_info;
       if (diverg_info_map->find(callParam.node_name) == diverg_info_map->end()) {
         return true;
       }
@@ -993,7 +1150,7 @@ STATUS PostTrainingQuantizer::DoInference() {
     KernelCallBack afterCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &afterInputs,
                                        const std::vector<mindspore::tensor::MSTensor *> &afterOutputs,
                                        const CallBackParam &callParam) -> bool {
-      auto diverg_info_map = calibrator_->GetOutputDivergInfo();
+      auto diverg_info_map = output_diverg_info;
       if (diverg_info_map->find(callParam.node_name) == diverg_info_map->end()) {
         return true;
       }
@@ -1017,7 +1174,7 @@ STATUS PostTrainingQuantizer::DoInference() {
       }
       return true;
     };
-    auto status = fp32_session_->RunGraph(beforeCallBack, afterCallBack);
+    auto status = session->RunGraph(beforeCallBack, afterCallBack);
     if (status != RET_OK) {
       MS_LOG(ERROR) << "run model failed!";
       return RET_ERROR;
@@ -1194,14 +1351,21 @@ STATUS PostTrainingQuantizer::BiasCorrection(const FuncGraphPtr &func_graph, con
 }
 
 STATUS PostTrainingQuantizer::CollectDataFrequency() {
+  return ParallelCalibrate(&PostTrainingQuantizer::CollectDataFrequency);
+}
+
+STATUS PostTrainingQuantizer::CollectDataFrequency(session::LiteSession *session, size_t worker_id,
+                                                   size_t worker_num, DivergInfoMap *input_diverg_info,
+                                                   DivergInfoMap *output_diverg_info) {
+  MS_ASSERT(session != nullptr && input_diverg_info != nullptr && output_diverg_info != nullptr);
   // get input tensor
-  vector<mindspore::tensor::MSTensor *> inputs = fp32_session_->GetInputs();
+  vector<mindspore::tensor::MSTensor *> inputs = session->GetInputs();
   if (inputs.size() != calibrator_->GetInputNum()) {
     MS_LOG(ERROR) << "model's input tensor cnt: " << inputs.size() << " != " << calibrator_->GetInputNum();
     return RET_ERROR;
   }
 
-  for (size_t i = 0; i < calibrator_->GetBatchNum(); i++) {
+  for (size_t i = worker_id; i < calibrator_->GetBatchNum(); i += worker_num) {
     // set multi-input data
     for (size_t input_index = 0; input_index < inputs.size(); input_index++) {
       STATUS status = calibrator_->GenerateInputData(input_index, i, inputs[input_index]);
@@ -1214,7 +1378,7 @@ STATUS PostTrainingQuantizer::CollectDataFrequency() {
     KernelCallBack beforeCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &beforeInputs,
                                         const std::vector<mindspore::tensor::MSTensor *> &beforeOutputs,
                                         const CallBackParam &callParam) {
-      auto diverg_info_map = calibrator_->GetInputDivergInfo();
+      auto diverg_info_map = input_diverg_info;
       if (diverg_info_map->find(callParam.node_name) == diverg_info_map->end()) {
         return true;
       }
@@ -1236,7 +1400,7 @@ STATUS PostTrainingQuantizer::CollectDataFrequency() {
     KernelCallBack afterCallBack = [&](const std::vector<mindspore::tensor::MSTensor *> &after_inputs,
                                        const std::vector<mindspore::tensor::MSTensor *> &after_outputs,
                                        const CallBackParam &call_param) {
-      auto diverg_info_map = calibrator_->GetOutputDivergInfo();
+      auto diverg_info_map = output_diverg_info;
       if (diverg_info_map->find(call_param.node_name) == diverg_info_map->end()) {
         return true;
       }
@@ -1254,7 +1418,7 @@ STATUS PostTrainingQuantizer::CollectDataFrequency() {
       }
       return true;
     };
-    auto status = fp32_session_->RunGraph(beforeCallBack, afterCallBack);
+    auto status = session->RunGraph(beforeCallBack, afterCallBack);
     if (status != RET_OK) {
       MS_LOG(ERROR) << "run model failed!";
       return RET_ERROR;
@@ -1311,6 +1475,10 @@ STATUS PostTrainingQuantizer::DoQuantize(FuncGraphPtr func_graph) {
     MS_LOG(ERROR) << "create session failed!";
     return RET_ERROR;
   }
+  status = CreateCalibSessions(func_graph);
+  if (status != RET_OK) {
+    return status;
+  }
   MS_LOG(INFO) << "start to update divergence's max value";
   status = DoInference();
   if (status != RET_OK) {
@@ -1323,6 +1491,7 @@ STATUS PostTrainingQuantizer::DoQuantize(FuncGraphPtr func_graph) {
   }
   MS_LOG(INFO) << "start to collect data's distribution";
   status = CollectDataFrequency();
+  FreeCalibSessions();
   if (status != RET_OK) {
     return status;
   }
@@ -35,6 +35,8 @@
 
 namespace mindspore::lite::quant {
 class Calibrator;
+struct DivergInfo;
+using DivergInfoMap = std::unordered_map<std::string, std::vector<std::unique_ptr<DivergInfo>>>;
 
 struct MaxMin {
  public:
@@ -56,17 +58,30 @@ class PostTrainingQuantizer : public Quantizer {
   int quant_max{INT8_MAX};
   int quant_min{INT8_MIN};
 
- private:
-  std::map<std::string, int> opname_bit_;
+ protected:
+  // the calibration steps of DoQuantize, run on fp32_session_ and calib_sessions_
+  STATUS DoInference();
 
-  bool per_channel_{true};
+  STATUS UpdateDivergInverval();
 
-  TypeId target_type_{kNumberTypeInt8};
+  STATUS CollectDataFrequency();
+
+  STATUS ComputeThreshold();
 
   std::unique_ptr<Calibrator> calibrator_;
 
   session::LiteSession *fp32_session_{nullptr};
   Model *fp32_model_{nullptr};
+  // extra fp32 sessions which run calibration batches concurrently with fp32_session_
+  std::vector<SessionModel> calib_sessions_;
+
+ private:
+  std::map<std::string, int> opname_bit_;
+
+  bool per_channel_{true};
+
+  TypeId target_type_{kNumberTypeInt8};
+
   session::LiteSession *int8_session_{nullptr};
   Model *int8_model_{nullptr};
 
@@ -95,13 +110,21 @@ class PostTrainingQuantizer : public Quantizer {
   static STATUS CheckFp32TensorVec(const std::string &node_name,
                                    const std::vector<mindspore::tensor::MSTensor *> &tensor_vec);
 
-  STATUS DoInference();
+  STATUS CreateCalibSessions(const FuncGraphPtr &func_graph);
 
-  STATUS UpdateDivergInverval();
+  void FreeCalibSessions();
 
-  STATUS CollectDataFrequency();
+  using CalibrateFunc = STATUS (PostTrainingQuantizer::*)(session::LiteSession *session, size_t worker_id,
+                                                          size_t worker_num, DivergInfoMap *input_diverg_info,
+                                                          DivergInfoMap *output_diverg_info);
 
-  STATUS ComputeThreshold();
+  STATUS ParallelCalibrate(CalibrateFunc calibrate_func);
+
+  STATUS DoInference(session::LiteSession *session, size_t worker_id, size_t worker_num,
+                     DivergInfoMap *input_diverg_info, DivergInfoMap *output_diverg_info);
+
+  STATUS CollectDataFrequency(session::LiteSession *session, size_t worker_id, size_t worker_num,
+                              DivergInfoMap *input_diverg_info, DivergInfoMap *output_diverg_info);
 
   STATUS QuantNodeSimpleOp(const CNodePtr &cnode);
 
@@ -169,6 +192,9 @@ struct DivergInfo {
 
   STATUS ComputeThreshold();
 
+  // merge the statistics another session collected for the same tensor
+  void Merge(const DivergInfo &other);
+
   std::pair<CNodePtr, float> GetScale();
 
   std::pair<CNodePtr, int32_t> GetZeropoint();
@@ -190,6 +216,8 @@ class Calibrator {
 
   uint32_t GetThreadNum() const { return config_param_.thread_num; }
 
+  uint32_t GetCalibSessionNum() const { return config_param_.calib_session_num; }
+
   std::string GetMethodX() const { return config_param_.method_x; }
 
   bool GetBiasCorrection() const { return config_param_.bias_correction; }
@@ -204,6 +232,13 @@ class Calibrator {
     std::unordered_map<std::string, std::vector<std::unique_ptr<DivergInfo>>> *diverg_info);
 
   static STATUS UpdateDataFrequency(const std::vector<float> &data, const std::unique_ptr<DivergInfo> &diverg_info);
+
+  // copy diverg infos for another calibration session, the histograms of the copies start empty
+  static void CloneDivergInfo(const DivergInfoMap &src, DivergInfoMap *dst);
+
+  static void MergeDivergInfo(const DivergInfoMap &src, DivergInfoMap *dst);
+
+  static STATUS ParallelComputeThreshold(const std::vector<DivergInfo *> &diverg_infos);
   void Dump();
 
   STATUS ComputeThreshold();
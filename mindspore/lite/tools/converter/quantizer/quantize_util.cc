@@ -595,6 +595,16 @@ void ParseThreadNum(PostQuantConfig *post_quant_config, const std::string &value
   post_quant_config->thread_num = std::stoul(value);
 }
 
+void ParseCalibSessionNum(PostQuantConfig *post_quant_config, const std::string &value) {
+  MS_ASSERT(post_quant_config != nullptr);
+  auto session_num = std::stoul(value);
+  if (session_num == 0) {
+    MS_LOG(WARNING) << "calib_session_num should be greater than 0. Use default value.";
+    return;
+  }
+  post_quant_config->calib_session_num = session_num;
+}
+
 void ParseMethodX(PostQuantConfig *post_quant_config, const std::string &value) {
   MS_ASSERT(post_quant_config != nullptr);
   if (value != kMethodKL && value != kMethodMaxMin && value != kMethodOutlier) {
@@ -657,6 +667,7 @@ STATUS ParseConfigFile(std::string config_file, PostQuantConfig *post_quant_conf
   std::string IMAGE_PATH = "image_path";
   std::string BATCH_COUNT = "batch_count";
   std::string THREAD_NUM = "thread_num";
+  std::string CALIB_SESSION_NUM = "calib_session_num";
   std::string METHOD_X = "method_x";
   std::string MIXED = "mixed";
   std::string MEAN_ERROR_THRESHOLD = "mean_error_threshold";
@@ -667,6 +678,7 @@ STATUS ParseConfigFile(std::string config_file, PostQuantConfig *post_quant_conf
   value_parser[IMAGE_PATH] = ParseImagePath;
   value_parser[BATCH_COUNT] = ParseBatchCount;
   value_parser[THREAD_NUM] = ParseThreadNum;
+  value_parser[CALIB_SESSION_NUM] = ParseCalibSessionNum;
   value_parser[METHOD_X] = ParseMethodX;
   value_parser[MIXED] = ParseMixed;
   value_parser[MEAN_ERROR_THRESHOLD] = ParseMeanErrorThreshold;
@@ -701,6 +713,7 @@ STATUS ParseConfigFile(std::string config_file, PostQuantConfig *post_quant_conf
   MS_LOG(DEBUG) << "batch_count: " << post_quant_config->batch_count << "\n"
                 << "method_x: " << post_quant_config->method_x << "\n"
                 << "thread_num: " << post_quant_config->thread_num << "\n"
+                << "calib_session_num: " << post_quant_config->calib_session_num << "\n"
                 << "bias_correction: " << post_quant_config->bias_correction << "\n"
                 << "mixed: " << post_quant_config->mixed << "\n"
                 << "mean_error_threshold: " << post_quant_config->mean_error_threshold;
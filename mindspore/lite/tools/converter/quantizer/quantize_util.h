@@ -63,6 +63,7 @@ struct PostQuantConfig {
   uint32_t batch_count{100};
   std::string method_x{kMethodKL};
   uint32_t thread_num{1};
+  uint32_t calib_session_num{1};
   bool bias_correction{false};
   bool mixed{false};
   float mean_error_threshold{0.04};
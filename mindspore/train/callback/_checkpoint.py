@@ -24,7 +24,7 @@ from mindspore import log as logger
 from mindspore import nn
 from mindspore._checkparam import Validator
 from mindspore.train._utils import _make_directory
-from mindspore.train.serialization import save_checkpoint, _save_graph
+from mindspore.train.serialization import save_checkpoint, _save_graph, _wait_indexed_checkpoint_saved
 from mindspore.parallel._ps_context import _is_role_pserver, _get_ps_mode_rank
 from mindspore.parallel._cell_wrapper import destroy_allgather_cell
 from ._callback import Callback, set_cur_net
@@ -89,6 +89,8 @@ class CheckpointConfig:
                                       is not required. Default: None.
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
+        ckpt_format (str): The format of the checkpoint files, currently supports 'PROTOBUF' and 'INDEXED'.
+            See `mindspore.save_checkpoint` for the details. Default: 'PROTOBUF'.
 
     Raises:
         ValueError: If input parameter is not the correct type.
@@ -139,7 +141,8 @@ class CheckpointConfig:
                  saved_network=None,
                  append_info=None,
                  enc_key=None,
-                 enc_mode='AES-GCM'):
+                 enc_mode='AES-GCM',
+                 ckpt_format='PROTOBUF'):
 
         if save_checkpoint_steps is not None:
             save_checkpoint_steps = Validator.check_non_negative_int(save_checkpoint_steps)
@@ -176,6 +179,10 @@ class CheckpointConfig:
         self._append_dict = self._handle_append_info(append_info)
         self._enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
         self._enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+        self._ckpt_format = Validator.check_string(ckpt_format, ['PROTOBUF', 'INDEXED'], 'ckpt_format',
+                                                   'CheckpointConfig')
+        if self._ckpt_format == 'INDEXED' and self._enc_key is not None:
+            raise ValueError("The 'INDEXED' checkpoint format does not support encryption, please use 'PROTOBUF'.")
 
     @property
     def save_checkpoint_steps(self):
@@ -222,6 +229,11 @@ class CheckpointConfig:
         """Get the value of _enc_mode"""
         return self._enc_mode
 
+    @property
+    def ckpt_format(self):
+        """Get the value of _ckpt_format"""
+        return self._ckpt_format
+
     @property
     def append_dict(self):
         """Get the value of append_dict."""
@@ -363,6 +375,9 @@ class ModelCheckpoint(Callback):
         for thread in thread_list:
             if thread.getName() == "asyn_save_ckpt":
                 thread.join()
+        # an indexed checkpoint is saved by the C++ engine rather than a python thread
+        if self._config.ckpt_format == 'INDEXED':
+            _wait_indexed_checkpoint_saved()
 
         destroy_allgather_cell()
 
@@ -423,7 +438,8 @@ class ModelCheckpoint(Callback):
                 self._append_dict["step_num"] = self._append_step_num + cb_params.cur_step_num
             network = self._config.saved_network if self._config.saved_network is not None else cb_params.train_network
             save_checkpoint(network, cur_file, self._config.integrated_save, self._config.async_save,
-                            self._append_dict, self._config.enc_key, self._config.enc_mode)
+                            self._append_dict, self._config.enc_key, self._config.enc_mode,
+                            self._config.ckpt_format)
 
             self._latest_ckpt_file_name = cur_file
 
@@ -58,6 +58,9 @@ tensor_to_np_type = {"Int8": np.int8, "Uint8": np.uint8, "Int16": np.int16, "Uin
 
 _ckpt_mutex = Lock()
 
+_CKPT_FORMATS = ("PROTOBUF", "INDEXED")
+_INDEXED_CKPT_MAGIC = b"MSCKPT01"
+
 # unit is KB
 SLICE_SIZE = 512 * 1024
 PROTO_LIMIT_SIZE = 1024 * 1024 * 2
@@ -191,7 +194,7 @@ def _exec_save(ckpt_file_name, data_list, enc_key=None, enc_mode="AES-GCM"):
 
 
 def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
-                    async_save=False, append_dict=None, enc_key=None, enc_mode="AES-GCM"):
+                    async_save=False, append_dict=None, enc_key=None, enc_mode="AES-GCM", ckpt_format="PROTOBUF"):
     """
     Saves checkpoint info to a specified file.
 
@@ -209,10 +212,15 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
                                       is not required. Default: None.
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
+        ckpt_format (str): The format of the checkpoint file, currently supports 'PROTOBUF' and 'INDEXED'. An
+                           'INDEXED' checkpoint is written by several threads and is mapped into memory when it is
+                           loaded, so only the parameters used are read; it does not support encryption and
+                           a background save is waited for by the next save. Default: 'PROTOBUF'.
 
     Raises:
         TypeError: If the parameter save_obj is not `nn.Cell` or list type. And if the parameter
                    `integrated_save` and `async_save` are not bool type.
+        ValueError: If the parameter `ckpt_format` is not supported, or `enc_key` is set for an 'INDEXED' checkpoint.
 
     Examples:
         >>> from mindspore import save_checkpoint
@@ -228,6 +236,9 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
     append_dict = _check_append_dict(append_dict)
     enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
     enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+    ckpt_format = Validator.check_string(ckpt_format, _CKPT_FORMATS, 'ckpt_format', 'save_checkpoint')
+    if ckpt_format == "INDEXED" and enc_key is not None:
+        raise ValueError("The 'INDEXED' checkpoint format does not support encryption, please use 'PROTOBUF'.")
 
     logger.info("Execute the process of saving checkpoint files.")
 
@@ -256,6 +267,11 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
             append_info_list.append({"name": k_name, "data": Tensor(value)})
             save_obj.extend(append_info_list)
 
+    if ckpt_format == "INDEXED":
+        _save_indexed_checkpoint(save_obj, os.path.realpath(ckpt_file_name), async_save)
+        logger.info("Saving checkpoint process is finished.")
+        return
+
     data_list = {}
     with _ckpt_mutex:
         for param in save_obj:
@@ -285,6 +301,49 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
     logger.info("Saving checkpoint process is finished.")
 
 
+def _save_indexed_checkpoint(save_obj, ckpt_file_name, async_save):
+    """Saves the data list in the indexed format, the data is copied before it returns."""
+    from .._c_expression import _save_indexed_checkpoint as _save_indexed
+    tensors = []
+    for param in save_obj:
+        if isinstance(param["data"], Parameter):
+            param["data"].init_data()
+        tensors.append((param["name"], param["data"]))
+    try:
+        _save_indexed(ckpt_file_name, tensors, async_save)
+    except BaseException as e:
+        logger.error("Failed to save the checkpoint file %s.", ckpt_file_name)
+        raise e
+
+
+def _wait_indexed_checkpoint_saved():
+    """Waits for the indexed checkpoint saved in the background."""
+    from .._c_expression import _wait_indexed_checkpoint
+    _wait_indexed_checkpoint()
+
+
+def _is_indexed_checkpoint(ckpt_file_name):
+    """Checks whether the checkpoint file is saved in the indexed format."""
+    with open(ckpt_file_name, "rb") as f:
+        return f.read(len(_INDEXED_CKPT_MAGIC)) == _INDEXED_CKPT_MAGIC
+
+
+def _load_indexed_checkpoint(ckpt_file_name, filter_prefix):
+    """Loads the parameters of an indexed checkpoint, their data is read from the file when it is first used."""
+    from .._c_expression import CheckpointReader_
+    parameter_dict = {}
+    try:
+        reader = CheckpointReader_(ckpt_file_name)
+        for name in reader.tensor_names():
+            if filter_prefix is not None and _check_param_prefix(filter_prefix, name):
+                continue
+            parameter_dict[name] = Parameter(Tensor(reader.read_tensor(name)), name=name)
+    except BaseException as e:
+        logger.error("Failed to load the checkpoint file `%s`.", ckpt_file_name)
+        raise ValueError(e.__str__())
+    return parameter_dict
+
+
 def _check_param_prefix(filter_prefix, param_name):
     """Checks whether the prefix of parameter name matches the given filter_prefix."""
     for prefix in filter_prefix:
@@ -403,6 +462,18 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     dec_key = Validator.check_isinstance('dec_key', dec_key, (type(None), bytes))
     dec_mode = Validator.check_isinstance('dec_mode', dec_mode, str)
     logger.info("Execute the process of loading checkpoint files.")
+    if _is_indexed_checkpoint(ckpt_file_name):
+        if dec_key is not None:
+            raise ValueError(f"The checkpoint file `{ckpt_file_name}` is saved in the 'INDEXED' format, "
+                             f"which is not encrypted, please do not pass in dec_key.")
+        parameter_dict = _load_indexed_checkpoint(ckpt_file_name, filter_prefix)
+        logger.info("Loading checkpoint files process is finished.")
+        if not parameter_dict:
+            raise ValueError(f"The loaded parameter dict is empty after filtering, please check filter_prefix.")
+        if net is not None:
+            load_param_into_net(net, parameter_dict, strict_load)
+        return parameter_dict
+
     checkpoint_list = Checkpoint()
 
     try:
@@ -0,0 +1,77 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""EmbeddingLookup and Gather CPU kernel performance over table sizes and index skew."""
+
+import time
+
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+import mindspore.common.dtype as mstype
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+embedding_size = 64
+batch_size = 65536
+repeat = 20
+
+
+class EmbeddingLookupNet(nn.Cell):
+    def __init__(self):
+        super(EmbeddingLookupNet, self).__init__()
+        self.embedding = P.EmbeddingLookup().add_prim_attr("primitive_target", "CPU")
+
+    def construct(self, param, index):
+        return self.embedding(param, index, 0)
+
+
+class GatherNet(nn.Cell):
+    def __init__(self):
+        super(GatherNet, self).__init__()
+        self.gather = P.Gather()
+
+    def construct(self, param, index):
+        return self.gather(param, index, 0)
+
+
+def make_indices(table_rows, skew):
+    """Uniform indices, or zipf distributed ones where a few rows take most of the lookups."""
+    if skew == "uniform":
+        indices = np.random.randint(0, table_rows, batch_size)
+    else:
+        indices = (np.random.zipf(1.2, batch_size) - 1) % table_rows
+    return Tensor(indices.astype(np.int32))
+
+
+def run_case(net, table_rows, skew):
+    params = Tensor(np.random.randn(table_rows, embedding_size), mstype.float32)
+    indices = make_indices(table_rows, skew)
+    net(params, indices)
+    start = time.time()
+    for _ in range(repeat):
+        net(params, indices).asnumpy()
+    return (time.time() - start) / repeat * 1000
+
+
+def test_embedding_lookup_perf():
+    for name, net in (("EmbeddingLookup", EmbeddingLookupNet()), ("Gather", GatherNet())):
+        for table_rows in (10000, 1000000, 4000000):
+            for skew in ("uniform", "zipf"):
+                cost = run_case(net, table_rows, skew)
+                print("{} table_rows {} indices {}: {:.3f} ms".format(name, table_rows, skew, cost))
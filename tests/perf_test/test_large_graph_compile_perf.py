@@ -0,0 +1,73 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Compile time and peak memory of large forward and backward graphs, whose ir nodes come from the node pool."""
+
+import resource
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+import mindspore.ops.composite as C
+from mindspore import Tensor
+from mindspore import context
+from mindspore.common.api import _executor
+
+context.set_context(mode=context.GRAPH_MODE)
+
+grad_all = C.GradOperation(get_all=True)
+
+hidden_size = 16
+layer_nums = (250, 500, 1000, 2000)
+
+
+class DeepNet(nn.Cell):
+    """A chain of small dense layers, the graph grows with the layer number while the kernels stay cheap."""
+
+    def __init__(self, layer_num):
+        super(DeepNet, self).__init__()
+        self.layers = nn.CellList([nn.Dense(hidden_size, hidden_size, activation='relu') for _ in range(layer_num)])
+
+    def construct(self, x):
+        for layer in self.layers:
+            x = layer(x)
+        return x
+
+
+class DeepNetGrad(nn.Cell):
+    def __init__(self, network):
+        super(DeepNetGrad, self).__init__()
+        self.network = network
+
+    def construct(self, x):
+        return grad_all(self.network)(x)
+
+
+def peak_memory_mb():
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024
+
+
+def test_large_graph_compile_perf():
+    """The peak memory of the process only grows, so the graphs compile from the smallest to the largest one."""
+    inp = Tensor(np.random.randn(1, hidden_size).astype(np.float32))
+    for layer_num in layer_nums:
+        net = DeepNetGrad(DeepNet(layer_num))
+        start_memory = peak_memory_mb()
+        start = time.time()
+        _executor.compile(net, inp, phase="train_{}".format(layer_num))
+        compile_time = time.time() - start
+        print("{} layers: compile {:.3f} s, peak memory {:.1f} MB (+{:.1f} MB)".format(
+            layer_num, compile_time, peak_memory_mb(), peak_memory_mb() - start_memory))
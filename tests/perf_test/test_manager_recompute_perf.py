@@ -0,0 +1,91 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Recomputations of the func graph manager analyses per optimizer pass while compiling large graphs."""
+
+import os
+import re
+import subprocess
+import sys
+import time
+from collections import Counter
+
+import numpy as np
+
+import mindspore.nn as nn
+import mindspore.ops.composite as C
+from mindspore import Tensor
+from mindspore import context
+from mindspore.common.api import _executor
+
+grad_all = C.GradOperation(get_all=True)
+
+hidden_size = 16
+layer_nums = (100, 200, 400)
+top_pass_num = 10
+recompute_log = re.compile(r"Optimizer (\S+) pass (\S+) recomputed (\d+) manager analyses")
+
+
+class DeepNet(nn.Cell):
+    """A chain of small dense layers, the graph grows with the layer number while the kernels stay cheap."""
+
+    def __init__(self, layer_num):
+        super(DeepNet, self).__init__()
+        self.layers = nn.CellList([nn.Dense(hidden_size, hidden_size, activation='relu') for _ in range(layer_num)])
+
+    def construct(self, x):
+        for layer in self.layers:
+            x = layer(x)
+        return x
+
+
+class DeepNetGrad(nn.Cell):
+    def __init__(self, network):
+        super(DeepNetGrad, self).__init__()
+        self.network = network
+
+    def construct(self, x):
+        return grad_all(self.network)(x)
+
+
+def compile_net(layer_num):
+    context.set_context(mode=context.GRAPH_MODE)
+    inp = Tensor(np.random.randn(1, hidden_size).astype(np.float32))
+    net = DeepNetGrad(DeepNet(layer_num))
+    _executor.compile(net, inp, phase="train_{}".format(layer_num))
+
+
+def test_manager_recompute_perf():
+    """Each graph compiles in a child process logging at info level, a pass whose recomputations grow faster than the
+    layer number invalidates more analyses than its changes affect."""
+    env = dict(os.environ, GLOG_v="1", GLOG_logtostderr="1")
+    for layer_num in layer_nums:
+        start = time.time()
+        result = subprocess.run([sys.executable, os.path.abspath(__file__), str(layer_num)], env=env,
+                                stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True, check=False)
+        compile_time = time.time() - start
+        assert result.returncode == 0, result.stderr[-2000:]
+        recomputes = Counter()
+        for match in recompute_log.finditer(result.stderr):
+            recomputes["{}.{}".format(match.group(1), match.group(2))] += int(match.group(3))
+        assert recomputes, "no optimizer pass logged its manager recomputations"
+        print("{} layers: compile {:.3f} s, {} recomputations in {} passes".format(
+            layer_num, compile_time, sum(recomputes.values()), len(recomputes)))
+        for name, count in recomputes.most_common(top_pass_num):
+            print("  {:<60} {}".format(name, count))
+
+
+if __name__ == "__main__":
+    compile_net(int(sys.argv[1]))
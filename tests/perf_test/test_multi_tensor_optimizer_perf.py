@@ -0,0 +1,81 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""CPU optimizer step time over the parameters of BERT-base, the updates are fused into multi tensor kernels."""
+
+import time
+
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore.common import ParameterTuple
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+repeat = 20
+hidden_size = 768
+intermediate_size = 3072
+num_layers = 12
+
+
+def bert_base_shapes():
+    """Shapes of the trainable parameters of BERT-base, about 200 tensors from 2 to 23 million elements."""
+    shapes = [(30522, hidden_size), (512, hidden_size), (2, hidden_size), (hidden_size,), (hidden_size,)]
+    for _ in range(num_layers):
+        for _ in range(4):
+            shapes += [(hidden_size, hidden_size), (hidden_size,)]
+        shapes += [(hidden_size,), (hidden_size,)]
+        shapes += [(intermediate_size, hidden_size), (intermediate_size,)]
+        shapes += [(hidden_size, intermediate_size), (hidden_size,)]
+        shapes += [(hidden_size,), (hidden_size,)]
+    shapes += [(hidden_size, hidden_size), (hidden_size,), (2, hidden_size), (2,)]
+    return shapes
+
+
+class OptimizerStep(nn.Cell):
+    def __init__(self, optimizer):
+        super(OptimizerStep, self).__init__()
+        self.optimizer = optimizer
+
+    def construct(self, grads):
+        return self.optimizer(grads)
+
+
+def make_params(shapes):
+    return ParameterTuple([Parameter(Tensor(np.random.randn(*shape).astype(np.float32) * 0.02), name="w{}".format(i))
+                           for i, shape in enumerate(shapes)])
+
+
+def timeit(net, grads):
+    net(grads)
+    start = time.time()
+    for _ in range(repeat):
+        net(grads)
+    return (time.time() - start) / repeat * 1000
+
+
+def test_multi_tensor_optimizer_perf():
+    shapes = bert_base_shapes()
+    grads = tuple(Tensor(np.random.randn(*shape).astype(np.float32) * 0.01) for shape in shapes)
+    optimizers = {
+        "AdamWeightDecay": lambda params: nn.AdamWeightDecay(params, learning_rate=1e-4, weight_decay=0.01),
+        "Adam": lambda params: nn.Adam(params, learning_rate=1e-4),
+        "Momentum": lambda params: nn.Momentum(params, learning_rate=0.01, momentum=0.9),
+    }
+    for name, create in optimizers.items():
+        net = OptimizerStep(create(make_params(shapes)))
+        print("{} over {} tensors: {:.3f} ms per step".format(name, len(shapes), timeit(net, grads)))
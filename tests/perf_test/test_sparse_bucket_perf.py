@@ -0,0 +1,79 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Unique and UnsortedSegmentSum CPU kernel performance over index counts and duplicate ratios."""
+
+import time
+
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+import mindspore.common.dtype as mstype
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+num_segments = 1000000
+row_size = 16
+repeat = 20
+
+
+class UniqueNet(nn.Cell):
+    def __init__(self):
+        super(UniqueNet, self).__init__()
+        self.unique = P.Unique()
+
+    def construct(self, x):
+        return self.unique(x)
+
+
+class SegmentSumNet(nn.Cell):
+    def __init__(self):
+        super(SegmentSumNet, self).__init__()
+        self.segment_sum = P.UnsortedSegmentSum()
+
+    def construct(self, x, segment_ids):
+        return self.segment_sum(x, segment_ids, num_segments)
+
+
+def make_indices(index_num, duplicate_ratio):
+    """Indices of which duplicate_ratio are drawn from 100 hot values, the others from all the segments."""
+    indices = np.random.randint(0, num_segments, index_num)
+    hot = np.random.rand(index_num) < duplicate_ratio
+    indices[hot] = np.random.randint(0, 100, int(hot.sum()))
+    return indices.astype(np.int32)
+
+
+def timeit(net, *inputs):
+    net(*inputs)
+    start = time.time()
+    for _ in range(repeat):
+        net(*inputs)
+    return (time.time() - start) / repeat * 1000
+
+
+def test_sparse_bucket_perf():
+    unique = UniqueNet()
+    segment_sum = SegmentSumNet()
+    for index_num in (10000, 100000, 1000000, 4000000):
+        for duplicate_ratio in (0.0, 0.5, 0.9, 0.99):
+            indices = make_indices(index_num, duplicate_ratio)
+            unique_cost = timeit(unique, Tensor(indices))
+            values = Tensor(np.random.randn(index_num, row_size), mstype.float32)
+            segment_sum_cost = timeit(segment_sum, values, Tensor(indices))
+            print("indices {} duplicates {}: Unique {:.3f} ms, UnsortedSegmentSum {:.3f} ms".format(
+                index_num, duplicate_ratio, unique_cost, segment_sum_cost))
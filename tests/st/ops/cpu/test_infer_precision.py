@@ -0,0 +1,139 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class ConvMatMulNet(nn.Cell):
+    def __init__(self, w_conv, w_matmul):
+        super(ConvMatMulNet, self).__init__()
+        self.conv = P.Conv2D(out_channel=w_conv.shape[0], kernel_size=w_conv.shape[2])
+        self.relu = P.ReLU()
+        self.matmul = P.MatMul()
+        self.w_conv = Parameter(Tensor(w_conv), name='w_conv', requires_grad=False)
+        self.w_matmul = Parameter(Tensor(w_matmul), name='w_matmul', requires_grad=False)
+
+    def construct(self, x, y):
+        return self.relu(self.conv(x, self.w_conv)), self.matmul(y, self.w_matmul)
+
+
+class UpdatedConvMatMulNet(ConvMatMulNet):
+    """The weights are written by the graph, so the Conv2D and the MatMul are trained."""
+    def __init__(self, w_conv, w_matmul):
+        super(UpdatedConvMatMulNet, self).__init__(w_conv, w_matmul)
+        self.assign = P.Assign()
+
+    def construct(self, x, y):
+        conv_out = self.relu(self.conv(x, self.w_conv))
+        matmul_out = self.matmul(y, self.w_matmul)
+        self.assign(self.w_conv, self.w_conv * 2)
+        self.assign(self.w_matmul, self.w_matmul * 2)
+        return conv_out, matmul_out
+
+
+def conv2d(x, w):
+    kernel_h, kernel_w = w.shape[2:]
+    out_h = x.shape[2] - kernel_h + 1
+    out_w = x.shape[3] - kernel_w + 1
+    out = np.zeros((x.shape[0], w.shape[0], out_h, out_w), np.float32)
+    for i in range(kernel_h):
+        for j in range(kernel_w):
+            out += np.einsum('nchw,oc->nohw', x[:, :, i:i + out_h, j:j + out_w], w[:, :, i, j])
+    return out
+
+
+def make_inputs():
+    np.random.seed(1)
+    x = np.random.randn(2, 8, 10, 10).astype(np.float32)
+    w_conv = np.random.randn(16, 8, 3, 3).astype(np.float32)
+    y = np.random.randn(32, 64).astype(np.float32)
+    w_matmul = np.random.randn(64, 48).astype(np.float32)
+    return x, w_conv, y, w_matmul
+
+
+def run_net(net_class, precision_mode):
+    x, w_conv, y, w_matmul = make_inputs()
+    context.set_context(infer_precision_mode=precision_mode)
+    try:
+        net = net_class(w_conv, w_matmul)
+        conv_out, matmul_out = net(Tensor(x), Tensor(y))
+    finally:
+        context.set_context(infer_precision_mode='fp32')
+    return conv_out.asnumpy(), matmul_out.asnumpy()
+
+
+def expect_outputs():
+    x, w_conv, y, w_matmul = make_inputs()
+    return np.maximum(conv2d(x, w_conv), 0), np.matmul(y, w_matmul)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_bf16_inference():
+    """
+    Feature: bf16 inference precision on CPU
+    Description: run a Conv2D with ReLU and a MatMul whose weights are never written in the bf16 mode
+    Expectation: the outputs are the float32 ones within the precision of bf16, which has an 8 bit mantissa
+    """
+    conv_out, matmul_out = run_net(ConvMatMulNet, 'bf16')
+    expect_conv, expect_matmul = expect_outputs()
+    assert conv_out.dtype == np.float32
+    assert np.allclose(conv_out, expect_conv, rtol=2e-2, atol=0.2)
+    assert np.allclose(matmul_out, expect_matmul, rtol=2e-2, atol=0.2)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_int8_inference():
+    """
+    Feature: int8 inference precision on CPU
+    Description: run a MatMul whose weight is never written in the int8 mode, its inputs are quantized at runtime
+    Expectation: the error of the MatMul is within the rounding of both quantized operands, the Conv2D is float32
+    """
+    conv_out, matmul_out = run_net(ConvMatMulNet, 'int8')
+    expect_conv, expect_matmul = expect_outputs()
+    _, _, y, w_matmul = make_inputs()
+    # Each product is off by at most half a step of both operands, summed over the k products.
+    y_step = np.abs(y).max() / 127
+    w_step = np.abs(w_matmul).max(axis=0) / 127
+    bound = 0.5 * (y_step * np.abs(w_matmul).sum(axis=0) + np.abs(y).sum(axis=1, keepdims=True) * w_step
+                   + 0.5 * y.shape[1] * y_step * w_step)
+    assert np.all(np.abs(matmul_out - expect_matmul) <= bound + 1e-4)
+    assert np.allclose(conv_out, expect_conv, rtol=1e-4, atol=1e-3)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize('precision_mode', ['bf16', 'int8'])
+def test_trained_nodes_stay_fp32(precision_mode):
+    """
+    Feature: inference precision on CPU
+    Description: run a Conv2D and a MatMul whose weights the graph updates in a reduced precision mode
+    Expectation: the trained nodes compute in float32, so the outputs are the float32 ones
+    """
+    conv_out, matmul_out = run_net(UpdatedConvMatMulNet, precision_mode)
+    expect_conv, expect_matmul = expect_outputs()
+    assert np.allclose(conv_out, expect_conv, rtol=1e-4, atol=1e-3)
+    assert np.allclose(matmul_out, expect_matmul, rtol=1e-4, atol=1e-3)
@@ -0,0 +1,110 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class ConvReluPoolNet(nn.Cell):
+    """On hosts where oneDNN prefers the blocked layout, conv1, relu and pool form a blocked region. conv2 and add
+    read the pooled tensor in the default layout and return graph outputs, so TransData kernels convert it."""
+    def __init__(self, w1, w2):
+        super(ConvReluPoolNet, self).__init__()
+        self.conv1 = P.Conv2D(out_channel=16, kernel_size=3)
+        self.relu = P.ReLU()
+        self.pool = P.MaxPool(kernel_size=2, strides=2)
+        self.conv2 = P.Conv2D(out_channel=32, kernel_size=3)
+        self.add = P.Add()
+        self.w1 = Parameter(Tensor(w1), name='w1')
+        self.w2 = Parameter(Tensor(w2), name='w2')
+
+    def construct(self, x, residual):
+        pooled = self.pool(self.relu(self.conv1(x, self.w1)))
+        return self.conv2(pooled, self.w2), self.add(pooled, residual)
+
+
+def conv2d(x, w):
+    kernel_h, kernel_w = w.shape[2:]
+    out_h = x.shape[2] - kernel_h + 1
+    out_w = x.shape[3] - kernel_w + 1
+    out = np.zeros((x.shape[0], w.shape[0], out_h, out_w), np.float32)
+    for i in range(kernel_h):
+        for j in range(kernel_w):
+            out += np.einsum('nchw,oc->nohw', x[:, :, i:i + out_h, j:j + out_w], w[:, :, i, j])
+    return out
+
+
+def max_pool(x):
+    n, c, h, w = x.shape
+    return x.reshape(n, c, h // 2, 2, w // 2, 2).max(axis=(3, 5))
+
+
+def expect_outputs(x, w1, w2, residual):
+    pooled = max_pool(np.maximum(conv2d(x, w1), 0))
+    return conv2d(pooled, w2), pooled + residual
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv_relu_pool_conv():
+    """
+    Feature: layout propagation on CPU
+    Description: run convolutions and a pooling whose results leave the blocked region to a conv and a graph output
+    Expectation: the outputs are the ones of the plain layout
+    """
+    np.random.seed(1)
+    x = np.random.randn(2, 8, 18, 18).astype(np.float32)
+    w1 = np.random.randn(16, 8, 3, 3).astype(np.float32)
+    w2 = np.random.randn(32, 16, 3, 3).astype(np.float32)
+    residual = np.random.randn(2, 16, 8, 8).astype(np.float32)
+    net = ConvReluPoolNet(w1, w2)
+    conv_out, add_out = net(Tensor(x), Tensor(residual))
+    expect_conv, expect_add = expect_outputs(x, w1, w2, residual)
+    assert np.allclose(conv_out.asnumpy(), expect_conv, rtol=1e-4, atol=1e-3)
+    assert np.allclose(add_out.asnumpy(), expect_add, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv_weight_reloaded():
+    """
+    Feature: layout propagation on CPU
+    Description: run a net with read-only conv weights, load new weight values of the same shape and run it again
+    Expectation: the second run uses the new weights instead of a stale converted copy of the old ones
+    """
+    np.random.seed(1)
+    x = np.random.randn(2, 8, 18, 18).astype(np.float32)
+    w1 = np.random.randn(16, 8, 3, 3).astype(np.float32)
+    w2 = np.random.randn(32, 16, 3, 3).astype(np.float32)
+    residual = np.random.randn(2, 16, 8, 8).astype(np.float32)
+    net = ConvReluPoolNet(w1, w2)
+    net(Tensor(x), Tensor(residual))
+
+    new_w1 = np.random.randn(16, 8, 3, 3).astype(np.float32)
+    new_w2 = np.random.randn(32, 16, 3, 3).astype(np.float32)
+    net.w1.set_data(Tensor(new_w1))
+    net.w2.set_data(Tensor(new_w2))
+    conv_out, add_out = net(Tensor(x), Tensor(residual))
+    expect_conv, expect_add = expect_outputs(x, new_w1, new_w2, residual)
+    assert np.allclose(conv_out.asnumpy(), expect_conv, rtol=1e-4, atol=1e-3)
+    assert np.allclose(add_out.asnumpy(), expect_add, rtol=1e-4, atol=1e-4)
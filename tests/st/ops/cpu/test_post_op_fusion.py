@@ -0,0 +1,80 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class ConvBiasAddReluNet(nn.Cell):
+    def __init__(self, out_channel):
+        super(ConvBiasAddReluNet, self).__init__()
+        self.conv = P.Conv2D(out_channel=out_channel, kernel_size=1)
+        self.bias_add = P.BiasAdd()
+        self.add = P.Add()
+        self.relu = P.ReLU()
+
+    def construct(self, x, w, b, residual):
+        return self.relu(self.add(self.bias_add(self.conv(x, w), b), residual))
+
+
+class MatMulBiasAddGeLUNet(nn.Cell):
+    def __init__(self):
+        super(MatMulBiasAddGeLUNet, self).__init__()
+        self.matmul = P.MatMul(transpose_b=True)
+        self.bias_add = P.BiasAdd()
+        self.gelu = P.GeLU()
+
+    def construct(self, x, w, b):
+        return self.gelu(self.bias_add(self.matmul(x, w), b))
+
+
+def gelu(x):
+    return 0.5 * x * (1.0 + np.tanh(np.sqrt(2.0 / np.pi) * (x + 0.044715 * np.power(x, 3))))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv_bias_add_residual_relu():
+    np.random.seed(1)
+    x = np.random.randn(2, 4, 5, 5).astype(np.float32)
+    w = np.random.randn(6, 4, 1, 1).astype(np.float32)
+    b = np.random.randn(6).astype(np.float32)
+    residual = np.random.randn(2, 6, 5, 5).astype(np.float32)
+    net = ConvBiasAddReluNet(6)
+    output = net(Tensor(x), Tensor(w), Tensor(b), Tensor(residual))
+    conv = np.einsum('nchw,oc->nohw', x, w.reshape(6, 4))
+    expect = np.maximum(conv + b.reshape(1, 6, 1, 1) + residual, 0)
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_matmul_bias_add_gelu():
+    np.random.seed(1)
+    x = np.random.randn(8, 16).astype(np.float32)
+    w = np.random.randn(12, 16).astype(np.float32)
+    b = np.random.randn(12).astype(np.float32)
+    net = MatMulBiasAddGeLUNet()
+    output = net(Tensor(x), Tensor(w), Tensor(b))
+    expect = gelu(np.matmul(x, w.T) + b)
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-4)
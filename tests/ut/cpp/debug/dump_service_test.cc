@@ -0,0 +1,128 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "debug/data_dump/dump_service.h"
+#define private public
+#include "debug/data_dump/dump_json_parser.h"
+#undef private
+
+namespace mindspore {
+class TestDumpService : public UT::Common {
+ public:
+  TestDumpService() {}
+  void TearDown() override { DumpService::GetInstance().Stop(); }
+
+ protected:
+  // The data of a dump file, after the npy header.
+  std::vector<int> ReadDumpData(const std::string &filename, size_t len) {
+    std::ifstream ifs(filename + ".npy", std::ios::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ifs.close();
+    (void)remove((filename + ".npy").c_str());
+    std::vector<int> data(len, -1);
+    size_t data_size = len * sizeof(int);
+    if (content.size() >= data_size) {
+      std::copy(content.end() - data_size, content.end(), reinterpret_cast<char *>(data.data()));
+    }
+    return data;
+  }
+};
+
+/// Feature: background dump writers
+/// Description: submit tensors to the running dump service and reuse their memory right after the submission
+/// Expectation: the files hold the data at the submission and no staging memory is left after the flush
+TEST_F(TestDumpService, test_background_write) {
+  auto &dump_service = DumpService::GetInstance();
+  const size_t len = 1000;
+  const size_t file_num = 8;
+  dump_service.Start(2, len * sizeof(int) * 2);
+  ASSERT_TRUE(dump_service.running());
+  std::vector<int> data(len);
+  for (size_t i = 0; i < file_num; ++i) {
+    for (size_t j = 0; j < len; ++j) {
+      data[j] = static_cast<int>(i * len + j);
+    }
+    auto filename = "./dump_service_test_" + std::to_string(i);
+    ASSERT_TRUE(dump_service.DumpToFile(filename, data.data(), len * sizeof(int), ShapeVector{10, 100},
+                                        kNumberTypeInt32));
+    std::fill(data.begin(), data.end(), -1);
+  }
+  dump_service.Flush();
+  EXPECT_EQ(dump_service.staging_bytes(), 0);
+  EXPECT_EQ(dump_service.failed_num(), 0);
+  for (size_t i = 0; i < file_num; ++i) {
+    auto file_data = ReadDumpData("./dump_service_test_" + std::to_string(i), len);
+    for (size_t j = 0; j < len; ++j) {
+      EXPECT_EQ(file_data[j], static_cast<int>(i * len + j));
+    }
+  }
+}
+
+/// Feature: background dump writers
+/// Description: submit a tensor larger than the staging memory budget
+/// Expectation: the tensor is staged alone instead of waiting forever
+TEST_F(TestDumpService, test_tensor_over_budget) {
+  auto &dump_service = DumpService::GetInstance();
+  const size_t len = 1000;
+  dump_service.Start(1, sizeof(int));
+  std::vector<int> data(len, 7);
+  ASSERT_TRUE(dump_service.DumpToFile("./dump_service_test_large", data.data(), len * sizeof(int), ShapeVector{1000},
+                                      kNumberTypeInt32));
+  ASSERT_TRUE(dump_service.DumpToFile("./dump_service_test_large_next", data.data(), len * sizeof(int),
+                                      ShapeVector{1000}, kNumberTypeInt32));
+  dump_service.Stop();
+  EXPECT_FALSE(dump_service.running());
+  EXPECT_EQ(ReadDumpData("./dump_service_test_large", len), data);
+  EXPECT_EQ(ReadDumpData("./dump_service_test_large_next", len), data);
+}
+
+/// Feature: background dump writers
+/// Description: dump through the service when its writers are not started
+/// Expectation: the file is written synchronously
+TEST_F(TestDumpService, test_write_without_writers) {
+  auto &dump_service = DumpService::GetInstance();
+  ASSERT_FALSE(dump_service.running());
+  std::vector<int> data = {1, 2, 3, 4};
+  ASSERT_TRUE(dump_service.DumpToFile("./dump_service_test_sync", data.data(), data.size() * sizeof(int),
+                                      ShapeVector{4}, kNumberTypeInt32));
+  EXPECT_EQ(ReadDumpData("./dump_service_test_sync", data.size()), data);
+}
+
+/// Feature: dump iteration sampling
+/// Description: check the dumped iterations with a sample interval
+/// Expectation: only the configured iterations that are a multiple of the interval are dumped
+TEST_F(TestDumpService, test_sample_interval) {
+  auto &dump_json_parser = DumpJsonParser::GetInstance();
+  auto iteration = dump_json_parser.iteration_;
+  auto sample_interval = dump_json_parser.sample_interval_;
+  dump_json_parser.iteration_ = "0-20|35";
+  dump_json_parser.sample_interval_ = 5;
+  std::vector<uint32_t> dump_iters;
+  for (uint32_t i = 0; i < 40; ++i) {
+    if (dump_json_parser.IsDumpIter(i)) {
+      dump_iters.emplace_back(i);
+    }
+  }
+  dump_json_parser.iteration_ = iteration;
+  dump_json_parser.sample_interval_ = sample_interval;
+  EXPECT_EQ(dump_iters, std::vector<uint32_t>({0, 5, 10, 15, 20, 35}));
+}
+}  // namespace mindspore
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "common/common_test.h"
+#include "debug/debugger/tensor_statistics.h"
+
+namespace mindspore {
+class TestTensorStatistics : public UT::Common {
+ public:
+  TestTensorStatistics() {}
+};
+
+/// Feature: tensor statistics of the debugger
+/// Description: compute the statistics of a tensor whose length is not a multiple of the lane number
+/// Expectation: the statistics equal the ones of a sequential two pass computation
+TEST_F(TestTensorStatistics, test_statistics) {
+  std::vector<float> data;
+  for (int i = 0; i < 1001; ++i) {
+    data.push_back(static_cast<float>((i * 37) % 101) - 50.0f);
+  }
+  auto statistics = CalculateTensorStatistics(data.data(), data.size());
+
+  double min = data[0];
+  double max = data[0];
+  double sum = 0;
+  double abs_sum = 0;
+  uint64_t zero_count = 0;
+  for (auto value : data) {
+    min = std::min(min, static_cast<double>(value));
+    max = std::max(max, static_cast<double>(value));
+    sum += value;
+    abs_sum += std::abs(value);
+    zero_count += value == 0;
+  }
+  double mean = sum / data.size();
+  double square_sum = 0;
+  for (auto value : data) {
+    square_sum += (value - mean) * (value - mean);
+  }
+  double variance = square_sum / (data.size() - 1);
+
+  ASSERT_EQ(statistics.num_elements, data.size());
+  ASSERT_EQ(statistics.min, min);
+  ASSERT_EQ(statistics.max, max);
+  ASSERT_EQ(statistics.zero_count, zero_count);
+  ASSERT_EQ(statistics.nan_count, 0);
+  ASSERT_EQ(statistics.inf_count, 0);
+  ASSERT_NEAR(statistics.mean, mean, 1e-9);
+  ASSERT_NEAR(statistics.abs_mean, abs_sum / data.size(), 1e-9);
+  ASSERT_NEAR(statistics.variance, variance, 1e-6);
+  ASSERT_NEAR(statistics.sd(), std::sqrt(variance), 1e-6);
+}
+
+/// Feature: tensor statistics of the debugger
+/// Description: compute the statistics of a tensor holding nan, inf and zero values
+/// Expectation: nan and inf are counted and nan is left out of min and max
+TEST_F(TestTensorStatistics, test_statistics_special_values) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> data = {nan, 3.0, 0.0, -inf, 2.0, nan, 0.0, inf, -1.0, 0.0};
+  auto statistics = CalculateTensorStatistics(data.data(), data.size());
+  ASSERT_EQ(statistics.nan_count, 2);
+  ASSERT_EQ(statistics.inf_count, 2);
+  ASSERT_EQ(statistics.zero_count, 3);
+  ASSERT_EQ(statistics.min, -inf);
+  ASSERT_EQ(statistics.max, inf);
+}
+
+/// Feature: tensor statistics of the debugger
+/// Description: compute the statistics of integer, bool and empty tensors
+/// Expectation: the statistics are converted to double and an empty tensor gives the initial values
+TEST_F(TestTensorStatistics, test_statistics_types) {
+  std::vector<int32_t> ints = {7, -3, 0, 12};
+  auto int_statistics = CalculateTensorStatistics(ints.data(), ints.size());
+  ASSERT_EQ(int_statistics.min, -3);
+  ASSERT_EQ(int_statistics.max, 12);
+  ASSERT_EQ(int_statistics.zero_count, 1);
+  ASSERT_NEAR(int_statistics.mean, 4.0, 1e-12);
+  ASSERT_NEAR(int_statistics.abs_mean, 5.5, 1e-12);
+
+  bool bools[] = {true, false, true};
+  auto bool_statistics = CalculateTensorStatistics(bools, 3);
+  ASSERT_EQ(bool_statistics.zero_count, 1);
+  ASSERT_EQ(bool_statistics.max, 1);
+
+  auto empty_statistics = CalculateTensorStatistics<float>(nullptr, 0);
+  ASSERT_EQ(empty_statistics.num_elements, 0);
+  ASSERT_EQ(empty_statistics.variance, 0);
+}
+}  // namespace mindspore
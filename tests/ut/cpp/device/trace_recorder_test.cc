@@ -0,0 +1,173 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "profiler/device/profiling.h"
+#include "profiler/device/trace_recorder.h"
+
+namespace mindspore {
+namespace profiler {
+class TestTraceRecorder : public UT::Common {
+ public:
+  TestTraceRecorder() {}
+  void SetUp() override {
+    auto &recorder = TraceRecorder::GetInstance();
+    recorder.Collect();
+    recorder.ClearEvents();
+    recorder.SetEnable(true);
+  }
+  void TearDown() override {
+    auto &recorder = TraceRecorder::GetInstance();
+    recorder.SetEnable(false);
+    recorder.SetCollectHook(nullptr);
+    recorder.Collect();
+    recorder.ClearEvents();
+  }
+};
+
+/// Feature: trace recorder
+/// Description: record kernel launches on several threads and collect them
+/// Expectation: every event is collected once, ordered by the begin time, with the thread that recorded it
+TEST_F(TestTraceRecorder, test_multi_thread_record) {
+  auto &recorder = TraceRecorder::GetInstance();
+  constexpr size_t kThreadNum = 4;
+  constexpr uint64_t kEventNum = 1000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&recorder, i]() {
+      auto name_id = recorder.GetNameId("Default/Op-" + std::to_string(i));
+      for (uint64_t j = 0; j < kEventNum; ++j) {
+        recorder.Record(TraceEventType::kKernelLaunch, name_id, j * kThreadNum + i, j * kThreadNum + i + 1, i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  recorder.Collect();
+  auto events = recorder.GetCollectedEvents();
+  ASSERT_EQ(events.size(), kThreadNum * kEventNum);
+  std::vector<uint32_t> thread_of_op(kThreadNum, UINT32_MAX);
+  for (size_t k = 0; k < events.size(); ++k) {
+    EXPECT_EQ(events[k].begin, k);
+    auto op = events[k].arg;
+    EXPECT_EQ(recorder.GetName(events[k].name_id), "Default/Op-" + std::to_string(op));
+    if (thread_of_op[op] == UINT32_MAX) {
+      thread_of_op[op] = events[k].tid;
+    }
+    EXPECT_EQ(events[k].tid, thread_of_op[op]);
+  }
+}
+
+/// Feature: trace recorder
+/// Description: record more events on one thread than its buffer holds before a collection
+/// Expectation: the events beyond the capacity are spilled and none of them is lost
+TEST_F(TestTraceRecorder, test_buffer_overflow) {
+  auto &recorder = TraceRecorder::GetInstance();
+  const uint64_t event_num = TraceBuffer::kCapacity * 3 + 5;
+  std::thread thread([&recorder, event_num]() {
+    for (uint64_t i = 0; i < event_num; ++i) {
+      recorder.Record(TraceEventType::kMemoryAlloc, "CPUMemoryPool", i, i + 1, i);
+    }
+  });
+  thread.join();
+  recorder.Collect();
+  auto events = recorder.GetCollectedEvents();
+  ASSERT_EQ(events.size(), event_num);
+  for (uint64_t i = 0; i < event_num; ++i) {
+    EXPECT_EQ(events[i].arg, i);
+  }
+}
+
+/// Feature: trace recorder
+/// Description: read the time of the recorder between two host timestamps of the profiler
+/// Expectation: the recorder uses the clock of the profiler, so its time lies between them
+TEST_F(TestTraceRecorder, test_profiler_clock) {
+  auto before = Profiler::GetHostMonoTimeStamp();
+  auto now = TraceRecorder::Now();
+  auto after = Profiler::GetHostMonoTimeStamp();
+  EXPECT_LE(before, now);
+  EXPECT_LE(now, after);
+}
+
+/// Feature: trace recorder
+/// Description: collect more events than the recorder keeps, over several collections with a collect hook
+/// Expectation: the hook sees every event once, only the newest kMaxCollectedEvents events are kept for the export
+TEST_F(TestTraceRecorder, test_collected_bound) {
+  auto &recorder = TraceRecorder::GetInstance();
+  uint64_t hook_event_num = 0;
+  recorder.SetCollectHook(
+    [&hook_event_num](const std::vector<TraceEvent> &events) { hook_event_num += events.size(); });
+  constexpr uint64_t kStepNum = 3;
+  const uint64_t step_event_num = TraceRecorder::kMaxCollectedEvents / 2 + 1;
+  std::thread thread([&recorder, step_event_num]() {
+    for (uint64_t step = 0; step < kStepNum; ++step) {
+      for (uint64_t i = 0; i < step_event_num; ++i) {
+        auto time = step * step_event_num + i;
+        recorder.Record(TraceEventType::kKernelLaunch, "Default/Add-op0", time, time + 1, time);
+      }
+      recorder.Collect();
+    }
+  });
+  thread.join();
+  EXPECT_EQ(hook_event_num, kStepNum * step_event_num);
+  auto events = recorder.GetCollectedEvents();
+  ASSERT_EQ(events.size(), TraceRecorder::kMaxCollectedEvents);
+  EXPECT_EQ(events.front().arg, kStepNum * step_event_num - TraceRecorder::kMaxCollectedEvents);
+  EXPECT_EQ(events.back().arg, kStepNum * step_event_num - 1);
+}
+
+/// Feature: trace recorder
+/// Description: export the recorded spans of each kind as a Chrome trace
+/// Expectation: the file holds a complete event per span with its category and a thread name per thread, and an async
+/// begin and end pair per actor message, whose wait overlaps the kernels of the thread
+TEST_F(TestTraceRecorder, test_export_chrome_trace) {
+  auto &recorder = TraceRecorder::GetInstance();
+  {
+    std::string name = "Default/MatMul-op0";
+    TraceScope scope(TraceEventType::kKernelLaunch, name);
+  }
+  recorder.Record(TraceEventType::kActorMessage, "kernel_actor", 10, 20);
+  recorder.Record(TraceEventType::kMemoryFree, "CPUMemoryPool", 20, 30, 4096);
+  recorder.Record(TraceEventType::kDataQueueWait, "data_source_actor\"0\"", 30, 40);
+  recorder.Collect();
+  const std::string file_path = "./trace_recorder_test.json";
+  ASSERT_TRUE(recorder.ExportChromeTrace(file_path));
+  std::ifstream ifs(file_path);
+  std::stringstream content;
+  content << ifs.rdbuf();
+  ifs.close();
+  (void)remove(file_path.c_str());
+  auto trace = content.str();
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+  EXPECT_NE(trace.find("\"name\":\"Default/MatMul-op0\",\"cat\":\"kernel\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"kernel_actor\",\"cat\":\"actor_message\",\"ph\":\"b\",\"id\":0,\"ts\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"kernel_actor\",\"cat\":\"actor_message\",\"ph\":\"e\",\"id\":0,\"ts\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"cat\":\"memory_free\""), std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{\"bytes\":4096}"), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"data_source_actor\\\"0\\\"\",\"cat\":\"data_queue\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"thread_name\",\"ph\":\"M\""), std::string::npos);
+  EXPECT_EQ(trace.rfind("]}"), trace.size() - 3);
+}
+}  // namespace profiler
+}  // namespace mindspore
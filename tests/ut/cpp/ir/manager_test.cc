@@ -621,4 +621,37 @@ TEST_F(TestManager, test_keep_roots_recursion) {
   ASSERT_EQ(mng->func_graphs().size(), 1);
 }
 
+TEST_F(TestManager, test_invalidate_changed_graphs) {
+  /*
+   *def f(x):
+   *    return g1(x, x) + g2(x, x)
+   */
+  FuncGraphPtr g1 = MakeFuncGraph(prim::kPrimScalarAdd);
+  FuncGraphPtr g2 = MakeFuncGraph(prim::kPrimScalarAdd);
+  FuncGraphPtr f = std::make_shared<FuncGraph>();
+  ParameterPtr x = f->add_parameter();
+  CNodePtr call_g1 = f->NewCNode({NewValueNode(g1), x, x});
+  CNodePtr call_g2 = f->NewCNode({NewValueNode(g2), x, x});
+  CNodePtr cnode_add = f->NewCNode({NewValueNode(prim::kPrimScalarAdd), call_g1, call_g2});
+  f->set_return(f->NewCNode({NewValueNode(prim::kPrimReturn), cnode_add}));
+
+  auto mng = Manage(f);
+  ASSERT_EQ(2, mng->func_graphs_used_total(f).size());
+  ASSERT_EQ(0, mng->func_graphs_used_total(g1).size());
+  ASSERT_EQ(0, mng->func_graphs_used_total(g2).size());
+  auto recompute_count = mng->analysis_recompute_count();
+
+  // Let g2 call a new graph h, the analyses of g1 stay valid.
+  FuncGraphPtr h = MakeFuncGraph(prim::kPrimScalarMul);
+  auto &g2_params = g2->parameters();
+  CNodePtr call_h = g2->NewCNode({NewValueNode(h), g2_params[0], g2_params[1]});
+  ASSERT_TRUE(mng->Replace(g2->output(), call_h));
+
+  ASSERT_EQ(0, mng->func_graphs_used_total(g1).size());
+  ASSERT_EQ(recompute_count, mng->analysis_recompute_count());
+  ASSERT_EQ(1, mng->func_graphs_used_total(g2).size());
+  ASSERT_EQ(3, mng->func_graphs_used_total(f).size());
+  ASSERT_EQ(recompute_count + 2, mng->analysis_recompute_count());
+}
+
 }  // namespace mindspore
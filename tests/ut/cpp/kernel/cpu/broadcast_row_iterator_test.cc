@@ -0,0 +1,84 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class BroadcastRowIteratorTest : public UT::Common {
+ public:
+  BroadcastRowIteratorTest() {}
+};
+
+namespace {
+// The sizes of the rows that cover the whole output.
+std::vector<size_t> GetRowSizes(const BroadcastRowIterator &iter, size_t output_size) {
+  std::vector<size_t> sizes;
+  iter.ForEachRow(0, output_size, [&sizes](size_t, size_t, size_t, size_t size) { sizes.push_back(size); });
+  return sizes;
+}
+}  // namespace
+
+TEST_F(BroadcastRowIteratorTest, test_rows) {
+  // Axes that broadcast the same way merge, so inputs of the same shape or with a scalar form one row.
+  BroadcastRowIterator same({2, 3}, {2, 3}, {2, 3});
+  EXPECT_EQ(same.row_type(), BroadcastRowIterator::kRowElementwise);
+  EXPECT_EQ(GetRowSizes(same, 6), std::vector<size_t>({6}));
+  BroadcastRowIterator scalar_a({}, {2, 3}, {2, 3});
+  EXPECT_EQ(scalar_a.row_type(), BroadcastRowIterator::kRowScalarA);
+  EXPECT_EQ(GetRowSizes(scalar_a, 6), std::vector<size_t>({6}));
+  BroadcastRowIterator scalar_b({2, 3}, {1}, {2, 3});
+  EXPECT_EQ(scalar_b.row_type(), BroadcastRowIterator::kRowScalarB);
+  EXPECT_EQ(GetRowSizes(scalar_b, 6), std::vector<size_t>({6}));
+  // b repeats along the merged outer axes of size 16.
+  BroadcastRowIterator row_broadcast({8, 2, 3}, {3}, {8, 2, 3});
+  EXPECT_EQ(row_broadcast.row_type(), BroadcastRowIterator::kRowElementwise);
+  EXPECT_EQ(GetRowSizes(row_broadcast, 48), std::vector<size_t>(16, 3));
+  // One element of b per row.
+  BroadcastRowIterator column_broadcast({2, 3, 4}, {2, 3, 1}, {2, 3, 4});
+  EXPECT_EQ(column_broadcast.row_type(), BroadcastRowIterator::kRowScalarB);
+  EXPECT_EQ(GetRowSizes(column_broadcast, 24), std::vector<size_t>(6, 4));
+  BroadcastRowIterator general({2, 1, 4}, {1, 3, 4}, {2, 3, 4});
+  EXPECT_EQ(general.row_type(), BroadcastRowIterator::kRowElementwise);
+  EXPECT_EQ(GetRowSizes(general, 24), std::vector<size_t>(6, 4));
+}
+
+TEST_F(BroadcastRowIteratorTest, test_general_broadcast) {
+  // a[2][1][3] + b[4][1] to out[2][4][3], from a position in the middle of a row.
+  std::vector<float> a{0, 1, 2, 3, 4, 5};
+  std::vector<float> b{0, 10, 20, 30};
+  std::vector<float> out(24, -1);
+  BroadcastRowIterator iter({2, 1, 3}, {4, 1}, {2, 4, 3});
+  iter.ForEachRow(1, 24, [&](size_t pos_a, size_t pos_b, size_t pos, size_t size) {
+    BroadcastRowCompute(a.data() + pos_a, b.data() + pos_b, out.data() + pos, size, iter.row_type(),
+                        [](float x, float y) { return x + y; });
+  });
+  EXPECT_EQ(out[0], -1);
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t k = 0; k < 3; ++k) {
+        size_t pos = (i * 4 + j) * 3 + k;
+        if (pos > 0) {
+          EXPECT_EQ(out[pos], a[i * 3 + k] + b[j]);
+        }
+      }
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/bucket_partition.h"
+
+namespace mindspore {
+namespace kernel {
+class BucketPartitionTest : public UT::Common {
+ public:
+  BucketPartitionTest() {}
+};
+
+TEST_F(BucketPartitionTest, test_unique_many_buckets) {
+  // Keys k * 7919 % 1000 - 500 repeat every 1000 positions, enough keys for many buckets.
+  const size_t key_num = 100000;
+  std::vector<int64_t> keys(key_num);
+  for (size_t i = 0; i < key_num; ++i) {
+    keys[i] = static_cast<int64_t>(i * 7919 % 1000) - 500;
+  }
+  std::vector<int64_t> output(key_num);
+  std::vector<int64_t> inverse(key_num);
+  std::vector<int64_t> workspace(2 * key_num);
+  size_t unique_num = UniqueByBucket(keys.data(), key_num, true, output.data(), inverse.data(), workspace.data());
+  ASSERT_EQ(unique_num, 1000);
+  for (size_t i = 0; i < unique_num; ++i) {
+    EXPECT_EQ(output[i], static_cast<int64_t>(i) - 500);
+  }
+  for (size_t i = 0; i < key_num; ++i) {
+    EXPECT_EQ(output[inverse[i]], keys[i]);
+  }
+
+  unique_num = UniqueByBucket(keys.data(), key_num, false, output.data(), inverse.data(), workspace.data());
+  ASSERT_EQ(unique_num, 1000);
+  for (size_t i = 0; i < unique_num; ++i) {
+    EXPECT_EQ(output[i], keys[i]);
+    EXPECT_EQ(inverse[i + 1000], static_cast<int64_t>(i));
+  }
+}
+
+TEST_F(BucketPartitionTest, test_reduce_sparse) {
+  std::vector<int> indices{3, 0, 3, 9, -1, 0, 3};
+  std::vector<float> values{1, 2, 3, 4, 5, 6, 7};
+  std::vector<int> output_indices(7);
+  std::vector<float> output_values(7);
+  std::vector<int> workspace(7);
+  size_t unique_num = ReduceSparseByBucket(indices.data(), values.data(), indices.size(), 1, 5,
+                                           output_indices.data(), output_values.data(), workspace.data());
+  ASSERT_EQ(unique_num, 2);
+  EXPECT_EQ(output_indices[0], 0);
+  EXPECT_EQ(output_values[0], 8);
+  EXPECT_EQ(output_indices[1], 3);
+  EXPECT_EQ(output_values[1], 11);
+}
+
+TEST_F(BucketPartitionTest, test_segment_sum) {
+  // 50000 rows of 2 with ids i % 20000, the ids 20000 and over are out of the segments.
+  const size_t id_num = 50000;
+  std::vector<int64_t> segment_ids(id_num);
+  std::vector<float> input(2 * id_num);
+  for (size_t i = 0; i < id_num; ++i) {
+    segment_ids[i] = static_cast<int64_t>(i % 20000);
+    input[2 * i] = 1;
+    input[2 * i + 1] = static_cast<float>(i);
+  }
+  segment_ids[1] = 20000;
+  std::vector<float> output(2 * 20000, 0);
+  std::vector<int64_t> workspace(id_num);
+  SegmentSumByBucket(input.data(), segment_ids.data(), id_num, 2, 20000, output.data(), workspace.data());
+  EXPECT_EQ(output[0], 3);
+  EXPECT_EQ(output[1], 0 + 20000 + 40000);
+  EXPECT_EQ(output[2], 2);
+  EXPECT_EQ(output[3], 20001 + 40001);
+  EXPECT_EQ(output[2 * 19999], 2);
+  EXPECT_EQ(output[2 * 19999 + 1], 19999 + 39999);
+}
+}  // namespace kernel
+}  // namespace mindspore
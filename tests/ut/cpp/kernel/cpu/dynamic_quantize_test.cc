@@ -0,0 +1,65 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/dynamic_quantize.h"
+
+namespace mindspore {
+namespace kernel {
+class DynamicQuantizeTest : public UT::Common {
+ public:
+  DynamicQuantizeTest() {}
+};
+
+/// Feature: int8 dynamic quantization
+/// Description: quantize a tensor, and a tensor of zeros
+/// Expectation: the largest magnitude maps to 127, values are rounded, and zeros keep the scale 1
+TEST_F(DynamicQuantizeTest, test_quantize_tensor) {
+  std::vector<float> src = {0.5f, -2.f, 1.f, 0.01f, -1.f};
+  std::vector<int8_t> dst(src.size());
+  float scale = QuantizeTensor(src.data(), src.size(), dst.data());
+  ASSERT_FLOAT_EQ(scale, 63.5f);
+  ASSERT_EQ(dst, std::vector<int8_t>({32, -127, 64, 1, -64}));
+
+  std::vector<float> zeros(3, 0.f);
+  ASSERT_FLOAT_EQ(QuantizeTensor(zeros.data(), zeros.size(), dst.data()), 1.f);
+  ASSERT_EQ(dst[0], 0);
+  ASSERT_EQ(dst[2], 0);
+}
+
+/// Feature: int8 dynamic quantization
+/// Description: quantize the columns of a 2 x 3 matrix, stored as is and transposed
+/// Expectation: each column gets its own scale, and both storages give the same values at the same places
+TEST_F(DynamicQuantizeTest, test_quantize_columns) {
+  // k = 2 rows, n = 3 columns, the last column is all zeros.
+  std::vector<float> src = {1.f, -4.f, 0.f, 0.5f, 2.f, 0.f};
+  std::vector<int8_t> dst(src.size());
+  std::vector<float> scales(3);
+  QuantizeColumns(src.data(), 2, 3, false, dst.data(), &scales);
+  ASSERT_EQ(scales, std::vector<float>({127.f, 31.75f, 1.f}));
+  ASSERT_EQ(dst, std::vector<int8_t>({127, -127, 0, 64, 64, 0}));
+
+  // The same matrix stored as n x k.
+  std::vector<float> trans_src = {1.f, 0.5f, -4.f, 2.f, 0.f, 0.f};
+  std::vector<int8_t> trans_dst(trans_src.size());
+  std::vector<float> trans_scales(3);
+  QuantizeColumns(trans_src.data(), 2, 3, true, trans_dst.data(), &trans_scales);
+  ASSERT_EQ(trans_scales, scales);
+  ASSERT_EQ(trans_dst, std::vector<int8_t>({127, 64, -127, 64, 0, 0}));
+}
+}  // namespace kernel
+}  // namespace mindspore
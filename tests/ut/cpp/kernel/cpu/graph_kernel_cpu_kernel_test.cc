@@ -0,0 +1,294 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "base/core_ops.h"
+#include "base/float16.h"
+#include "ir/tensor.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+#include "runtime/device/kernel_info.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/optimizer/graph_kernel/graph_kernel_cluster.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/graph_kernel_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class GraphKernelCpuKernelTest : public UT::Common {
+ public:
+  GraphKernelCpuKernelTest() : sub_graph_(std::make_shared<FuncGraph>()), main_graph_(std::make_shared<FuncGraph>()) {}
+
+  // A parameter of the sub graph and the node feeding it in the main graph.
+  AnfNodePtr AddInput(const TypePtr &type, const ShapeVector &shape) {
+    auto param = sub_graph_->add_parameter();
+    param->set_abstract(std::make_shared<abstract::AbstractTensor>(type, shape));
+    auto input = main_graph_->add_parameter();
+    input->set_abstract(std::make_shared<abstract::AbstractTensor>(type, shape));
+    KernelBuildInfoBuilder builder;
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({type->type_id()});
+    input->set_kernel_info(std::make_shared<device::KernelInfo>());
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), input.get());
+    inputs_.push_back(input);
+    input_types_.push_back(type->type_id());
+    return param;
+  }
+
+  AnfNodePtr AddOp(const PrimitivePtr &prim, const AnfNodePtrList &inputs, const TypePtr &type,
+                   const ShapeVector &shape) {
+    AnfNodePtrList node_inputs = {NewValueNode(prim)};
+    (void)node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto node = sub_graph_->NewCNode(node_inputs);
+    node->set_abstract(std::make_shared<abstract::AbstractTensor>(type, shape));
+    return node;
+  }
+
+  AnfNodePtr AddReduce(const PrimitivePtr &prim, const AnfNodePtr &input, const std::vector<int64_t> &axis,
+                       const ShapeVector &shape) {
+    auto reduce_prim = std::make_shared<Primitive>(prim->name());
+    reduce_prim->AddAttr(kAttrAxis, MakeValue(axis));
+    return AddOp(reduce_prim, {input}, kFloat32, shape);
+  }
+
+  static AnfNodePtr Scalar(float value) {
+    return NewValueNode(std::make_shared<tensor::Tensor>(static_cast<double>(value), kFloat32));
+  }
+
+  // Wraps the sub graph into a graph kernel node and initializes the kernel, the outputs are returned by the
+  // sub graph in the order given here.
+  void Build(const AnfNodePtrList &outputs, const std::vector<TypeId> &output_types) {
+    AbstractBasePtrList output_abstracts;
+    std::vector<std::string> output_formats;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      auto shape = outputs[i]->abstract()->cast<abstract::AbstractTensorPtr>()->shape()->shape();
+      output_abstracts.push_back(std::make_shared<abstract::AbstractTensor>(TypeIdToType(output_types[i]), shape));
+      output_formats.push_back(kOpFormat_DEFAULT);
+    }
+    if (outputs.size() == 1) {
+      sub_graph_->set_output(outputs[0]);
+    } else {
+      AnfNodePtrList tuple_inputs = {NewValueNode(prim::kPrimMakeTuple)};
+      (void)tuple_inputs.insert(tuple_inputs.end(), outputs.begin(), outputs.end());
+      auto tuple = sub_graph_->NewCNode(tuple_inputs);
+      tuple->set_abstract(std::make_shared<abstract::AbstractTuple>(output_abstracts));
+      sub_graph_->set_output(tuple);
+    }
+
+    AnfNodePtrList kernel_inputs = {NewValueNode(sub_graph_)};
+    (void)kernel_inputs.insert(kernel_inputs.end(), inputs_.begin(), inputs_.end());
+    auto kernel_node = main_graph_->NewCNode(kernel_inputs);
+    if (outputs.size() == 1) {
+      kernel_node->set_abstract(output_abstracts[0]);
+    } else {
+      kernel_node->set_abstract(std::make_shared<abstract::AbstractTuple>(output_abstracts));
+    }
+    KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat(std::vector<std::string>(inputs_.size(), kOpFormat_DEFAULT));
+    builder.SetInputsDeviceType(input_types_);
+    builder.SetOutputsFormat(output_formats);
+    builder.SetOutputsDeviceType(output_types);
+    kernel_node->set_kernel_info(std::make_shared<device::KernelInfo>());
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), kernel_node.get());
+    kernel_->Init(kernel_node);
+  }
+
+  // Runs the kernel once with the given chunk planning, so the chunked path is taken on any machine.
+  void Launch(size_t thread_num, const std::vector<void *> &inputs, const std::vector<void *> &outputs) {
+    kernel_->PlanChunks(thread_num);
+    std::vector<AddressPtr> input_addrs;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      input_addrs.push_back(CreateKernelAddress(inputs[i], kernel_->GetInputSizeList()[i]));
+    }
+    std::vector<AddressPtr> output_addrs;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      output_addrs.push_back(CreateKernelAddress(outputs[i], kernel_->GetOutputSizeList()[i]));
+    }
+    std::vector<AddressPtr> workspace_addrs;
+    const auto &workspace_sizes = kernel_->GetWorkspaceSizeList();
+    std::vector<float> workspace(workspace_sizes.empty() ? 0 : workspace_sizes[0] / sizeof(float));
+    if (!workspace_sizes.empty()) {
+      workspace_addrs.push_back(CreateKernelAddress(workspace.data(), workspace_sizes[0]));
+    }
+    ASSERT_TRUE(kernel_->Launch(input_addrs, workspace_addrs, output_addrs));
+  }
+
+  static AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  static std::vector<float> MakeData(size_t size, float scale) {
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = scale * (static_cast<float>((i * 37) % 101) / 50.0f - 1.0f);
+    }
+    return data;
+  }
+
+  static void ExpectNear(const std::vector<float> &actual, const std::vector<float> &expect) {
+    ASSERT_EQ(actual.size(), expect.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+      ASSERT_NEAR(actual[i], expect[i], 1e-5 * std::max(1.0f, std::fabs(expect[i]))) << "at " << i;
+    }
+  }
+
+  FuncGraphPtr sub_graph_;
+  FuncGraphPtr main_graph_;
+  AnfNodePtrList inputs_;
+  std::vector<TypeId> input_types_;
+  std::shared_ptr<GraphKernelCPUKernel> kernel_ = std::make_shared<GraphKernelCPUKernel>();
+};
+
+/// Feature: cpu graph kernel
+/// Description: run an elementwise chain with a broadcast input and a scalar constant over several chunks and tiles
+/// Expectation: the fused result is the one of running the ops one by one
+TEST_F(GraphKernelCpuKernelTest, test_elementwise_broadcast) {
+  const size_t rows = 4 * 40;
+  const size_t cols = 100;
+  auto x = AddInput(kFloat32, {4, 40, 100});
+  auto y = AddInput(kFloat32, {100});
+  auto mul = AddOp(prim::kPrimMul, {x, y}, kFloat32, {4, 40, 100});
+  auto sub = AddOp(prim::kPrimSub, {mul, Scalar(0.25f)}, kFloat32, {4, 40, 100});
+  auto relu = AddOp(prim::kPrimRelu, {sub}, kFloat32, {4, 40, 100});
+  auto add = AddOp(prim::kPrimAdd, {relu, x}, kFloat32, {4, 40, 100});
+  Build({add}, {kNumberTypeFloat32});
+
+  auto x_data = MakeData(rows * cols, 2.0f);
+  auto y_data = MakeData(cols, 1.5f);
+  std::vector<float> expect(rows * cols);
+  for (size_t i = 0; i < rows * cols; ++i) {
+    float value = x_data[i] * y_data[i % cols] - 0.25f;
+    expect[i] = std::max(value, 0.0f) + x_data[i];
+  }
+  for (size_t thread_num : {1, 3}) {
+    std::vector<float> output(rows * cols, -1.0f);
+    Launch(thread_num, {x_data.data(), y_data.data()}, {output.data()});
+    ExpectNear(output, expect);
+  }
+}
+
+/// Feature: cpu graph kernel
+/// Description: reduce a trailing axis and a non trailing axis in one stage and use a reduce result in the next one
+/// Expectation: the per chunk partials are combined into the results of the unfused reduces
+TEST_F(GraphKernelCpuKernelTest, test_reduce) {
+  const size_t dim0 = 8;
+  const size_t dim1 = 64;
+  const size_t dim2 = 40;
+  auto x = AddInput(kFloat32, {8, 64, 40});
+  auto sum = AddReduce(prim::kPrimReduceSum, x, {-1}, {8, 64});
+  auto max = AddReduce(prim::kPrimReduceMax, x, {1}, {8, 40});
+  auto half = AddOp(prim::kPrimMul, {sum, Scalar(0.5f)}, kFloat32, {8, 64});
+  Build({half, max}, {kNumberTypeFloat32, kNumberTypeFloat32});
+
+  auto x_data = MakeData(dim0 * dim1 * dim2, 3.0f);
+  std::vector<float> expect_half(dim0 * dim1, 0.0f);
+  std::vector<float> expect_max(dim0 * dim2, -std::numeric_limits<float>::infinity());
+  for (size_t i = 0; i < dim0; ++i) {
+    for (size_t j = 0; j < dim1; ++j) {
+      for (size_t k = 0; k < dim2; ++k) {
+        float value = x_data[(i * dim1 + j) * dim2 + k];
+        expect_half[i * dim1 + j] += value;
+        expect_max[i * dim2 + k] = std::max(expect_max[i * dim2 + k], value);
+      }
+    }
+  }
+  for (auto &value : expect_half) {
+    value *= 0.5f;
+  }
+  for (size_t thread_num : {1, 4}) {
+    std::vector<float> output_half(dim0 * dim1, -1.0f);
+    std::vector<float> output_max(dim0 * dim2, -1.0f);
+    Launch(thread_num, {x_data.data()}, {output_half.data(), output_max.data()});
+    ExpectNear(output_half, expect_half);
+    ASSERT_EQ(output_max, expect_max);
+  }
+}
+
+/// Feature: cpu graph kernel
+/// Description: return a float32 value and its float16 cast from a float16 input
+/// Expectation: both outputs are written, the float16 output holds the rounded values
+TEST_F(GraphKernelCpuKernelTest, test_multi_output_cast) {
+  const size_t size = 20000;
+  auto x = AddInput(kFloat16, {20000});
+  auto square = AddOp(prim::kPrimMul, {x, x}, kFloat32, {20000});
+  auto add = AddOp(prim::kPrimAdd, {square, Scalar(1.0f)}, kFloat32, {20000});
+  auto cast = AddOp(prim::kPrimCast, {add}, kFloat16, {20000});
+  Build({add, cast}, {kNumberTypeFloat32, kNumberTypeFloat16});
+
+  auto data = MakeData(size, 4.0f);
+  std::vector<float16> x_data(size);
+  std::vector<float> expect_add(size);
+  std::vector<float16> expect_cast(size);
+  for (size_t i = 0; i < size; ++i) {
+    x_data[i] = float16(data[i]);
+    float value = static_cast<float>(x_data[i]);
+    expect_add[i] = value * value + 1.0f;
+    expect_cast[i] = float16(expect_add[i]);
+  }
+  for (size_t thread_num : {1, 2}) {
+    std::vector<float> output_add(size, -1.0f);
+    std::vector<float16> output_cast(size, float16(-1.0f));
+    Launch(thread_num, {x_data.data()}, {output_add.data(), output_cast.data()});
+    ExpectNear(output_add, expect_add);
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_EQ(static_cast<float>(output_cast[i]), static_cast<float>(expect_cast[i])) << "at " << i;
+    }
+  }
+}
+
+/// Feature: graph kernel cluster on cpu
+/// Description: check whether an Add with a scalar constant and an Add with a tensor constant can be clustered
+/// Expectation: only the Add with the scalar constant is clusterable, the interpreter folds constants into scalars
+TEST_F(GraphKernelCpuKernelTest, test_cluster_tensor_const) {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto device_target = context->get_param<std::string>(MS_CTX_DEVICE_TARGET);
+  context->set_param<std::string>(MS_CTX_DEVICE_TARGET, kCPUDevice);
+  auto x = AddInput(kFloat32, {4});
+  auto new_add = [this, &x](const AnfNodePtr &constant) {
+    auto add = AddOp(prim::kPrimAdd, {x, constant}, kFloat32, {4});
+    KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat({kOpFormat_DEFAULT, kOpFormat_DEFAULT});
+    builder.SetInputsDeviceType({kNumberTypeFloat32, kNumberTypeFloat32});
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({kNumberTypeFloat32});
+    builder.SetProcessor(kernel::Processor::AICORE);
+    add->set_kernel_info(std::make_shared<device::KernelInfo>());
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), add.get());
+    return add;
+  };
+  std::vector<float> bias = {1.0f, 2.0f, 3.0f, 4.0f};
+  auto tensor_const =
+    NewValueNode(std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{4}, bias.data(), sizeof(float) * 4));
+  EXPECT_TRUE(opt::IsClusterableOp(new_add(Scalar(1.0f))));
+  EXPECT_FALSE(opt::IsClusterableOp(new_add(tensor_const)));
+  context->set_param<std::string>(MS_CTX_DEVICE_TARGET, device_target);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/lookup_engine.h"
+
+namespace mindspore {
+namespace kernel {
+class LookupEngineTest : public UT::Common {
+ public:
+  LookupEngineTest() {}
+};
+
+TEST_F(LookupEngineTest, test_gather_outer_rows) {
+  // x[o][r][c] = o * 100 + r * 10 + c, gathered on the middle axis with a negative and a repeated index.
+  std::vector<float> x;
+  for (size_t o = 0; o < 2; ++o) {
+    for (size_t r = 0; r < 4; ++r) {
+      for (size_t c = 0; c < 3; ++c) {
+        x.emplace_back(o * 100 + r * 10 + c);
+      }
+    }
+  }
+  std::vector<int32_t> indices{3, -1, 0, 3};
+  std::vector<int32_t> rows{3, 3, 0, 3};
+  LookupEngine engine;
+  engine.Init(2, 4, 3 * sizeof(float), false);
+  std::vector<float> y(2 * 4 * 3);
+  ASSERT_TRUE(engine.Lookup(x.data(), indices.data(), indices.size(), 0, y.data()));
+  for (size_t o = 0; o < 2; ++o) {
+    for (size_t i = 0; i < 4; ++i) {
+      for (size_t c = 0; c < 3; ++c) {
+        EXPECT_EQ(y[(o * 4 + i) * 3 + c], o * 100 + rows[i] * 10 + c);
+      }
+    }
+  }
+
+  indices[1] = 4;
+  EXPECT_FALSE(engine.Lookup(x.data(), indices.data(), indices.size(), 0, y.data()));
+}
+
+TEST_F(LookupEngineTest, test_embedding_large_table) {
+  // A table above the sort threshold, the indices are shifted by the offset and the invalid ones give zeros.
+  const size_t table_rows = 600000;
+  const size_t cols = 16;
+  std::vector<float> table(table_rows * cols);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i / cols);
+  }
+  std::vector<int64_t> indices{599999 + 5, 5, 7, 599999 + 5, 3, 1000 + 5};
+  LookupEngine engine;
+  engine.Init(1, table_rows, cols * sizeof(float), true);
+  std::vector<float> y(indices.size() * cols);
+  ASSERT_TRUE(engine.Lookup(table.data(), indices.data(), indices.size(), static_cast<int64_t>(5), y.data()));
+  std::vector<float> expect{599999, 0, 2, 599999, 0, 1000};
+  for (size_t i = 0; i < indices.size(); ++i) {
+    for (size_t c = 0; c < cols; ++c) {
+      EXPECT_EQ(y[i * cols + c], expect[i]);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/multi_tensor_optimizer_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class MultiTensorOptimizerCpuKernelTest : public UT::Common {
+ public:
+  MultiTensorOptimizerCpuKernelTest() : optimizer_(std::make_shared<MultiTensorOptimizerCPUKernel>()) {}
+
+  void SetUp() override {
+    tensors_.clear();
+    inputs_.clear();
+    workspace_.clear();
+    outputs_.clear();
+  }
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  // Tensors of the given size filled with values depending on the tensor and the element, they are kept alive
+  // by the fixture and added to the inputs.
+  std::vector<float> &AddTensor(size_t size, float scale) {
+    tensors_.emplace_back(std::make_shared<std::vector<float>>(size));
+    auto &tensor = *tensors_.back();
+    for (size_t i = 0; i < size; ++i) {
+      tensor[i] = scale * (0.5f + static_cast<float>(i % 7) / 7);
+    }
+    inputs_.push_back(CreateKernelAddress(tensor.data(), size * sizeof(float)));
+    return tensor;
+  }
+
+  void AddScalar(float *scalar) { inputs_.push_back(CreateKernelAddress(scalar, sizeof(float))); }
+
+  // Sizes across the parallel blocks of the flattened list, with an empty tensor.
+  std::vector<size_t> sizes_{3, 40000, 0, 17, 25000};
+  std::vector<std::shared_ptr<std::vector<float>>> tensors_;
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<MultiTensorOptimizerCPUKernel> optimizer_;
+  float beta1_power_ = 0.9;
+  float beta2_power_ = 0.999;
+  float lr_ = 0.001;
+  float beta1_ = 0.9;
+  float beta2_ = 0.999;
+  float epsilon_ = 1e-8;
+  float decay_ = 0.01;
+  float momentum_ = 0.9;
+};
+
+TEST_F(MultiTensorOptimizerCpuKernelTest, test_adam) {
+  std::vector<std::vector<float>> expects;
+  for (size_t t = 0; t < sizes_.size(); ++t) {
+    auto &var = AddTensor(sizes_[t], 1.0f + t);
+    auto &m = AddTensor(sizes_[t], 0.1f);
+    auto &v = AddTensor(sizes_[t], 0.2f);
+    AddScalar(&beta1_power_);
+    AddScalar(&beta2_power_);
+    AddScalar(&lr_);
+    AddScalar(&beta1_);
+    AddScalar(&beta2_);
+    AddScalar(&epsilon_);
+    auto &grad = AddTensor(sizes_[t], 0.3f * (t + 1));
+    float new_lr = lr_ * std::sqrt(1 - beta2_power_) / (1 - beta1_power_);
+    std::vector<float> expect(sizes_[t]);
+    for (size_t i = 0; i < sizes_[t]; ++i) {
+      float m_t = m[i] + (grad[i] - m[i]) * (1 - beta1_);
+      float v_t = v[i] + (grad[i] * grad[i] - v[i]) * (1 - beta2_);
+      expect[i] = var[i] - new_lr * m_t / (std::sqrt(v_t) + epsilon_);
+    }
+    expects.emplace_back(expect);
+  }
+  optimizer_->InitTensors(MultiTensorOptimizerType::kAdam, sizes_);
+  optimizer_->Launch(inputs_, workspace_, outputs_);
+  for (size_t t = 0; t < sizes_.size(); ++t) {
+    auto &var = *tensors_[t * 4];
+    for (size_t i = 0; i < sizes_[t]; ++i) {
+      EXPECT_TRUE(std::fabs(var[i] - expects[t][i]) < 1e-5);
+    }
+  }
+}
+
+TEST_F(MultiTensorOptimizerCpuKernelTest, test_adam_weight_decay) {
+  std::vector<std::vector<float>> expects;
+  for (size_t t = 0; t < sizes_.size(); ++t) {
+    auto &var = AddTensor(sizes_[t], 1.0f + t);
+    auto &m = AddTensor(sizes_[t], 0.1f);
+    auto &v = AddTensor(sizes_[t], 0.2f);
+    AddScalar(&lr_);
+    AddScalar(&beta1_);
+    AddScalar(&beta2_);
+    AddScalar(&epsilon_);
+    AddScalar(&decay_);
+    auto &grad = AddTensor(sizes_[t], 0.3f * (t + 1));
+    std::vector<float> expect(sizes_[t]);
+    for (size_t i = 0; i < sizes_[t]; ++i) {
+      float m_t = m[i] + (grad[i] - m[i]) * (1 - beta1_);
+      float v_t = v[i] + (grad[i] * grad[i] - v[i]) * (1 - beta2_);
+      float update = m_t / (std::sqrt(v_t) + epsilon_) + decay_ * var[i];
+      expect[i] = var[i] - lr_ * update;
+    }
+    expects.emplace_back(expect);
+  }
+  optimizer_->InitTensors(MultiTensorOptimizerType::kAdamWeightDecay, sizes_);
+  optimizer_->Launch(inputs_, workspace_, outputs_);
+  for (size_t t = 0; t < sizes_.size(); ++t) {
+    auto &var = *tensors_[t * 4];
+    for (size_t i = 0; i < sizes_[t]; ++i) {
+      EXPECT_TRUE(std::fabs(var[i] - expects[t][i]) < 1e-5);
+    }
+  }
+}
+
+TEST_F(MultiTensorOptimizerCpuKernelTest, test_apply_momentum) {
+  std::vector<std::vector<float>> expects;
+  for (size_t t = 0; t < sizes_.size(); ++t) {
+    auto &var = AddTensor(sizes_[t], 1.0f + t);
+    auto &accum = AddTensor(sizes_[t], 0.1f);
+    AddScalar(&lr_);
+    auto &grad = AddTensor(sizes_[t], 0.3f * (t + 1));
+    AddScalar(&momentum_);
+    std::vector<float> expect(sizes_[t]);
+    for (size_t i = 0; i < sizes_[t]; ++i) {
+      expect[i] = var[i] - (accum[i] * momentum_ + grad[i]) * lr_;
+    }
+    expects.emplace_back(expect);
+  }
+  optimizer_->InitTensors(MultiTensorOptimizerType::kApplyMomentum, sizes_);
+  optimizer_->Launch(inputs_, workspace_, outputs_);
+  for (size_t t = 0; t < sizes_.size(); ++t) {
+    auto &var = *tensors_[t * 3];
+    for (size_t i = 0; i < sizes_[t]; ++i) {
+      EXPECT_TRUE(std::fabs(var[i] - expects[t][i]) < 1e-6);
+    }
+  }
+}
+
+TEST_F(MultiTensorOptimizerCpuKernelTest, test_input_size_mismatch) {
+  for (size_t t = 0; t < 2; ++t) {
+    AddTensor(sizes_[t], 1.0f);
+    AddTensor(sizes_[t], 0.1f);
+    AddScalar(&lr_);
+    AddTensor(sizes_[t], 0.3f);
+    AddScalar(&momentum_);
+  }
+  // The second tensor is declared one element larger than its inputs.
+  optimizer_->InitTensors(MultiTensorOptimizerType::kApplyMomentum, {sizes_[0], sizes_[1] + 1});
+  EXPECT_ANY_THROW(optimizer_->Launch(inputs_, workspace_, outputs_));
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/reduce_engine.h"
+
+namespace mindspore {
+namespace kernel {
+class ReduceEngineTest : public UT::Common {
+ public:
+  ReduceEngineTest() {}
+};
+
+TEST_F(ReduceEngineTest, test_reduce_middle_axes) {
+  // x[n][c][h][w] = n * 1000 + c * 100 + h * 10 + w, reduced over c and w.
+  std::vector<size_t> shape{2, 3, 4, 5};
+  std::vector<float> x;
+  for (size_t n = 0; n < 2; ++n) {
+    for (size_t c = 0; c < 3; ++c) {
+      for (size_t h = 0; h < 4; ++h) {
+        for (size_t w = 0; w < 5; ++w) {
+          x.emplace_back(n * 1000 + c * 100 + h * 10 + w);
+        }
+      }
+    }
+  }
+  ReduceEngine<float> engine;
+  engine.Init(shape, {1, 3}, ReduceOpType::kSum);
+  std::vector<float> workspace(engine.GetWorkspaceSize() / sizeof(float) + 1);
+  std::vector<float> y(8);
+  engine.Execute(x.data(), y.data(), workspace.data());
+  for (size_t n = 0; n < 2; ++n) {
+    for (size_t h = 0; h < 4; ++h) {
+      EXPECT_EQ(y[n * 4 + h], 15 * (n * 1000 + h * 10) + 5 * 300 + 3 * 10);
+    }
+  }
+
+  engine.Init(shape, {1, 3}, ReduceOpType::kMax);
+  engine.Execute(x.data(), y.data(), workspace.data());
+  for (size_t n = 0; n < 2; ++n) {
+    for (size_t h = 0; h < 4; ++h) {
+      EXPECT_EQ(y[n * 4 + h], n * 1000 + 200 + h * 10 + 4);
+    }
+  }
+}
+
+TEST_F(ReduceEngineTest, test_reduce_long_axis) {
+  std::vector<size_t> shape{100000, 3};
+  std::vector<int32_t> x(300000);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<int32_t>(i % 3) - 1;
+  }
+  ReduceEngine<int32_t> engine;
+  engine.Init(shape, {0}, ReduceOpType::kMean);
+  std::vector<int32_t> workspace(engine.GetWorkspaceSize() / sizeof(int32_t) + 1);
+  std::vector<int32_t> y(3);
+  engine.Execute(x.data(), y.data(), workspace.data());
+  EXPECT_EQ(y[0], -1);
+  EXPECT_EQ(y[1], 0);
+  EXPECT_EQ(y[2], 1);
+}
+}  // namespace kernel
+}  // namespace mindspore
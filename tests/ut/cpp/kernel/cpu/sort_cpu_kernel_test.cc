@@ -0,0 +1,150 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/sort_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr float kNan = std::numeric_limits<float>::quiet_NaN();
+
+AddressPtr CreateKernelAddress(void *addr, size_t size) {
+  auto kernel_addr = std::make_shared<Address>();
+  kernel_addr->addr = addr;
+  kernel_addr->size = size;
+  return kernel_addr;
+}
+
+// Values with many ties, every fifth of them NaN.
+std::vector<float> MakeRow(size_t size) {
+  std::vector<float> row(size);
+  for (size_t i = 0; i < size; ++i) {
+    row[i] = i % 5 == 3 ? kNan : static_cast<float>((i * 7) % 4);
+  }
+  return row;
+}
+
+// The indices of a stable sort of the row, NaN being greater than every number.
+std::vector<int> StableOrder(const std::vector<float> &row, bool descending) {
+  std::vector<int> numbers;
+  std::vector<int> nans;
+  for (size_t i = 0; i < row.size(); ++i) {
+    (std::isnan(row[i]) ? nans : numbers).push_back(static_cast<int>(i));
+  }
+  std::stable_sort(numbers.begin(), numbers.end(), [&row, descending](int a, int b) {
+    return descending ? row[a] > row[b] : row[a] < row[b];
+  });
+  std::vector<int> order = descending ? nans : numbers;
+  const auto &tail = descending ? numbers : nans;
+  (void)order.insert(order.end(), tail.begin(), tail.end());
+  return order;
+}
+
+bool SameValue(float a, float b) { return (std::isnan(a) && std::isnan(b)) || a == b; }
+}  // namespace
+
+class SortCpuKernelTest : public UT::Common {
+ public:
+  SortCpuKernelTest() {}
+
+  // Sort a (2, axis_size, 3) tensor along axis 1 and compare every row with a stable sort.
+  void CheckSort(size_t axis_size, bool descending) {
+    constexpr size_t kOuterSize = 2;
+    constexpr size_t kInnerSize = 3;
+    SortCpuKernel<float> sort;
+    sort.outer_size_ = kOuterSize;
+    sort.axis_size_ = axis_size;
+    sort.inner_size_ = kInnerSize;
+    sort.descending_ = descending;
+    sort.task_num_ = 2;
+    std::vector<std::vector<float>> rows;
+    std::vector<float> input(kOuterSize * axis_size * kInnerSize);
+    for (size_t i = 0; i < kOuterSize; ++i) {
+      for (size_t j = 0; j < kInnerSize; ++j) {
+        auto row = MakeRow(axis_size + i + j);
+        row.resize(axis_size);
+        std::reverse(row.begin() + static_cast<std::ptrdiff_t>(j), row.end());
+        for (size_t k = 0; k < axis_size; ++k) {
+          input[(i * axis_size + k) * kInnerSize + j] = row[k];
+        }
+        rows.push_back(row);
+      }
+    }
+    std::vector<float> output(input.size());
+    std::vector<int> indices(input.size());
+    std::vector<SortCpuKernel<float>::SortElement> scratch(sort.task_num_ * axis_size);
+    std::vector<AddressPtr> inputs = {CreateKernelAddress(input.data(), input.size() * sizeof(float))};
+    std::vector<AddressPtr> workspace = {
+      CreateKernelAddress(scratch.data(), scratch.size() * sizeof(SortCpuKernel<float>::SortElement))};
+    std::vector<AddressPtr> outputs = {CreateKernelAddress(output.data(), output.size() * sizeof(float)),
+                                       CreateKernelAddress(indices.data(), indices.size() * sizeof(int))};
+    ASSERT_TRUE(sort.Launch(inputs, workspace, outputs));
+    for (size_t i = 0; i < kOuterSize; ++i) {
+      for (size_t j = 0; j < kInnerSize; ++j) {
+        const auto &row = rows[i * kInnerSize + j];
+        auto order = StableOrder(row, descending);
+        for (size_t k = 0; k < axis_size; ++k) {
+          size_t offset = (i * axis_size + k) * kInnerSize + j;
+          ASSERT_EQ(indices[offset], order[k]);
+          ASSERT_TRUE(SameValue(output[offset], row[order[k]]));
+        }
+      }
+    }
+  }
+};
+
+/// Feature: Sort cpu kernel
+/// Description: sort rows with ties and NaN no longer than the insertion sort threshold and longer than it
+/// Expectation: both paths return the order of a stable sort where NaN is the greatest value
+TEST_F(SortCpuKernelTest, test_sort_insertion_and_std_sort) {
+  for (size_t axis_size : {1, 2, 15, 16, 17, 100}) {
+    CheckSort(axis_size, false);
+    CheckSort(axis_size, true);
+  }
+}
+
+/// Feature: Sort cpu kernel
+/// Description: sort a row of NaN only
+/// Expectation: the indices keep their order
+TEST_F(SortCpuKernelTest, test_sort_all_nan) {
+  SortCpuKernel<float> sort;
+  sort.axis_size_ = 20;
+  sort.descending_ = true;
+  std::vector<float> input(sort.axis_size_, kNan);
+  std::vector<float> output(input.size());
+  std::vector<int> indices(input.size());
+  std::vector<SortCpuKernel<float>::SortElement> scratch(input.size());
+  std::vector<AddressPtr> inputs = {CreateKernelAddress(input.data(), input.size() * sizeof(float))};
+  std::vector<AddressPtr> workspace = {
+    CreateKernelAddress(scratch.data(), scratch.size() * sizeof(SortCpuKernel<float>::SortElement))};
+  std::vector<AddressPtr> outputs = {CreateKernelAddress(output.data(), output.size() * sizeof(float)),
+                                     CreateKernelAddress(indices.data(), indices.size() * sizeof(int))};
+  ASSERT_TRUE(sort.Launch(inputs, workspace, outputs));
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(indices[i], static_cast<int>(i));
+    ASSERT_TRUE(std::isnan(output[i]));
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -59,11 +59,9 @@ class SparseApplyAdamCpuKernelTest : public UT::Common {
   }
 
   void CreateWorkspaceAddress(std::vector<float> &new_grad, std::vector<int64_t> &new_indices,
-                              std::vector<float> &tmp_grad, std::vector<int64_t> &tmp_indices,
-                              std::vector<float> &m_t) {
+                              std::vector<int64_t> &tmp_indices, std::vector<float> &m_t) {
     workspace_.push_back(CreateKernelAddress(new_grad.data()));
     workspace_.push_back(CreateKernelAddress(new_indices.data()));
-    workspace_.push_back(CreateKernelAddress(tmp_grad.data()));
     workspace_.push_back(CreateKernelAddress(tmp_indices.data()));
     workspace_.push_back(CreateKernelAddress(m_t.data()));
   }
@@ -100,10 +98,9 @@ TEST_F(SparseApplyAdamCpuKernelTest, dense_test) {
   CreateInputAddress(indices);
   std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
   std::vector<float> m_t(3 * 3 * 3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices, m_t);
+  CreateWorkspaceAddress(new_grad, new_indices, tmp_indices, m_t);
   sparse_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999684) < 1e-6);
@@ -128,10 +125,9 @@ TEST_F(SparseApplyAdamCpuKernelTest, sparse_test1) {
   CreateInputAddress(indices);
   std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
   std::vector<float> m_t(3 * 3 * 3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices, m_t);
+  CreateWorkspaceAddress(new_grad, new_indices, tmp_indices, m_t);
   sparse_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999684) < 1e-6);
@@ -160,10 +156,9 @@ TEST_F(SparseApplyAdamCpuKernelTest, sparse_test2) {
   CreateInputAddress(indices);
   std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
   std::vector<float> m_t(3 * 3 * 3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices, m_t);
+  CreateWorkspaceAddress(new_grad, new_indices, tmp_indices, m_t);
   sparse_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999715) < 1e-6);
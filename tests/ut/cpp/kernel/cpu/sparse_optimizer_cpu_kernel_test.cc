@@ -49,15 +49,13 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient1) {
   std::vector<int> unique_indices(6);
   std::vector<float> summed_grad(12);
   std::vector<int> tmp_indices(6);
-  std::vector<float> tmp_grad(12);
 
   SparseGradient<int> unique_grad({summed_grad.data(), unique_indices.data(), 6});
-  SparseGradient<int> workspace_grad({tmp_grad.data(), tmp_indices.data(), 6});
   SparseGradient<int> input_grad({grad.data(), indices.data(), 6});
 
   ReduceSparseGradientParam<int> param;
   param.input_grad_ = &input_grad;
-  param.workspace_grad_ = &workspace_grad;
+  param.workspace_indices_ = tmp_indices.data();
   param.output_grad_ = &unique_grad;
   param.max_index_ = 6;
   param.value_stride_ = 2;
@@ -102,14 +100,12 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
   std::vector<int> unique_indices(6);
   std::vector<float> summed_grad(12);
   std::vector<int> tmp_indices(6);
-  std::vector<float> tmp_grad(12);
   SparseGradient<int> unique_grad({summed_grad.data(), unique_indices.data(), 6});
-  SparseGradient<int> workspace_grad({tmp_grad.data(), tmp_indices.data(), 6});
   SparseGradient<int> input_grad({grad.data(), indices.data(), 6});
 
   ReduceSparseGradientParam<int> param;
   param.input_grad_ = &input_grad;
-  param.workspace_grad_ = &workspace_grad;
+  param.workspace_indices_ = tmp_indices.data();
   param.output_grad_ = &unique_grad;
   param.max_index_ = 6;
   param.value_stride_ = 2;
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/topk_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr float kNan = std::numeric_limits<float>::quiet_NaN();
+
+AddressPtr CreateKernelAddress(void *addr, size_t size) {
+  auto kernel_addr = std::make_shared<Address>();
+  kernel_addr->addr = addr;
+  kernel_addr->size = size;
+  return kernel_addr;
+}
+
+// Values with many ties, every fifth of them NaN.
+std::vector<float> MakeRow(size_t size) {
+  std::vector<float> row(size);
+  for (size_t i = 0; i < size; ++i) {
+    row[i] = i % 5 == 3 ? kNan : static_cast<float>((i * 7) % 4);
+  }
+  return row;
+}
+
+// The indices of a stable sort of the row, NaN being greater than every number.
+std::vector<int> StableOrder(const std::vector<float> &row, bool descending) {
+  std::vector<int> numbers;
+  std::vector<int> nans;
+  for (size_t i = 0; i < row.size(); ++i) {
+    (std::isnan(row[i]) ? nans : numbers).push_back(static_cast<int>(i));
+  }
+  std::stable_sort(numbers.begin(), numbers.end(), [&row, descending](int a, int b) {
+    return descending ? row[a] > row[b] : row[a] < row[b];
+  });
+  std::vector<int> order = descending ? nans : numbers;
+  const auto &tail = descending ? numbers : nans;
+  (void)order.insert(order.end(), tail.begin(), tail.end());
+  return order;
+}
+
+bool SameValue(float a, float b) { return (std::isnan(a) && std::isnan(b)) || a == b; }
+}  // namespace
+
+class TopKCpuKernelTest : public UT::Common {
+ public:
+  TopKCpuKernelTest() {}
+
+  // TopK of two rows, compared with the head of a stable descending sort.
+  void CheckTopK(size_t row_size, int k, bool sorted) {
+    constexpr size_t kRowNum = 2;
+    TopKCPUKernel topk;
+    topk.outer_size_ = kRowNum;
+    topk.inner_size_ = row_size;
+    topk.sorted_ = sorted;
+    topk.dtype_ = kNumberTypeFloat32;
+    topk.task_num_ = kRowNum;
+    topk.scratch_size_ = std::max(row_size * sizeof(int), 128 * 2 * sizeof(float));
+    std::vector<std::vector<float>> rows = {MakeRow(row_size), MakeRow(row_size)};
+    std::reverse(rows[1].begin(), rows[1].end());
+    std::vector<float> input;
+    for (const auto &row : rows) {
+      (void)input.insert(input.end(), row.begin(), row.end());
+    }
+    size_t k_num = std::min<size_t>(row_size, IntToSize(k));
+    std::vector<float> output(kRowNum * k_num);
+    std::vector<int> indices(kRowNum * k_num);
+    std::vector<uint8_t> scratch(topk.task_num_ * topk.scratch_size_);
+    std::vector<AddressPtr> inputs = {CreateKernelAddress(input.data(), input.size() * sizeof(float)),
+                                      CreateKernelAddress(&k, sizeof(int))};
+    std::vector<AddressPtr> workspace = {CreateKernelAddress(scratch.data(), scratch.size())};
+    std::vector<AddressPtr> outputs = {CreateKernelAddress(output.data(), output.size() * sizeof(float)),
+                                       CreateKernelAddress(indices.data(), indices.size() * sizeof(int))};
+    ASSERT_TRUE(topk.Launch(inputs, workspace, outputs));
+    for (size_t i = 0; i < kRowNum; ++i) {
+      auto order = StableOrder(rows[i], true);
+      std::vector<int> expect_indices(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(k_num));
+      std::vector<int> row_indices(indices.begin() + static_cast<std::ptrdiff_t>(i * k_num),
+                                   indices.begin() + static_cast<std::ptrdiff_t>((i + 1) * k_num));
+      if (!sorted) {
+        std::sort(expect_indices.begin(), expect_indices.end());
+        std::sort(row_indices.begin(), row_indices.end());
+      }
+      ASSERT_EQ(row_indices, expect_indices);
+      for (size_t j = 0; j < k_num; ++j) {
+        ASSERT_TRUE(SameValue(output[i * k_num + j], rows[i][indices[i * k_num + j]]));
+      }
+    }
+  }
+};
+/// Feature: TopK cpu kernel
+/// Description: select a few elements of rows with ties and NaN by the heap
+/// Expectation: NaN ranks first, equal values keep the index order
+TEST_F(TopKCpuKernelTest, test_topk_heap) {
+  CheckTopK(100, 5, true);
+  CheckTopK(100, 12, true);
+}
+
+/// Feature: TopK cpu kernel
+/// Description: select many elements of rows with ties and NaN by nth_element, sorted or not, or sort the whole row
+/// Expectation: the selected elements are the first ones of a stable descending sort where NaN is the greatest
+TEST_F(TopKCpuKernelTest, test_topk_select_and_sort) {
+  CheckTopK(100, 40, true);
+  CheckTopK(100, 40, false);
+  CheckTopK(100, 80, true);
+}
+
+/// Feature: TopK cpu kernel
+/// Description: k equals the row size or exceeds it
+/// Expectation: the whole rows are returned in the stable descending order
+TEST_F(TopKCpuKernelTest, test_topk_whole_row) {
+  CheckTopK(100, 100, true);
+  CheckTopK(7, 7, true);
+  CheckTopK(7, 9, true);
+}
+}  // namespace kernel
+}  // namespace mindspore
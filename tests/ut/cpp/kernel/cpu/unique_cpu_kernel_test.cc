@@ -47,8 +47,6 @@ class UniqueCpuKernelTest : public UT::Common {
     outputs_.push_back(CreateKernelAddress(y_.data()));
     outputs_.push_back(CreateKernelAddress(idx_.data()));
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
-    workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
-    workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
   }
 
   std::vector<float> x_;
@@ -65,7 +63,7 @@ TEST_F(UniqueCpuKernelTest, compute_test) {
   x_ = {1, 1, 2, 4, 4, 4, 7, 8, 8};
   y_ = {1, 1, 1, 1, 1};
   idx_ = {1, 1, 1, 1, 1, 1, 1, 1, 1};
-  workspace_idx_ = {1, 1, 1, 1, 1, 1, 1, 1, 1};
+  workspace_idx_ = std::vector<int64_t>(18, 1);
   CreateAddress();
   unique_->Launch(inputs_, workspace_, outputs_);
 
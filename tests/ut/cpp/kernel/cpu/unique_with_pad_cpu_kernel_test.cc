@@ -48,8 +48,6 @@ class UniqueWithPadCpuKernelTest : public UT::Common {
     outputs_.push_back(CreateKernelAddress(out_.data()));
     outputs_.push_back(CreateKernelAddress(idx_.data()));
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
-    workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
-    workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
   }
 
   std::vector<int64_t> x_;
@@ -68,7 +66,7 @@ TEST_F(UniqueWithPadCpuKernelTest, compute_test) {
   pad_dim_ = 8;
   out_ = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
   idx_ = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
-  workspace_idx_ = {1, 1, 1, 1, 1, 1, 1, 1, 1};
+  workspace_idx_ = std::vector<int64_t>(20, 1);
   CreateAddress();
   unique_with_pad_->Launch(inputs_, workspace_, outputs_);
 
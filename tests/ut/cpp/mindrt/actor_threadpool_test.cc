@@ -0,0 +1,167 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "actor/actor.h"
+#include "actor/actormgr.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+
+namespace mindspore {
+namespace {
+constexpr auto kWaitTime = std::chrono::seconds(10);
+
+// Names of the actors in the order they ran.
+class RunRecord {
+ public:
+  void Add(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    names_.push_back(name);
+    cond_.notify_all();
+  }
+  std::vector<std::string> WaitFor(size_t num) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    (void)cond_.wait_for(lock, kWaitTime, [this, num]() { return names_.size() >= num; });
+    return names_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<std::string> names_;
+};
+
+// Waits in its run until the given number of actors run at the same time, so it only finishes in time when the other
+// ones run on other threads.
+class Rendezvous {
+ public:
+  explicit Rendezvous(size_t num) : num_(num) {}
+  bool Arrive() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++arrived_;
+    cond_.notify_all();
+    return cond_.wait_for(lock, kWaitTime, [this]() { return arrived_ >= num_; });
+  }
+
+ private:
+  size_t num_;
+  size_t arrived_{0};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+};
+
+class TargetActor : public ActorBase {
+ public:
+  TargetActor(const std::string &name, ActorThreadPool *pool, RunRecord *record, Rendezvous *rendezvous)
+      : ActorBase(name, pool), record_(record), rendezvous_(rendezvous) {}
+  ~TargetActor() override = default;
+
+  void Record() {
+    if (rendezvous_ != nullptr && !rendezvous_->Arrive()) {
+      return;
+    }
+    record_->Add(GetAID().Name());
+  }
+
+ private:
+  RunRecord *record_;
+  Rendezvous *rendezvous_;
+};
+
+// Makes the targets ready from an actor thread, so they go to the run queue of that thread.
+class SourceActor : public ActorBase {
+ public:
+  SourceActor(const std::string &name, ActorThreadPool *pool) : ActorBase(name, pool) {}
+  ~SourceActor() override = default;
+
+  void Trigger(const std::vector<AID> &targets) {
+    for (const auto &target : targets) {
+      Async(target, &TargetActor::Record);
+    }
+  }
+};
+}  // namespace
+
+class TestActorThreadPool : public UT::Common {
+ public:
+  TestActorThreadPool() {}
+  void TearDown() override {
+    for (const auto &actor : actors_) {
+      ActorMgr::GetActorMgrRef()->Terminate(actor->GetAID());
+      ActorMgr::GetActorMgrRef()->Wait(actor->GetAID());
+    }
+    actors_.clear();
+    delete pool_;
+    pool_ = nullptr;
+  }
+
+ protected:
+  template <typename T, typename... Args>
+  AID SpawnActor(const std::string &name, Args &&... args) {
+    auto actor = std::make_shared<T>(name, pool_, std::forward<Args>(args)...);
+    actors_.push_back(actor);
+    return ActorMgr::GetActorMgrRef()->Spawn(actor);
+  }
+
+  ActorThreadPool *pool_{nullptr};
+  std::vector<ActorReference> actors_;
+};
+
+/// Feature: actor thread pool
+/// Description: an actor on the only actor thread makes three actors of different priorities ready at once
+/// Expectation: they run from the highest priority to the lowest, whatever the order they were made ready in
+TEST_F(TestActorThreadPool, test_priority_order) {
+  pool_ = ActorThreadPool::CreateThreadPool(1);
+  ASSERT_NE(pool_, nullptr);
+  RunRecord record;
+  std::vector<AID> targets;
+  for (int priority : {1, 3, 2}) {
+    auto name = "priority_target_" + std::to_string(priority);
+    targets.push_back(SpawnActor<TargetActor>(name, &record, nullptr));
+    actors_.back()->set_priority(priority);
+  }
+  auto source = SpawnActor<SourceActor>("priority_source");
+  Async(source, &SourceActor::Trigger, targets);
+  auto names = record.WaitFor(targets.size());
+  ASSERT_EQ(names, std::vector<std::string>({"priority_target_3", "priority_target_2", "priority_target_1"}));
+}
+
+/// Feature: actor thread pool
+/// Description: an actor on an actor thread makes two actors ready, each runs until both of them run
+/// Expectation: an idle actor thread steals one from the run queue of the busy one, so both finish
+TEST_F(TestActorThreadPool, test_idle_worker_steals) {
+  if (std::thread::hardware_concurrency() < 2) {
+    return;
+  }
+  pool_ = ActorThreadPool::CreateThreadPool(2);
+  ASSERT_NE(pool_, nullptr);
+  ASSERT_EQ(pool_->GetActorThreadNum(), 2);
+  RunRecord record;
+  Rendezvous rendezvous(2);
+  std::vector<AID> targets;
+  targets.push_back(SpawnActor<TargetActor>("steal_target_0", &record, &rendezvous));
+  targets.push_back(SpawnActor<TargetActor>("steal_target_1", &record, &rendezvous));
+  auto source = SpawnActor<SourceActor>("steal_source");
+  Async(source, &SourceActor::Trigger, targets);
+  ASSERT_EQ(record.WaitFor(targets.size()).size(), targets.size());
+}
+}  // namespace mindspore
@@ -0,0 +1,197 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+#include "backend/optimizer/common/helper.h"
+#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/cpu/multi_tensor_optimizer_fusion_cpu.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWMultiTensorOptimizerFusionCPU : public UT::Common {
+ public:
+  TestHWMultiTensorOptimizerFusionCPU() {}
+};
+
+namespace {
+using KernelGraph = session::KernelGraph;
+
+AbstractBasePtr TensorAbstract() { return std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{4}); }
+
+AnfNodePtr NewMonad() {
+  auto monad = NewValueNode(kUMonad);
+  monad->set_abstract(kUMonad->ToAbstract());
+  return monad;
+}
+
+// An UpdateState which waits for the node, the updates reading it come after the node.
+AnfNodePtr NewUpdateState(const std::shared_ptr<KernelGraph> &graph, const AnfNodePtr &monad, const AnfNodePtr &node) {
+  auto update_state = graph->NewCNode({NewValueNode(prim::kPrimUpdateState), monad, node});
+  update_state->set_abstract(kUMonad->ToAbstract());
+  return update_state;
+}
+
+// An ApplyMomentum whose inputs are fresh parameters, except the gradient when it is given.
+CNodePtr NewApplyMomentum(const std::shared_ptr<KernelGraph> &graph, const AnfNodePtr &monad,
+                          const AnfNodePtr &gradient = nullptr) {
+  AnfNodePtrList inputs = {NewValueNode(std::make_shared<Primitive>(kApplyMomentumOpName))};
+  for (size_t i = 0; i < 5; ++i) {
+    inputs.emplace_back(i == 3 && gradient != nullptr ? gradient : graph->NewParameter(TensorAbstract()));
+  }
+  inputs.emplace_back(monad);
+  auto node = graph->NewCNode(inputs);
+  node->set_abstract(TensorAbstract());
+  return node;
+}
+
+void RunPass(const std::shared_ptr<KernelGraph> &graph, const AnfNodePtrList &outputs) {
+  AnfNodePtrList make_tuple_inputs = {NewValueNode(prim::kPrimMakeTuple)};
+  (void)make_tuple_inputs.insert(make_tuple_inputs.end(), outputs.begin(), outputs.end());
+  graph->set_output(graph->NewCNode(make_tuple_inputs));
+  auto manager = Manage(graph, true);
+  auto optimizer = std::make_shared<GraphOptimizer>();
+  auto pm = std::make_shared<PassManager>();
+  pm->AddPass(std::make_shared<MultiTensorOptimizerFusionCPU>("multi_tensor_optimizer_fusion_cpu"));
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(graph);
+}
+
+std::vector<CNodePtr> GetNodes(const FuncGraphPtr &graph, const std::string &op_name) {
+  std::vector<CNodePtr> nodes;
+  for (const auto &node : TopoSort(graph->get_return())) {
+    if (node->isa<CNode>() && AnfAlgo::GetCNodeName(node) == op_name) {
+      nodes.emplace_back(node->cast<CNodePtr>());
+    }
+  }
+  return nodes;
+}
+
+// The monads after the tensor inputs of the node.
+AnfNodePtrList GetMonads(const CNodePtr &cnode) {
+  AnfNodePtrList monads;
+  for (size_t i = AnfAlgo::GetInputTensorNum(cnode) + 1; i < cnode->inputs().size(); ++i) {
+    monads.emplace_back(cnode->input(i));
+  }
+  return monads;
+}
+}  // namespace
+
+/// Feature: multi tensor optimizer fusion on CPU
+/// Description: three ApplyMomentum nodes wait for the same monad
+/// Expectation: one MultiTensorApplyMomentum updates the three parameters and waits for the monad once
+TEST_F(TestHWMultiTensorOptimizerFusionCPU, test_shared_monad) {
+  auto graph = std::make_shared<KernelGraph>();
+  auto monad = NewMonad();
+  AnfNodePtrList updates;
+  for (size_t i = 0; i < 3; ++i) {
+    updates.emplace_back(NewApplyMomentum(graph, monad));
+  }
+  RunPass(graph, updates);
+  ASSERT_TRUE(GetNodes(graph, kApplyMomentumOpName).empty());
+  auto fused_nodes = GetNodes(graph, kMultiTensorApplyMomentumOpName);
+  ASSERT_EQ(fused_nodes.size(), 1);
+  auto fused_node = fused_nodes[0];
+  ASSERT_EQ(AnfAlgo::GetNodeAttr<int64_t>(fused_node, kAttrN), 3);
+  ASSERT_EQ(AnfAlgo::GetInputTensorNum(fused_node), 15);
+  ASSERT_EQ(GetMonads(fused_node), AnfNodePtrList({monad}));
+}
+
+/// Feature: multi tensor optimizer fusion on CPU
+/// Description: three ApplyMomentum nodes wait for different monads which do not depend on the updates
+/// Expectation: the fused node waits for all the monads, so no update runs before the side effects it waited for
+TEST_F(TestHWMultiTensorOptimizerFusionCPU, test_distinct_monads) {
+  auto graph = std::make_shared<KernelGraph>();
+  auto monad = NewMonad();
+  AnfNodePtrList monads;
+  AnfNodePtrList updates;
+  for (size_t i = 0; i < 3; ++i) {
+    monads.emplace_back(NewUpdateState(graph, monad, graph->NewParameter(TensorAbstract())));
+    updates.emplace_back(NewApplyMomentum(graph, monads.back()));
+  }
+  RunPass(graph, updates);
+  auto fused_nodes = GetNodes(graph, kMultiTensorApplyMomentumOpName);
+  ASSERT_EQ(fused_nodes.size(), 1);
+  ASSERT_EQ(AnfAlgo::GetNodeAttr<int64_t>(fused_nodes[0], kAttrN), 3);
+  auto fused_monads = GetMonads(fused_nodes[0]);
+  ASSERT_EQ(fused_monads.size(), 3);
+  ASSERT_EQ(std::set<AnfNodePtr>(fused_monads.begin(), fused_monads.end()),
+            std::set<AnfNodePtr>(monads.begin(), monads.end()));
+}
+
+/// Feature: multi tensor optimizer fusion on CPU
+/// Description: four ApplyMomentum nodes chained by auto monad, each update waits for the UpdateState which attaches
+/// the update before it, as the updates of an optimizer in a training graph
+/// Expectation: the four updates are fused, the fused node waits for the head of the chain and the UpdateStates of the
+/// chain attach the outputs of the fused node
+TEST_F(TestHWMultiTensorOptimizerFusionCPU, test_serial_chain) {
+  auto graph = std::make_shared<KernelGraph>();
+  auto head = NewMonad();
+  auto monad = head;
+  AnfNodePtrList outputs;
+  AnfNodePtrList chain;
+  for (size_t i = 0; i < 4; ++i) {
+    auto update = NewApplyMomentum(graph, monad);
+    outputs.emplace_back(update);
+    monad = NewUpdateState(graph, monad, update);
+    chain.emplace_back(monad);
+  }
+  outputs.emplace_back(monad);
+  RunPass(graph, outputs);
+  ASSERT_TRUE(GetNodes(graph, kApplyMomentumOpName).empty());
+  auto fused_nodes = GetNodes(graph, kMultiTensorApplyMomentumOpName);
+  ASSERT_EQ(fused_nodes.size(), 1);
+  auto fused_node = fused_nodes[0];
+  ASSERT_EQ(AnfAlgo::GetNodeAttr<int64_t>(fused_node, kAttrN), 4);
+  ASSERT_EQ(GetMonads(fused_node), AnfNodePtrList({head}));
+  for (size_t i = 0; i < chain.size(); ++i) {
+    auto update_state = chain[i]->cast<CNodePtr>();
+    ASSERT_EQ(update_state->input(1), i == 0 ? head : chain[i - 1]);
+    auto attached = AnfAlgo::VisitKernel(update_state->input(2), 0);
+    ASSERT_EQ(attached.first, fused_node);
+    ASSERT_EQ(attached.second, i);
+  }
+}
+
+/// Feature: multi tensor optimizer fusion on CPU
+/// Description: of four ApplyMomentum nodes, the second reads the output of the first as its gradient and the third
+/// waits for an UpdateState which attaches the second
+/// Expectation: only the first and the fourth are fused, the two dependent updates are kept and read the fused node
+TEST_F(TestHWMultiTensorOptimizerFusionCPU, test_dependent_updates) {
+  auto graph = std::make_shared<KernelGraph>();
+  auto monad = NewMonad();
+  auto first = NewApplyMomentum(graph, monad);
+  auto second = NewApplyMomentum(graph, monad, first);
+  auto third = NewApplyMomentum(graph, NewUpdateState(graph, monad, second));
+  auto fourth = NewApplyMomentum(graph, monad);
+  RunPass(graph, {first, second, third, fourth});
+  auto fused_nodes = GetNodes(graph, kMultiTensorApplyMomentumOpName);
+  ASSERT_EQ(fused_nodes.size(), 1);
+  auto fused_node = fused_nodes[0];
+  ASSERT_EQ(AnfAlgo::GetNodeAttr<int64_t>(fused_node, kAttrN), 2);
+  ASSERT_EQ(GetMonads(fused_node), AnfNodePtrList({monad}));
+  auto updates = GetNodes(graph, kApplyMomentumOpName);
+  ASSERT_EQ(std::set<CNodePtr>(updates.begin(), updates.end()), std::set<CNodePtr>({second, third}));
+  ASSERT_EQ(AnfAlgo::VisitKernel(second->input(4), 0).first, fused_node);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,130 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "ir/manager.h"
+#include "ir/param_info.h"
+#include "ir/tensor.h"
+#include "utils/flags.h"
+#include "utils/utils.h"
+#include "backend/optimizer/common/helper.h"
+#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/pass/add_training_attr.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWAddTrainingAttr : public UT::Common {
+ public:
+  TestHWAddTrainingAttr() {}
+};
+
+namespace {
+ParameterPtr AddWeight(const FuncGraphPtr &graph, bool requires_grad) {
+  auto weight = graph->add_parameter();
+  auto value = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{4, 4});
+  auto param_info = std::make_shared<ParamInfo>();
+  param_info->set_requires_grad(requires_grad);
+  value->set_param_info(param_info);
+  weight->set_default_param(value);
+  return weight;
+}
+
+CNodePtr NewNode(const FuncGraphPtr &graph, const std::string &op_name, const AnfNodePtrList &args) {
+  AnfNodePtrList inputs = {NewValueNode(std::make_shared<Primitive>(op_name))};
+  (void)inputs.insert(inputs.end(), args.begin(), args.end());
+  return graph->NewCNode(inputs);
+}
+
+CNodePtr NewAssign(const FuncGraphPtr &graph, const AnfNodePtr &param, const AnfNodePtr &value) {
+  auto prim = std::make_shared<Primitive>(prim::kPrimAssign->name());
+  (void)prim->AddAttr(GRAPH_FLAG_SIDE_EFFECT_MEM, MakeValue(true));
+  return graph->NewCNode({NewValueNode(prim), param, value});
+}
+
+void RunPass(const FuncGraphPtr &graph) {
+  auto optimizer = std::make_shared<GraphOptimizer>();
+  auto pm = std::make_shared<PassManager>();
+  pm->AddPass(std::make_shared<AddTrainingAttr>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(graph);
+}
+
+bool IsTraining(const CNodePtr &cnode) {
+  return cnode->HasAttr(kAttrIsTraining) && GetValue<bool>(cnode->GetAttr(kAttrIsTraining));
+}
+}  // namespace
+
+/// Feature: training attr of Conv2D and MatMul
+/// Description: a Conv2D and a MatMul share a weight that is neither trained nor written
+/// Expectation: both nodes are inferred only, and the weight is read only although two kinds of ops read it
+TEST_F(TestHWAddTrainingAttr, test_inference) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto x = graph->add_parameter();
+  auto weight = AddWeight(graph, false);
+  auto load = NewNode(graph, prim::kPrimLoad->name(), {weight, NewValueNode(kUMonad)});
+  auto conv = NewNode(graph, prim::kPrimConv2D->name(), {x, load});
+  auto matmul = NewNode(graph, prim::kPrimMatMul->name(), {conv, load});
+  graph->set_output(matmul);
+  auto manager = Manage(graph, true);
+  RunPass(graph);
+  ASSERT_TRUE(conv->HasAttr(kAttrIsTraining));
+  ASSERT_FALSE(IsTraining(conv));
+  ASSERT_TRUE(matmul->HasAttr(kAttrIsTraining));
+  ASSERT_FALSE(IsTraining(matmul));
+  ASSERT_TRUE(IsReadOnlyWeight(manager, load));
+  ASSERT_FALSE(IsWrittenParameter(manager, load));
+}
+
+/// Feature: training attr of Conv2D and MatMul
+/// Description: an Assign updates the weight of a Conv2D and a MatMul
+/// Expectation: both nodes are trained and the weight is not read only
+TEST_F(TestHWAddTrainingAttr, test_written_weight) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto x = graph->add_parameter();
+  auto weight = AddWeight(graph, false);
+  auto conv = NewNode(graph, prim::kPrimConv2D->name(), {x, weight});
+  auto matmul = NewNode(graph, prim::kPrimMatMul->name(), {conv, weight});
+  auto assign = NewAssign(graph, weight, matmul);
+  graph->set_output(NewNode(graph, prim::kPrimMakeTuple->name(), {matmul, assign}));
+  auto manager = Manage(graph, true);
+  RunPass(graph);
+  ASSERT_TRUE(IsTraining(conv));
+  ASSERT_TRUE(IsTraining(matmul));
+  ASSERT_TRUE(IsWrittenParameter(manager, weight));
+  ASSERT_FALSE(IsReadOnlyWeight(manager, weight));
+}
+
+/// Feature: training attr of Conv2D
+/// Description: a Conv2DBackpropFilter reads the input of a Conv2D whose weight is trained but not written
+/// Expectation: the Conv2D is trained, and a trained weight is never read only
+TEST_F(TestHWAddTrainingAttr, test_conv_backprop) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto x = graph->add_parameter();
+  auto dout = graph->add_parameter();
+  auto weight = AddWeight(graph, true);
+  auto conv = NewNode(graph, prim::kPrimConv2D->name(), {x, weight});
+  auto filter_grad = NewNode(graph, prim::kPrimConv2DBackpropFilter->name(), {dout, x});
+  graph->set_output(NewNode(graph, prim::kPrimMakeTuple->name(), {conv, filter_grad}));
+  auto manager = Manage(graph, true);
+  RunPass(graph);
+  ASSERT_TRUE(IsTraining(conv));
+  ASSERT_FALSE(IsWrittenParameter(manager, weight));
+  ASSERT_FALSE(IsReadOnlyWeight(manager, weight));
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/framework/graph_scheduler.h"
+
+namespace mindspore {
+namespace runtime {
+class TestGraphScheduler : public UT::Common {
+ public:
+  TestGraphScheduler() {}
+};
+
+namespace {
+constexpr size_t kActorThreadNum = 4;
+constexpr size_t kKernelThreadNum = 8;
+using Edges = std::vector<std::vector<size_t>>;
+}  // namespace
+
+/// Feature: intra op thread budget of kernel actors
+/// Description: a chain of three kernels
+/// Expectation: the kernels share the kernel threads, the budget is zero
+TEST_F(TestGraphScheduler, test_thread_budget_chain) {
+  Edges successors = {{1}, {2}, {}};
+  Edges predecessors = {{}, {0}, {1}};
+  ASSERT_EQ(GraphScheduler::GetIntraOpThreadBudget(successors, predecessors, {1.0, 1.0, 1.0}, kActorThreadNum,
+                                                   kKernelThreadNum),
+            0);
+}
+
+/// Feature: intra op thread budget of kernel actors
+/// Description: two independent kernels of the same cost
+/// Expectation: each kernel gets half of the kernel threads
+TEST_F(TestGraphScheduler, test_thread_budget_parallel) {
+  Edges successors = {{}, {}};
+  Edges predecessors = {{}, {}};
+  ASSERT_EQ(
+    GraphScheduler::GetIntraOpThreadBudget(successors, predecessors, {1.0, 1.0}, kActorThreadNum, kKernelThreadNum),
+    5);
+}
+
+/// Feature: intra op thread budget of kernel actors
+/// Description: a costly kernel runs beside three kernels that together cost less than half of it
+/// Expectation: the level counts as a chain, the costly kernel keeps the kernel threads
+TEST_F(TestGraphScheduler, test_thread_budget_weighted_by_cost) {
+  Edges successors = {{}, {}, {}, {}};
+  Edges predecessors = {{}, {}, {}, {}};
+  ASSERT_EQ(GraphScheduler::GetIntraOpThreadBudget(successors, predecessors, {10.0, 1.0, 1.0, 1.0}, kActorThreadNum,
+                                                   kKernelThreadNum),
+            0);
+  ASSERT_EQ(GraphScheduler::GetIntraOpThreadBudget(successors, predecessors, {1.0, 1.0, 1.0, 1.0}, kActorThreadNum,
+                                                   kKernelThreadNum),
+            3);
+}
+
+/// Feature: intra op thread budget of kernel actors
+/// Description: eight independent kernels with two actor threads
+/// Expectation: the graph width is capped by the actor threads
+TEST_F(TestGraphScheduler, test_thread_budget_capped_by_actor_threads) {
+  Edges successors(8);
+  Edges predecessors(8);
+  std::vector<double> costs(8, 1.0);
+  ASSERT_EQ(GraphScheduler::GetIntraOpThreadBudget(successors, predecessors, costs, 2, kKernelThreadNum), 5);
+}
+
+/// Feature: intra op thread budget of kernel actors
+/// Description: the costs do not match the kernels of the edges
+/// Expectation: throw an exception
+TEST_F(TestGraphScheduler, test_thread_budget_mismatched_costs) {
+  Edges successors = {{}, {}};
+  Edges predecessors = {{}, {}};
+  ASSERT_ANY_THROW(
+    GraphScheduler::GetIntraOpThreadBudget(successors, predecessors, {1.0}, kActorThreadNum, kKernelThreadNum));
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "proto/checkpoint.pb.h"
+#include "utils/checkpoint_engine.h"
+
+namespace mindspore {
+namespace checkpoint {
+class TestCheckpointEngine : public UT::Common {
+ public:
+  TestCheckpointEngine() {}
+  void TearDown() override {
+    for (auto &file : {kIndexedFile, kTruncatedFile, kProtoFile}) {
+      (void)std::remove(file);
+    }
+  }
+
+ protected:
+  static constexpr char kIndexedFile[] = "./checkpoint_engine_test_indexed.ckpt";
+  static constexpr char kTruncatedFile[] = "./checkpoint_engine_test_truncated.ckpt";
+  static constexpr char kProtoFile[] = "./checkpoint_engine_test_proto.ckpt";
+};
+
+constexpr char TestCheckpointEngine::kIndexedFile[];
+constexpr char TestCheckpointEngine::kTruncatedFile[];
+constexpr char TestCheckpointEngine::kProtoFile[];
+
+namespace {
+std::vector<NamedTensor> MakeTensors(std::vector<float> *weight) {
+  for (size_t i = 0; i < weight->size(); ++i) {
+    (*weight)[i] = static_cast<float>(i) * 0.5f;
+  }
+  std::vector<int64_t> step = {1, 2, 3};
+  bool flag = true;
+  auto weight_tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{64, 16384}, weight->data(),
+                                                        weight->size() * sizeof(float));
+  auto step_tensor =
+    std::make_shared<tensor::Tensor>(kNumberTypeInt64, ShapeVector{3}, step.data(), step.size() * sizeof(int64_t));
+  auto flag_tensor = std::make_shared<tensor::Tensor>(kNumberTypeBool, ShapeVector{}, &flag, sizeof(bool));
+  return {{"weight", weight_tensor}, {"step", step_tensor}, {"flag", flag_tensor}};
+}
+}  // namespace
+
+/// Feature: indexed checkpoint
+/// Description: save tensors in the background with several threads and read them back from the mapped file
+/// Expectation: the data is the one of the save, aligned, and a write to a read tensor does not reach the file
+TEST_F(TestCheckpointEngine, test_save_and_read_indexed) {
+  std::vector<float> weight(64 * 16384);
+  auto tensors = MakeTensors(&weight);
+  auto &saver = CheckpointSaver::GetInstance();
+  saver.SaveAsync(kIndexedFile, tensors, 4);
+  // the save works on a copy, so the training may update the tensors at once
+  static_cast<float *>(tensors[0].second->data_c())[5] = -1.0f;
+  saver.Wait();
+  ASSERT_TRUE(IsIndexedCheckpoint(kIndexedFile));
+
+  {
+    CheckpointReader reader(kIndexedFile);
+    ASSERT_EQ(reader.GetTensorNames(), std::vector<std::string>({"weight", "step", "flag"}));
+    auto weight_tensor = reader.ReadTensor("weight");
+    ASSERT_EQ(weight_tensor->data_type(), kNumberTypeFloat32);
+    ASSERT_EQ(weight_tensor->shape(), ShapeVector({64, 16384}));
+    auto weight_data = static_cast<float *>(weight_tensor->data_c());
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(weight_data) % kCheckpointAlign, 0);
+    ASSERT_EQ(weight_data[5], 2.5f);
+    ASSERT_EQ(weight_data[weight.size() - 1], static_cast<float>(weight.size() - 1) * 0.5f);
+    weight_data[0] = 42.0f;
+
+    auto step_tensor = reader.ReadTensor("step");
+    ASSERT_EQ(static_cast<int64_t *>(step_tensor->data_c())[2], 3);
+    auto flag_tensor = reader.ReadTensor("flag");
+    ASSERT_TRUE(flag_tensor->shape().empty());
+    ASSERT_TRUE(*static_cast<bool *>(flag_tensor->data_c()));
+    EXPECT_ANY_THROW(reader.ReadTensor("bias"));
+  }
+  CheckpointReader reader(kIndexedFile);
+  ASSERT_EQ(static_cast<float *>(reader.ReadTensor("weight")->data_c())[0], 0.0f);
+}
+
+/// Feature: indexed checkpoint
+/// Description: read a checkpoint whose end is cut off, and save to a directory which does not exist twice, waiting for
+/// the first save and starting another one after the second
+/// Expectation: the reader, the wait and the save after a failed one raise an exception, the saves after it succeed
+TEST_F(TestCheckpointEngine, test_broken_indexed) {
+  std::vector<float> weight(64 * 16384);
+  auto tensors = MakeTensors(&weight);
+  ASSERT_TRUE(WriteIndexedCheckpoint(kIndexedFile, tensors, 2));
+  {
+    std::ifstream input(kIndexedFile, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::ofstream output(kTruncatedFile, std::ios::binary);
+    (void)output.write(content.data(), static_cast<std::streamsize>(content.size() - 100));
+  }
+  EXPECT_ANY_THROW(CheckpointReader reader(kTruncatedFile));
+
+  auto &saver = CheckpointSaver::GetInstance();
+  saver.SaveAsync("./checkpoint_engine_test_not_exist/net.ckpt", tensors, 2);
+  EXPECT_ANY_THROW(saver.Wait());
+  saver.SaveAsync("./checkpoint_engine_test_not_exist/net.ckpt", tensors, 2);
+  EXPECT_ANY_THROW(saver.SaveAsync(kIndexedFile, tensors, 2));
+  saver.SaveAsync(kIndexedFile, tensors, 2);
+  saver.Wait();
+  ASSERT_TRUE(IsIndexedCheckpoint(kIndexedFile));
+}
+
+/// Feature: protobuf checkpoint
+/// Description: read a checkpoint of mindspore.save_checkpoint whose tensor is split into slices
+/// Expectation: the slices are joined and the scalar saved with dims [0] has an empty shape
+TEST_F(TestCheckpointEngine, test_read_proto) {
+  ::Checkpoint checkpoint;
+  for (int i = 0; i < 2; ++i) {
+    auto value = checkpoint.add_value();
+    value->set_tag("weight");
+    auto tensor = value->mutable_tensor();
+    tensor->add_dims(2);
+    tensor->add_dims(2);
+    tensor->set_tensor_type("Float32");
+    float data[2] = {i * 2.0f, i * 2.0f + 1};
+    tensor->set_tensor_content(std::string(reinterpret_cast<char *>(data), sizeof(data)));
+  }
+  auto value = checkpoint.add_value();
+  value->set_tag("learning_rate");
+  value->mutable_tensor()->add_dims(0);
+  value->mutable_tensor()->set_tensor_type("Float32");
+  float learning_rate = 0.1f;
+  value->mutable_tensor()->set_tensor_content(
+    std::string(reinterpret_cast<char *>(&learning_rate), sizeof(learning_rate)));
+  {
+    std::ofstream output(kProtoFile, std::ios::binary);
+    output << checkpoint.SerializeAsString();
+  }
+
+  ASSERT_FALSE(IsIndexedCheckpoint(kProtoFile));
+  CheckpointReader reader(kProtoFile);
+  ASSERT_EQ(reader.GetTensorNames(), std::vector<std::string>({"weight", "learning_rate"}));
+  auto weight_tensor = reader.ReadTensor("weight");
+  ASSERT_EQ(weight_tensor->shape(), ShapeVector({2, 2}));
+  ASSERT_EQ(static_cast<float *>(weight_tensor->data_c())[3], 3.0f);
+  auto learning_rate_tensor = reader.ReadTensor("learning_rate");
+  ASSERT_TRUE(learning_rate_tensor->shape().empty());
+  ASSERT_EQ(*static_cast<float *>(learning_rate_tensor->data_c()), learning_rate);
+}
+}  // namespace checkpoint
+}  // namespace mindspore
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+#include <vector>
+#include "utils/node_pool.h"
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "ir/value.h"
+#include "base/core_ops.h"
+
+namespace mindspore {
+class TestNodePool : public UT::Common {
+ public:
+  TestNodePool() {}
+};
+
+TEST_F(TestNodePool, test_reuse_freed_block) {
+  void *block = NodePool::Allocate(100);
+  ASSERT_NE(block, nullptr);
+  NodePool::Free(block, 100);
+  // Sizes in the same size class share the freed block.
+  void *reused = NodePool::Allocate(97);
+  ASSERT_EQ(block, reused);
+  NodePool::Free(reused, 97);
+
+  void *large = NodePool::Allocate(NodePool::kMaxBlockSize + 1);
+  ASSERT_NE(large, nullptr);
+  NodePool::Free(large, NodePool::kMaxBlockSize + 1);
+}
+
+TEST_F(TestNodePool, test_free_on_other_thread) {
+  void *block = NodePool::Allocate(64);
+  std::thread free_thread([block]() { NodePool::Free(block, 64); });
+  free_thread.join();
+  // The exited thread hands the block over, a thread without blocks of the class refills with it first.
+  void *other = nullptr;
+  std::thread allocate_thread([&other]() {
+    other = NodePool::Allocate(64);
+    NodePool::Free(other, 64);
+  });
+  allocate_thread.join();
+  ASSERT_EQ(other, block);
+}
+
+TEST_F(TestNodePool, test_trim_free_slabs) {
+  // The largest size class is not used by the other tests.
+  constexpr size_t kBlockSize = NodePool::kMaxBlockSize;
+  constexpr size_t kSlabNum = 8;
+  size_t slab_num = NodePool::GetSlabNum();
+  size_t peak_slab_num = 0;
+  std::thread alloc_thread([&peak_slab_num]() {
+    std::vector<void *> blocks;
+    for (size_t i = 0; i < kSlabNum * NodePool::kSlabSize / kBlockSize; ++i) {
+      blocks.push_back(NodePool::Allocate(kBlockSize));
+    }
+    peak_slab_num = NodePool::GetSlabNum();
+    for (auto block : blocks) {
+      NodePool::Free(block, kBlockSize);
+    }
+  });
+  alloc_thread.join();
+  ASSERT_GE(peak_slab_num, slab_num + kSlabNum);
+  // The slabs whose blocks are all freed go back to the heap.
+  ASSERT_LE(NodePool::GetSlabNum(), slab_num);
+}
+
+TEST_F(TestNodePool, test_pooled_nodes) {
+  FuncGraphPtr fg = std::make_shared<FuncGraph>();
+  ParameterPtr x = fg->add_parameter();
+  ValueNodePtr value = NewValueNode(static_cast<int64_t>(1));
+  CNodePtr cnode = fg->NewCNode({NewValueNode(prim::kPrimScalarAdd), x, value});
+  fg->set_output(cnode);
+  ASSERT_EQ(cnode->func_graph(), fg);
+  ASSERT_EQ(cnode->input(1), x);
+  ASSERT_EQ(cnode->shared_from_base<CNode>(), cnode);
+}
+}  // namespace mindspore
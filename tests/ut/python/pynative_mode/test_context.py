@@ -124,6 +124,23 @@ def test_variable_memory_max_size():
     context.set_context(variable_memory_max_size="3GB")
 
 
+def test_intra_op_thread_num():
+    """
+    Feature: intra op thread number of CPU kernels
+    Description: set the intra op thread number to a negative value, a non integer value and a valid value
+    Expectation: the invalid values raise errors, the valid value is read back
+    """
+    context.set_context(device_target="CPU")
+    with pytest.raises(ValueError):
+        context.set_context(intra_op_thread_num=-1)
+    with pytest.raises(TypeError):
+        context.set_context(intra_op_thread_num="4")
+    context.set_context(intra_op_thread_num=4)
+    assert context.get_context("intra_op_thread_num") == 4
+    context.set_context(intra_op_thread_num=0)
+    assert context.get_context("intra_op_thread_num") == 0
+
+
 def test_print_file_path():
     """test_print_file_path"""
     with pytest.raises(IOError):
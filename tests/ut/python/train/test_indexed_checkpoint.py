@@ -0,0 +1,162 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""ut for the indexed checkpoint format"""
+import os
+import platform
+import secrets
+from unittest import mock
+
+import numpy as np
+import pytest
+
+import mindspore.common.dtype as mstype
+from mindspore.common.tensor import Tensor
+from mindspore.train.callback import ModelCheckpoint, RunContext, CheckpointConfig, _InternalCallbackParam
+from mindspore.train.serialization import save_checkpoint, load_checkpoint, _wait_indexed_checkpoint_saved
+
+indexed_ckpt_file = "./indexed_checkpoint_test.ckpt"
+proto_ckpt_file = "./indexed_checkpoint_test_proto.ckpt"
+
+skip_on_windows = pytest.mark.skipif(platform.system().lower() == "windows",
+                                     reason="the indexed checkpoint engine is not built on windows")
+
+
+def teardown_function():
+    for file_name in (indexed_ckpt_file, proto_ckpt_file):
+        if os.path.exists(file_name):
+            os.remove(file_name)
+
+
+def make_parameter_list():
+    weight = np.arange(12 * 1024).reshape(12, 1024).astype(np.float32)
+    bias = np.arange(12).astype(np.float32)
+    step = np.array([7]).astype(np.int32)
+    return [{"name": "fc.weight", "data": Tensor(weight)},
+            {"name": "fc.bias", "data": Tensor(bias)},
+            {"name": "global_step", "data": Tensor(step, dtype=mstype.int32)}]
+
+
+def test_save_checkpoint_format_invalid():
+    """
+    Feature: checkpoint format of save_checkpoint
+    Description: save with an unknown format, and with an encryption key in the indexed format
+    Expectation: both raise ValueError before any file is written
+    """
+    with pytest.raises(ValueError):
+        save_checkpoint(make_parameter_list(), indexed_ckpt_file, ckpt_format="JSON")
+    with pytest.raises(ValueError):
+        save_checkpoint(make_parameter_list(), indexed_ckpt_file, enc_key=secrets.token_bytes(16),
+                        ckpt_format="INDEXED")
+    assert not os.path.exists(indexed_ckpt_file)
+
+
+def test_checkpoint_config_format():
+    """
+    Feature: checkpoint format of CheckpointConfig
+    Description: create configs with the default, the indexed and an unknown format, and an encrypted indexed one
+    Expectation: the known formats are kept, the unknown format and the encryption of the indexed one raise ValueError
+    """
+    assert CheckpointConfig().ckpt_format == "PROTOBUF"
+    assert CheckpointConfig(ckpt_format="INDEXED").ckpt_format == "INDEXED"
+    with pytest.raises(ValueError):
+        CheckpointConfig(ckpt_format="indexed")
+    with pytest.raises(ValueError):
+        CheckpointConfig(enc_key=secrets.token_bytes(16), ckpt_format="INDEXED")
+
+
+@pytest.mark.parametrize("ckpt_format, wait_count", [("INDEXED", 1), ("PROTOBUF", 0)])
+def test_model_checkpoint_end_wait(ckpt_format, wait_count):
+    """
+    Feature: checkpoint format of ModelCheckpoint
+    Description: end the training of a ModelCheckpoint saving in the indexed and in the protobuf format
+    Expectation: only the indexed one waits for the checkpoint the engine saves in the background
+    """
+    ckpt_cb = ModelCheckpoint(prefix="indexed_ckpt", directory="./test_files",
+                              config=CheckpointConfig(ckpt_format=ckpt_format))
+    run_context = RunContext(_InternalCallbackParam())
+    with mock.patch.object(ModelCheckpoint, "_save_ckpt") as save_ckpt, \
+            mock.patch("mindspore.train.callback._checkpoint._wait_indexed_checkpoint_saved") as wait_saved:
+        ckpt_cb.end(run_context)
+    save_ckpt.assert_called_once()
+    assert wait_saved.call_count == wait_count
+
+
+@skip_on_windows
+def test_save_and_load_indexed():
+    """
+    Feature: indexed checkpoint
+    Description: save parameters in the indexed format in the background, then load them with and without a filter
+    Expectation: the loader recognizes the format by its magic bytes and returns the saved data
+    """
+    parameter_list = make_parameter_list()
+    save_checkpoint(parameter_list, indexed_ckpt_file, async_save=True, ckpt_format="INDEXED")
+    _wait_indexed_checkpoint_saved()
+    with open(indexed_ckpt_file, "rb") as f:
+        assert f.read(8) == b"MSCKPT01"
+
+    param_dict = load_checkpoint(indexed_ckpt_file)
+    assert set(param_dict.keys()) == {"fc.weight", "fc.bias", "global_step"}
+    for param in parameter_list:
+        assert np.array_equal(param_dict[param["name"]].asnumpy(), param["data"].asnumpy())
+    assert param_dict["global_step"].dtype == mstype.int32
+
+    param_dict = load_checkpoint(indexed_ckpt_file, filter_prefix="fc.")
+    assert set(param_dict.keys()) == {"global_step"}
+    with pytest.raises(ValueError):
+        load_checkpoint(indexed_ckpt_file, filter_prefix=["fc.", "global"])
+
+
+@skip_on_windows
+def test_load_indexed_dec_key():
+    """
+    Feature: indexed checkpoint
+    Description: load an indexed checkpoint with a decryption key
+    Expectation: raise ValueError, as the indexed format is never encrypted
+    """
+    save_checkpoint(make_parameter_list(), indexed_ckpt_file, ckpt_format="INDEXED")
+    with pytest.raises(ValueError):
+        load_checkpoint(indexed_ckpt_file, dec_key=secrets.token_bytes(16))
+
+
+@skip_on_windows
+def test_load_proto_after_indexed():
+    """
+    Feature: checkpoint format sniffing of load_checkpoint
+    Description: save the same parameters in the protobuf and in the indexed format and load both
+    Expectation: each file is read in its own format and the parameters are the same
+    """
+    parameter_list = make_parameter_list()
+    save_checkpoint(parameter_list, proto_ckpt_file)
+    save_checkpoint(parameter_list, indexed_ckpt_file, ckpt_format="INDEXED")
+    proto_dict = load_checkpoint(proto_ckpt_file)
+    indexed_dict = load_checkpoint(indexed_ckpt_file)
+    assert set(proto_dict.keys()) == set(indexed_dict.keys())
+    for name, param in proto_dict.items():
+        assert np.array_equal(param.asnumpy(), indexed_dict[name].asnumpy())
+
+
+@skip_on_windows
+def test_failed_async_save_raised():
+    """
+    Feature: indexed checkpoint
+    Description: save in the background to a directory which does not exist, then save again
+    Expectation: the next save raises the failure of the background one, and a save after it succeeds
+    """
+    parameter_list = make_parameter_list()
+    save_checkpoint(parameter_list, "./indexed_checkpoint_not_exist/net.ckpt", async_save=True, ckpt_format="INDEXED")
+    with pytest.raises(RuntimeError):
+        save_checkpoint(parameter_list, indexed_ckpt_file, ckpt_format="INDEXED")
+    save_checkpoint(parameter_list, indexed_ckpt_file, ckpt_format="INDEXED")
+    assert os.path.exists(indexed_ckpt_file)